@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Compile the XML description of an alphabet (`res/<alphabet>/language_<alphabet>.xml`) into the
+# tables the library registers without parsing it (see `src/res/alphabet_def.res.h`):
+#
+#   - `<out>/font/<font-id>.def.cpp` for each font of the alphabet, see `src/res/font_def.res.h`
+#   - `<out>/alphabet/<alphabet>.def.cpp` for its symbols and character mappings
+#
+# Usage: alphabet_def.py res/cyrillic/language_cyrillic.xml src/res
+#
+# The generated files are committed, run it again when the XML-files change.
+
+import os
+import sys
+import xml.etree.ElementTree as ET
+
+ATOM_TYPES = {
+    'ord': 'ordinary',
+    'op': 'bigOperator',
+    'bin': 'binaryOperator',
+    'rel': 'relation',
+    'open': 'opening',
+    'close': 'closing',
+    'punct': 'punctuation',
+    'acc': 'accent',
+}
+
+VERSIONS = [
+    ('romanVersion', 'roman'),
+    ('boldVersion', 'bold'),
+    ('ssVersion', 'ss'),
+    ('ttVersion', 'tt'),
+    ('itVersion', 'it'),
+]
+
+
+def fail(msg):
+    sys.stderr.write('alphabet_def: %s\n' % msg)
+    sys.exit(1)
+
+
+def c_str(s):
+    """Quote the given string as a C string literal, the non-ASCII bytes are octal escaped"""
+    out = []
+    for b in s.encode('utf-8'):
+        c = chr(b)
+        if c in '\\"':
+            out.append('\\' + c)
+        elif 0x20 <= b < 0x7f:
+            out.append(c)
+        else:
+            out.append('\\%03o' % b)
+    return '"' + ''.join(out) + '"'
+
+
+def include_of(elem, base):
+    include = elem.get('include')
+    if not include:
+        fail('<%s> has no include' % elem.tag)
+    return os.path.join(base, include)
+
+
+def table(start, rows, end):
+    return [start, ',\n'.join(rows), end, '']
+
+
+def read_font(path, alphabet):
+    font = ET.parse(path).getroot()
+    font_id = font.get('id')
+    metrics, extensions, ligs, kerns = [], [], [], []
+    for c in font.iter('Char'):
+        code = int(c.get('code'))
+        metrics.append((code, [c.get(a, '0') for a in ('width', 'height', 'depth', 'italic')]))
+        for x in c:
+            if x.tag == 'Kern':
+                kerns.append(((code, int(x.get('code'))), x.get('val')))
+            elif x.tag == 'Lig':
+                ligs.append(((code, int(x.get('code'))), x.get('ligCode')))
+            elif x.tag == 'Extension':
+                ext = [x.get(a, '-1') for a in ('top', 'mid')] + [x.get('rep')] + [x.get('bot', '-1')]
+                extensions.append((code, ext))
+            else:
+                # the larger versions refer to the fonts by their ids, only known at run time
+                fail('%s: <%s> is not supported, keep the alphabet in XML' % (path, x.tag))
+    # sorted like DefaultTeXFontParser#sortBasicInfo
+    metrics.sort(key=lambda x: x[0])
+    extensions.sort(key=lambda x: x[0])
+    ligs.sort(key=lambda x: x[0])
+    kerns.sort(key=lambda x: x[0])
+
+    lines = [
+        '// Generated by prebuilt/alphabet_def.py from res/%s/%s, do not edit'
+        % (alphabet, os.path.basename(path)),
+        '',
+        '#include "res/font_def.res.h"',
+        '',
+        'DEF_FONT(%s, %s/%s, %s)' % (font_id, alphabet, font.get('name'), font.get('unicode', '0')),
+        '',
+    ]
+    dims = ['xHeight(%s)' % font.get('xHeight'), 'quad(%s)' % font.get('quad'),
+            'space(%s)' % font.get('space')]
+    if font.get('skewChar'):
+        dims.append('skew(%s)' % font.get('skewChar'))
+    lines += [' '.join(dims), '']
+    versions = ['%s(%s)' % (m, font.get(a)) for a, m in VERSIONS if font.get(a)]
+    if versions:
+        lines += [' '.join(versions), '']
+    if metrics:
+        lines += table('METRICS_START', ['%d, %s' % (c, ', '.join(m)) for c, m in metrics],
+                       'METRICS_END')
+    if extensions:
+        lines += table('EXTENSIONS_START', ['%d, %s' % (c, ', '.join(e)) for c, e in extensions],
+                       'EXTENSIONS_END')
+    if ligs:
+        lines += table('LIGTURES_START', ['%d, %d, %s' % (l, r, x) for (l, r), x in ligs],
+                       'LIGTURES_END')
+    if kerns:
+        lines += table('KERNS_START', ['%d, %d, %s' % (l, r, k) for (l, r), k in kerns],
+                       'KERNS_END')
+    lines.append('END')
+    return font_id, '\n'.join(lines) + '\n'
+
+
+def read_symbol_mappings(path):
+    rows = []
+    for m in ET.parse(path).getroot().iter('SymbolMapping'):
+        if m.get('boldId'):
+            fail('%s: boldId is not supported, keep the alphabet in XML' % path)
+        rows.append('M(%s, %s, %s)' % (m.get('fontId'), m.get('ch'), c_str(m.get('name'))))
+    return rows
+
+
+def read_symbols(path):
+    rows = []
+    for s in ET.parse(path).getroot().iter('Symbol'):
+        t = s.get('type')
+        if t not in ATOM_TYPES:
+            fail('%s: unknown symbol type %s' % (path, t))
+        kind = 'DEL' if s.get('del') == 'true' else 'SYM'
+        rows.append('%s(%s, %s)' % (kind, ATOM_TYPES[t], c_str(s.get('name'))))
+    return rows
+
+
+def read_char_mappings(root, group, attr):
+    rows = []
+    e = root.find(group)
+    if e is None:
+        return rows
+    for m in e.iter('Map'):
+        ch = m.get('char')
+        if len(ch) != 1:
+            fail('<Map> of %s: unknown code point %s' % (group, ch))
+        text = m.get('text')
+        rows.append('C(%d, %s, %s)' % (
+            ord(ch), c_str(m.get(attr)), 'nullptr' if text is None else c_str(text)))
+    return rows
+
+
+def compile_alphabet(language, out):
+    base = os.path.dirname(os.path.abspath(language))
+    alphabet = os.path.basename(base)
+    root = ET.parse(language).getroot()
+    if root.find('TextStyleMappings') is not None:
+        fail('%s: text style mappings are not supported, keep the alphabet in XML' % language)
+
+    fonts = []
+    des = root.find('FontDescriptions')
+    for met in ([] if des is None else des.iter('Metrics')):
+        font_id, src = read_font(include_of(met, base), alphabet)
+        with open(os.path.join(out, 'font', font_id + '.def.cpp'), 'w') as f:
+            f.write(src)
+        fonts.append(font_id)
+
+    lines = [
+        '// Generated by prebuilt/alphabet_def.py from res/%s, do not edit' % alphabet,
+        '',
+        '#include "res/alphabet_def.res.h"',
+        '',
+    ]
+    lines += ['DECL_FONT_REG(%s);' % f for f in fonts] + ['']
+    lines += ['DEF_ALPHABET(%s)' % alphabet, '']
+    if fonts:
+        lines += table('FONTS_START', ['FONT(%s)' % f for f in fonts], 'FONTS_END')
+    syms = root.find('TeXSymbols')
+    if syms is not None:
+        lines += table('SYMBOLS_START', read_symbols(include_of(syms, base)), 'SYMBOLS_END')
+    settings = root.find('FormulaSettings')
+    if settings is not None:
+        s = ET.parse(include_of(settings, base)).getroot()
+        rows = read_char_mappings(s, 'CharacterToSymbolMappings', 'symbol')
+        if rows:
+            lines += table('CHAR_SYMBOLS_START', rows, 'CHAR_SYMBOLS_END')
+        rows = read_char_mappings(s, 'CharacterToFormulaMappings', 'formula')
+        if rows:
+            lines += table('CHAR_FORMULAS_START', rows, 'CHAR_FORMULAS_END')
+    mappings = root.find('SymbolMappings')
+    if mappings is None:
+        fail('%s: no SymbolMappings' % language)
+    rows = []
+    for m in mappings.iter('Mapping'):
+        rows += read_symbol_mappings(include_of(m, base))
+    if rows:
+        lines += table('SYMBOL_MAPPINGS_START', rows, 'SYMBOL_MAPPINGS_END')
+    lines.append('END_DEF_ALPHABET')
+
+    os.makedirs(os.path.join(out, 'alphabet'), exist_ok=True)
+    with open(os.path.join(out, 'alphabet', alphabet + '.def.cpp'), 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        fail('usage: alphabet_def.py <language-xml> <out-dir>')
+    compile_alphabet(sys.argv[1], sys.argv[2])
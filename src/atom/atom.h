@@ -3,7 +3,9 @@
 
 #undef DEBUG
 
+#include <atomic>
 #include <list>
+#include <typeinfo>
 
 #include "box/box.h"
 
@@ -24,6 +26,25 @@ namespace tex {
  * the following one (in a row, if any).
  */
 class Atom {
+private:
+  /** The hash of the atom computed by #hash, not copied with the atom (a copy may change) */
+  struct HashSlot {
+    static constexpr size_t NONE = ~static_cast<size_t>(0);
+    // read and written by the layouts of the same atom on several threads
+    std::atomic<size_t> _value{NONE};
+
+    HashSlot() = default;
+
+    HashSlot(const HashSlot&) {}
+
+    HashSlot& operator=(const HashSlot&) {
+      _value.store(NONE, std::memory_order_relaxed);
+      return *this;
+    }
+  };
+
+  mutable HashSlot _hash;
+
 public:
   /** The type of the atom (default value: ordinary atom) */
   AtomType _type = AtomType::ordinary;
@@ -69,8 +90,77 @@ public:
   /** Shallow clone a atom from this atom. */
   virtual sptr<Atom> clone() const = 0;
 
+  /**
+   * Get the structural hash of this atom: the atoms of the same class made of the same values
+   * and children have the same hash, and are laid out to the same box in the same environment
+   * (see BoxMemo). It is 0 if the atom is not compared to others. It is computed by
+   * #computeHash on the first call and kept, the atoms do not change once laid out.
+   */
+  inline size_t hash() const {
+    size_t h = _hash._value.load(std::memory_order_relaxed);
+    if (h == HashSlot::NONE) {
+      h = computeHash();
+      _hash._value.store(h, std::memory_order_relaxed);
+    }
+    return h;
+  }
+
+  /**
+   * Test if the given atom has the same structure as this atom, only called if the atoms have
+   * the same hash.
+   */
+  virtual bool isSameAs(const Atom&) const { return false; }
+
   virtual ~Atom() = default;
 
+protected:
+  /**
+   * Compute the structural hash of this atom (see #hash), 0 by default, the atoms that return
+   * another value implement Atom#isSameAs.
+   */
+  virtual size_t computeHash() const { return 0; }
+
+  /** Drop the kept hash of this atom, called when it changes */
+  inline void invalidateHash() { _hash._value.store(HashSlot::NONE, std::memory_order_relaxed); }
+
+  static inline void mix(size_t& h, size_t v) {
+    h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+  }
+
+  /** Get the hash of the class and the types of this atom, the subclasses mix their values in */
+  inline size_t baseHash() const {
+    size_t h = typeid(*this).hash_code();
+    mix(h, static_cast<size_t>(_type));
+    mix(h, static_cast<size_t>(_limitsType) << 8 | static_cast<size_t>(_alignment));
+    return h;
+  }
+
+  /** Test if the given atom has the same class and types as this atom */
+  inline bool isBaseSameAs(const Atom& atom) const {
+    return typeid(*this) == typeid(atom)
+           && _type == atom._type
+           && _limitsType == atom._limitsType
+           && _alignment == atom._alignment;
+  }
+
+  /** Mix the hash of the given child (may be nullptr) into h, return false if it has no hash */
+  static inline bool mixChild(size_t& h, const sptr<Atom>& child) {
+    if (child == nullptr) {
+      mix(h, 1);
+      return true;
+    }
+    const size_t ch = child->hash();
+    mix(h, ch);
+    return ch != 0;
+  }
+
+  /** Test if the given children (may be nullptr) have the same structure */
+  static inline bool isSame(const sptr<Atom>& a, const sptr<Atom>& b) {
+    if (a == b) return true;
+    if (a == nullptr || b == nullptr) return false;
+    return a->isSameAs(*b);
+  }
+
 #ifndef __decl_clone
 #define __decl_clone(type) \
   virtual sptr<Atom> clone() const override { return sptr<Atom>(new type(*this)); }
@@ -22,7 +22,7 @@ sptr<Box> ScaleAtom::createBox(Environment& env) {
 }
 
 sptr<Box> MathAtom::createBox(Environment& env) {
-  Environment& e = *(env.copy(env.getTeXFont()->copy()));
+  Environment e = env.copy(env.getTeXFont()->copy());
   e.getTeXFont()->setRoman(false);
   TexStyle style = e.getStyle();
   // if parent style greater than "this style",
@@ -51,11 +51,12 @@ CumulativeScriptsAtom::CumulativeScriptsAtom(
   auto* ca = dynamic_cast<CumulativeScriptsAtom*>(base.get());
   ScriptsAtom* sa = nullptr;
   if (ca != nullptr) {
+    // the base may be shared (see ParseMemo), extend copies of its scripts
     _base = ca->_base;
-    ca->_sup->add(sup);
-    ca->_sub->add(sub);
-    _sup = ca->_sup;
-    _sub = ca->_sub;
+    _sup = sptrOf<RowAtom>(ca->_sup);
+    _sub = sptrOf<RowAtom>(ca->_sub);
+    _sup->add(sup);
+    _sub->add(sub);
   } else if ((sa = dynamic_cast<ScriptsAtom*>(base.get()))) {
     _base = sa->_base;
     _sup = sptrOf<RowAtom>(sa->_sup);
@@ -86,11 +87,12 @@ sptr<Box> CumulativeScriptsAtom::createBox(Environment& env) {
 }
 
 sptr<Box> TextRenderingAtom::createBox(Environment& env) {
+  auto* tf = (DefaultTeXFont*) (env.getTeXFont());
+  const float size = tf->getSizeFactor(env.getStyle());
   if (_infos == nullptr) {
-    return sptrOf<TextRenderingBox>(
-      _str, _type, DefaultTeXFont::getSizeFactor(env.getStyle()));
+    if (env.isMeasuring()) return TextRenderingBox::measure(_str, _type, size);
+    return sptrOf<TextRenderingBox>(_str, _type, size);
   }
-  auto* tf = (DefaultTeXFont*) (env.getTeXFont().get());
   int type = tf->_isIt ? ITALIC : PLAIN;
   type = type | (tf->_isBold ? BOLD : 0);
   bool kerning = tf->_isRoman;
@@ -109,7 +111,8 @@ sptr<Box> TextRenderingAtom::createBox(Environment& env) {
       font = Font::_create(infos._serif, PLAIN, 10);
     }
   }
-  return sptrOf<TextRenderingBox>(_str, type, DefaultTeXFont::getSizeFactor(env.getStyle()), font, kerning);
+  if (env.isMeasuring()) return TextRenderingBox::measure(_str, type, size, font, kerning);
+  return sptrOf<TextRenderingBox>(_str, type, size, font, kerning);
 }
 
 SpaceAtom UnderScoreAtom::_w(UnitType::em, 0.7f, 0.f, 0.f);
@@ -232,7 +235,7 @@ sptr<Box> ColorAtom::createBox(Environment& env) {
 
 sptr<Box> RomanAtom::createBox(Environment& env) {
   if (_base == nullptr) return sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f);
-  Environment& c = *(env.copy(env.getTeXFont()->copy()));
+  Environment c = env.copy(env.getTeXFont()->copy());
   c.getTeXFont()->setRoman(true);
   return _base->createBox(c);
 }
@@ -313,24 +316,25 @@ AccentedAtom::AccentedAtom(const sptr<Atom>& base, const sptr<Formula>& acc) {
 }
 
 sptr<Box> AccentedAtom::createBox(Environment& env) {
-  TeXFont* tf = env.getTeXFont().get();
+  TeXFont* tf = env.getTeXFont();
   const TexStyle style = env.getStyle();
 
   // set base in cramped style
+  Environment cramped = env.crampStyle();
   auto b = (
     _base == nullptr
     ? sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f)
-    : _base->createBox(*(env.crampStyle()))
+    : _base->createBox(cramped)
   );
 
   float u = b->_width;
   float s = 0;
   auto* sym = dynamic_cast<CharSymbol*>(_underbase.get());
-  if (sym != nullptr) s = tf->getSkew(*(sym->getCharFont(*tf)), style);
+  if (sym != nullptr) s = tf->getSkew(sym->getCharFont(*tf), style);
 
   // retrieve best char from the accent symbol
   auto* acc = (SymbolAtom*) _accent.get();
-  Char ch = tf->getChar(acc->getName(), style);
+  Char ch = acc->getChar(*tf, style);
   while (tf->hasNextLarger(ch)) {
     Char larger = tf->getNextLarger(ch, style);
     if (larger.getWidth() <= u) ch = larger;
@@ -348,7 +352,10 @@ sptr<Box> AccentedAtom::createBox(Environment& env) {
   sptr<Box> y(nullptr);
   float italic = ch.getItalic();
   sptr<Box> cb = sptrOf<CharBox>(ch);
-  if (_acc) cb = _accent->createBox(_changeSize ? *(env.subStyle()) : env);
+  if (_acc) {
+    Environment sub = env.subStyle();
+    cb = _accent->createBox(_changeSize ? sub : env);
+  }
 
   if (abs(italic) > PREC) {
     auto hbox = sptrOf<HBox>(sptrOf<StrutBox>(-italic, 0.f, 0.f, 0.f));
@@ -398,12 +405,13 @@ sptr<Box> UnderOverAtom::createBox(Environment& env) {
   sptr<Box> o(nullptr);
   sptr<Box> u(nullptr);
   float mx = b->_width;
+  Environment sub = env.subStyle();
   if (_over != nullptr) {
-    o = _over->createBox(_overSmall ? *(env.subStyle()) : env);
+    o = _over->createBox(_overSmall ? sub : env);
     mx = max(mx, o->_width);
   }
   if (_under != nullptr) {
-    u = _under->createBox(_underSmall ? *(env.subStyle()) : env);
+    u = _under->createBox(_underSmall ? sub : env);
     mx = max(mx, u->_width);
   }
 
@@ -453,7 +461,7 @@ sptr<Box> ScriptsAtom::createBox(Environment& env) {
   sptr<Box> deltaSymbol = sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f);
   if (_sub == nullptr && _sup == nullptr) return b;
 
-  TeXFont* tf = env.getTeXFont().get();
+  TeXFont* tf = env.getTeXFont();
   const TexStyle style = env.getStyle();
 
   if (_base->_limitsType == LimitsType::limits ||
@@ -468,7 +476,7 @@ sptr<Box> ScriptsAtom::createBox(Environment& env) {
   // if no last font found (whitespace box), use default "mu font"
   if (lastFontId == TeXFont::NO_FONT) lastFontId = tf->getMuFontId();
 
-  Environment subStyle = *(env.subStyle()), supStyle = *(env.supStyle());
+  Environment subStyle = env.subStyle(), supStyle = env.supStyle();
 
   // set delta and preliminary shift-up and shift-down values
   float delta = 0, shiftUp = 0, shiftDown = 0;
@@ -478,12 +486,13 @@ sptr<Box> ScriptsAtom::createBox(Environment& env) {
   auto* cs = dynamic_cast<CharSymbol*>(_base.get());
   if (acc != nullptr) {
     // special case: accent
-    auto box = acc->_base->createBox(*(env.crampStyle()));
+    Environment cramped = env.crampStyle();
+    auto box = acc->_base->createBox(cramped);
     shiftUp = box->_height - tf->getSupDrop(supStyle.getStyle());
     shiftDown = box->_depth + tf->getSubDrop(subStyle.getStyle());
   } else if (sym != nullptr && _base->_type == AtomType::bigOperator) {
     // single big operator symbol
-    Char c = tf->getChar(sym->getName(), style);
+    Char c = sym->getChar(*tf, style);
     // display style
     if (style < TexStyle::text && tf->hasNextLarger(c)) c = tf->getNextLarger(c, style);
     auto x = sptrOf<CharBox>(c);
@@ -501,8 +510,7 @@ sptr<Box> ScriptsAtom::createBox(Environment& env) {
     shiftDown = hor->_depth + tf->getSubDrop(subStyle.getStyle());
   } else if (cs != nullptr) {
     shiftUp = shiftDown = 0;
-    sptr<CharFont> pcf = cs->getCharFont(*tf);
-    CharFont& cf = *pcf;
+    const CharFont cf = cs->getCharFont(*tf);
     if (!cs->isMarkedAsTextSymbol() || !tf->hasSpace(cf.fontId)) {
       delta = tf->getChar(cf, style).getItalic();
     }
@@ -541,7 +549,7 @@ sptr<Box> ScriptsAtom::createBox(Environment& env) {
   // adjust shift-up
   float p;
   if (style == TexStyle::display) p = tf->getSup1(style);
-  else if (env.crampStyle()->getStyle() == style) p = tf->getSup3(style);
+  else if (env.crampStyle().getStyle() == style) p = tf->getSup3(style);
   else p = tf->getSup2(style);
   shiftUp = max(max(shiftUp, p), x->_depth + abs(tf->getXHeight(style, lastFontId)) / 4);
 
@@ -589,6 +597,35 @@ sptr<Box> ScriptsAtom::createBox(Environment& env) {
   return hor;
 }
 
+size_t ScriptsAtom::computeHash() const {
+  size_t h = baseHash();
+  if (!mixChild(h, _base) || !mixChild(h, _sub) || !mixChild(h, _sup)) return 0;
+  mix(h, static_cast<size_t>(_align));
+  return h;
+}
+
+bool ScriptsAtom::isSameAs(const Atom& atom) const {
+  if (!isBaseSameAs(atom)) return false;
+  const auto& a = static_cast<const ScriptsAtom&>(atom);
+  return _align == a._align
+         && isSame(_base, a._base)
+         && isSame(_sub, a._sub)
+         && isSame(_sup, a._sup);
+}
+
+size_t TypedAtom::computeHash() const {
+  size_t h = baseHash();
+  if (!mixChild(h, _atom)) return 0;
+  mix(h, static_cast<size_t>(_leftType) << 8 | static_cast<size_t>(_rightType));
+  return h;
+}
+
+bool TypedAtom::isSameAs(const Atom& atom) const {
+  if (!isBaseSameAs(atom)) return false;
+  const auto& a = static_cast<const TypedAtom&>(atom);
+  return _leftType == a._leftType && _rightType == a._rightType && isSame(_atom, a._atom);
+}
+
 /************************************ BigOperatorAtom implementation ******************************/
 
 void BigOperatorAtom::init(const sptr<Atom>& base, const sptr<Atom>& under, const sptr<Atom>& over) {
@@ -638,22 +675,23 @@ sptr<Box> BigOperatorAtom::createSideSets(Environment& env) {
   y->add(opbox);
   if (sr != nullptr) y->add(sr->createBox(env));
 
-  TeXFont* tf = env.getTeXFont().get();
+  TeXFont* tf = env.getTeXFont();
   const TexStyle style = env.getStyle();
 
   float delta = 0;
   if (sb->_type == AtomType::bigOperator) {
     auto* sym = dynamic_cast<SymbolAtom*>(sb.get());
     if (sym != nullptr) {
-      Char c = tf->getChar(sym->getName(), style);
+      Char c = sym->getChar(*tf, style);
       delta = c.getItalic();
     }
   }
 
   // under and over
   sptr<Box> x, z;
-  if (_over != nullptr) x = _over->createBox(*(env.supStyle()));
-  if (_under != nullptr) z = _under->createBox(*(env.subStyle()));
+  Environment sup = env.supStyle(), sub = env.subStyle();
+  if (_over != nullptr) x = _over->createBox(sup);
+  if (_under != nullptr) z = _under->createBox(sub);
 
   // build vertical box
   auto* vbox = new VBox();
@@ -688,7 +726,7 @@ sptr<Box> BigOperatorAtom::createSideSets(Environment& env) {
 sptr<Box> BigOperatorAtom::createBox(Environment& env) {
   if (dynamic_cast<SideSetsAtom*>(_base.get())) return createSideSets(env);
 
-  TeXFont* tf = env.getTeXFont().get();
+  TeXFont* tf = env.getTeXFont();
   const TexStyle style = env.getStyle();
 
   RowAtom* row = nullptr;
@@ -731,7 +769,7 @@ sptr<Box> BigOperatorAtom::createBox(Environment& env) {
   auto* sym = dynamic_cast<SymbolAtom*>(_base.get());
   if (sym != nullptr && _base->_type == AtomType::bigOperator) {
     // single big operator symbol
-    Char c = tf->getChar(sym->getName(), style);
+    Char c = sym->getChar(*tf, style);
     y = _base->createBox(env);
     // include delta in width
     delta = c.getItalic();
@@ -747,8 +785,9 @@ sptr<Box> BigOperatorAtom::createBox(Environment& env) {
 
   // limits
   sptr<Box> x, z;
-  if (_over != nullptr) x = _over->createBox(*(env.supStyle()));
-  if (_under != nullptr) z = _under->createBox(*(env.subStyle()));
+  Environment sup = env.supStyle(), sub = env.subStyle();
+  if (_over != nullptr) x = _over->createBox(sup);
+  if (_under != nullptr) z = _under->createBox(sub);
 
   // make boxes equally wide
   float maxW = max(
@@ -849,7 +888,8 @@ sptr<Box> OverUnderDelimiter::createBox(Environment& env) {
 
   sptr<Box> sb(nullptr);
   if (_script != nullptr) {
-    sb = _script->createBox((_over ? *(env.supStyle()) : *(env.subStyle())));
+    Environment e = _over ? env.supStyle() : env.subStyle();
+    sb = _script->createBox(e);
   }
 
   // create centered horizontal box if smaller than maximum width
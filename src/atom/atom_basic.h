@@ -32,6 +32,10 @@ public:
     return sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f);
   }
 
+  size_t computeHash() const override { return baseHash(); }
+
+  bool isSameAs(const Atom& atom) const override { return isBaseSameAs(atom); }
+
   __decl_clone(EmptyAtom)
 };
 
@@ -376,8 +380,11 @@ public:
   }
 
   sptr<Atom> getBase() {
-    _atom->_limitsType = _limitsType;
-    return _atom;
+    if (_atom->_limitsType == _limitsType) return _atom;
+    // the base may be shared, apply the limits type to a copy
+    auto base = _atom->clone();
+    base->_limitsType = _limitsType;
+    return base;
   }
 
   sptr<Box> createBox(Environment& env) override {
@@ -392,6 +399,10 @@ public:
     return _rightType;
   }
 
+  size_t computeHash() const override;
+
+  bool isSameAs(const Atom& atom) const override;
+
   __decl_clone(TypedAtom)
 };
 
@@ -571,6 +582,10 @@ public:
 
   sptr<Box> createBox(Environment& env) override;
 
+  size_t computeHash() const override;
+
+  bool isSameAs(const Atom& atom) const override;
+
   __decl_clone(ScriptsAtom)
 };
 
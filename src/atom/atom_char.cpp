@@ -1,4 +1,5 @@
 #include "atom/atom_char.h"
+#include "core/command_table.h"
 #include "core/core.h"
 #include "res/parser/formula_parser.h"
 
@@ -12,12 +13,32 @@ using namespace std;
 sptr<Box> FixedCharAtom::createBox(Environment& env) {
   const auto& i = env.getTeXFont();
   TeXFont& tf = *i;
-  Char c = tf.getChar(*_cf, env.getStyle());
+  Char c = tf.getChar(_cf, env.getStyle());
   return sptrOf<CharBox>(c);
 }
 
+size_t FixedCharAtom::computeHash() const {
+  size_t h = baseHash();
+  mix(h, static_cast<size_t>(_cf.chr));
+  mix(h, static_cast<size_t>(_cf.fontId) << 16 | static_cast<size_t>(_cf.boldFontId));
+  mix(h, isMarkedAsTextSymbol() ? 1 : 0);
+  return h;
+}
+
+bool FixedCharAtom::isSameAs(const Atom& atom) const {
+  if (!isBaseSameAs(atom)) return false;
+  const auto& a = static_cast<const FixedCharAtom&>(atom);
+  return _cf.chr == a._cf.chr
+         && _cf.fontId == a._cf.fontId
+         && _cf.boldFontId == a._cf.boldFontId
+         && isMarkedAsTextSymbol() == a.isMarkedAsTextSymbol();
+}
+
 SymbolAtom::SymbolAtom(const string& name, AtomType type, bool del) noexcept: _unicode(0) {
   _name = name;
+  // the builtin symbols are constructed before the symbol table is built, they get
+  // their ids from resolveSymbolIds
+  _id = DefaultTeXFont::symbolId(name);
   _type = type;
   if (type == AtomType::bigOperator) _limitsType = LimitsType::normal;
 }
@@ -26,17 +47,17 @@ sptr<Box> SymbolAtom::createBox(Environment& env) {
   const auto& i = env.getTeXFont();
   TeXFont& tf = *i;
   TexStyle style = env.getStyle();
-  Char c = tf.getChar(_name, style);
+  Char c = getChar(tf, style);
   sptr<Box> cb = sptrOf<CharBox>(c);
   if (env.getSmallCap() && _unicode != 0 && islower(_unicode)) {
     // find if exists in mapping
     auto it = Formula::_symbolTextMappings.find(toupper(_unicode));
-    if (it != Formula::_symbolFormulaMappings.end()) {
-      const string& name = it->second;
-      try {
-        auto cx = sptrOf<CharBox>(tf.getChar(name, style));
+    if (it != Formula::_symbolTextMappings.end()) {
+      const int id = DefaultTeXFont::symbolId(it->second);
+      if (id >= 0) {
+        auto cx = sptrOf<CharBox>(tf.getChar(id, style));
         cb = sptrOf<ScaleBox>(cx, 0.8f, 0.8f);
-      } catch (ex_symbol_mapping_not_found& e) {}
+      }
     }
   }
   if (_type == AtomType::bigOperator) {
@@ -51,16 +72,43 @@ sptr<Box> SymbolAtom::createBox(Environment& env) {
   return cb;
 }
 
+size_t SymbolAtom::computeHash() const {
+  size_t h = baseHash();
+  mix(h, std::hash<std::string>()(_name));
+  mix(h, static_cast<size_t>(_unicode));
+  mix(h, isMarkedAsTextSymbol() ? 1 : 0);
+  return h;
+}
+
+bool SymbolAtom::isSameAs(const Atom& atom) const {
+  if (!isBaseSameAs(atom)) return false;
+  const auto& a = static_cast<const SymbolAtom&>(atom);
+  return _name == a._name
+         && _unicode == a._unicode
+         && isMarkedAsTextSymbol() == a.isMarkedAsTextSymbol();
+}
+
 //sptr<CharFont> SymbolAtom::getCharFont(TeXFont& tf) {
 //  return tf.getChar(_name, TexStyle::display).getCharFont();
 //}
 
+void SymbolAtom::resolveSymbolIds() {
+  for (auto& i : _symbols) i.second->_id = DefaultTeXFont::symbolId(i.second->_name);
+}
+
+/** The symbols are resolved through the CommandTable once it is built, see CommandTable */
+static void checkNotBuilt(const string& what) {
+  if (CommandTable::isBuilt()) throw ex_invalid_state("Cannot add " + what + " after LaTeX::init!");
+}
+
 void SymbolAtom::addSymbolAtom(const string& file) {
+  checkNotBuilt("the symbols of " + file);
   TeXSymbolParser parser(file);
   parser.readSymbols(_symbols);
 }
 
 void SymbolAtom::addSymbolAtom(const sptr<SymbolAtom>& sym) {
+  checkNotBuilt("the symbol " + sym->_name);
   _symbols[sym->_name] = sym;
 }
 
@@ -70,13 +118,18 @@ sptr<SymbolAtom> SymbolAtom::get(const string& name) {
   return it->second;
 }
 
-Char CharAtom::getChar(TeXFont& tf, TexStyle style, bool smallCap) {
+sptr<SymbolAtom> SymbolAtom::find(const string& name) {
+  auto it = _symbols.find(name);
+  return it == _symbols.end() ? nullptr : it->second;
+}
+
+Char CharAtom::getChar(TeXFont& tf, TexStyle style, bool smallCap, const string& textStyle) {
   wchar_t chr = _c;
   if (smallCap) {
     if (islower(_c)) chr = toupper(_c);
   }
-  if (_textStyle.empty()) return tf.getDefaultChar(chr, style);
-  return tf.getChar(chr, _textStyle, style);
+  if (textStyle.empty()) return tf.getDefaultChar(chr, style);
+  return tf.getChar(chr, textStyle, style);
 }
 
 //sptr<CharFont> CharAtom::getCharFont(TeXFont& tf) {
@@ -85,12 +138,10 @@ Char CharAtom::getChar(TeXFont& tf, TexStyle style, bool smallCap) {
 //}
 
 sptr<Box> CharAtom::createBox(Environment& env) {
-  if (_textStyle.empty()) {
-    const string& ts = env.getTextStyle();
-    if (!ts.empty()) _textStyle = ts;
-  }
+  // do not change this atom, it may be shared by formulas rendered concurrently
+  const string& textStyle = _textStyle.empty() ? env.getTextStyle() : _textStyle;
   bool smallCap = env.getSmallCap();
-  Char ch = getChar(*env.getTeXFont(), env.getStyle(), smallCap);
+  Char ch = getChar(*env.getTeXFont(), env.getStyle(), smallCap, textStyle);
   sptr<Box> box = sptrOf<CharBox>(ch);
   if (smallCap && islower(_c)) {
     // we have a small capital
@@ -99,6 +150,23 @@ sptr<Box> CharAtom::createBox(Environment& env) {
   return box;
 }
 
+size_t CharAtom::computeHash() const {
+  size_t h = baseHash();
+  mix(h, static_cast<size_t>(_c));
+  mix(h, std::hash<std::string>()(_textStyle));
+  mix(h, (_mathMode ? 1 : 0) | (isMarkedAsTextSymbol() ? 2 : 0));
+  return h;
+}
+
+bool CharAtom::isSameAs(const Atom& atom) const {
+  if (!isBaseSameAs(atom)) return false;
+  const auto& a = static_cast<const CharAtom&>(atom);
+  return _c == a._c
+         && _mathMode == a._mathMode
+         && _textStyle == a._textStyle
+         && isMarkedAsTextSymbol() == a.isMarkedAsTextSymbol();
+}
+
 sptr<Box> BreakMarkAtom::createBox(Environment& env) {
   return sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f);
 }
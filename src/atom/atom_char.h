@@ -56,28 +56,32 @@ public:
    * @param tf the TeXFont containing all font related information
    * @return a CharFont
    */
-  virtual sptr<CharFont> getCharFont(TeXFont& tf) = 0;
+  virtual CharFont getCharFont(TeXFont& tf) = 0;
 };
 
 /** An atom representing a fixed character (not depending on a text style). */
 class FixedCharAtom : public CharSymbol {
 private:
-  const sptr<CharFont> _cf;
+  const CharFont _cf;
 
 public:
   FixedCharAtom() = delete;
 
-  explicit FixedCharAtom(const sptr<CharFont>& c) : _cf(c) {}
+  explicit FixedCharAtom(const CharFont& c) : _cf(c) {}
 
   // FIXME
   // workaround for the MSVS's LNK2019 error
   // it should be implemented in the atom_char.cpp file
-  sptr<CharFont> getCharFont(TeXFont& tf) override {
+  CharFont getCharFont(TeXFont& tf) override {
     return _cf;
   }
 
   sptr<Box> createBox(Environment& env) override;
 
+  size_t computeHash() const override;
+
+  bool isSameAs(const Atom& atom) const override;
+
   __decl_clone(FixedCharAtom)
 };
 
@@ -86,6 +90,8 @@ private:
 
   // symbol name
   std::string _name;
+  // the symbol id, resolved from the name once the symbol table is built, -1 if unresolved
+  int _id;
   wchar_t _unicode;
 
 public:
@@ -117,15 +123,32 @@ public:
     return _name;
   }
 
+  /** Get the Char-object of this symbol in the given style */
+  inline Char getChar(TeXFont& tf, TexStyle style) const {
+    return _id < 0 ? tf.getChar(_name, style) : tf.getChar(_id, style);
+  }
+
   sptr<Box> createBox(Environment& env) override;
 
   // FIXME
   // workaround for the MSVS's LNK2019 error
   // it should be implemented in the atom_char.cpp file
-  sptr<CharFont> getCharFont(TeXFont& tf) override {
-    return tf.getChar(_name, TexStyle::display).getCharFont();
+  CharFont getCharFont(TeXFont& tf) override {
+    return getChar(tf, TexStyle::display).getCharFont();
   }
 
+  /**
+   * Resolve the ids of all the defined symbols, called once the symbol table of the
+   * DefaultTeXFont is built.
+   */
+  static void resolveSymbolIds();
+
+  /**
+   * Add the symbols of the given file, or the given symbol. Only possible before LaTeX::init,
+   * the symbols are resolved through the CommandTable after that.
+   *
+   * @throw ex_invalid_state if called after LaTeX::init
+   */
   static void addSymbolAtom(const std::string& file);
 
   static void addSymbolAtom(const sptr<SymbolAtom>& sym);
@@ -141,6 +164,16 @@ public:
    */
   static sptr<SymbolAtom> get(const std::string& name);
 
+  /**
+   * Looks up the name in the table, the same as SymbolAtom::get but return nullptr if no
+   * symbol with the given name was found.
+   */
+  static sptr<SymbolAtom> find(const std::string& name);
+
+  size_t computeHash() const override;
+
+  bool isSameAs(const Atom& atom) const override;
+
   __decl_clone(SymbolAtom)
 };
 
@@ -160,7 +193,7 @@ private:
    * Get the Char-object representing this character ("c") in the right text
    * style
    */
-  Char getChar(TeXFont& tf, TexStyle style, bool smallCap);
+  Char getChar(TeXFont& tf, TexStyle style, bool smallCap, const std::string& textStyle);
 
 public:
   CharAtom() = delete;
@@ -191,10 +224,14 @@ public:
   // FIXME
   // workaround for the MSVS's LNK2019 error
   // it should be implemented in the atom_char.cpp file
-  sptr<CharFont> getCharFont(TeXFont& tf) override {
-    return getChar(tf, TexStyle::display, false).getCharFont();
+  CharFont getCharFont(TeXFont& tf) override {
+    return getChar(tf, TexStyle::display, false, _textStyle).getCharFont();
   }
 
+  size_t computeHash() const override;
+
+  bool isSameAs(const Atom& atom) const override;
+
   __decl_clone(CharAtom)
 };
 
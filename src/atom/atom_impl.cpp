@@ -19,6 +19,14 @@ void FencedAtom::init(const sptr<Atom>& b, const sptr<SymbolAtom>& l, const sptr
     _base = sptrOf<RowAtom>();
   else
     _base = b;
+  // can not break
+  auto* ra = dynamic_cast<RowAtom*>(_base.get());
+  if (ra != nullptr && ra->isFrozen()) {
+    // a shared row, change a copy
+    _base = _base->clone();
+    ra = static_cast<RowAtom*>(_base.get());
+  }
+  if (ra != nullptr) ra->setBreakable(false);
   if (l == nullptr || l->getName() != "normaldot") _left = l;
   if (r == nullptr || r->getName() != "normaldot") _right = r;
 }
@@ -29,10 +37,15 @@ void FencedAtom::center(Box& b, float axis) {
 }
 
 sptr<Box> FencedAtom::createBox(Environment& env) {
+  if (!_middle.empty() && (env.getLayoutCache() != nullptr || env.getBoxMemo() != nullptr)) {
+    // the boxes of the \middle delimiters are set between the two layouts of the content, so
+    // the content is laid out without the boxes kept by the caches (see LayoutCache and BoxMemo)
+    Environment e(env);
+    e.setLayoutCache(nullptr);
+    e.setBoxMemo(nullptr);
+    return createBox(e);
+  }
   TeXFont& tf = *(env.getTeXFont());
-  // can not break
-  auto* ra = dynamic_cast<RowAtom*>(_base.get());
-  if (ra != nullptr) ra->setBreakable(false);
   auto content = _base->createBox(env);
   float shortfall = DELIMITER_SHORTFALL * SpaceAtom::getFactor(UnitType::point, env);
   float axis = tf.getAxisHeight(env.getStyle());
@@ -102,19 +115,24 @@ sptr<Box> FractionAtom::createBox(Environment& env) {
   TexStyle style = env.getStyle();
   // set thickness to default if default value should be use
   float drt = tf.getDefaultRuleThickness(style);
-  if (_nodefault) _thickness *= SpaceAtom::getFactor(_unit, env);
-  else _thickness = _deffactorset ? _deffactor * drt : drt;
+  // the atom may be laid out again, keep the given thickness
+  const float thickness = (
+    _nodefault
+    ? _thickness * SpaceAtom::getFactor(_unit, env)
+    : (_deffactorset ? _deffactor * drt : drt)
+  );
 
   // create equal width boxes in appropriate styles
+  Environment numStyle = env.numStyle(), dnomStyle = env.dnomStyle();
   auto num = (
     _numerator == nullptr
     ? sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f)
-    : _numerator->createBox(*(env.numStyle()))
+    : _numerator->createBox(numStyle)
   );
   auto denom = (
     _denominator == nullptr
     ? sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f)
-    : _denominator->createBox(*(env.dnomStyle()))
+    : _denominator->createBox(dnomStyle)
   );
 
   if (num->_width < denom->_width) num = sptrOf<HBox>(num, denom->_width, _numAlign);
@@ -127,7 +145,7 @@ sptr<Box> FractionAtom::createBox(Environment& env) {
     shiftdown = tf.getDenom1(style);
   } else {
     shiftdown = tf.getDenom2(style);
-    if (_thickness > 0) shiftup = tf.getNum2(style);
+    if (thickness > 0) shiftup = tf.getNum2(style);
     else shiftup = tf.getNum3(style);
   }
 
@@ -138,14 +156,14 @@ sptr<Box> FractionAtom::createBox(Environment& env) {
   // calculate clearance clr, adjust shift amounts and create vertical box
   float clr, delta, axis = tf.getAxisHeight(style);
 
-  if (_thickness > 0) {
+  if (thickness > 0) {
     // with fraction rule
     // clearance clr
-    if (style < TexStyle::text) clr = 3 * _thickness;
-    else clr = _thickness;
+    if (style < TexStyle::text) clr = 3 * thickness;
+    else clr = thickness;
 
     // adjust shift amount
-    delta = _thickness / 2.f;
+    delta = thickness / 2.f;
     float kern1 = shiftup - num->_depth - (axis + delta);
     float kern2 = axis - delta - (denom->_height - shiftdown);
     float delta1 = clr - kern1;
@@ -161,7 +179,7 @@ sptr<Box> FractionAtom::createBox(Environment& env) {
 
     // fill vertical box
     vb->add(sptrOf<StrutBox>(0.f, kern1, 0.f, 0.f));
-    vb->add(sptrOf<RuleBox>(_thickness, num->_width, 0.f));
+    vb->add(sptrOf<RuleBox>(thickness, num->_width, 0.f));
     vb->add(sptrOf<StrutBox>(0.f, kern2, 0.f, 0.f));
   } else {
     // without fraction rule
@@ -194,6 +212,45 @@ sptr<Box> FractionAtom::createBox(Environment& env) {
   return sptrOf<HBox>(sptr<Box>(vb), vb->_width + 2 * f, Alignment::center);
 }
 
+size_t FractionAtom::computeHash() const {
+  size_t h = baseHash();
+  if (!mixChild(h, _numerator) || !mixChild(h, _denominator)) return 0;
+  mix(h, std::hash<float>()(_thickness));
+  mix(h, std::hash<float>()(_deffactor));
+  mix(h, static_cast<size_t>(_numAlign) << 8 | static_cast<size_t>(_denomAlign));
+  mix(h, static_cast<size_t>(_unit));
+  mix(h, (_nodefault ? 1 : 0) | (_deffactorset ? 2 : 0) | (_useKern ? 4 : 0));
+  return h;
+}
+
+bool FractionAtom::isSameAs(const Atom& atom) const {
+  if (!isBaseSameAs(atom)) return false;
+  const auto& a = static_cast<const FractionAtom&>(atom);
+  return _nodefault == a._nodefault
+         && _unit == a._unit
+         && _numAlign == a._numAlign
+         && _denomAlign == a._denomAlign
+         && _thickness == a._thickness
+         && _deffactor == a._deffactor
+         && _deffactorset == a._deffactorset
+         && _useKern == a._useKern
+         && isSame(_numerator, a._numerator)
+         && isSame(_denominator, a._denominator);
+}
+
+size_t StyleAtom::computeHash() const {
+  size_t h = baseHash();
+  if (!mixChild(h, _at)) return 0;
+  mix(h, static_cast<size_t>(_style));
+  return h;
+}
+
+bool StyleAtom::isSameAs(const Atom& atom) const {
+  if (!isBaseSameAs(atom)) return false;
+  const auto& a = static_cast<const StyleAtom&>(atom);
+  return _style == a._style && isSame(_at, a._at);
+}
+
 const string NthRoot::_sqrtSymbol = "sqrt";
 const float NthRoot::FACTOR = 0.55f;
 
@@ -208,7 +265,7 @@ sptr<Box> NthRoot::createBox(Environment& env) {
   clr = drt + abs(clr) / 4.f;
 
   // cramped style for the formula under the root sign
-  Environment& cramped = *(env.crampStyle());
+  Environment cramped = env.crampStyle();
   auto bs = _base->createBox(cramped);
   auto b = sptrOf<HBox>(bs);
   b->add(sptr<Box>(SpaceAtom(UnitType::mu, 1.f, 0.f, 0.f).createBox(cramped)));
@@ -232,7 +289,8 @@ sptr<Box> NthRoot::createBox(Environment& env) {
   if (_root == nullptr) return squareRoot;
 
   // nth root
-  auto r = _root->createBox(*(env.rootStyle()));
+  Environment rootStyle = env.rootStyle();
+  auto r = _root->createBox(rootStyle);
   // shift root up
   float bottomShift = FACTOR * (squareRoot->_height + squareRoot->_depth);
   r->_shift = squareRoot->_depth - r->_depth - bottomShift;
@@ -331,19 +389,20 @@ sptr<Box> UnderOverArrowAtom::createBox(Environment& env) {
 }
 
 sptr<Box> XArrowAtom::createBox(Environment& env) {
+  Environment sup = env.supStyle(), sub = env.subStyle();
   auto O = (
     _over != nullptr
-    ? _over->createBox(*(env.supStyle()))
+    ? _over->createBox(sup)
     : sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f)
   );
   auto U = (
     _under != nullptr
-    ? _under->createBox(*(env.subStyle()))
+    ? _under->createBox(sub)
     : sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f)
   );
 
-  auto oside = SpaceAtom(UnitType::em, 1.5f, 0, 0).createBox(*(env.supStyle()));
-  auto uside = SpaceAtom(UnitType::em, 1.5f, 0, 0).createBox(*(env.subStyle()));
+  auto oside = SpaceAtom(UnitType::em, 1.5f, 0, 0).createBox(sup);
+  auto uside = SpaceAtom(UnitType::em, 1.5f, 0, 0).createBox(sub);
   auto sep = SpaceAtom(UnitType::mu, 0, 2.f, 0).createBox(env);
   float width = max(O->_width + 2 * oside->_width, U->_width + 2 * uside->_width);
   auto arrow = XLeftRightArrowFactory::create(_left, env, width);
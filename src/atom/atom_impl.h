@@ -52,7 +52,7 @@ public:
 
   sptr<Box> createBox(Environment& env) override {
     if (_base != nullptr) {
-      Environment& e = *(env.copy(env.getTeXFont()->copy()));
+      Environment e = env.copy(env.getTeXFont()->copy());
       e.getTeXFont()->setBold(true);
       return _base->createBox(e);
     }
@@ -105,7 +105,7 @@ public:
 class DdtosAtom : public Atom {
 public:
   sptr<Box> createBox(Environment& env) override {
-    auto ldots = Formula::get(L"ldots")->_root->createBox(env);
+    auto ldots = Formula::get(L"ldots")->createBox(env);
     float w = ldots->_width;
     auto dot = SymbolAtom::get("ldotp")->createBox(env);
     auto* hb1 = new HBox(dot, w, Alignment::left);
@@ -199,18 +199,26 @@ public:
  * An atom representing a oval-boxed base atom
  */
 class OvalAtom : public FBoxAtom {
+private:
+  float _cornerMultiplier, _cornerDiameter;
+
 public:
+  // the default corner size, a document changes its own with \cornersize
   static float _multiplier;
   static float _diameter;
 
   OvalAtom() = delete;
 
-  explicit OvalAtom(const sptr<Atom>& base) : FBoxAtom(base) {}
+  explicit OvalAtom(const sptr<Atom>& base)
+    : FBoxAtom(base), _cornerMultiplier(_multiplier), _cornerDiameter(_diameter) {}
+
+  OvalAtom(const sptr<Atom>& base, float multiplier, float diameter)
+    : FBoxAtom(base), _cornerMultiplier(multiplier), _cornerDiameter(diameter) {}
 
   sptr<Box> createBox(Environment& env) override {
     auto x = FBoxAtom::createBox(env);
     auto box = std::dynamic_pointer_cast<FramedBox>(x);
-    return sptrOf<OvalBox>(box, _multiplier, _diameter);
+    return sptrOf<OvalBox>(box, _cornerMultiplier, _cornerDiameter);
   }
 
   __decl_clone(OvalAtom)
@@ -345,6 +353,10 @@ public:
 
   sptr<Box> createBox(Environment& env) override;
 
+  size_t computeHash() const override;
+
+  bool isSameAs(const Atom& atom) const override;
+
   __decl_clone(FractionAtom)
 };
 
@@ -352,7 +364,7 @@ public:
 class IddotsAtom : public Atom {
 public:
   sptr<Box> createBox(Environment& env) override {
-    auto ldots = Formula::get(L"ldots")->_root->createBox(env);
+    auto ldots = Formula::get(L"ldots")->createBox(env);
     float w = ldots->_width;
     auto dot = SymbolAtom::get("ldotp")->createBox(env);
     sptr<Box> hb1(new HBox(dot, w, Alignment::right));
@@ -412,7 +424,7 @@ public:
   sptr<Box> createBox(Environment& env) override {
     sptr<Box> box;
     if (_base != nullptr) {
-      Environment& e = *(env.copy(env.getTeXFont()->copy()));
+      Environment e = env.copy(env.getTeXFont()->copy());
       e.getTeXFont()->setIt(true);
       box = _base->createBox(e);
     } else {
@@ -498,7 +510,7 @@ public:
     : ScaleAtom(base, factor, factor), _factor(factor) {}
 
   sptr<Box> createBox(Environment& env) override {
-    Environment& e = *(env.copy());
+    Environment e = env.copy();
     float f = e.getScaleFactor();
     e.setScaleFactor(_factor);
     auto box = sptrOf<ScaleBox>(_base->createBox(e), _factor / f);
@@ -564,10 +576,11 @@ public:
     float drt = env.getTeXFont()->getDefaultRuleThickness(env.getStyle());
     // cramp the style of the formula to be over-lined and create
     // vertical box
+    Environment cramped = env.crampStyle();
     auto b = (
       _base == nullptr
       ? sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f)
-      : _base->createBox(*(env.crampStyle()))
+      : _base->createBox(cramped)
     );
     auto* ob = new OverBar(b, 3 * drt, drt);
 
@@ -845,6 +858,10 @@ public:
     return box;
   }
 
+  size_t computeHash() const override;
+
+  bool isSameAs(const Atom& atom) const override;
+
   __decl_clone(StyleAtom)
 };
 
@@ -890,19 +907,21 @@ public:
 /** An atom representing a modification of style in a formula */
 class TextStyleAtom : public Atom {
 private:
-  std::string _style;
+  // interned, see Environment#internTextStyle
+  const std::string* _style;
   sptr<Atom> _at;
 
 public:
   TextStyleAtom() = delete;
 
-  TextStyleAtom(const sptr<Atom>& a, std::string style) : _style(std::move(style)), _at(a) {}
+  TextStyleAtom(const sptr<Atom>& a, const std::string& style)
+    : _style(Environment::internTextStyle(style)), _at(a) {}
 
   sptr<Box> createBox(Environment& env) override {
-    std::string prev = env.getTextStyle();
-    env.setTextStyle(_style);
+    const std::string* prev = env.getTextStyleId();
+    env.setTextStyleId(_style);
     auto box = _at->createBox(env);
-    env.setTextStyle(prev);
+    env.setTextStyleId(prev);
     return box;
   }
 
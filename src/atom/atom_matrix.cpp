@@ -5,7 +5,7 @@
 using namespace std;
 using namespace tex;
 
-color MatrixAtom::LINE_COLOR = transparent;
+const color MatrixAtom::LINE_COLOR = transparent;
 
 map<wstring, wstring> MatrixAtom::_colspeReplacement;
 
@@ -22,7 +22,11 @@ void MatrixAtom::defineColumnSpecifier(const wstring& rep, const wstring& spe) {
   _colspeReplacement[rep] = spe;
 }
 
-void MatrixAtom::parsePositions(wstring opt, vector<Alignment>& lpos) {
+void MatrixAtom::parsePositions(
+  wstring opt,
+  vector<Alignment>& lpos,
+  const map<wstring, wstring>* columnTypes
+) {
   int len = opt.length();
   int pos = 0;
   wchar_t ch;
@@ -53,7 +57,7 @@ void MatrixAtom::parsePositions(wstring opt, vector<Alignment>& lpos) {
             nb++;
           }
         }
-        _vlines[lpos.size()] = sptrOf<VlineAtom>(nb);
+        _vlines[lpos.size()] = sptrOf<VlineAtom>(nb, _lineColor);
       }
         break;
       case '@': {
@@ -103,10 +107,19 @@ void MatrixAtom::parsePositions(wstring opt, vector<Alignment>& lpos) {
         int spos = len + 1;
         bool hasrep = false;
         while (--spos > pos) {
-          auto it = _colspeReplacement.find(opt.substr(pos, spos - pos));
-          if (it != _colspeReplacement.end()) {
+          const wstring name = opt.substr(pos, spos - pos);
+          const wstring* rep = nullptr;
+          if (columnTypes != nullptr) {
+            auto it = columnTypes->find(name);
+            if (it != columnTypes->end()) rep = &it->second;
+          }
+          if (rep == nullptr) {
+            auto it = _colspeReplacement.find(name);
+            if (it != _colspeReplacement.end()) rep = &it->second;
+          }
+          if (rep != nullptr) {
             hasrep = true;
-            opt.insert(spos, it->second);
+            opt.insert(spos, *rep);
             len = opt.length();
             pos = spos - 1;
             break;
@@ -128,10 +141,16 @@ float* MatrixAtom::getColumnSep(Environment& env, float width) {
   const int cols = _matrix->cols();
   auto* arr = new float[cols + 1]();
   sptr<Box> Align, AlignSep, Hsep;
-  float h, w = env.getTextWidth();
+  float h, w = POS_INF;
   int i = 0;
 
-  if (_matType == MatrixType::aligned || _matType == MatrixType::alignedAt) w = POS_INF;
+  // only the align environments are spread over the text width, the layout of the others
+  // does not depend on it, see Environment#trackTextWidth
+  if (_matType == MatrixType::align
+      || _matType == MatrixType::alignAt
+      || _matType == MatrixType::flAlign) {
+    w = env.getTextWidth();
+  }
 
   switch (_matType) {
     case MatrixType::array: {
@@ -243,10 +262,12 @@ void MatrixAtom::recalculateLine(
 ) {
   const size_t s = multiRows.size();
   for (size_t i = 0; i < s; i++) {
+    // the atom may be laid out again, its position is not changed
     auto* m = (MultiRowAtom*) multiRows[i].get();
     const int r = m->_i;
     const int c = m->_j;
     int n = m->_n;
+    int top = r;
     int skipped = 0;
     float h = 0;
     if (n < 0) {
@@ -262,7 +283,7 @@ void MatrixAtom::recalculateLine(
           h += height[j] + depth[j] + vspace;
         }
       }
-      m->_i = ++j;
+      top = ++j;
       auto tmp = boxarr[r][c];
       boxarr[r][c] = boxarr[j][c];
       boxarr[j][c] = tmp;
@@ -279,24 +300,24 @@ void MatrixAtom::recalculateLine(
         }
       }
     }
-    m->_n = abs(n);
-    auto b = boxarr[m->_i][m->_j];
+    n = abs(n);
+    auto b = boxarr[top][c];
     const float bh = b->_height + b->_depth + vspace;
     if (h > bh) {
       b->_height = (h - bh + vspace) / 2.f;
     } else if (h < bh) {
       const float ex = (bh - h) / skipped / 2.f;
-      const int mr = m->_i + m->_n;
-      for (int j = m->_i; j < mr; j++) {
+      const int mr = top + n;
+      for (int j = top; j < mr; j++) {
         if (boxarr[j][0]->_type != AtomType::hline) {
           height[j] += ex;
           depth[j] += ex;
         }
       }
-      b->_height = height[m->_i];
+      b->_height = height[top];
       b->_depth = bh - b->_height - vspace;
     }
-    boxarr[m->_i][m->_j]->_type = AtomType::none;
+    boxarr[top][c]->_type = AtomType::none;
   }
 }
 
@@ -319,8 +340,10 @@ sptr<Box> MatrixAtom::generateMulticolumn(
   w += colWidth[k];
 
   if (mca->isNeedWidth() && mca->colWidth() <= PREC) {
-    mca->setColWidth(w);
-    return mca->createBox(env);
+    // the atom may be laid out again, set the width of a copy
+    auto copy = mca->clone();
+    static_cast<MulticolumnAtom*>(copy.get())->setColWidth(w);
+    return copy->createBox(env);
   }
 
   if (b->_width >= w) return b;
@@ -328,25 +351,40 @@ sptr<Box> MatrixAtom::generateMulticolumn(
   return sptrOf<HBox>(b, w, mca->align());
 }
 
-MatrixAtom::MatrixAtom(bool isPartial, const sptr<ArrayFormula>& arr, const wstring& options, bool spaceAround) {
+MatrixAtom::MatrixAtom(
+  bool isPartial,
+  const sptr<ArrayFormula>& arr,
+  const wstring& options,
+  bool spaceAround,
+  const map<wstring, wstring>* columnTypes,
+  color lineColor
+) {
   _matrix = arr;
   _matType = MatrixType::array;
+  _lineColor = lineColor;
   _isPartial = isPartial;
   _spaceAround = spaceAround;
-  parsePositions(wstring(options), _position);
+  parsePositions(wstring(options), _position, columnTypes);
 }
 
 MatrixAtom::MatrixAtom(bool isPartial, const sptr<ArrayFormula>& arr, const wstring& options) {
   _matrix = arr;
   _matType = MatrixType::array;
+  _lineColor = LINE_COLOR;
   _isPartial = isPartial;
   _spaceAround = false;
   parsePositions(wstring(options), _position);
 }
 
-MatrixAtom::MatrixAtom(bool isPartial, const sptr<ArrayFormula>& arr, MatrixType type) {
+MatrixAtom::MatrixAtom(
+  bool isPartial,
+  const sptr<ArrayFormula>& arr,
+  MatrixType type,
+  color lineColor
+) {
   _matrix = arr;
   _matType = type;
+  _lineColor = lineColor;
   _isPartial = isPartial;
   _spaceAround = false;
 
@@ -412,10 +450,10 @@ sptr<Box> MatrixAtom::createBox(Environment& e) {
   float drt = env.getTeXFont()->getDefaultRuleThickness(env.getStyle());
 
   if (_matType == MatrixType::smallMatrix) {
-    env = *(e.copy());
+    env = e.copy();
     env.setStyle(TexStyle::script);
   } /* else if (_matType == MatrixType::matrix) {
-    env = *(e.copy());
+    env = e.copy();
     env.setStyle(STYLE_TEXT);
   }*/
 
@@ -556,8 +594,10 @@ sptr<Box> MatrixAtom::createBox(Environment& e) {
           break;
 
         case AtomType::hline: {
-          auto* at = (HlineAtom*) _matrix->_array[i][j].get();
-          at->setColor(LINE_COLOR);
+          // the atom may be laid out again, its width is measured with the rows
+          auto hline = _matrix->_array[i][j]->clone();
+          auto* at = static_cast<HlineAtom*>(hline.get());
+          at->setColor(_lineColor);
           at->setWidth(matW);
           if (i >= 1 && dynamic_cast<HlineAtom*>(_matrix->_array[i - 1][j].get()) != nullptr) {
             hb->add(sptrOf<StrutBox>(0.f, 2 * drt, 0.f, 0.f));
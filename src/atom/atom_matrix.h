@@ -78,10 +78,16 @@ private:
   std::map<int, sptr<Atom>> _columnSpecifiers;
 
   MatrixType _matType;
+  // the color to draw the rules of this matrix
+  color _lineColor;
   bool _isPartial;
   bool _spaceAround;
 
-  void parsePositions(std::wstring opt, std::vector<Alignment>& lpos);
+  void parsePositions(
+    std::wstring opt,
+    std::vector<Alignment>& lpos,
+    const std::map<std::wstring, std::wstring>* columnTypes = nullptr
+  );
 
   sptr<Box> generateMulticolumn(
     Environment& env,
@@ -107,8 +113,8 @@ private:
   void applyCell(WrapperBox& box, int i, int j);
 
 public:
-  // The color to draw the rule of the matrix
-  static color LINE_COLOR;
+  // The default color to draw the rules of the matrix, see MacroScope#_ruleColor
+  static const color LINE_COLOR;
 
   static SpaceAtom _hsep, _semihsep, _vsep_in, _vsep_ext_top, _vsep_ext_bot;
 
@@ -116,11 +122,20 @@ public:
 
   MatrixAtom() = delete;
 
+  /**
+   * Create a matrix with the given column specifiers
+   *
+   * @param columnTypes the column types defined by the document, come before
+   * the predefined ones if not null
+   * @param lineColor the color to draw the rules of the matrix
+   */
   MatrixAtom(
     bool isPartial,
     const sptr<ArrayFormula>& arr,
     const std::wstring& options,
-    bool spaceAround
+    bool spaceAround,
+    const std::map<std::wstring, std::wstring>* columnTypes = nullptr,
+    color lineColor = LINE_COLOR
   );
 
   MatrixAtom(
@@ -132,7 +147,8 @@ public:
   MatrixAtom(
     bool isPartial,
     const sptr<ArrayFormula>& arr,
-    MatrixType type
+    MatrixType type,
+    color lineColor = LINE_COLOR
   );
 
   sptr<Box> createBox(Environment& env) override;
@@ -147,13 +163,14 @@ class VlineAtom : public Atom {
 private:
   // Number of lines to draw
   int _n;
+  color _color;
 
 public:
   float _height, _shift;
 
   VlineAtom() = delete;
 
-  explicit VlineAtom(int n) : _n(n), _height(0), _shift(0) {}
+  VlineAtom(int n, color c) : _n(n), _color(c), _height(0), _shift(0) {}
 
   inline float getWidth(Environment& env) const {
     if (_n != 0) {
@@ -167,7 +184,7 @@ public:
     if (_n == 0) return sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f);
 
     float drt = env.getTeXFont()->getDefaultRuleThickness(env.getStyle());
-    auto b = sptrOf<RuleBox>(_height, drt, _shift, MatrixAtom::LINE_COLOR, true);
+    auto b = sptrOf<RuleBox>(_height, drt, _shift, _color, true);
     auto sep = sptrOf<StrutBox>(2 * drt, 0.f, 0.f, 0.f);
     auto* hb = new HBox();
     for (int i = 0; i < _n - 1; i++) {
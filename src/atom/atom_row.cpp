@@ -3,6 +3,7 @@
 #include <memory>
 #include "atom/atom_basic.h"
 #include "core/core.h"
+#include "core/memo.h"
 
 using namespace std;
 using namespace tex;
@@ -17,7 +18,7 @@ inline bool Dummy::isCharInMathMode() const {
   return at != nullptr && at->isMathMode();
 }
 
-inline sptr<CharFont> Dummy::getCharFont(TeXFont& tf) const {
+inline CharFont Dummy::getCharFont(TeXFont& tf) const {
   return ((CharSymbol*) _atom.get())->getCharFont(tf);
 }
 
@@ -28,10 +29,9 @@ void Dummy::changeAtom(const sptr<FixedCharAtom>& atom) {
 }
 
 sptr<Box> Dummy::createBox(Environment& env) {
-  if (_textSymbol) ((CharSymbol*) _atom.get())->markAsTextSymbol();
-  auto box = _atom->createBox(env);
-  if (_textSymbol) ((CharSymbol*) _atom.get())->removeMark();
-  return box;
+  // the text-symbol mark is not written through to the atom, symbols are shared
+  // between formulas and may be laid out by several threads at the same time
+  return _atom->createBox(env);
 }
 
 inline bool Dummy::isKern() const {
@@ -62,8 +62,14 @@ bitset<16> RowAtom::_ligKernSet = bitset<16>()
   .set(static_cast<i8>(AtomType::closing))
   .set(static_cast<i8>(AtomType::punctuation));
 
+// The previous atom given by the enclosing row, it is consumed by the next call
+// of createBox on the same row. It is kept per thread rather than in the row
+// because the rows of a shared formula may be laid out concurrently.
+static thread_local const RowAtom* _pendingRow = nullptr;
+static thread_local sptr<Dummy> _pendingPrevious;
+
 RowAtom::RowAtom(const sptr<Atom>& atom)
-  : _lookAtLastAtom(false), _previousAtom(nullptr), _breakable(true) {
+  : _lookAtLastAtom(false), _breakable(true) {
   if (atom != nullptr) {
     auto* x = dynamic_cast<RowAtom*>(atom.get());
     if (x != nullptr) {
@@ -84,6 +90,7 @@ sptr<Atom> RowAtom::popLastAtom() {
   if (!_elements.empty()) {
     sptr<Atom> x = _elements.back();
     _elements.pop_back();
+    invalidateHash();
     return x;
   }
   return sptrOf<SpaceAtom>(UnitType::point, 0.f, 0.f, 0.f);
@@ -95,7 +102,9 @@ sptr<Atom> RowAtom::get(size_t pos) {
 }
 
 void RowAtom::add(const sptr<Atom>& atom) {
-  if (atom != nullptr) _elements.push_back(atom);
+  if (atom == nullptr) return;
+  _elements.push_back(atom);
+  invalidateHash();
 }
 
 void RowAtom::changeToOrd(Dummy* cur, Dummy* prev, Atom* next) {
@@ -123,11 +132,93 @@ AtomType RowAtom::rightType() const {
   return _elements.back()->rightType();
 }
 
+size_t RowAtom::computeHash() const {
+  size_t h = baseHash();
+  mix(h, (_breakable ? 1 : 0) | (_lookAtLastAtom ? 2 : 0));
+  for (const auto& e : _elements) {
+    if (!mixChild(h, e)) return 0;
+  }
+  return h;
+}
+
+bool RowAtom::isSameAs(const Atom& atom) const {
+  if (!isBaseSameAs(atom)) return false;
+  const auto& a = static_cast<const RowAtom&>(atom);
+  if (_breakable != a._breakable
+      || _lookAtLastAtom != a._lookAtLastAtom
+      || _elements.size() != a._elements.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < _elements.size(); i++) {
+    if (!isSame(_elements[i], a._elements[i])) return false;
+  }
+  return true;
+}
+
+/**
+ * Create the box of an element of a row, its previous atom is given to it if it lays out a row.
+ * The previous atom is dropped if it is not taken, it may be allocated from the arena of the
+ * render (see Arena) and must not outlive the layout.
+ */
+static sptr<Box> createElementBox(Dummy& atom, const sptr<Dummy>& previous, Environment& env) {
+  struct Release {
+    ~Release() {
+      _pendingRow = nullptr;
+      _pendingPrevious = nullptr;
+    }
+  } release;
+  atom.setPreviousAtom(previous);
+  return atom.createBox(env);
+}
+
+/**
+ * Create the box of an element of a row, or take it from the boxes kept by the previous
+ * layouts of the document (see LayoutCache) or from the box of the same sub-expression laid
+ * out before by the render (see BoxMemo)
+ */
+static sptr<Box> elementBox(
+  const sptr<Atom>& element, Dummy& atom, const sptr<Dummy>& previous, Environment& env
+) {
+  LayoutCache* cache = env.getLayoutCache();
+  BoxMemo* memo = env.getBoxMemo();
+  // the characters are cheaper to lay out again than to look up
+  if ((cache == nullptr && memo == nullptr) || Box::DEBUG || atom.isCharSymbol()) {
+    return createElementBox(atom, previous, env);
+  }
+  const bool isRow = dynamic_cast<Row*>(element.get()) != nullptr;
+  const AtomType prev = isRow && previous != nullptr ? previous->rightType() : AtomType::none;
+  sptr<Box> box;
+  LayoutCache::Key key{};
+  if (cache != nullptr) {
+    key = LayoutCache::keyOf(reinterpret_cast<size_t>(element.get()), env, prev);
+    box = cache->find(key, env);
+    if (box != nullptr) return box;
+  }
+  const size_t hash = memo != nullptr ? element->hash() : 0;
+  LayoutCache::Key memoKey{};
+  if (hash != 0) {
+    memoKey = LayoutCache::keyOf(hash, env, prev);
+    box = memo->find(memoKey, *element, env);
+  }
+  if (box == nullptr) {
+    box = createElementBox(atom, previous, env);
+    if (hash != 0) memo->put(std::move(memoKey), element, box, env.isTextWidthUsed());
+  }
+  if (cache != nullptr) cache->put(std::move(key), element, box, env.isTextWidthUsed());
+  return box;
+}
+
 sptr<Box> RowAtom::createBox(Environment& env) {
   auto x = env.getTeXFont();
   TeXFont& tf = *x;
   auto* hbox = new HBox();
 
+  sptr<Dummy> previousAtom;
+  if (_pendingRow == this) {
+    previousAtom = std::move(_pendingPrevious);
+    _pendingRow = nullptr;
+  }
+
   // convert atoms to boxes and add to the horizontal box
   const int end = _elements.size() - 1;
   for (int i = -1; i < end;) {
@@ -149,7 +240,7 @@ sptr<Box> RowAtom::createBox(Environment& env) {
     // i.e. for formula: $+ e - f$, the plus sign should be treat as an ordinary type
     sptr<Atom> nextAtom(nullptr);
     if (i < end) nextAtom = _elements[i + 1];
-    changeToOrd(atom.get(), _previousAtom.get(), nextAtom.get());
+    changeToOrd(atom.get(), previousAtom.get(), nextAtom.get());
 
     // check for ligature or kerning
     float kern = 0;
@@ -158,11 +249,11 @@ sptr<Box> RowAtom::createBox(Environment& env) {
       auto* c = dynamic_cast<CharSymbol*>(next.get());
       if (c != nullptr && _ligKernSet[static_cast<i8>(next->leftType())]) {
         atom->markAsTextSymbol();
-        auto l = atom->getCharFont(tf);
-        auto r = c->getCharFont(tf);
-        auto lig = tf.getLigature(*l, *r);
-        if (lig == nullptr) {
-          kern = tf.getKern(*l, *r, env.getStyle());
+        const CharFont l = atom->getCharFont(tf);
+        const CharFont r = c->getCharFont(tf);
+        const CharFont lig = tf.getLigature(l, r);
+        if (!lig.isValid()) {
+          kern = tf.getKern(l, r, env.getStyle());
           i--;
           break;  // iterator remains unchanged (no ligature!)
         } else {
@@ -178,16 +269,15 @@ sptr<Box> RowAtom::createBox(Environment& env) {
     // insert glue, unless it's the first element of the row
     // or this element or the next is a kerning
     if (i != 0
-        && _previousAtom != nullptr
-        && !_previousAtom->isKern()
+        && previousAtom != nullptr
+        && !previousAtom->isKern()
         && !atom->isKern()
       ) {
-      hbox->add(Glue::get(_previousAtom->rightType(), atom->leftType(), env));
+      hbox->add(Glue::get(previousAtom->rightType(), atom->leftType(), env));
     }
 
     // insert atom's box
-    atom->setPreviousAtom(_previousAtom);
-    auto b = atom->createBox(env);
+    auto b = elementBox(at, *atom, previousAtom, env);
     auto* cb = dynamic_cast<CharBox*>(b.get());
     if (cb != nullptr
         && !atom->isCharInMathMode()
@@ -199,7 +289,7 @@ sptr<Box> RowAtom::createBox(Environment& env) {
     }
 
     if (_breakable) {
-      if (_breakEveywhere) {
+      if (env.isBreakEverywhere()) {
         hbox->addBreakPosition(hbox->_children.size());
       } else {
         auto ca = dynamic_cast<CharAtom*>(at.get());
@@ -218,13 +308,12 @@ sptr<Box> RowAtom::createBox(Environment& env) {
     if (abs(kern) > PREC) hbox->add(sptrOf<StrutBox>(kern, 0.f, 0.f, 0.f));
 
     // kerning do not interfere with the normal glue-rules without kerning
-    if (!atom->isKern()) _previousAtom = atom;
+    if (!atom->isKern()) previousAtom = atom;
   }
-  // reset previous atom
-  _previousAtom = nullptr;
   return sptr<Box>(hbox);
 }
 
 void RowAtom::setPreviousAtom(const sptr<Dummy>& prev) {
-  _previousAtom = prev;
+  _pendingRow = this;
+  _pendingPrevious = prev;
 }
@@ -86,7 +86,7 @@ public:
   bool isCharInMathMode() const;
 
   /** This method will only be called if isCharSymbol returns true. */
-  sptr<CharFont> getCharFont(TeXFont& tf) const;
+  CharFont getCharFont(TeXFont& tf) const;
 
   /**
    * Changes this atom into the given "ligature atom".
@@ -122,10 +122,10 @@ private:
 
   // whether the box generated can be broken
   bool _breakable;
+  // whether this row is shared by several formulas, see #freeze
+  bool _frozen = false;
   // atoms to be displayed horizontally next to each-other
   std::vector<sptr<Atom>> _elements;
-  // previous atom (for nested Row atoms)
-  sptr<Dummy> _previousAtom;
 
   /**
    * Change the atom-type to ORD if necessary
@@ -136,6 +136,7 @@ private:
   static void changeToOrd(Dummy* cur, Dummy* prev, Atom* next);
 
 public:
+  // the default of the documents, see Environment#isBreakEverywhere
   static bool _breakEveywhere;
 
   bool _lookAtLastAtom;
@@ -164,6 +165,7 @@ public:
    */
   inline void setBreakable(bool breakable) {
     _breakable = breakable;
+    invalidateHash();
   }
 
   /** Retrieve the size of the elements */
@@ -174,6 +176,18 @@ public:
   /** Push an atom to back */
   void add(const sptr<Atom>& atom);
 
+  /**
+   * Mark this row as shared by several formulas (e.g. the root of a predefined formula), a
+   * formula copies a frozen row before appending to it, see Formula#add.
+   */
+  inline void freeze() {
+    _frozen = true;
+  }
+
+  inline bool isFrozen() const {
+    return _frozen;
+  }
+
   sptr<Box> createBox(Environment& env) override;
 
   void setPreviousAtom(const sptr<Dummy>& prev) override;
@@ -182,6 +196,10 @@ public:
 
   AtomType rightType() const override;
 
+  size_t computeHash() const override;
+
+  bool isSameAs(const Atom& atom) const override;
+
   __decl_clone(RowAtom)
 };
 
@@ -25,6 +25,32 @@ sptr<Box> SpaceAtom::createBox(Environment& env) {
   return Glue::get(_blankType, env);
 }
 
+size_t SpaceAtom::computeHash() const {
+  size_t h = baseHash();
+  mix(h, _blankSpace ? 1 + static_cast<size_t>(_blankType) : 0);
+  mix(h, std::hash<float>()(_width));
+  mix(h, std::hash<float>()(_height));
+  mix(h, std::hash<float>()(_depth));
+  mix(
+    h,
+    static_cast<size_t>(_wUnit) << 16 | static_cast<size_t>(_hUnit) << 8 | static_cast<size_t>(_dUnit)
+  );
+  return h;
+}
+
+bool SpaceAtom::isSameAs(const Atom& atom) const {
+  if (!isBaseSameAs(atom)) return false;
+  const auto& a = static_cast<const SpaceAtom&>(atom);
+  return _blankSpace == a._blankSpace
+         && _blankType == a._blankType
+         && _width == a._width
+         && _height == a._height
+         && _depth == a._depth
+         && _wUnit == a._wUnit
+         && _hUnit == a._hUnit
+         && _dUnit == a._dUnit;
+}
+
 pair<UnitType, float> SpaceAtom::getLength(const string& lgth) {
   if (lgth.empty()) return {UnitType::pixel, 0.f};
 
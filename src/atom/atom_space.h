@@ -63,6 +63,10 @@ public:
    */
   static std::pair<UnitType, float> getLength(const std::wstring& lgth);
 
+  size_t computeHash() const override;
+
+  bool isSameAs(const Atom& atom) const override;
+
   __decl_clone(SpaceAtom)
 };
 
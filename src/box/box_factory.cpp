@@ -12,7 +12,7 @@ sptr<Box> DelimiterFactory::create(SymbolAtom& symbol, Environment& env, int siz
 
   TeXFont& tf = *(env.getTeXFont());
   const TexStyle style = env.getStyle();
-  Char c = tf.getChar(symbol.getName(), style);
+  Char c = symbol.getChar(tf, style);
   int i = 0;
 
   for (int i = 1; i <= size && tf.hasNextLarger(c); i++) c = tf.getNextLarger(c, style);
@@ -50,40 +50,39 @@ sptr<Box> DelimiterFactory::create(const string& symbol, Environment& env, float
   } else if (tf.isExtensionChar(c)) {
     // construct vertical box
     auto* vBox = new VBox();
-    Extension* ext = tf.getExtension(c, style);
+    const Extension ext = tf.getExtension(c, style);
 
     // insert top part
-    if (ext->hasTop()) {
-      c = ext->getTop();
+    if (ext.hasTop()) {
+      c = ext.getTop();
       vBox->add(sptrOf<CharBox>(c));
     }
 
-    if (ext->hasMiddle()) {
-      c = ext->getMiddle();
+    if (ext.hasMiddle()) {
+      c = ext.getMiddle();
       vBox->add(sptrOf<CharBox>(c));
     }
 
-    if (ext->hasBottom()) {
-      c = ext->getBottom();
+    if (ext.hasBottom()) {
+      c = ext.getBottom();
       vBox->add(sptrOf<CharBox>(c));
     }
 
     // insert repeatable part until tall enough
-    c = ext->getRepeat();
+    c = ext.getRepeat();
     auto rep = sptrOf<CharBox>(c);
     while (vBox->_height + vBox->_depth <= minHeight) {
-      if (ext->hasTop() && ext->hasBottom()) {
+      if (ext.hasTop() && ext.hasBottom()) {
         vBox->add(1, rep);
-        if (ext->hasMiddle()) {
+        if (ext.hasMiddle()) {
           vBox->add(vBox->size() - 1, rep);
         }
-      } else if (ext->hasBottom()) {
+      } else if (ext.hasBottom()) {
         vBox->add(0, rep);
       } else {
         vBox->add(rep);
       }
     }
-    delete ext;
     return sptr<Box>(vBox);
   }
   // no extensions, so return the tallest possible character
@@ -94,13 +93,19 @@ sptr<Atom> XLeftRightArrowFactory::MINUS;
 sptr<Atom> XLeftRightArrowFactory::LEFT;
 sptr<Atom> XLeftRightArrowFactory::RIGHT;
 
+void XLeftRightArrowFactory::_init_() {
+  MINUS = SymbolAtom::get("minus");
+  LEFT = SymbolAtom::get("leftarrow");
+  RIGHT = SymbolAtom::get("rightarrow");
+}
+
+void XLeftRightArrowFactory::_free_() {
+  MINUS = nullptr;
+  LEFT = nullptr;
+  RIGHT = nullptr;
+}
+
 sptr<Box> XLeftRightArrowFactory::create(Environment& env, float width) {
-  // initialize
-  if (MINUS == nullptr) {
-    MINUS = SymbolAtom::get("minus");
-    LEFT = SymbolAtom::get("leftarrow");
-    RIGHT = SymbolAtom::get("rightarrow");
-  }
   sptr<Box> left = LEFT->createBox(env);
   sptr<Box> right = RIGHT->createBox(env);
   float swidth = left->_width + right->_width;
@@ -136,12 +141,6 @@ sptr<Box> XLeftRightArrowFactory::create(Environment& env, float width) {
 }
 
 sptr<Box> XLeftRightArrowFactory::create(bool left, Environment& env, float width) {
-  // initialize
-  if (MINUS == nullptr) {
-    MINUS = SymbolAtom::get("minus");
-    LEFT = SymbolAtom::get("leftarrow");
-    RIGHT = SymbolAtom::get("rightarrow");
-  }
   auto arr = left ? LEFT->createBox(env) : RIGHT->createBox(env);
   float h = arr->_height;
   float d = arr->_depth;
@@ -45,6 +45,11 @@ public:
   static sptr<Box> create(bool left, Environment& env, float width);
 
   static sptr<Box> create(Environment& env, float width);
+
+  /** Resolve the symbols of the arrows, the symbols must be loaded */
+  static void _init_();
+
+  static void _free_();
 };
 
 }
@@ -94,9 +94,17 @@ pair<sptr<HBox>, sptr<HBox>> HBox::split(int pos, int shift) {
 
 void HBox::draw(Graphics2D& g2, float x, float y) {
   float xPos = x;
-  for (const auto& box : _children) {
-    box->draw(g2, xPos, y + box->_shift);
-    xPos += box->_width;
+  const size_t n = _children.size();
+  for (size_t i = 0; i < n;) {
+    // the consecutive characters with the same font are drawn in one run
+    const size_t count = CharBox::drawRun(g2, &_children[i], n - i, xPos, y);
+    if (count == 0) {
+      const auto& box = _children[i++];
+      box->draw(g2, xPos, y + box->_shift);
+      xPos += box->_width;
+      continue;
+    }
+    for (const size_t end = i + count; i < end; i++) xPos += _children[i]->_width;
   }
 }
 
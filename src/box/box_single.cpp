@@ -1,4 +1,5 @@
 #include "box_single.h"
+#include "box/display_list.h"
 #include "fonts/fonts.h"
 
 using namespace std;
@@ -20,17 +21,40 @@ void CharBox::addItalicCorrectionToWidth() {
 
 void CharBox::draw(Graphics2D& g2, float x, float y) {
   g2.translate(x, y);
-  const Font* font = FontInfo::getFont(_cf->fontId);
+  const Font* font = FontInfo::getFont(_cf.fontId);
   if (_size != 1) g2.scale(_size, _size);
   if (g2.getFont() != font) g2.setFont(font);
-  g2.drawChar(_cf->chr, 0, 0);
+  g2.drawChar(_cf.chr, 0, 0);
   // reset
   if (_size != 1) g2.scale(1.f / _size, 1.f / _size);
   g2.translate(-x, -y);
 }
 
+size_t CharBox::drawRun(Graphics2D& g2, const sptr<Box>* boxes, size_t n, float x, float y) {
+  const auto* first = dynamic_cast<const CharBox*>(boxes[0].get());
+  if (first == nullptr) return 0;
+  const float size = first->_size;
+  GlyphRun run;
+  float xPos = 0;
+  for (size_t i = 0; i < n && !run.full(); i++) {
+    const auto* cb = dynamic_cast<const CharBox*>(boxes[i].get());
+    if (cb == nullptr || cb->_cf.fontId != first->_cf.fontId || cb->_size != size) break;
+    run.add((u32) cb->_cf.chr, Point(xPos / size, cb->_shift / size));
+    xPos += cb->_width;
+  }
+  if (run.count < 2) return 0;
+
+  g2.translate(x, y);
+  if (size != 1) g2.scale(size, size);
+  run.draw(g2, FontInfo::getFont(first->_cf.fontId));
+  // reset
+  if (size != 1) g2.scale(1.f / size, 1.f / size);
+  g2.translate(-x, -y);
+  return run.count;
+}
+
 int CharBox::lastFontId() {
-  return _cf->fontId;
+  return _cf.fontId;
 }
 
 sptr<Font> TextRenderingBox::_font(nullptr);
@@ -54,17 +78,39 @@ void TextRenderingBox::init(
 ) {
   _size = size;
   _layout = TextLayout::create(str, f->deriveFont(type));
+  layoutBounds(_layout, size, *this);
+}
+
+void TextRenderingBox::layoutBounds(const sptr<TextLayout>& layout, float size, Box& box) {
   Rect rect;
-  _layout->getBounds(rect);
-  _height = -rect.y * size / 10;
-  _depth = rect.h * size / 10 - _height;
-  _width = (rect.w + rect.x + 0.4f) * size / 10;
+  layout->getBounds(rect);
+  box._height = -rect.y * size / 10;
+  box._depth = rect.h * size / 10 - box._height;
+  box._width = (rect.w + rect.x + 0.4f) * size / 10;
+}
+
+sptr<Box> TextRenderingBox::measure(
+  const wstring& str, int type, float size, const sptr<Font>& font, bool kerning
+) {
+  auto box = sptrOf<StrutBox>(0.f, 0.f, 0.f, 0.f);
+  layoutBounds(TextLayout::create(str, font->deriveFont(type)), size, *box);
+  return box;
+}
+
+sptr<Box> TextRenderingBox::measure(const wstring& str, int type, float size) {
+  return measure(str, type, size, _font, true);
 }
 
 void TextRenderingBox::draw(Graphics2D& g2, float x, float y) {
   g2.translate(x, y);
   g2.scale(0.1f * _size, 0.1f * _size);
-  _layout->draw(g2, 0, 0);
+  // the layouts draw through their platform context, keep them as they are in a display list
+  auto* recorder = dynamic_cast<DisplayListRecorder*>(&g2);
+  if (recorder != nullptr) {
+    recorder->drawLayout(_layout, 0, 0);
+  } else {
+    _layout->draw(g2, 0, 0);
+  }
   g2.scale(10 / _size, 10 / _size);
   g2.translate(-x, -y);
 }
@@ -2,13 +2,10 @@
 #define LATEX_BOX_SINGLE_H
 
 #include "atom/atom.h"
+#include "fonts/font_basic.h"
 
 namespace tex {
 
-class Char;
-
-class CharFont;
-
 /** A box representing whitespace */
 class StrutBox : public Box {
 public:
@@ -56,7 +53,7 @@ public:
 /** A box representing a single character */
 class CharBox : public Box {
 private:
-  sptr<CharFont> _cf;
+  CharFont _cf;
   float _size;
   float _italic;
 
@@ -75,6 +72,18 @@ public:
 
   void draw(Graphics2D& g2, float x, float y) override;
 
+  /**
+   * Draw the consecutive children of a horizontal box in a single glyph run (see
+   * Graphics2D#drawGlyphs), the run takes the CharBoxes that have the same font and size as
+   * the first one, up to GlyphRun#MAX boxes.
+   *
+   * @param boxes the children to draw, the first one is placed at (x, y)
+   * @param n the count of the children
+   * @return the count of the drawn children, 0 if they do not start with a run of at least 2
+   * CharBoxes
+   */
+  static size_t drawRun(Graphics2D& g2, const sptr<Box>* boxes, size_t n, float x, float y);
+
   int lastFontId() override;
 };
 
@@ -87,6 +96,9 @@ private:
 
   void init(const std::wstring& str, int type, float size, const sptr<Font>& font, bool kerning);
 
+  /** Compute the dimensions of the given layout into the given box */
+  static void layoutBounds(const sptr<TextLayout>& layout, float size, Box& box);
+
 public:
   TextRenderingBox() = delete;
 
@@ -103,6 +115,18 @@ public:
 
   void draw(Graphics2D& g2, float x, float y) override;
 
+  /**
+   * Create a box that has the dimensions of the TextRenderingBox of the given text but draws
+   * nothing, the layout of the text is dropped once measured
+   */
+  static sptr<Box> measure(
+    const std::wstring& str, int type, float size,
+    const sptr<Font>& font, bool kerning
+  );
+
+  /** Same as #measure(str, type, size, font, kerning) with the default font */
+  static sptr<Box> measure(const std::wstring& str, int type, float size);
+
   static void setFont(const std::string& name);
 
   static void _init_();
@@ -0,0 +1,284 @@
+#include "box/display_list.h"
+
+#include <cmath>
+
+using namespace std;
+using namespace tex;
+
+/** Change the transformation of the context from the linear part from to to */
+static void transformTo(Graphics2D& g2, const DisplayTransform& from, const DisplayTransform& to) {
+  if (from.angle == to.angle) {
+    if (from.sx != to.sx || from.sy != to.sy) g2.scale(to.sx / from.sx, to.sy / from.sy);
+    return;
+  }
+  g2.scale(1 / from.sx, 1 / from.sy);
+  g2.rotate(to.angle - from.angle);
+  g2.scale(to.sx, to.sy);
+}
+
+void DisplayList::replay(Graphics2D& g2, float x, float y) const {
+  const color oldColor = g2.getColor();
+  g2.translate(x, y);
+
+  const DisplayTransform identity{0, 1, 1};
+  const DisplayTransform* t = &identity;
+  color fg = oldColor;
+  const Font* font = g2.getFont();
+  i32 stroke = -1;
+  GlyphRun run;
+  const size_t count = _commands.size();
+  for (size_t i = 0; i < count; i++) {
+    const auto& cmd = _commands[i];
+    const DisplayTransform& ct = _transforms[cmd.transform];
+    if (&ct != t) {
+      if (ct != *t) transformTo(g2, *t, ct);
+      t = &ct;
+    }
+    if (cmd.fg != fg) g2.setColor(fg = cmd.fg);
+    switch (cmd.op) {
+      case DisplayOp::glyph: {
+        // the following glyphs drawn with the same state go into one run
+        run.count = 0;
+        for (size_t j = i; j < count && !run.full(); j++) {
+          const auto& c = _commands[j];
+          if (c.op != DisplayOp::glyph
+              || c.transform != cmd.transform
+              || c.fg != cmd.fg
+              || c.font != cmd.font) {
+            break;
+          }
+          run.add(c.arg, Point(c.x, c.y));
+        }
+        if (run.count == 1) {
+          if (cmd.font != font) g2.setFont(font = cmd.font);
+          g2.drawChar((wchar_t) cmd.arg, cmd.x, cmd.y);
+        } else {
+          run.draw(g2, font = cmd.font);
+        }
+        i += run.count - 1;
+        break;
+      }
+      case DisplayOp::text:
+        if (cmd.font != font) g2.setFont(font = cmd.font);
+        g2.drawText(_texts[cmd.arg], cmd.x, cmd.y);
+        break;
+      case DisplayOp::layout:
+        _layouts[cmd.arg]->draw(g2, cmd.x, cmd.y);
+        // the layout may change the font
+        font = g2.getFont();
+        break;
+      case DisplayOp::fillRect:
+        g2.fillRect(cmd.x, cmd.y, cmd.w, cmd.h);
+        break;
+      case DisplayOp::fillRoundRect:
+        g2.fillRoundRect(cmd.x, cmd.y, cmd.w, cmd.h, cmd.rx, cmd.ry);
+        break;
+      default:
+        // the stroked commands
+        if (cmd.stroke != stroke && cmd.stroke >= 0) g2.setStroke(_strokes[cmd.stroke]);
+        stroke = cmd.stroke;
+        if (cmd.op == DisplayOp::line) {
+          g2.drawLine(cmd.x, cmd.y, cmd.w, cmd.h);
+        } else if (cmd.op == DisplayOp::rect) {
+          g2.drawRect(cmd.x, cmd.y, cmd.w, cmd.h);
+        } else {
+          g2.drawRoundRect(cmd.x, cmd.y, cmd.w, cmd.h, cmd.rx, cmd.ry);
+        }
+        break;
+    }
+  }
+
+  transformTo(g2, *t, identity);
+  g2.translate(-x, -y);
+  g2.setColor(oldColor);
+}
+
+/************************************* display list recorder **************************************/
+
+DisplayListRecorder::DisplayListRecorder() : _list(sptrOf<DisplayList>()) {}
+
+DisplayCommand& DisplayListRecorder::record(DisplayOp op, float x, float y, bool stroked) {
+  auto& l = *_list;
+  // decompose the linear part into a rotation followed by a scaling, a skew cannot
+  const float n1 = hypot(_a, _b), n2 = hypot(_c, _d);
+  if (n1 == 0 || n2 == 0 || abs(_a * _c + _b * _d) > 1e-4f * n1 * n2) _flat = false;
+  DisplayTransform t{0, _a, _d};
+  float dx = _e / _a, dy = _f / _d;
+  if (_b != 0 || _a <= 0) {
+    t.angle = atan2(_b, _a);
+    const float s = sin(t.angle), c = cos(t.angle);
+    t.sx = n1;
+    t.sy = -_c * s + _d * c;
+    dx = (c * _e + s * _f) / t.sx;
+    dy = (-s * _e + c * _f) / t.sy;
+  }
+
+  size_t ti = 0;
+  if (!l._commands.empty() && l._transforms[l._commands.back().transform] == t) {
+    ti = l._commands.back().transform;
+  } else {
+    while (ti < l._transforms.size() && l._transforms[ti] != t) ti++;
+    if (ti == l._transforms.size()) l._transforms.push_back(t);
+  }
+
+  if (stroked && _strokeChanged) {
+    const Stroke* last = _strokeIndex < 0 ? nullptr : &l._strokes[_strokeIndex];
+    if (last == nullptr
+        || last->lineWidth != _stroke.lineWidth
+        || last->miterLimit != _stroke.miterLimit
+        || last->cap != _stroke.cap
+        || last->join != _stroke.join) {
+      l._strokes.push_back(_stroke);
+      _strokeIndex = (i32) (l._strokes.size() - 1);
+    }
+    _strokeChanged = false;
+  }
+
+  l._commands.push_back({});
+  DisplayCommand& cmd = l._commands.back();
+  cmd.op = op;
+  cmd.transform = (u32) ti;
+  cmd.stroke = stroked ? _strokeIndex : -1;
+  cmd.fg = _color;
+  cmd.font = _font;
+  cmd.x = x + dx;
+  cmd.y = y + dy;
+  cmd.w = cmd.h = cmd.rx = cmd.ry = 0;
+  cmd.arg = 0;
+  if (op == DisplayOp::line) {
+    // the end point is shifted as the start point
+    cmd.w = dx;
+    cmd.h = dy;
+  }
+  return cmd;
+}
+
+void DisplayListRecorder::drawLayout(const sptr<TextLayout>& layout, float x, float y) {
+  auto& cmd = record(DisplayOp::layout, x, y, false);
+  cmd.arg = (u32) _list->_layouts.size();
+  _list->_layouts.push_back(layout);
+}
+
+sptr<DisplayList> DisplayListRecorder::finish() {
+  auto list = std::move(_list);
+  _list = sptrOf<DisplayList>();
+  if (!_flat) return nullptr;
+  return list;
+}
+
+void DisplayListRecorder::setColor(color c) {
+  _color = c;
+}
+
+color DisplayListRecorder::getColor() const {
+  return _color;
+}
+
+void DisplayListRecorder::setStroke(const Stroke& s) {
+  _stroke = s;
+  _strokeChanged = true;
+}
+
+const Stroke& DisplayListRecorder::getStroke() const {
+  return _stroke;
+}
+
+void DisplayListRecorder::setStrokeWidth(float w) {
+  _stroke.lineWidth = w;
+  _strokeChanged = true;
+}
+
+const Font* DisplayListRecorder::getFont() const {
+  return _font;
+}
+
+void DisplayListRecorder::setFont(const Font* font) {
+  _font = font;
+}
+
+void DisplayListRecorder::translate(float dx, float dy) {
+  _e += _a * dx + _c * dy;
+  _f += _b * dx + _d * dy;
+}
+
+void DisplayListRecorder::scale(float sx, float sy) {
+  _a *= sx;
+  _b *= sx;
+  _c *= sy;
+  _d *= sy;
+  _sx *= sx;
+  _sy *= sy;
+}
+
+void DisplayListRecorder::rotate(float angle) {
+  const float s = sin(angle), c = cos(angle);
+  const float a = _a * c + _c * s, b = _b * c + _d * s;
+  _c = _c * c - _a * s;
+  _d = _d * c - _b * s;
+  _a = a;
+  _b = b;
+}
+
+void DisplayListRecorder::rotate(float angle, float px, float py) {
+  translate(px, py);
+  rotate(angle);
+  translate(-px, -py);
+}
+
+void DisplayListRecorder::reset() {
+  _a = _d = 1;
+  _b = _c = _e = _f = 0;
+  _sx = _sy = 1;
+}
+
+float DisplayListRecorder::sx() const {
+  return _sx;
+}
+
+float DisplayListRecorder::sy() const {
+  return _sy;
+}
+
+void DisplayListRecorder::drawChar(wchar_t c, float x, float y) {
+  record(DisplayOp::glyph, x, y, false).arg = (u32) c;
+}
+
+void DisplayListRecorder::drawText(const wstring& c, float x, float y) {
+  auto& cmd = record(DisplayOp::text, x, y, false);
+  cmd.arg = (u32) _list->_texts.size();
+  _list->_texts.push_back(c);
+}
+
+void DisplayListRecorder::drawLine(float x1, float y1, float x2, float y2) {
+  auto& cmd = record(DisplayOp::line, x1, y1, true);
+  cmd.w += x2;
+  cmd.h += y2;
+}
+
+void DisplayListRecorder::drawRect(float x, float y, float w, float h) {
+  auto& cmd = record(DisplayOp::rect, x, y, true);
+  cmd.w = w;
+  cmd.h = h;
+}
+
+void DisplayListRecorder::fillRect(float x, float y, float w, float h) {
+  auto& cmd = record(DisplayOp::fillRect, x, y, false);
+  cmd.w = w;
+  cmd.h = h;
+}
+
+void DisplayListRecorder::drawRoundRect(float x, float y, float w, float h, float rx, float ry) {
+  auto& cmd = record(DisplayOp::roundRect, x, y, true);
+  cmd.w = w;
+  cmd.h = h;
+  cmd.rx = rx;
+  cmd.ry = ry;
+}
+
+void DisplayListRecorder::fillRoundRect(float x, float y, float w, float h, float rx, float ry) {
+  auto& cmd = record(DisplayOp::fillRoundRect, x, y, false);
+  cmd.w = w;
+  cmd.h = h;
+  cmd.rx = rx;
+  cmd.ry = ry;
+}
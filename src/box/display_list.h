@@ -0,0 +1,173 @@
+#ifndef LATEX_DISPLAY_LIST_H
+#define LATEX_DISPLAY_LIST_H
+
+#include <string>
+#include <vector>
+
+#include "common.h"
+#include "graphic/graphic.h"
+
+namespace tex {
+
+enum class DisplayOp : u8 {
+  glyph,
+  text,
+  layout,
+  line,
+  rect,
+  fillRect,
+  roundRect,
+  fillRoundRect
+};
+
+/** The linear part of a transformation, rotate by angle (in radian) then scale by (sx, sy) */
+struct DisplayTransform {
+  float angle, sx, sy;
+
+  inline bool operator==(const DisplayTransform& t) const {
+    return angle == t.angle && sx == t.sx && sy == t.sy;
+  }
+
+  inline bool operator!=(const DisplayTransform& t) const {
+    return !(*this == t);
+  }
+};
+
+/**
+ * A drawing command with its state folded in. The geometry is in the coordinates of its
+ * transform, with the translations of the box tree added, so the command is drawn as is once
+ * the transform is applied to the origin of the list.
+ */
+struct DisplayCommand {
+  DisplayOp op;
+  // index of the transform
+  u32 transform;
+  // index of the stroke, -1 to keep the stroke of the graphics context
+  i32 stroke;
+  color fg;
+  // the font of the glyph and the text commands
+  const Font* font;
+  // glyph, text, layout: (x, y) is the baseline origin
+  // line: from (x, y) to (w, h)
+  // rect: (x, y) is the top-left corner, (rx, ry) are the radii of the round rectangles
+  float x, y, w, h, rx, ry;
+  // the character of a glyph, or the index of the text or the layout
+  u32 arg;
+};
+
+/**
+ * A box tree compiled into a flat list of drawing commands (see DisplayListRecorder), so
+ * drawing it again is a single pass over the commands instead of a walk of the tree, with
+ * the state changes made only when the state of the next command differs. The consecutive
+ * glyphs that share their state are drawn in a single call (see Graphics2D#drawGlyphs).
+ */
+class DisplayList {
+private:
+  std::vector<DisplayCommand> _commands;
+  std::vector<DisplayTransform> _transforms;
+  std::vector<Stroke> _strokes;
+  std::vector<std::wstring> _texts;
+  std::vector<sptr<TextLayout>> _layouts;
+
+  friend class DisplayListRecorder;
+
+public:
+  inline const std::vector<DisplayCommand>& commands() const { return _commands; }
+
+  inline const DisplayTransform& transform(const DisplayCommand& cmd) const {
+    return _transforms[cmd.transform];
+  }
+
+  inline const Stroke* stroke(const DisplayCommand& cmd) const {
+    return cmd.stroke < 0 ? nullptr : &_strokes[cmd.stroke];
+  }
+
+  inline const std::wstring& text(const DisplayCommand& cmd) const { return _texts[cmd.arg]; }
+
+  inline const sptr<TextLayout>& layout(const DisplayCommand& cmd) const {
+    return _layouts[cmd.arg];
+  }
+
+  /**
+   * Draw the commands to the given graphics context with the origin at (x, y), the
+   * transformation and the color of the context are restored afterwards.
+   */
+  void replay(Graphics2D& g2, float x, float y) const;
+};
+
+/**
+ * A graphics context that records the drawing operations into a display list. It follows
+ * the transformations like the platform contexts do, a tree that skews its content (a
+ * non-uniform scaling of a rotated box) cannot be flattened and #finish returns nullptr.
+ * The recording starts with the default stroke, as a new platform context does.
+ */
+class DisplayListRecorder : public Graphics2D {
+private:
+  sptr<DisplayList> _list;
+  color _color = black;
+  Stroke _stroke;
+  i32 _strokeIndex = -1;
+  bool _strokeChanged = false;
+  const Font* _font = nullptr;
+  // the transformation: x' = a * x + c * y + e, y' = b * x + d * y + f
+  float _a = 1, _b = 0, _c = 0, _d = 1, _e = 0, _f = 0;
+  float _sx = 1, _sy = 1;
+  bool _flat = true;
+
+  DisplayCommand& record(DisplayOp op, float x, float y, bool stroked);
+
+public:
+  DisplayListRecorder();
+
+  /** Record a text layout (see TextRenderingBox), it is drawn by the layout on replay */
+  void drawLayout(const sptr<TextLayout>& layout, float x, float y);
+
+  /** Get the recorded list, nullptr if the drawing cannot be flattened */
+  sptr<DisplayList> finish();
+
+  void setColor(color c) override;
+
+  color getColor() const override;
+
+  void setStroke(const Stroke& s) override;
+
+  const Stroke& getStroke() const override;
+
+  void setStrokeWidth(float w) override;
+
+  const Font* getFont() const override;
+
+  void setFont(const Font* font) override;
+
+  void translate(float dx, float dy) override;
+
+  void scale(float sx, float sy) override;
+
+  void rotate(float angle) override;
+
+  void rotate(float angle, float px, float py) override;
+
+  void reset() override;
+
+  float sx() const override;
+
+  float sy() const override;
+
+  void drawChar(wchar_t c, float x, float y) override;
+
+  void drawText(const std::wstring& c, float x, float y) override;
+
+  void drawLine(float x1, float y1, float x2, float y2) override;
+
+  void drawRect(float x, float y, float w, float h) override;
+
+  void fillRect(float x, float y, float w, float h) override;
+
+  void drawRoundRect(float x, float y, float w, float h, float rx, float ry) override;
+
+  void fillRoundRect(float x, float y, float w, float h, float rx, float ry) override;
+};
+
+}  // namespace tex
+
+#endif  // LATEX_DISPLAY_LIST_H
@@ -0,0 +1,117 @@
+#include "core/command_table.h"
+
+#include <algorithm>
+#include <map>
+
+#include "atom/atom_char.h"
+#include "core/formula.h"
+#include "core/macro.h"
+#include "utils/utf.h"
+
+using namespace std;
+using namespace tex;
+
+vector<CommandEntry> CommandTable::_entries;
+vector<u32> CommandTable::_displacements;
+bool CommandTable::_built = false;
+
+u32 CommandTable::hash(const wstring& name, u32 seed) {
+  // FNV-1a, then a murmur3 finalizer to spread the seeded values
+  u32 h = 2166136261u ^ (seed * 0x9e3779b9u);
+  for (wchar_t c : name) {
+    h ^= (u32) c;
+    h *= 16777619u;
+  }
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+bool CommandTable::place(
+  const vector<vector<const wstring*>>& buckets, const vector<size_t>& order, size_t m
+) {
+  vector<bool> taken(m, false);
+  vector<size_t> slots;
+  for (size_t b : order) {
+    const auto& keys = buckets[b];
+    if (keys.empty()) break;
+    u32 d = 1;
+    for (; d <= MAX_DISPLACEMENT; d++) {
+      slots.clear();
+      bool ok = true;
+      for (const wstring* k : keys) {
+        const size_t s = hash(*k, d) % m;
+        if (taken[s] || std::find(slots.begin(), slots.end(), s) != slots.end()) {
+          ok = false;
+          break;
+        }
+        slots.push_back(s);
+      }
+      if (ok) break;
+    }
+    if (d > MAX_DISPLACEMENT) return false;
+    for (size_t s : slots) taken[s] = true;
+    _displacements[b] = d;
+  }
+  return true;
+}
+
+void CommandTable::build() {
+  // the union of all the predefined names
+  map<wstring, CommandEntry> all;
+  for (const auto& i : MacroInfo::_commands) {
+    auto& e = all[i.first];
+    e.macro = i.second;
+  }
+  for (const auto& i : Formula::_predefinedTeXFormulasAsString) {
+    all[i.first].isFormula = true;
+  }
+  for (const auto& i : SymbolAtom::_symbols) {
+    all[utf82wide(i.first)].symbol = i.second;
+  }
+
+  const size_t n = all.size();
+  _entries.clear();
+  _displacements.clear();
+  _built = true;
+  if (n == 0) return;
+
+  // about 4 names per bucket
+  const size_t r = n / 4 + 1;
+  _displacements.assign(r, 0);
+
+  vector<vector<const wstring*>> buckets(r);
+  for (const auto& i : all) buckets[bucketOf(i.first)].push_back(&i.first);
+  vector<size_t> order(r);
+  for (size_t i = 0; i < r; i++) order[i] = i;
+  // place the large buckets first while there are more free slots
+  stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  // 20% free slots, more if a bucket cannot be placed
+  size_t m = n + n / 5 + 1;
+  while (!place(buckets, order, m)) m += m / 4;
+
+  _entries.resize(m);
+  for (auto& i : all) {
+    const size_t s = hash(i.first, _displacements[bucketOf(i.first)]) % m;
+    _entries[s] = std::move(i.second);
+    _entries[s].name = i.first;
+  }
+}
+
+const CommandEntry* CommandTable::find(const wstring& name) {
+  if (_entries.empty()) return nullptr;
+  const CommandEntry& e = _entries[hash(name, _displacements[bucketOf(name)]) % _entries.size()];
+  return e.name == name ? &e : nullptr;
+}
+
+void CommandTable::_free_() {
+  _entries.clear();
+  _displacements.clear();
+  _built = false;
+}
@@ -0,0 +1,78 @@
+#ifndef COMMAND_TABLE_H_INCLUDED
+#define COMMAND_TABLE_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace tex {
+
+class MacroInfo;
+
+class SymbolAtom;
+
+/** What a command name resolves to, in the order of precedence used by the parser */
+struct CommandEntry {
+  std::wstring name;
+  // the predefined macro, nullptr if not a macro
+  MacroInfo* macro = nullptr;
+  // whether the name is a predefined formula
+  bool isFormula = false;
+  // the predefined symbol, nullptr if not a symbol
+  sptr<SymbolAtom> symbol;
+};
+
+/**
+ * A minimal perfect hash (hash-and-displace) over the names of all the predefined macros,
+ * formulas and symbols. It is built once the predefined tables are loaded and read-only
+ * after that, so a command is resolved with a single probe and without a chain of map
+ * lookups or exceptions. The commands defined by a document are not in this table, see
+ * MacroScope, and no predefined macro or symbol can be added once it is built (see
+ * MacroInfo#add and SymbolAtom#addSymbolAtom).
+ */
+class CommandTable {
+private:
+  // slots of the table, every name takes exactly one slot
+  static std::vector<CommandEntry> _entries;
+  // displacement for every first-level bucket
+  static std::vector<u32> _displacements;
+  static bool _built;
+
+  // the displacements tried for a bucket before the table is made larger
+  static constexpr u32 MAX_DISPLACEMENT = 1 << 16;
+
+  static u32 hash(const std::wstring& name, u32 seed);
+
+  static inline size_t bucketOf(const std::wstring& name) {
+    return hash(name, 0) % _displacements.size();
+  }
+
+  /**
+   * Find a displacement for every bucket, in the given order, so that the names take distinct
+   * slots in a table of m slots. Return false if a bucket cannot be placed.
+   */
+  static bool place(
+    const std::vector<std::vector<const std::wstring*>>& buckets,
+    const std::vector<size_t>& order,
+    size_t m
+  );
+
+public:
+  no_copy_assign(CommandTable);
+
+  /** Build the table from the predefined macros, formulas and symbols. */
+  static void build();
+
+  /** Test if the table is built, the predefined tables are read-only then */
+  static inline bool isBuilt() { return _built; }
+
+  /** Find the entry of the given command name, return nullptr if not found. */
+  static const CommandEntry* find(const std::wstring& name);
+
+  static void _free_();
+};
+
+}  // namespace tex
+
+#endif
@@ -1,5 +1,8 @@
 #include "core/core.h"
 
+#include <mutex>
+#include <unordered_set>
+
 #include "atom/atom_basic.h"
 #include "box/box_group.h"
 #include "common.h"
@@ -58,11 +61,13 @@ void tex::print_box(const sptr<Box>& b) {
 
 #endif  // HAVE_LOG
 
-sptr<Box> BoxSplitter::split(const sptr<Box>& b, float width, float lineSpace) {
+sptr<Box> BoxSplitter::split(
+  const sptr<Box>& b, float width, float lineSpace, LineBreaking breaking
+) {
   auto h = dynamic_pointer_cast<HBox>(b);
   sptr<Box> box;
   if (h != nullptr) {
-    auto box = split(h, width, lineSpace);
+    auto box = split(h, width, lineSpace, breaking);
 #ifdef HAVE_LOG
     if (box != b) {
       __print("[BEFORE SPLIT]:\n");
@@ -83,9 +88,15 @@ sptr<Box> BoxSplitter::split(const sptr<Box>& b, float width, float lineSpace) {
   return b;
 }
 
-sptr<Box> BoxSplitter::split(const sptr<HBox>& hb, float width, float lineSpace) {
+sptr<Box> BoxSplitter::split(
+  const sptr<HBox>& hb, float width, float lineSpace, LineBreaking breaking
+) {
   if (width == 0 || hb->_width <= width) return hb;
+  if (breaking == LineBreaking::optimal) return splitOptimal(hb, width, lineSpace);
+  return splitGreedy(hb, width, lineSpace);
+}
 
+sptr<Box> BoxSplitter::splitGreedy(const sptr<HBox>& hb, float width, float lineSpace) {
   auto* vbox = new VBox();
   sptr<HBox> first, second;
   stack<Position> positions;
@@ -178,16 +189,131 @@ int BoxSplitter::getBreakPosition(const sptr<HBox>& hb, int i) {
   return hb->_breakPositions[pos - 1];
 }
 
+void BoxSplitter::collectBreaks(
+  const HBox& hb, float x, vector<int>& prefix, vector<Candidate>& candidates, vector<int>& paths
+) {
+  const auto& breaks = hb._breakPositions;
+  const int count = hb._children.size();
+  size_t k = 0;
+  for (int i = 0; i < count; i++) {
+    while (k < breaks.size() && breaks[k] < i) k++;
+    // a break before the first child would leave an empty line
+    if (i > 0 && k < breaks.size() && breaks[k] == i) {
+      candidates.push_back({x, (u32) paths.size(), (u32) prefix.size() + 1});
+      paths.insert(paths.end(), prefix.begin(), prefix.end());
+      paths.push_back(i);
+    }
+    const auto& child = hb._children[i];
+    if (auto h = dynamic_cast<const HBox*>(child.get()); h != nullptr) {
+      prefix.push_back(i);
+      collectBreaks(*h, x, prefix, candidates, paths);
+      prefix.pop_back();
+    }
+    x += child->_width;
+  }
+}
+
+sptr<HBox> BoxSplitter::slice(const HBox& hb, const int* lo, int loLen, const int* hi, int hiLen) {
+  auto box = sptrOf<HBox>();
+  box->_shift = hb._shift;
+  const auto& children = hb._children;
+  int start = loLen > 0 ? lo[0] : 0;
+  const int end = hiLen > 0 ? hi[0] : children.size();
+  if (loLen > 1 && hiLen > 1 && start == end) {
+    // both the breaks are in the same child
+    const auto& child = static_cast<const HBox&>(*children[start]);
+    box->add(slice(child, lo + 1, loLen - 1, hi + 1, hiLen - 1));
+    return box;
+  }
+  if (loLen > 1) {
+    const auto& child = static_cast<const HBox&>(*children[start]);
+    box->add(slice(child, lo + 1, loLen - 1, nullptr, 0));
+    start++;
+  }
+  for (int i = start; i < end; i++) box->add(children[i]);
+  if (hiLen > 1) {
+    const auto& child = static_cast<const HBox&>(*children[end]);
+    box->add(slice(child, nullptr, 0, hi + 1, hiLen - 1));
+  }
+  return box;
+}
+
+sptr<Box> BoxSplitter::splitOptimal(const sptr<HBox>& hb, float width, float lineSpace) {
+  // the nodes are the start of the formula, the breaks and the end of the formula
+  vector<Candidate> nodes{{0.f, 0, 0}};
+  vector<int> paths, prefix;
+  collectBreaks(*hb, 0.f, prefix, nodes, paths);
+  nodes.push_back({hb->_width, 0, 0});
+  const int n = nodes.size();
+  if (n == 2) return hb;
+
+  // the cost of a line is its badness, from its unused space like in TeX, a line that
+  // overflows is only taken if there is no other way, the breaks in nested boxes are
+  // slightly penalized to keep the groups together
+  static const float OVERFLOW_COST = 1e6f, NESTED_COST = 0.5f;
+  const auto cost = [&](int a, int b) {
+    const float w = nodes[b]._x - nodes[a]._x;
+    if (w > width) return OVERFLOW_COST * (1 + (w - width) / width);
+    // the last line may be as short as it likes
+    if (b == n - 1) return 1.f;
+    const float r = (width - w) / width;
+    return 1 + 100 * r * r * r + NESTED_COST * (nodes[b]._depth - 1);
+  };
+
+  // the best cost to break at each node and the previous break of the best way, only the
+  // lines that fit are tried (and the shortest one that does not), so it takes linear time
+  // in the number of breaks times the number of breaks that fit in a line
+  vector<float> best(n, F_MAX);
+  vector<int> previous(n, 0);
+  best[0] = 0;
+  for (int b = 1; b < n; b++) {
+    for (int a = b - 1; a >= 0; a--) {
+      if (a < b - 1 && nodes[b]._x - nodes[a]._x > width) break;
+      const float c = best[a] + cost(a, b);
+      if (c < best[b]) {
+        best[b] = c;
+        previous[b] = a;
+      }
+    }
+  }
+
+  vector<int> breaks;
+  for (int b = n - 1; b > 0; b = previous[b]) breaks.push_back(b);
+  breaks.push_back(0);
+  if (breaks.size() == 2) return hb;
+
+  auto* vbox = new VBox();
+  for (size_t i = breaks.size() - 1; i > 0; i--) {
+    const Candidate& lo = nodes[breaks[i]];
+    const Candidate& hi = nodes[breaks[i - 1]];
+    vbox->add(
+      slice(*hb, paths.data() + lo._path, lo._depth, paths.data() + hi._path, hi._depth),
+      lineSpace
+    );
+  }
+  return sptr<Box>(vbox);
+}
+
 /************************************* Environment implementation ******************************/
 
-Environment::Environment(TexStyle style, const sptr<TeXFont>& tf, UnitType wu, float tw) {
+Environment::Environment(TexStyle style, TeXFont& tf, UnitType wu, float tw) {
   init();
   _style = style;
-  _tf = tf;
+  _tf = &tf;
   setInterline(UnitType::ex, 1.f);
   _textWidth = tw * SpaceAtom::getFactor(wu, *this);
 }
 
+const string* Environment::internTextStyle(const string& style) {
+  static const string none;
+  if (style.empty()) return &none;
+  // the environments of several threads may intern at the same time
+  static mutex lock;
+  static unordered_set<string> styles;
+  lock_guard<mutex> guard(lock);
+  return &*styles.insert(style).first;
+}
+
 float Environment::getInterline() const {
   return _interline * SpaceAtom::getFactor(_interlineUnit, *this);
 }
@@ -196,64 +322,54 @@ void Environment::setTextWidth(UnitType wu, float w) {
   _textWidth = w * SpaceAtom::getFactor(wu, *this);
 }
 
-sptr<Environment>& Environment::copy() {
-  Environment* t = new Environment(_style, _scaleFactor, _tf, _textStyle, _smallCap);
-  _copy = sptr<Environment>(t);
-  return _copy;
+Environment Environment::derive(TexStyle style) const {
+  Environment e(*this);
+  e._style = style;
+  e._lastFontId = TeXFont::NO_FONT;
+  e._textWidth = POS_INF;
+  e.setInterline(UnitType::ex, 1.f);
+  return e;
+}
+
+Environment Environment::copy() const {
+  return derive(_style);
 }
 
-sptr<Environment>& Environment::copy(const sptr<TeXFont>& tf) {
-  Environment* te = new Environment(_style, _scaleFactor, tf, _textStyle, _smallCap);
-  te->_textWidth = _textWidth;
-  te->_interline = _interline;
-  te->_interlineUnit = _interlineUnit;
-  _copytf = sptr<Environment>(te);
-  return _copytf;
+Environment Environment::copy(const sptr<TeXFont>& tf) const {
+  Environment e = derive(_style);
+  e._tf = tf.get();
+  e._font = tf;
+  e._textWidth = _textWidth;
+  e._interline = _interline;
+  e._interlineUnit = _interlineUnit;
+  return e;
 }
 
-sptr<Environment>& Environment::crampStyle() {
-  Environment* t = new Environment(_style, _scaleFactor, _tf, _textStyle, _smallCap);
-  _cramp = sptr<Environment>(t);
+Environment Environment::crampStyle() const {
   const i8 style = static_cast<i8>(_style);
-  _cramp->_style = static_cast<TexStyle>(style % 2 == 1 ? style : style + 1);
-  return _cramp;
+  return derive(static_cast<TexStyle>(style % 2 == 1 ? style : style + 1));
 }
 
-sptr<Environment>& Environment::dnomStyle() {
-  Environment* t = new Environment(_style, _scaleFactor, _tf, _textStyle, _smallCap);
-  _dnom = sptr<Environment>(t);
+Environment Environment::dnomStyle() const {
   const i8 style = static_cast<i8>(_style);
-  _dnom->_style = static_cast<TexStyle>(2 * (style / 2) + 1 + 2 - 2 * (style / 6));
-  return _dnom;
+  return derive(static_cast<TexStyle>(2 * (style / 2) + 1 + 2 - 2 * (style / 6)));
 }
 
-sptr<Environment>& Environment::numStyle() {
-  Environment* t = new Environment(_style, _scaleFactor, _tf, _textStyle, _smallCap);
-  _num = sptr<Environment>(t);
+Environment Environment::numStyle() const {
   const i8 style = static_cast<i8>(_style);
-  _num->_style = static_cast<TexStyle>(style + 2 - 2 * (style / 6));
-  return _num;
+  return derive(static_cast<TexStyle>(style + 2 - 2 * (style / 6)));
 }
 
-sptr<Environment>& Environment::rootStyle() {
-  Environment* t = new Environment(_style, _scaleFactor, _tf, _textStyle, _smallCap);
-  _root = sptr<Environment>(t);
-  _root->_style = TexStyle::scriptScript;
-  return _root;
+Environment Environment::rootStyle() const {
+  return derive(TexStyle::scriptScript);
 }
 
-sptr<Environment>& Environment::subStyle() {
-  Environment* t = new Environment(_style, _scaleFactor, _tf, _textStyle, _smallCap);
-  _sub = sptr<Environment>(t);
+Environment Environment::subStyle() const {
   const i8 style = static_cast<i8>(_style);
-  _sub->_style = static_cast<TexStyle>(2 * (style / 4) + 4 + 1);
-  return _sub;
+  return derive(static_cast<TexStyle>(2 * (style / 4) + 4 + 1));
 }
 
-sptr<Environment>& Environment::supStyle() {
-  Environment* t = new Environment(_style, _scaleFactor, _tf, _textStyle, _smallCap);
-  _sup = sptr<Environment>(t);
+Environment Environment::supStyle() const {
   const i8 style = static_cast<i8>(_style);
-  _sup->_style = static_cast<TexStyle>(2 * (style / 4) + 4 + (style % 2));
-  return _sup;
+  return derive(static_cast<TexStyle>(2 * (style / 4) + 4 + (style % 2)));
 }
@@ -12,6 +12,10 @@ namespace tex {
 
 class Box;
 
+class LayoutCache;
+
+class BoxMemo;
+
 #ifdef HAVE_LOG
 
 void print_box(const sptr<Box>& box);
@@ -29,34 +33,70 @@ public:
   };
 
 private:
+  /** A place where a line can be broken, see #splitOptimal */
+  struct Candidate {
+    // the offset from the start of the formula
+    float _x;
+    // the path to the break in the flattened paths, see #collectBreaks
+    u32 _path;
+    u32 _depth;
+  };
+
   static float canBreak(std::stack<Position>& stack, const sptr<HBox>& hbox, float width);
 
   static int getBreakPosition(const sptr<HBox>& hb, int index);
 
+  /**
+   * Collect the break positions of the given box and of the HBoxes it contains, in order.
+   * The path of a break is the index of the child that starts the new line at each depth,
+   * the last one included, the other ones are the HBoxes that contain the break.
+   */
+  static void collectBreaks(
+    const HBox& hb, float x, std::vector<int>& prefix,
+    std::vector<Candidate>& candidates, std::vector<int>& paths);
+
+  /** Copy the part of the given box between the breaks lo and hi, empty paths are the ends */
+  static sptr<HBox> slice(const HBox& hb, const int* lo, int loLen, const int* hi, int hiLen);
+
+  static sptr<Box> splitGreedy(const sptr<HBox>& hb, float width, float lineSpace);
+
+  static sptr<Box> splitOptimal(const sptr<HBox>& hb, float width, float lineSpace);
+
 public:
-  static sptr<Box> split(const sptr<Box>& box, float width, float lineSpace);
+  static sptr<Box> split(
+    const sptr<Box>& box, float width, float lineSpace,
+    LineBreaking breaking = LineBreaking::optimal);
 
-  static sptr<Box> split(const sptr<HBox>& hb, float width, float lineSpace);
+  static sptr<Box> split(
+    const sptr<HBox>& hb, float width, float lineSpace,
+    LineBreaking breaking = LineBreaking::optimal);
 };
 
 /**
  * Contains the used TeXFont-object, color settings and the current style in
  * which a formula must be drawn. It's used in the createBox-methods. Contains
  * methods that apply the style changing rules for subformula's.
+ *
+ * It is a small value type: the environments of the subformulas (see #subStyle...) are copies
+ * made on the stack, the font is shared by pointer and the text style is interned.
  */
 class Environment {
+  friend class LayoutCache;
+
 private:
   // current style
   TexStyle _style;
   // TeXFont used
-  sptr<TeXFont> _tf;
+  TeXFont* _tf;
+  // the font if it is owned by this environment and its copies, see #copy(tf)
+  sptr<TeXFont> _font;
   // last used font
   int _lastFontId{};
   // Environment width
   float _textWidth{};
 
-  // The text style to use
-  std::string _textStyle;
+  // The text style to use, interned, see #internTextStyle
+  const std::string* _textStyle;
   // If is small capital
   bool _smallCap{};
   float _scaleFactor{};
@@ -64,44 +104,55 @@ private:
   UnitType _interlineUnit;
   // The inter line space
   float _interline{};
-
-  // Member to store copies to prevent destruct
-  sptr<Environment> _copy, _copytf, _cramp, _dnom;
-  sptr<Environment> _num, _root, _sub, _sup;
+  // If only the dimensions of the boxes are needed, see TeXRenderBuilder#measure
+  bool _measuring{};
+  // If the rows can be broken after every atom, see \breakEverywhere
+  bool _breakEverywhere{};
+  // Set to true once the text width is read, nullptr if not tracked, see #trackTextWidth
+  bool* _textWidthUsed{};
+  // The boxes kept from the previous layouts, nullptr if none, see LayoutCache
+  LayoutCache* _layoutCache{};
+  // The boxes of the render laid out so far, nullptr if none, see BoxMemo
+  BoxMemo* _boxMemo{};
 
   inline void init() {
     _style = TexStyle::display;
     _lastFontId = TeXFont::NO_FONT;
     _textWidth = POS_INF;
+    _textStyle = internTextStyle("");
     _smallCap = false;
     _scaleFactor = 1.f;
     _interlineUnit = UnitType::em;
     _interline = 0;
+    _measuring = false;
+    _breakEverywhere = false;
+    _textWidthUsed = nullptr;
+    _layoutCache = nullptr;
+    _boxMemo = nullptr;
   }
 
-  Environment(
-    TexStyle style, float scaleFactor,
-    const sptr<TeXFont>& tf,
-    const std::string& textstyle, bool smallCap  //
-  ) {
-    init();
-    _style = style;
-    _scaleFactor = scaleFactor;
-    _tf = tf;
-    _textStyle = textstyle;
-    _smallCap = smallCap;
-    setInterline(UnitType::ex, 1.f);
-  }
+  /**
+   * Copy this environment in the given style, the last used font, the text width and the
+   * inter-line space are reset
+   */
+  Environment derive(TexStyle style) const;
 
 public:
-  Environment(TexStyle style, const sptr<TeXFont>& tf) {
+  /** Create an environment with the given font, the font must outlive it and its copies */
+  Environment(TexStyle style, TeXFont& tf) {
     init();
     _style = style;
-    _tf = tf;
+    _tf = &tf;
     setInterline(UnitType::ex, 1.f);
   }
 
-  Environment(TexStyle style, const sptr<TeXFont>& tf, UnitType widthUnit, float textWidth);
+  Environment(TexStyle style, TeXFont& tf, UnitType widthUnit, float textWidth);
+
+  /**
+   * Get the interned copy of the given text style, equal text styles have the same copy so they
+   * are compared by address. It lives as long as the program.
+   */
+  static const std::string* internTextStyle(const std::string& style);
 
   inline void setInterline(UnitType unit, float len) {
     _interline = len;
@@ -112,45 +163,71 @@ public:
 
   void setTextWidth(UnitType widthUnit, float width);
 
-  inline float getTextWidth() const { return _textWidth; }
+  inline float getTextWidth() const {
+    if (_textWidthUsed != nullptr) *_textWidthUsed = true;
+    return _textWidth;
+  }
+
+  /**
+   * Track if the layout depends on the text width: the given flag is set to true once the
+   * text width is read from this environment or from its copies (nullptr to stop)
+   */
+  inline void trackTextWidth(bool* used) { _textWidthUsed = used; }
+
+  /** Test if the text width was read, true if it is not tracked */
+  inline bool isTextWidthUsed() const { return _textWidthUsed == nullptr || *_textWidthUsed; }
+
+  /**
+   * Get the boxes kept from the previous layouts of the document, shared by the copies of this
+   * environment, nullptr if none
+   */
+  inline LayoutCache* getLayoutCache() const { return _layoutCache; }
+
+  inline void setLayoutCache(LayoutCache* cache) { _layoutCache = cache; }
+
+  /** Get the boxes of the render laid out so far, shared by the copies, nullptr if none */
+  inline BoxMemo* getBoxMemo() const { return _boxMemo; }
+
+  inline void setBoxMemo(BoxMemo* memo) { _boxMemo = memo; }
 
   inline void setScaleFactor(float f) { _scaleFactor = f; }
 
   inline float getScaleFactor() const { return _scaleFactor; }
 
-  sptr<Environment>& copy();
+  Environment copy() const;
 
-  sptr<Environment>& copy(const sptr<TeXFont>& tf);
+  /** Copy of this environment with the given font, owned by the copy and its copies */
+  Environment copy(const sptr<TeXFont>& tf) const;
 
   /**
    * Copy of this envrionment in cramped style.
    */
-  sptr<Environment>& crampStyle();
+  Environment crampStyle() const;
 
   /**
    * Style to display denominator.
    */
-  sptr<Environment>& dnomStyle();
+  Environment dnomStyle() const;
 
   /**
    * Style to display numerator.
    */
-  sptr<Environment>& numStyle();
+  Environment numStyle() const;
 
   /**
    * Style to display roots.
    */
-  sptr<Environment>& rootStyle();
+  Environment rootStyle() const;
 
   /**
    * Style to display subscripts.
    */
-  sptr<Environment>& subStyle();
+  Environment subStyle() const;
 
   /**
    * Style to display superscripts.
    */
-  sptr<Environment>& supStyle();
+  Environment supStyle() const;
 
   inline float getSize() const { return _tf->getSize(); }
 
@@ -158,15 +235,33 @@ public:
 
   inline void setStyle(TexStyle style) { _style = style; }
 
-  inline const std::string& getTextStyle() const { return _textStyle; }
+  inline const std::string& getTextStyle() const { return *_textStyle; }
+
+  inline void setTextStyle(const std::string& style) { _textStyle = internTextStyle(style); }
 
-  inline void setTextStyle(const std::string& style) { _textStyle = style; }
+  /** Get the interned text style, see #internTextStyle */
+  inline const std::string* getTextStyleId() const { return _textStyle; }
+
+  inline void setTextStyleId(const std::string* style) { _textStyle = style; }
 
   inline bool getSmallCap() const { return _smallCap; }
 
   inline void setSmallCap(bool s) { _smallCap = s; }
 
-  inline const sptr<TeXFont>& getTeXFont() const { return _tf; }
+  inline TeXFont* getTeXFont() const { return _tf; }
+
+  /**
+   * If the boxes are only measured, the atoms may then create boxes that have the right
+   * dimensions but draw nothing, instead of the boxes that hold costly drawing data
+   */
+  inline bool isMeasuring() const { return _measuring; }
+
+  inline void setMeasuring(bool measuring) { _measuring = measuring; }
+
+  /** If the rows can be broken after every atom rather than after the relations and operators */
+  inline bool isBreakEverywhere() const { return _breakEverywhere; }
+
+  inline void setBreakEverywhere(bool breakEverywhere) { _breakEverywhere = breakEverywhere; }
 
   inline float getSpace() const { return _tf->getSpace(_style) * _tf->getScaleFactor(); }
 
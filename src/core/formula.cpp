@@ -1,5 +1,7 @@
 #include "core/formula.h"
 
+#include <mutex>
+
 #include "common.h"
 #include "core/core.h"
 #include "core/parser.h"
@@ -10,10 +12,13 @@
 using namespace std;
 using namespace tex;
 
-map<wstring, sptr<Formula>> Formula::_predefinedTeXFormulas;
+map<wstring, sptr<Atom>> Formula::_predefinedTeXFormulas;
 
 map<UnicodeBlock, FontInfos*> Formula::_externalFontMap;
 
+// guards the external fonts, they may be filled while rendering
+static mutex _cacheMutex;
+
 float Formula::PIXELS_PER_POINT = 1.f;
 
 void Formula::_init_() {
@@ -23,6 +28,10 @@ void Formula::_init_() {
   // Register external alphabet
   DefaultTeXFont::registerAlphabet(new CyrillicRegistration());
   DefaultTeXFont::registerAlphabet(new GreekRegistration());
+  DefaultTeXFont::loadRegisteredAlphabets();
+  // all the symbol mappings are loaded, resolve the symbols to dense ids
+  DefaultTeXFont::buildSymbolTable();
+  SymbolAtom::resolveSymbolIds();
 #ifdef HAVE_LOG
   __log << "elements in _symbolMappings:" << endl;
   for (auto i : _symbolMappings)
@@ -38,48 +47,51 @@ void Formula::_init_() {
 
 Formula::Formula(
   const TeXParser& tp,
-  const wstring& latex,
+  const TeXSource& latex,
   const string& textStyle,
   bool preprocess, bool isMathMode
-) : _parser(tp.isPartial(), latex, this, preprocess, isMathMode) {
+) : _parser(tp, latex, this, preprocess, isMathMode) {
   _textStyle = textStyle;
   _xmlMap = tp._formula->_xmlMap;
+  _ignoreLatinFont = tp._formula->_ignoreLatinFont;
   if (tp.isPartial()) {
     try {
-      _parser.parse();
+      _parser.parseOrReuse();
     } catch (exception& e) {
       if (_root == nullptr) _root = sptrOf<EmptyAtom>();
     }
   } else {
-    _parser.parse();
+    _parser.parseOrReuse();
   }
 }
 
-Formula::Formula(const TeXParser& tp, const wstring& latex, bool preprocess)
-  : _parser(tp.isPartial(), latex, this, preprocess) {
+Formula::Formula(const TeXParser& tp, const TeXSource& latex, bool preprocess)
+  : _parser(tp, latex, this, preprocess, true) {
   _textStyle = "";
   _xmlMap = tp._formula->_xmlMap;
+  _ignoreLatinFont = tp._formula->_ignoreLatinFont;
   if (tp.isPartial()) {
     try {
-      _parser.parse();
+      _parser.parseOrReuse();
     } catch (exception& e) {}
   } else {
-    _parser.parse();
+    _parser.parseOrReuse();
   }
 }
 
-Formula::Formula(const TeXParser& tp, const wstring& latex)
-  : _parser(tp.isPartial(), latex, this) {
+Formula::Formula(const TeXParser& tp, const TeXSource& latex)
+  : _parser(tp, latex, this, true, true) {
   _textStyle = "";
   _xmlMap = tp._formula->_xmlMap;
+  _ignoreLatinFont = tp._formula->_ignoreLatinFont;
   if (tp.isPartial()) {
     try {
-      _parser.parse();
+      _parser.parseOrReuse();
     } catch (exception& e) {
       if (_root == nullptr) _root = sptrOf<EmptyAtom>();
     }
   } else {
-    _parser.parse();
+    _parser.parseOrReuse();
   }
 }
 
@@ -105,11 +117,13 @@ Formula* Formula::add(const sptr<Atom>& a) {
   auto atom = dynamic_pointer_cast<MiddleAtom>(a);
   if (atom != nullptr) _middle.push_back(atom);
   if (_root == nullptr) {
-    _root = a;
+    auto* ra = dynamic_cast<RowAtom*>(a.get());
+    // the elements of a shared row are shared, only the row is copied
+    _root = ra != nullptr && ra->isFrozen() ? sptrOf<RowAtom>(a) : a;
     return this;
   }
   auto* rm = dynamic_cast<RowAtom*>(_root.get());
-  if (rm == nullptr) _root = sptrOf<RowAtom>(_root);
+  if (rm == nullptr || rm->isFrozen()) _root = sptrOf<RowAtom>(_root);
   rm = static_cast<RowAtom*>(_root.get());
   rm->add(a);
   auto* ta = dynamic_cast<TypedAtom*>(a.get());
@@ -131,20 +145,32 @@ void Formula::setDEBUG(bool b) {
   Box::DEBUG = b;
 }
 
-sptr<Formula> Formula::get(const wstring& name) {
+static sptr<Atom> parsePredefined(const wstring& latex) {
+  auto root = Formula(latex)._root;
+  auto* ra = dynamic_cast<RowAtom*>(root.get());
+  if (ra != nullptr) ra->freeze();
+  return root;
+}
+
+sptr<Atom> Formula::get(const wstring& name) {
   auto it = _predefinedTeXFormulas.find(name);
-  if (it == _predefinedTeXFormulas.end()) {
-    auto i = _predefinedTeXFormulasAsString.find(name);
-    if (i == _predefinedTeXFormulasAsString.end())
-      throw ex_formula_not_found(wide2utf8(name));
-    auto tf = sptrOf<Formula>(i->second);
-    auto* ra = dynamic_cast<RowAtom*>(tf->_root.get());
-    if (ra == nullptr) {
-      _predefinedTeXFormulas[name] = tf;
+  if (it != _predefinedTeXFormulas.end()) return it->second;
+  auto i = _predefinedTeXFormulasAsString.find(name);
+  if (i == _predefinedTeXFormulasAsString.end())
+    throw ex_formula_not_found(wide2utf8(name));
+  // the table is being built, or the formula could not be parsed when building it
+  return parsePredefined(i->second);
+}
+
+void Formula::buildPredefinedFormulas() {
+  for (const auto& i : _predefinedTeXFormulasAsString) {
+    if (_predefinedTeXFormulas.find(i.first) != _predefinedTeXFormulas.end()) continue;
+    try {
+      _predefinedTeXFormulas[i.first] = parsePredefined(i.second);
+    } catch (ex_tex&) {
+      // parsed on every use
     }
-    return tf;
   }
-  return it->second;
 }
 
 void Formula::setDPITarget(float dpi) {
@@ -152,10 +178,18 @@ void Formula::setDPITarget(float dpi) {
 }
 
 bool Formula::isRegisteredBlock(const UnicodeBlock& block) {
+  lock_guard<mutex> lock(_cacheMutex);
   return _externalFontMap.find(block) != _externalFontMap.end();
 }
 
+FontInfos* Formula::findExternalFont(const UnicodeBlock& block) {
+  lock_guard<mutex> lock(_cacheMutex);
+  auto it = _externalFontMap.find(block);
+  return it == _externalFontMap.end() ? nullptr : it->second;
+}
+
 FontInfos* Formula::getExternalFont(const UnicodeBlock& block) {
+  lock_guard<mutex> lock(_cacheMutex);
   auto it = _externalFontMap.find(block);
   FontInfos* infos = nullptr;
   if (it == _externalFontMap.end()) {
@@ -174,6 +208,7 @@ void Formula::addSymbolMappings(const string& file) {
 }
 
 void Formula::_free_() {
+  _predefinedTeXFormulas.clear();
   for (auto i : _externalFontMap) delete i.second;
 }
 
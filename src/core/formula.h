@@ -55,8 +55,8 @@ public:
   // point-to-pixel conversion
   static float PIXELS_PER_POINT;
 
-  // predefined TeX formulas
-  static std::map<std::wstring, sptr<Formula>> _predefinedTeXFormulas;
+  // predefined TeX formulas, parsed once by #buildPredefinedFormulas and shared
+  static std::map<std::wstring, sptr<Atom>> _predefinedTeXFormulas;
   static std::map<std::wstring, std::wstring> _predefinedTeXFormulasAsString;
 
   // character-to-symbol and character-to-delimiter mappings
@@ -70,6 +70,8 @@ public:
   sptr<Atom> _root;
   // the current text style
   std::string _textStyle;
+  // whether to ignore the external font registered for the basic latin block
+  bool _ignoreLatinFont = false;
 
   /**
    * Creates a new Formula by parsing the given string (using a primitive
@@ -80,12 +82,12 @@ public:
    *
    * @throw ex_parse if the string could not be parsed correctly
    */
-  Formula(const TeXParser& tp, const std::wstring& latex);
+  Formula(const TeXParser& tp, const TeXSource& latex);
 
-  Formula(const TeXParser& tp, const std::wstring& latex, bool preprocess);
+  Formula(const TeXParser& tp, const TeXSource& latex, bool preprocess);
 
   Formula(
-    const TeXParser& tp, const std::wstring& latex,
+    const TeXParser& tp, const TeXSource& latex,
     const std::string& textStyle, bool preprocess,
     bool isMathMode
   );
@@ -112,6 +114,12 @@ public:
    */
   void setLaTeX(const std::wstring& latex);
 
+  /** Keep the parsed groups in the given memo to reuse them, see ParseMemo */
+  inline void setMemo(ParseMemo* memo) { _parser.setMemo(memo); }
+
+  /** Get the definitions and the settings made by this formula */
+  inline const MacroScope& getMacroScope() const { return _parser.getMacroScope(); }
+
   /** Inserts an a at the end of the current formula. */
   Formula* add(const sptr<Atom>& a);
 
@@ -122,15 +130,22 @@ public:
   virtual bool isArrayMode() const { return false; }
 
   /**
-   * Get a predefined Formula.
+   * Get the atom tree of a predefined Formula.
    *
    * @param name the name of the predefined Formula
-   * @return a <b>copy</b> of the predefined Formula
+   * @return the atom tree of the predefined Formula, it is shared by all the
+   * formulas using it and must not be changed
    *
    * @throw ex_formula_not_found
    *      if no predefined Formula is found with the given name
    */
-  static sptr<Formula> get(const std::wstring& name);
+  static sptr<Atom> get(const std::wstring& name);
+
+  /**
+   * Parse all the predefined formulas, the table is read-only afterwards. It
+   * must be called once all the commands and symbols are loaded.
+   */
+  static void buildPredefinedFormulas();
 
   /**
    * Set the DPI of target
@@ -142,8 +157,12 @@ public:
   /** Check if the given unicode-block is registered. */
   static bool isRegisteredBlock(const UnicodeBlock& block);
 
+  /** Get the external font of the given unicode-block, register a default one if absent. */
   static FontInfos* getExternalFont(const UnicodeBlock& block);
 
+  /** Find the external font of the given unicode-block, return nullptr if absent. */
+  static FontInfos* findExternalFont(const UnicodeBlock& block);
+
   static void addSymbolMappings(const std::string& file);
 
   /** Enable or disable debug mode. */
@@ -1,6 +1,9 @@
 #include "core/macro.h"
 #include "common.h"
+#include "core/command_table.h"
 #include "core/macro_impl.h"
+#include "core/parser.h"
+#include "render.h"
 
 #include <string>
 
@@ -32,8 +35,8 @@ void NewCommandMacro::checkRenew(const wstring& name) {
 
 void NewCommandMacro::addNewCommand(const wstring& name, const wstring& code, int argc) {
   checkNew(name);
-  _codes[name] = code;
   MacroInfo::add(name, new InflationMacroInfo(_instance, argc));
+  _codes[name] = MacroBody(code);
 }
 
 void NewCommandMacro::addNewCommand(
@@ -43,15 +46,15 @@ void NewCommandMacro::addNewCommand(
   const wstring& def
 ) {
   checkNew(name);
-  _codes[name] = code;
-  _replacements[name] = def;
   MacroInfo::add(name, new InflationMacroInfo(_instance, argc, 1));
+  _codes[name] = MacroBody(code);
+  _replacements[name] = def;
 }
 
 void NewCommandMacro::addRenewCommand(const wstring& name, const wstring& code, int argc) {
   checkRenew(name);
-  _codes[name] = code;
   MacroInfo::add(name, new InflationMacroInfo(_instance, argc));
+  _codes[name] = MacroBody(code);
 }
 
 void NewCommandMacro::addRenewCommand(
@@ -61,18 +64,40 @@ void NewCommandMacro::addRenewCommand(
   const wstring& def
 ) {
   checkRenew(name);
-  _codes[name] = code;
-  _replacements[name] = def;
   MacroInfo::add(name, new InflationMacroInfo(_instance, argc, 1));
+  _codes[name] = MacroBody(code);
+  _replacements[name] = def;
+}
+
+MacroBody::MacroBody(const wstring& code) : _code(code) {
+  size_t start = 0;
+  for (size_t i = 0; i + 1 < code.length(); i++) {
+    const wchar_t c = code[i + 1];
+    if (code[i] != L'#' || c < L'1' || c > L'9') continue;
+    if (i > start) _pieces.push_back({start, i - start, 0});
+    _pieces.push_back({i, 2, c - L'0'});
+    start = ++i + 1;
+  }
+  if (start < code.length()) _pieces.push_back({start, code.length() - start, 0});
+}
+
+void MacroBody::expand(const vector<const wstring*>& params, wstring& out) const {
+  for (const auto& p : _pieces) {
+    const wstring* v = p.param > 0 && (size_t) p.param <= params.size() ? params[p.param - 1] : nullptr;
+    if (v != nullptr) out.append(*v);
+    else out.append(_code, p.start, p.len);
+  }
 }
 
 void NewCommandMacro::execute(TeXParser& tp, vector<wstring>& args) {
-  wstring code = _codes[args[0]];
-  wstring rep;
+  const MacroScope& scope = tp.getMacroScope();
+  const MacroBody* body = scope.getCode(args[0]);
   size_t argc = args.size() - 12;
-  int dec = 0;
+  // the parameters are substituted in one pass, the text of an argument is copied as is
+  vector<const wstring*> params;
+  params.reserve(argc + 1);
 
-  auto it = _replacements.find(args[0]);
+  const wstring* def = scope.getReplacement(args[0]);
 
   // FIXME
   // Keep slash "\" and dollar "$" signs?
@@ -80,21 +105,17 @@ void NewCommandMacro::execute(TeXParser& tp, vector<wstring>& args) {
   //      \newcommand{\cmd}[2][\sqrt{e^x}]{ #2 - #1 }
   // we want the optional argument "\sqrt{e^x}" keep the slash sign
   if (!args[argc + 1].empty()) {
-    dec = 1;
-    // quotereplace(args[argc + 1], rep);
-    replaceall(code, L"#1", args[argc + 1]);
-  } else if (it != _replacements.end()) {
-    dec = 1;
-    // quotereplace(it->second, rep);
-    replaceall(code, L"#1", it->second);
+    params.push_back(&args[argc + 1]);
+  } else if (def != nullptr) {
+    params.push_back(def);
   }
 
-  for (int i = 1; i <= argc; i++) {
-    rep = args[i];
-    replaceall(code, L"#" + towstring(i + dec), rep);
-  }
+  for (size_t i = 1; i <= argc; i++) params.push_back(&args[i]);
+
+  wstring code;
+  if (body != nullptr) body->expand(params, code);
   // push back as returned value (inflated macro)
-  args.push_back(code);
+  args.push_back(std::move(code));
 }
 
 void NewEnvironmentMacro::addNewEnvironment(
@@ -125,11 +146,177 @@ void NewEnvironmentMacro::addRenewEnvironment(
   );
 }
 
+/**************************************** MacroScope *********************************************/
+
+MacroScope::MacroScope()
+  : _cornerMultiplier(OvalAtom::_multiplier),
+    _cornerDiameter(OvalAtom::_diameter),
+    _ruleColor(MatrixAtom::LINE_COLOR),
+    _breakEverywhere(RowAtom::_breakEveywhere),
+    _textFactor(0),
+    _scriptFactor(0),
+    _scriptScriptFactor(0),
+    _magFactor(TeXRender::_magFactor),
+    _errIfConflict(NewCommandMacro::_errIfConflict) {}
+
+MacroInfo* MacroScope::get(const wstring& name) const {
+  auto it = _commands.find(name);
+  if (it != _commands.end()) return it->second.get();
+  return MacroInfo::get(name);
+}
+
+MacroInfo* MacroScope::getDefined(const wstring& name) const {
+  if (_commands.empty()) return nullptr;
+  auto it = _commands.find(name);
+  return it == _commands.end() ? nullptr : it->second.get();
+}
+
+bool MacroScope::isMacro(const wstring& name) const {
+  return _codes.find(name) != _codes.end() || NewCommandMacro::isMacro(name);
+}
+
+bool MacroScope::isDefault() const {
+  return _codes.empty()
+         && _replacements.empty()
+         && _commands.empty()
+         && _colors.empty()
+         && _columnTypes.empty()
+         && _cornerMultiplier == OvalAtom::_multiplier
+         && _cornerDiameter == OvalAtom::_diameter
+         && _ruleColor == MatrixAtom::LINE_COLOR
+         && _magFactor == TeXRender::_magFactor
+         && isDefaultLayout()
+         && _errIfConflict == NewCommandMacro::_errIfConflict;
+}
+
+bool MacroScope::isDefaultLayout() const {
+  return _breakEverywhere == RowAtom::_breakEveywhere && _textFactor == 0;
+}
+
+const MacroBody* MacroScope::getCode(const wstring& name) const {
+  auto it = _codes.find(name);
+  if (it != _codes.end()) return &it->second;
+  auto bit = NewCommandMacro::_codes.find(name);
+  if (bit != NewCommandMacro::_codes.end()) return &bit->second;
+  return nullptr;
+}
+
+const wstring* MacroScope::getReplacement(const wstring& name) const {
+  // a redefinition in this scope hides the replacement of the predefined one
+  if (_codes.find(name) != _codes.end()) {
+    auto it = _replacements.find(name);
+    return it == _replacements.end() ? nullptr : &it->second;
+  }
+  auto it = NewCommandMacro::_replacements.find(name);
+  return it == NewCommandMacro::_replacements.end() ? nullptr : &it->second;
+}
+
+void MacroScope::checkNew(const wstring& name) const {
+  if (_errIfConflict && isMacro(name))
+    throw ex_parse(
+      "Command " + wide2utf8(name)
+      + " already exists! Use renewcommand instead!"
+    );
+}
+
+void MacroScope::checkRenew(const wstring& name) const {
+  if (_errIfConflict && !isMacro(name))
+    throw ex_parse(
+      "Command " + wide2utf8(name)
+      + " is no defined! Use newcommand instead!"
+    );
+}
+
+void MacroScope::define(const wstring& name, const wstring& code, int argc, int posOpts) {
+  _codes[name] = MacroBody(code);
+  _replacements.erase(name);
+  _commands[name] = sptrOf<InflationMacroInfo>(NewCommandMacro::_instance, argc, posOpts);
+}
+
+void MacroScope::addNewCommand(const wstring& name, const wstring& code, int argc) {
+  checkNew(name);
+  define(name, code, argc, 0);
+}
+
+void MacroScope::addNewCommand(
+  const wstring& name,
+  const wstring& code,
+  int argc,
+  const wstring& def
+) {
+  checkNew(name);
+  define(name, code, argc, 1);
+  _replacements[name] = def;
+}
+
+void MacroScope::addRenewCommand(const wstring& name, const wstring& code, int argc) {
+  checkRenew(name);
+  define(name, code, argc, 0);
+}
+
+void MacroScope::addRenewCommand(
+  const wstring& name,
+  const wstring& code,
+  int argc,
+  const wstring& def
+) {
+  checkRenew(name);
+  define(name, code, argc, 1);
+  _replacements[name] = def;
+}
+
+void MacroScope::addNewEnvironment(
+  const wstring& name,
+  const wstring& begDef, const wstring& endDef,
+  int argc
+) {
+  wstring def = begDef + L" #" + towstring(argc + 1) + L" " + endDef;
+  addNewCommand(name + L"@env", def, argc + 1);
+}
+
+void MacroScope::addRenewEnvironment(
+  const wstring& name,
+  const wstring& begDef, const wstring& endDef,
+  int argc
+) {
+  if (!isMacro(name + L"@env")) {
+    throw ex_parse(
+      "Environment " + wide2utf8(name)
+      + "is not defined! Use newenvironment instead!"
+    );
+  }
+  addRenewCommand(
+    name + L"@env",
+    begDef + L" #" + towstring(argc + 1) + L" " + endDef,
+    argc + 1
+  );
+}
+
+void MacroScope::defineColor(const string& name, color c) {
+  string n = name;
+  trim(n);
+  _colors[tolower(n)] = c;
+}
+
+color MacroScope::getColor(const string& name) const {
+  if (!_colors.empty()) {
+    string n = name;
+    trim(n);
+    auto it = _colors.find(tolower(n));
+    if (it != _colors.end()) return it->second;
+  }
+  return ColorAtom::getColor(name);
+}
+
 void NewCommandMacro::_free_() {
   delete _instance;
 }
 
 void MacroInfo::add(const wstring& name, MacroInfo* mac) {
+  if (CommandTable::isBuilt()) {
+    delete mac;
+    throw ex_invalid_state("Cannot add the macro " + wide2utf8(name) + " after LaTeX::init!");
+  }
   auto it = _commands.find(name);
   if (it != _commands.end()) delete it->second;
   _commands[name] = mac;
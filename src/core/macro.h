@@ -3,6 +3,7 @@
 
 #include "atom/atom.h"
 #include "common.h"
+#include "graphic/graphic_basic.h"
 
 #include <map>
 #include <string>
@@ -18,9 +19,48 @@ public:
   virtual ~Macro() = default;
 };
 
+class MacroScope;
+
+/**
+ * The replacement text of a command defined by \newcommand, split into literal parts and
+ * parameters (#1 to #9) when the command is defined, so expanding it only copies the parts
+ * instead of searching the text once for every argument.
+ */
+class MacroBody {
+private:
+  struct Piece {
+    // range of the literal in the code, or the parameter number if param > 0
+    size_t start, len;
+    int param;
+  };
+
+  std::wstring _code;
+  std::vector<Piece> _pieces;
+
+public:
+  MacroBody() = default;
+
+  explicit MacroBody(const std::wstring& code);
+
+  inline const std::wstring& code() const { return _code; }
+
+  /**
+   * Append the expansion to the given string, the parameter #i is replaced by params[i - 1],
+   * it is kept as is if params[i - 1] is nullptr or out of range.
+   */
+  void expand(const std::vector<const std::wstring*>& params, std::wstring& out) const;
+};
+
+/**
+ * The commands and environments defined by NewCommandMacro::_init_ are shared
+ * by all the documents and read-only after the initialization, the ones
+ * defined by a document are kept in its MacroScope.
+ */
 class NewCommandMacro : public Macro {
+  friend class MacroScope;
+
 protected:
-  static std::map<std::wstring, std::wstring> _codes;
+  static std::map<std::wstring, MacroBody> _codes;
   static std::map<std::wstring, std::wstring> _replacements;
   static Macro* _instance;
 
@@ -90,11 +130,127 @@ public:
   );
 };
 
+class MacroInfo;
+
+/**
+ * The definitions made by a document (with \newcommand, \definecolor, ...),
+ * layered over the predefined tables which are read-only after the
+ * initialization. A parser and the parsers of its nested formulas share one
+ * scope, so the definitions of a document never leak into another one, and
+ * documents can be parsed concurrently without locking.
+ */
+class MacroScope {
+private:
+  std::map<std::wstring, MacroBody> _codes;
+  std::map<std::wstring, std::wstring> _replacements;
+  std::map<std::wstring, sptr<MacroInfo>> _commands;
+
+  void checkNew(const std::wstring& name) const;
+
+  void checkRenew(const std::wstring& name) const;
+
+  void define(const std::wstring& name, const std::wstring& code, int argc, int posOpts);
+
+public:
+  // colors defined by \definecolor
+  std::map<std::string, color> _colors;
+  // column types defined by \newcolumntype
+  std::map<std::wstring, std::wstring> _columnTypes;
+  // corner size of the oval boxes, changed by \cornersize
+  float _cornerMultiplier, _cornerDiameter;
+  // color of the rules of the arrays, changed by \arrayrulecolor
+  color _ruleColor;
+  // if the rows can be broken after every atom, changed by \breakEverywhere
+  bool _breakEverywhere;
+  // size factors of the text, script and script-script styles, changed by \DeclareMathSizes,
+  // 0 for the ones of the fonts
+  float _textFactor, _scriptFactor, _scriptScriptFactor;
+  // magnification factor of the render, 0 if none, changed by \magnification
+  float _magFactor;
+  // see NewCommandMacro#_errIfConflict
+  bool _errIfConflict;
+
+  MacroScope();
+
+  /** Get the macro info from given name, return nullptr if not found. */
+  MacroInfo* get(const std::wstring& name) const;
+
+  /**
+   * Get the macro info defined by the document from given name, return nullptr if the
+   * document does not define it.
+   */
+  MacroInfo* getDefined(const std::wstring& name) const;
+
+  /** Test if the given name is a command or environment defined by \newcommand. */
+  bool isMacro(const std::wstring& name) const;
+
+  /**
+   * Test if the document defined nothing so far, a part of it is then parsed the same
+   * wherever it is, see ParseMemo
+   */
+  bool isDefault() const;
+
+  /**
+   * Test if the atoms of the document are laid out with the default settings, see
+   * \breakEverywhere and \DeclareMathSizes
+   */
+  bool isDefaultLayout() const;
+
+  /** Get the code of the given user-defined command, return nullptr if not found. */
+  const MacroBody* getCode(const std::wstring& name) const;
+
+  /** Get the default value of the optional argument, return nullptr if not found. */
+  const std::wstring* getReplacement(const std::wstring& name) const;
+
+  void addNewCommand(const std::wstring& name, const std::wstring& code, int argc);
+
+  void addNewCommand(
+    const std::wstring& name,
+    const std::wstring& code,
+    int argc,
+    const std::wstring& def
+  );
+
+  void addRenewCommand(const std::wstring& name, const std::wstring& code, int argc);
+
+  void addRenewCommand(
+    const std::wstring& name,
+    const std::wstring& code,
+    int argc,
+    const std::wstring& def
+  );
+
+  void addNewEnvironment(
+    const std::wstring& name,
+    const std::wstring& begDef,
+    const std::wstring& endDef,
+    int argc
+  );
+
+  void addRenewEnvironment(
+    const std::wstring& name,
+    const std::wstring& begDef,
+    const std::wstring& endDef,
+    int argc
+  );
+
+  /** Define a color in this scope, the name is case-insensitive. */
+  void defineColor(const std::string& name, color c);
+
+  /** Get the color from given name, the colors defined by the document come first. */
+  color getColor(const std::string& name) const;
+};
+
 class MacroInfo {
 public:
   static std::map<std::wstring, MacroInfo*> _commands;
 
-  /** Add a macro, replace it if the macro is exists. */
+  /**
+   * Add a macro, replace it if the macro is exists. The predefined macros are resolved through
+   * the CommandTable, so this is only possible before LaTeX::init builds it.
+   *
+   * @throw ex_invalid_state if called after LaTeX::init
+   */
   static void add(const std::wstring& name, MacroInfo* mac);
 
   /** Get the macro info from given name, return nullptr if not found. */
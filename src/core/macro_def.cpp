@@ -326,7 +326,7 @@ map<wstring, MacroInfo*> MacroInfo::_commands{
 #endif  // GRAPHICS_DEBUG
 };
 
-map<wstring, wstring> NewCommandMacro::_codes;
+map<wstring, MacroBody> NewCommandMacro::_codes;
 map<wstring, wstring> NewCommandMacro::_replacements;
 Macro* NewCommandMacro::_instance = new NewCommandMacro();
 
@@ -174,16 +174,11 @@ macro(textstyles) {
   else if (style == L"bold") return sptrOf<BoldAtom>(Formula(tp, args[1], false)._root);
   else if (style == L"cal") style = L"mathcal";
 
-  FontInfos* info = nullptr;
-  auto it = Formula::_externalFontMap.find(UnicodeBlock::BASIC_LATIN);
-  if (it != Formula::_externalFontMap.end()) {
-    info = it->second;
-    Formula::_externalFontMap[UnicodeBlock::BASIC_LATIN] = nullptr;
-  }
+  // the latin letters are drawn with the given style rather than the external font
+  const bool ignoreLatinFont = tp._formula->_ignoreLatinFont;
+  tp._formula->_ignoreLatinFont = true;
   auto atom = Formula(tp, args[1], false)._root;
-  if (info != nullptr) {
-    Formula::_externalFontMap[UnicodeBlock::BASIC_LATIN] = info;
-  }
+  tp._formula->_ignoreLatinFont = ignoreLatinFont;
 
   string s = wide2utf8(style);
   return sptrOf<TextStyleAtom>(atom, s);
@@ -287,9 +282,9 @@ macro(newcommand) {
   if (!args[3].empty()) valueof(args[3], nbArgs);
 
   if (args[4].empty()) {
-    NewCommandMacro::addNewCommand(newcmd.substr(1), args[2], nbArgs);
+    tp.getMacroScope().addNewCommand(newcmd.substr(1), args[2], nbArgs);
   } else {
-    NewCommandMacro::addNewCommand(newcmd.substr(1), args[2], nbArgs, args[4]);
+    tp.getMacroScope().addNewCommand(newcmd.substr(1), args[2], nbArgs, args[4]);
   }
 
   return nullptr;
@@ -304,9 +299,9 @@ macro(renewcommand) {
   if (!args[3].empty()) valueof(args[3], nbArgs);
 
   if (args[4].empty()) {
-    NewCommandMacro::addRenewCommand(newcmd.substr(1), args[2], nbArgs);
+    tp.getMacroScope().addRenewCommand(newcmd.substr(1), args[2], nbArgs);
   } else {
-    NewCommandMacro::addRenewCommand(newcmd.substr(1), args[2], nbArgs, args[4]);
+    tp.getMacroScope().addRenewCommand(newcmd.substr(1), args[2], nbArgs, args[4]);
   }
 
   return nullptr;
@@ -351,7 +346,7 @@ macro(definecolor) {
     throw ex_parse("Color model is incorrect!");
   }
 
-  ColorAtom::defineColor(wide2utf8(args[1]), c);
+  tp.getMacroScope().defineColor(wide2utf8(args[1]), c);
   return nullptr;
 }
 
@@ -34,12 +34,12 @@ inline macro(undebug) {
 #endif  // GRAPHICS_DEBUG
 
 inline macro(fatalIfCmdConflict) {
-  NewCommandMacro::_errIfConflict = args[1] == L"true";
+  tp.getMacroScope()._errIfConflict = args[1] == L"true";
   return nullptr;
 }
 
 inline macro(breakEverywhere) {
-  RowAtom::_breakEveywhere = args[1] == L"true";
+  tp.getMacroScope()._breakEverywhere = args[1] == L"true";
   return nullptr;
 }
 
@@ -62,7 +62,7 @@ inline macro(longdiv) {
 
 inline macro(cellcolor) {
   if (!tp.isArrayMode()) throw ex_parse("Command \\cellcolor must used in array environment!");
-  color c = ColorAtom::getColor(wide2utf8(args[1]));
+  color c = tp.getMacroScope().getColor(wide2utf8(args[1]));
   auto atom = sptrOf<CellColorAtom>(c);
   ((ArrayFormula*) tp._formula)->addCellSpecifier(atom);
   return nullptr;
@@ -73,31 +73,31 @@ inline macro(color) {
   // when parsing a LaTeX string, it is useless to specify a global foreground color again, but in
   // array mode, the \color command is useful to specify the foreground color of the columns.
   if (tp.isArrayMode()) {
-    color c = ColorAtom::getColor(wide2utf8(args[1]));
+    color c = tp.getMacroScope().getColor(wide2utf8(args[1]));
     return sptrOf<CellForegroundAtom>(c);
   }
   return nullptr;
 }
 
 inline macro(newcolumntype) {
-  MatrixAtom::defineColumnSpecifier(args[1], args[2]);
+  tp.getMacroScope()._columnTypes[args[1]] = args[2];
   return nullptr;
 }
 
 inline macro(arrayrulecolor) {
-  color c = ColorAtom::getColor(wide2utf8(args[1]));
-  MatrixAtom::LINE_COLOR = c;
+  auto& scope = tp.getMacroScope();
+  scope._ruleColor = scope.getColor(wide2utf8(args[1]));
   return nullptr;
 }
 
 inline macro(columnbg) {
-  color c = ColorAtom::getColor(wide2utf8(args[1]));
+  color c = tp.getMacroScope().getColor(wide2utf8(args[1]));
   return sptrOf<CellColorAtom>(c);
 }
 
 inline macro(rowcolor) {
   if (!tp.isArrayMode()) throw ex_parse("Command \\rowcolor must used in array environment!");
-  color c = ColorAtom::getColor(wide2utf8(args[1]));
+  color c = tp.getMacroScope().getColor(wide2utf8(args[1]));
   auto spe = sptrOf<CellColorAtom>(c);
   ((ArrayFormula*) tp._formula)->addRowSpecifier(spe);
   return nullptr;
@@ -502,7 +502,7 @@ inline macro(cr) {
     arr.add(tp._formula->_root);
     arr.addRow();
     TeXParser parser(
-      tp.isPartial(),
+      tp,
       tp.forwardBalancedGroup(),
       &arr,
       false,
@@ -522,18 +522,28 @@ inline macro(backslashcr) {
 
 inline macro(smallmatrixATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser parser(tp.isPartial(), args[1], arr, false);
+  TeXParser parser(tp, args[1], arr, false, true);
   parser.parse();
   arr->checkDimensions();
-  return sptrOf<MatrixAtom>(tp.isPartial(), sptr<ArrayFormula>(arr), MatrixType::smallMatrix);
+  return sptrOf<MatrixAtom>(
+    tp.isPartial(),
+    sptr<ArrayFormula>(arr),
+    MatrixType::smallMatrix,
+    tp.getMacroScope()._ruleColor
+  );
 }
 
 inline macro(matrixATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser parser(tp.isPartial(), args[1], arr, false);
+  TeXParser parser(tp, args[1], arr, false, true);
   parser.parse();
   arr->checkDimensions();
-  return sptrOf<MatrixAtom>(tp.isPartial(), sptr<ArrayFormula>(arr), MatrixType::matrix);
+  return sptrOf<MatrixAtom>(
+    tp.isPartial(),
+    sptr<ArrayFormula>(arr),
+    MatrixType::matrix,
+    tp.getMacroScope()._ruleColor
+  );
 }
 
 inline macro(multicolumn) {
@@ -559,51 +569,79 @@ inline macro(hdotsfor) {
 
 inline macro(arrayATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser parser(tp.isPartial(), args[2], arr, false);
+  TeXParser parser(tp, args[2], arr, false, true);
   parser.parse();
   arr->checkDimensions();
-  return sptrOf<MatrixAtom>(tp.isPartial(), sptr<ArrayFormula>(arr), args[1], true);
+  auto& scope = tp.getMacroScope();
+  return sptrOf<MatrixAtom>(
+    tp.isPartial(),
+    sptr<ArrayFormula>(arr),
+    args[1],
+    true,
+    &scope._columnTypes,
+    scope._ruleColor
+  );
 }
 
 inline macro(alignATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser parser(tp.isPartial(), args[1], arr, false);
+  TeXParser parser(tp, args[1], arr, false, true);
   parser.parse();
   arr->checkDimensions();
-  return sptrOf<MatrixAtom>(tp.isPartial(), sptr<ArrayFormula>(arr), MatrixType::align);
+  return sptrOf<MatrixAtom>(
+    tp.isPartial(),
+    sptr<ArrayFormula>(arr),
+    MatrixType::align,
+    tp.getMacroScope()._ruleColor
+  );
 }
 
 inline macro(flalignATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser parser(tp.isPartial(), args[1], arr, false);
+  TeXParser parser(tp, args[1], arr, false, true);
   parser.parse();
   arr->checkDimensions();
-  return sptrOf<MatrixAtom>(tp.isPartial(), sptr<ArrayFormula>(arr), MatrixType::flAlign);
+  return sptrOf<MatrixAtom>(
+    tp.isPartial(),
+    sptr<ArrayFormula>(arr),
+    MatrixType::flAlign,
+    tp.getMacroScope()._ruleColor
+  );
 }
 
 inline macro(alignatATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser par(tp.isPartial(), args[2], arr, false);
+  TeXParser par(tp, args[2], arr, false, true);
   par.parse();
   arr->checkDimensions();
   size_t n = 0;
   valueof(args[1], n);
   if (arr->cols() != 2 * n) throw ex_parse("Bad number of equations in alignat environment!");
 
-  return sptrOf<MatrixAtom>(tp.isPartial(), sptr<ArrayFormula>(arr), MatrixType::alignAt);
+  return sptrOf<MatrixAtom>(
+    tp.isPartial(),
+    sptr<ArrayFormula>(arr),
+    MatrixType::alignAt,
+    tp.getMacroScope()._ruleColor
+  );
 }
 
 inline macro(alignedATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser p(tp.isPartial(), args[1], arr, false);
+  TeXParser p(tp, args[1], arr, false, true);
   p.parse();
   arr->checkDimensions();
-  return sptrOf<MatrixAtom>(tp.isPartial(), sptr<ArrayFormula>(arr), MatrixType::aligned);
+  return sptrOf<MatrixAtom>(
+    tp.isPartial(),
+    sptr<ArrayFormula>(arr),
+    MatrixType::aligned,
+    tp.getMacroScope()._ruleColor
+  );
 }
 
 inline macro(alignedatATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser p(tp.isPartial(), args[2], arr, false);
+  TeXParser p(tp, args[2], arr, false, true);
   p.parse();
   arr->checkDimensions();
   size_t n = 0;
@@ -612,12 +650,17 @@ inline macro(alignedatATATenv) {
     throw ex_parse("Bad number of equations in alignedat environment!");
   }
 
-  return sptrOf<MatrixAtom>(tp.isPartial(), sptr<ArrayFormula>(arr), MatrixType::alignedAt);
+  return sptrOf<MatrixAtom>(
+    tp.isPartial(),
+    sptr<ArrayFormula>(arr),
+    MatrixType::alignedAt,
+    tp.getMacroScope()._ruleColor
+  );
 }
 
 inline macro(multlineATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser p(tp.isPartial(), args[1], arr, false);
+  TeXParser p(tp, args[1], arr, false, true);
   p.parse();
   arr->checkDimensions();
   if (arr->cols() > 1) {
@@ -630,7 +673,7 @@ inline macro(multlineATATenv) {
 
 inline macro(gatherATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser p(tp.isPartial(), args[1], arr, false);
+  TeXParser p(tp, args[1], arr, false, true);
   p.parse();
   arr->checkDimensions();
   if (arr->cols() > 1) throw ex_parse("Requires exact one column in gather envrionment!");
@@ -642,7 +685,7 @@ inline macro(gatherATATenv) {
 
 inline macro(gatheredATATenv) {
   auto* arr = new ArrayFormula();
-  TeXParser p(tp.isPartial(), args[1], arr, false);
+  TeXParser p(tp, args[1], arr, false, true);
   p.parse();
   arr->checkDimensions();
   if (arr->cols() > 1) throw ex_parse("Requires exact one column in gathered envrionment!");
@@ -652,13 +695,13 @@ inline macro(gatheredATATenv) {
 }
 
 inline macro(shoveright) {
-  auto a = Formula(tp, args[1])._root;
+  auto a = Formula(tp, args[1])._root->clone();
   a->_alignment = Alignment::right;
   return a;
 }
 
 inline macro(shoveleft) {
-  auto a = Formula(tp, args[1])._root;
+  auto a = Formula(tp, args[1])._root->clone();
   a->_alignment = Alignment::left;
   return a;
 }
@@ -677,7 +720,7 @@ inline macro(newenvironment) {
   int opt = 0;
   if (!args[4].empty()) valueof(args[4], opt);
 
-  NewEnvironmentMacro::addNewEnvironment(args[1], args[2], args[3], opt);
+  tp.getMacroScope().addNewEnvironment(args[1], args[2], args[3], opt);
   return nullptr;
 }
 
@@ -685,7 +728,7 @@ inline macro(renewenvironment) {
   int opt = 0;
   if (!args[4].empty()) valueof(args[4], opt);
 
-  NewEnvironmentMacro::addRenewEnvironment(args[1], args[2], args[3], opt);
+  tp.getMacroScope().addRenewEnvironment(args[1], args[2], args[3], opt);
   return nullptr;
 }
 
@@ -930,15 +973,18 @@ inline macro(shadowbox) {
 }
 
 inline macro(ovalbox) {
-  return sptrOf<OvalAtom>(Formula(tp, args[1])._root);
+  const MacroScope& scope = tp.getMacroScope();
+  return sptrOf<OvalAtom>(
+    Formula(tp, args[1])._root, scope._cornerMultiplier, scope._cornerDiameter);
 }
 
 inline macro(cornersize) {
   float size = 0.5f;
   valueof(args[1], size);
   if (size <= 0 || size > 0.5f) size = 0.5f;
-  OvalAtom::_multiplier = size;
-  OvalAtom::_diameter = 0;
+  MacroScope& scope = tp.getMacroScope();
+  scope._cornerMultiplier = size;
+  scope._cornerDiameter = 0;
   return nullptr;
 }
 
@@ -949,32 +995,32 @@ inline macro(doublebox) {
 inline macro(fgcolor) {
   auto a = Formula(tp, args[2])._root;
   std::string x = wide2utf8(args[1]);
-  return sptrOf<ColorAtom>(a, TRANSPARENT, ColorAtom::getColor(x));
+  return sptrOf<ColorAtom>(a, TRANSPARENT, tp.getMacroScope().getColor(x));
 }
 
 inline macro(bgcolor) {
   auto a = Formula(tp, args[2])._root;
   std::string x = wide2utf8(args[1]);
-  return sptrOf<ColorAtom>(a, ColorAtom::getColor(x), TRANSPARENT);
+  return sptrOf<ColorAtom>(a, tp.getMacroScope().getColor(x), TRANSPARENT);
 }
 
 inline macro(textcolor) {
   auto a = Formula(tp, args[2])._root;
   std::string x = wide2utf8(args[1]);
-  return sptrOf<ColorAtom>(a, TRANSPARENT, ColorAtom::getColor(x));
+  return sptrOf<ColorAtom>(a, TRANSPARENT, tp.getMacroScope().getColor(x));
 }
 
 inline macro(colorbox) {
   std::string x = wide2utf8(args[1]);
-  color c = ColorAtom::getColor(x);
+  color c = tp.getMacroScope().getColor(x);
   return sptrOf<FBoxAtom>(Formula(tp, args[2])._root, c, c);
 }
 
 inline macro(fcolorbox) {
   std::string x = wide2utf8(args[2]);
-  color f = ColorAtom::getColor(x);
+  color f = tp.getMacroScope().getColor(x);
   std::string y = wide2utf8(args[1]);
-  color b = ColorAtom::getColor(y);
+  color b = tp.getMacroScope().getColor(y);
   return sptrOf<FBoxAtom>(Formula(tp, args[3])._root, f, b);
 }
 
@@ -1018,19 +1064,25 @@ inline macro(textitbf) {
 inline macro(declaremathsizes) {
   float a, b, c, d;
   valueof(args[1], a), valueof(args[2], b), valueof(args[3], c), valueof(args[4], d);
-  DefaultTeXFont::setMathSizes(a, b, c, c);
+  if (!DefaultTeXFont::isMagnificationEnabled()) return nullptr;
+  // the sizes apply to the current formula only, see DefaultTeXFont#setMathSizes
+  auto& scope = tp.getMacroScope();
+  scope._textFactor = std::abs(b / a);
+  scope._scriptFactor = std::abs(c / a);
+  scope._scriptScriptFactor = std::abs(c / a);
   return nullptr;
 }
 
 inline macro(magnification) {
   float x;
   valueof(args[1], x);
-  DefaultTeXFont::setMagnification(x);
+  if (DefaultTeXFont::isMagnificationEnabled()) tp.getMacroScope()._magFactor = x / 1000.f;
   return nullptr;
 }
 
 inline macro(hline) {
-  if (!tp.isArrayMode())
+  // the groups in the cells are parsed in formulas that are not arrays
+  if (!tp.isArrayMode() || !tp._formula->isArrayMode())
     throw ex_parse("The macro \\hline only available in array mode!");
   return sptrOf<HlineAtom>();
 }
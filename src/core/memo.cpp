@@ -0,0 +1,123 @@
+#include "core/memo.h"
+
+#include "box/box_single.h"
+#include "core/core.h"
+
+using namespace std;
+using namespace tex;
+
+ParseMemo::Entry& ParseMemo::get(wstring&& key) {
+  Entry& entry = _entries[std::move(key)];
+  entry.lastUse = _parses;
+  return entry;
+}
+
+void ParseMemo::sweep() {
+  for (auto it = _entries.begin(); it != _entries.end();) {
+    if (_parses - it->second.lastUse >= MAX_AGE) it = _entries.erase(it);
+    else ++it;
+  }
+  _parses++;
+}
+
+void ParseMemo::clear() {
+  _entries.clear();
+}
+
+bool LayoutCache::Key::operator==(const Key& k) const {
+  return id == k.id
+         && size == k.size
+         && scaleFactor == k.scaleFactor
+         && fontScale == k.fontScale
+         && textWidth == k.textWidth
+         && interline == k.interline
+         && lastFontId == k.lastFontId
+         && style == k.style
+         && interlineUnit == k.interlineUnit
+         && previous == k.previous
+         && flags == k.flags
+         && textStyle == k.textStyle;
+}
+
+size_t LayoutCache::Key::Hash::operator()(const Key& k) const {
+  size_t h = k.id;
+  const auto mix = [&h](size_t v) { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+  mix(hash<float>()(k.size));
+  mix(hash<float>()(k.scaleFactor));
+  mix(hash<int>()(k.lastFontId));
+  mix(static_cast<size_t>(k.style) | (static_cast<size_t>(k.previous) << 8) | (k.flags << 16));
+  mix(hash<const string*>()(k.textStyle));
+  return h;
+}
+
+LayoutCache::Key LayoutCache::keyOf(size_t id, Environment& env, AtomType previous) {
+  TeXFont& tf = *env._tf;
+  const u8 flags = (tf.isBold() ? 1 : 0)
+                   | (tf.isRoman() ? 2 : 0)
+                   | (tf.isSs() ? 4 : 0)
+                   | (tf.isTt() ? 8 : 0)
+                   | (tf.isIt() ? 16 : 0)
+                   | (env._smallCap ? 32 : 0)
+                   | (env._measuring ? 64 : 0);
+  return {
+    id,
+    env._textStyle,
+    tf.getSize(),
+    env._scaleFactor,
+    tf.getScaleFactor(),
+    env._textWidth,
+    env._interline,
+    env._lastFontId,
+    env._style,
+    env._interlineUnit,
+    previous,
+    flags
+  };
+}
+
+sptr<Box> LayoutCache::find(const Key& key, Environment& env) {
+  const auto it = _entries.find(key);
+  if (it == _entries.end()) return nullptr;
+  it->second.lastUse = _layouts;
+  it->second.reused = true;
+  // the box depends on the text width as much as the one it was laid out with
+  if (it->second.textWidthUsed) env.getTextWidth();
+  return it->second.box;
+}
+
+void LayoutCache::put(Key&& key, const sptr<Atom>& atom, const sptr<Box>& box, bool textWidthUsed) {
+  if (dynamic_cast<CharBox*>(box.get()) != nullptr) return;
+  _entries[std::move(key)] = {atom, box, textWidthUsed, false, _layouts};
+}
+
+void LayoutCache::sweep() {
+  for (auto it = _entries.begin(); it != _entries.end();) {
+    const u32 age = _layouts - it->second.lastUse;
+    // most atoms are parsed again on every change, their boxes are dropped at once
+    if (age >= ParseMemo::MAX_AGE || (age > 0 && !it->second.reused)) it = _entries.erase(it);
+    else ++it;
+  }
+  _layouts++;
+}
+
+void LayoutCache::clear() {
+  _entries.clear();
+}
+
+sptr<Box> BoxMemo::find(const LayoutCache::Key& key, const Atom& atom, Environment& env) {
+  const auto range = _entries.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    const Entry& e = it->second;
+    if (e.atom.get() != &atom && !e.atom->isSameAs(atom)) continue;
+    if (e.textWidthUsed) env.getTextWidth();
+    return e.box;
+  }
+  return nullptr;
+}
+
+void BoxMemo::put(
+  LayoutCache::Key&& key, const sptr<Atom>& atom, const sptr<Box>& box, bool textWidthUsed
+) {
+  if (dynamic_cast<CharBox*>(box.get()) != nullptr) return;
+  _entries.emplace(std::move(key), Entry{atom, box, textWidthUsed});
+}
@@ -0,0 +1,155 @@
+#ifndef MEMO_H_INCLUDED
+#define MEMO_H_INCLUDED
+
+#include <string>
+#include <unordered_map>
+
+#include "common.h"
+#include "utils/enums.h"
+
+namespace tex {
+
+class Atom;
+
+class Box;
+
+class Environment;
+
+/**
+ * The atoms of the groups of a document kept from a parse to the next one, so an editor that
+ * parses the document again after every change only parses the groups that changed and the
+ * text around them. A group (a braced argument or a formula parsed by a nested parser) is
+ * looked up by its text and the state of the parser it depends on, see TeXParser#memoOf. The
+ * groups are only kept while the document defines nothing (commands, colors...), a group may
+ * parse differently depending on the definitions above it otherwise.
+ *
+ * The kept atoms are shared by the parses (like the predefined formulas), the rows are frozen
+ * so the formulas copy them before appending to them, see RowAtom#freeze.
+ */
+class ParseMemo {
+public:
+  struct Entry {
+    // the atom of the group, and its copy as an ordinary atom if the group is in a formula
+    sptr<Atom> atom, ordinary;
+    u32 lastUse = 0;
+  };
+
+  // the entries not used by this count of parses are dropped
+  static constexpr u32 MAX_AGE = 8;
+
+private:
+  std::unordered_map<std::wstring, Entry> _entries;
+  u32 _parses = 0;
+
+public:
+  /** Get the entry of the group of the given key, added if absent */
+  Entry& get(std::wstring&& key);
+
+  /** Mark the end of a parse and drop the entries not used for a while */
+  void sweep();
+
+  void clear();
+
+  inline size_t size() const { return _entries.size(); }
+};
+
+/**
+ * The boxes of the atoms of a document kept from a layout to the next one, shared by the atoms
+ * the document keeps from a parse to the next one (see ParseMemo), so only the atoms the parse
+ * did not keep are laid out again. The boxes are kept for the elements of the rows, they are
+ * looked up by the atom and the state of the environment they are laid out in.
+ *
+ * The kept boxes are shared by the renders, nothing changes a box once the row it belongs to is
+ * laid out. A box a row changes (a CharBox that gets the italic correction) is not kept.
+ */
+class LayoutCache {
+public:
+  struct Key {
+    // the address of the atom, or its structural hash for BoxMemo
+    size_t id;
+    // interned, see Environment#internTextStyle
+    const std::string* textStyle;
+    float size, scaleFactor, fontScale, textWidth, interline;
+    int lastFontId;
+    TexStyle style;
+    UnitType interlineUnit;
+    // the type of the previous atom in the row, for the rows only, see Row#setPreviousAtom
+    AtomType previous;
+    // bold, roman, sans-serif, typewriter, italic, small capital and measuring
+    u8 flags;
+
+    bool operator==(const Key& k) const;
+
+    struct Hash {
+      size_t operator()(const Key& k) const;
+    };
+  };
+
+private:
+  struct Entry {
+    // holds the atom so its address is not reused by another atom while it is a key
+    sptr<Atom> atom;
+    sptr<Box> box;
+    // if the layout read the text width, see Environment#trackTextWidth
+    bool textWidthUsed;
+    // if the box was used by a layout after the one that kept it
+    bool reused;
+    u32 lastUse;
+  };
+
+  std::unordered_map<Key, Entry, Key::Hash> _entries;
+  u32 _layouts = 0;
+
+public:
+  /** Make the key of the atom of the given id laid out in the given environment */
+  static Key keyOf(size_t id, Environment& env, AtomType previous);
+
+  /** Get the box of the given key, return nullptr if not kept */
+  sptr<Box> find(const Key& key, Environment& env);
+
+  /** Keep the box of the given key, the atom is held as long as the box is kept */
+  void put(Key&& key, const sptr<Atom>& atom, const sptr<Box>& box, bool textWidthUsed);
+
+  /**
+   * Mark the end of a layout and drop the boxes not used for a while, or not used by the
+   * layout following the one that kept them
+   */
+  void sweep();
+
+  void clear();
+
+  inline size_t size() const { return _entries.size(); }
+};
+
+/**
+ * The boxes of the atoms laid out by a render, shared by the atoms of the same structure (see
+ * Atom#hash) laid out in the same environment, so the sub-expressions repeated in the cells of a
+ * matrix or in the cases of a \cases (x_i, \frac{1}{2}...) are laid out once. Like the ones of
+ * LayoutCache, the boxes are kept for the elements of the rows, nothing changes them once kept.
+ */
+class BoxMemo {
+private:
+  struct Entry {
+    // the atom laid out, to compare with the atoms of the same hash
+    sptr<Atom> atom;
+    sptr<Box> box;
+    bool textWidthUsed;
+  };
+
+  std::unordered_multimap<LayoutCache::Key, Entry, LayoutCache::Key::Hash> _entries;
+
+public:
+  /** Get the box of an atom of the same structure as the given one, return nullptr if none */
+  sptr<Box> find(const LayoutCache::Key& key, const Atom& atom, Environment& env);
+
+  /** Keep the box of the given atom */
+  void put(
+    LayoutCache::Key&& key, const sptr<Atom>& atom, const sptr<Box>& box, bool textWidthUsed
+  );
+
+  inline size_t size() const { return _entries.size(); }
+};
+
+}  // namespace tex
+
+#endif
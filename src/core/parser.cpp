@@ -3,6 +3,7 @@
 #include "atom/atom.h"
 #include "atom/atom_basic.h"
 #include "common.h"
+#include "core/command_table.h"
 #include "core/formula.h"
 #include "core/macro.h"
 #include "fonts/alphabet.h"
@@ -72,13 +73,13 @@ const set<wstring> TeXParser::_unparsedContents = {
   L"externalFont",
 };
 
-bool TeXParser::_isLoading = false;
 
 void TeXParser::init(
   bool isPartial,
-  const wstring& latex,
+  const TeXSource& latex,
   Formula* formula,
-  bool firstPass
+  bool firstPass,
+  const sptr<MacroScope>& scope
 ) {
   _pos = _spos = _len = 0;
   _line = _col = 0;
@@ -90,13 +91,14 @@ void TeXParser::init(
   _formula = formula;
   _isMathMode = true;
   _isPartial = isPartial;
+  _macroScope = scope != nullptr ? scope : sptrOf<MacroScope>();
   if (!latex.empty()) {
     _latex = latex;
     _len = latex.length();
     _pos = 0;
     if (firstPass) preprocess();
   } else {
-    _latex = L"";
+    _latex = TeXSource();
     _pos = 0;
     _len = 0;
   }
@@ -107,6 +109,7 @@ void TeXParser::reset(const wstring& latex) {
   _latex = latex;
   _len = latex.length();
   _formula->_root = nullptr;
+  _formula->_middle.clear();
   _pos = 0;
   _spos = 0;
   _line = 0;
@@ -116,12 +119,19 @@ void TeXParser::reset(const wstring& latex) {
   _atIsLetter = 0;
   _arrayMode = false;
   _isMathMode = true;
+  // a new document, forget the previous definitions
+  _macroScope = sptrOf<MacroScope>();
   preprocess();
 }
 
 sptr<Atom> TeXParser::popLastAtom() const {
   auto a = _formula->_root;
   auto* ra = dynamic_cast<RowAtom*>(a.get());
+  if (ra != nullptr && ra->isFrozen()) {
+    // a shared row, copy it before removing from it
+    _formula->_root = sptrOf<RowAtom>(a);
+    ra = static_cast<RowAtom*>(_formula->_root.get());
+  }
   if (ra != nullptr) return ra->popLastAtom();
   _formula->_root = nullptr;
   return a;
@@ -138,7 +148,8 @@ void TeXParser::addAtom(const sptr<Atom>& atom) const {
 }
 
 void TeXParser::addRow() const {
-  if (!_arrayMode) throw ex_parse("Can not add row in none-array mode!");
+  // the groups in the cells are parsed in formulas that are not arrays
+  if (!_formula->isArrayMode()) throw ex_parse("Can not add row in none-array mode!");
   ((ArrayFormula*) _formula)->addRow();
 }
 
@@ -156,11 +167,30 @@ wstring TeXParser::getDollarGroup(wchar_t openclose) {
 }
 
 wstring TeXParser::getGroup(wchar_t open, wchar_t close) {
-  if (_pos == _len) return L"";
+  wstring group;
+  if (tryGetGroup(open, close, group)) return group;
+  throw ex_parse("Missing '" + tostring((char) open) + "'!");
+}
+
+bool TeXParser::tryGetGroup(wchar_t open, wchar_t close, wstring& res) {
+  if (_pos == _len) {
+    res.clear();
+    return true;
+  }
 
   int group, spos;
   wchar_t ch = _latex[_pos];
 
+  if (_pos < _len && ch == open && open == L_GROUP && close == R_GROUP) {
+    // the buffer knows where the group ends
+    const int end = _latex.matchingBrace(_pos);
+    if (end >= 0) {
+      res = _latex.substr(_pos + 1, end - _pos - 1);
+      _pos = end + 1;
+      return true;
+    }
+  }
+
   if (_pos < _len && ch == open) {
     group = 1;
     spos = _pos;
@@ -177,10 +207,11 @@ wstring TeXParser::getGroup(wchar_t open, wchar_t close) {
 
     _pos++;
 
-    if (group != 0) return _latex.substr(spos + 1, _pos - spos - 1);
-    return _latex.substr(spos + 1, _pos - spos - 2);
+    if (group != 0) res = _latex.substr(spos + 1, _pos - spos - 1);
+    else res = _latex.substr(spos + 1, _pos - spos - 2);
+    return true;
   }
-  throw ex_parse("Missing '" + tostring((char) open) + "'!");
+  return false;
 }
 
 wstring TeXParser::getGroup(const wstring& open, const wstring& close) {
@@ -252,8 +283,8 @@ wstring TeXParser::getGroup(const wstring& open, const wstring& close) {
   return buf.substr(0, buf.length() - _pos + startC);
 }
 
-wstring TeXParser::getOverArgument() {
-  if (_pos == _len) return L"";
+TeXSource TeXParser::getOverArgument() {
+  if (_pos == _len) return TeXSource();
 
   int ogroup = 1, spos;
   wchar_t ch = L'\0';
@@ -296,11 +327,11 @@ wstring TeXParser::getOverArgument() {
   // end of string reached, bu not processed properly
   if (ogroup >= 2) throw ex_parse("Illegal end, missing '}'!");
 
-  wstring str;
+  TeXSource str;
   if (ogroup == 0) {
-    str = _latex.substr(spos, _pos - spos - 1);
+    str = _latex.slice(spos, _pos - spos - 1);
   } else {
-    str = _latex.substr(spos, _pos - spos);
+    str = _latex.slice(spos, _pos - spos);
     ch = '\0';
   }
 
@@ -344,7 +375,7 @@ void TeXParser::insert(int beg, int end, const wstring& formula) {
 wstring TeXParser::getCommandWithArgs(const wstring& command) {
   if (command == L"left") return getGroup(L"\\left", L"\\right");
 
-  auto mac = MacroInfo::get(command);
+  auto mac = _macroScope->get(command);
   if (mac == nullptr) {
     return L"\\" + command;
   }
@@ -386,9 +417,9 @@ void TeXParser::skipWhiteSpace() {
   }
 }
 
-wstring TeXParser::forwardBalancedGroup() {
+TeXSource TeXParser::forwardBalancedGroup() {
   if (_group == 0) {
-    const wstring& sub = _latex.substr(_pos);
+    const TeXSource sub = _latex.slice(_pos);
     finish();
     return sub;
   }
@@ -404,7 +435,7 @@ wstring TeXParser::forwardBalancedGroup() {
   if (closing != 0) {
     throw ex_parse("Found a closing '}' without an opening '{'!");
   }
-  const wstring& sub = _latex.substr(_pos, i - _pos);
+  const TeXSource sub = _latex.slice(_pos, i - _pos);
   _pos = i;
   return sub;
 }
@@ -416,22 +447,18 @@ void TeXParser::getOptsArgs(int argc, int opts, Args& args) {
   args.resize(argc + 10 + 1 + 1);
 
   auto getOpts = [&]() {
-    int j = argc + 1;
-    try {
-      for (; j < argc + 11; j++) {
-        skipWhiteSpace();
-        args[j] = getGroup(L_BRACK, R_BRACK);
+    for (int j = argc + 1; j < argc + 11; j++) {
+      skipWhiteSpace();
+      if (!tryGetGroup(L_BRACK, R_BRACK, args[j])) {
+        args[j] = L"";
+        break;
       }
-    } catch (ex_parse& e) {
-      args[j] = L"";
     }
   };
 
   auto getArg = [&](int i) { // NOLINT(misc-no-recursion)
     skipWhiteSpace();
-    try {
-      args[i] = getGroup(L_GROUP, R_GROUP);
-    } catch (ex_parse& e) {
+    if (!tryGetGroup(L_GROUP, R_GROUP, args[i])) {
       if (_latex[_pos] != '\\') {
         args[i] = towstring(_latex[_pos]);
         _pos++;
@@ -479,23 +506,25 @@ sptr<Atom> TeXParser::processEscape() {
 
   if (command.length() == 0) return sptrOf<EmptyAtom>();
 
-  auto mac = MacroInfo::get(command);
+  // the commands defined by the document come first
+  auto mac = _macroScope->getDefined(command);
   if (mac != nullptr) {
     return processCommands(command, mac);
   }
 
-  const string cmd = wide2utf8(command);
-  try {
-    return Formula::get(command)->_root;
-  } catch (ex_formula_not_found& e) {
-    try {
-      return SymbolAtom::get(cmd);
-    } catch (ex_symbol_not_found& ex) {}
+  // then macros, predefined formulas and symbols, in this order
+  const CommandEntry* entry = CommandTable::find(command);
+  if (entry != nullptr) {
+    if (entry->macro != nullptr) return processCommands(command, entry->macro);
+    if (entry->isFormula) return Formula::get(command);
+    return entry->symbol;
   }
 
   // not a valid command or symbol or predefined Formula found
   if (!_isPartial) {
-    throw ex_parse("Unknown symbol or command or predefined Formula: '" + cmd + "'");
+    throw ex_parse(
+      "Unknown symbol or command or predefined Formula: '" + wide2utf8(command) + "'"
+    );
   }
   // Show invalid command
   auto rm = sptrOf<RomanAtom>(Formula(L"\\backslash " + command)._root);
@@ -510,7 +539,7 @@ sptr<Atom> TeXParser::processCommands(const wstring& cmd, MacroInfo* mac) {
   // we promise the first argument is the command name itself
   args[0] = cmd;
 
-  if (NewCommandMacro::isMacro(cmd)) {
+  if (_macroScope->isMacro(cmd)) {
     // The last value in "args" is the replacement string
     auto ret = mac->invoke(*this, args);
     insert(_spos, _pos, args.back());
@@ -549,25 +578,16 @@ sptr<Atom> TeXParser::getScripts(wchar_t first) {
     sub = nullptr;
   }
 
-  sptr<Atom> atom;
-  RowAtom* rm = nullptr;
   if (_formula->_root == nullptr) {
     // If there's no root exists, passing a null atom to ScriptsAtom as base is OK,
     // the ScriptsAtom will handle it
     return sptrOf<ScriptsAtom>(nullptr, sub, sup);
-  } else if ((rm = dynamic_cast<RowAtom*>(_formula->_root.get()))) {
-    atom = rm->popLastAtom();
-  } else {
-    atom = _formula->_root;
-    _formula->_root = nullptr;
   }
+  sptr<Atom> atom = popLastAtom();
 
-  // Check if previous atom is CumulativeScriptsAtom
-  auto* ca = dynamic_cast<CumulativeScriptsAtom*>(atom.get());
-  if (ca != nullptr) {
-    ca->addSubscript(sub);
-    ca->addSuperscript(sup);
-    return atom;
+  // Check if previous atom is CumulativeScriptsAtom, it may be shared, extend a copy
+  if (dynamic_cast<CumulativeScriptsAtom*>(atom.get()) != nullptr) {
+    return sptrOf<CumulativeScriptsAtom>(atom, sub, sup);
   }
 
   if (atom->rightType() == AtomType::bigOperator) {
@@ -575,41 +595,94 @@ sptr<Atom> TeXParser::getScripts(wchar_t first) {
   }
 
   auto* del = dynamic_cast<OverUnderDelimiter*>(atom.get());
-  if (del != nullptr) {
+  if (del != nullptr && (del->isOver() ? sup != nullptr : sub != nullptr)) {
+    // the delimiter may be shared, change a copy
+    atom = atom->clone();
+    del = static_cast<OverUnderDelimiter*>(atom.get());
     if (del->isOver()) {
-      if (sup != nullptr) {
-        del->addScript(sup);
-        return sptrOf<ScriptsAtom>(atom, sub, nullptr);
-      }
-    } else if (sub != nullptr) {
-      del->addScript(sub);
-      return sptrOf<ScriptsAtom>(atom, nullptr, sup);
+      del->addScript(sup);
+      return sptrOf<ScriptsAtom>(atom, sub, nullptr);
     }
+    del->addScript(sub);
+    return sptrOf<ScriptsAtom>(atom, nullptr, sup);
   }
 
   return sptrOf<ScriptsAtom>(atom, sub, sup);
 }
 
-sptr<Atom> TeXParser::getArgument() {
-  skipWhiteSpace();
-  wchar_t ch;
-  if (_pos < _len) ch = _latex[_pos];
-  else return sptrOf<EmptyAtom>();
+/** Freeze the given atom if it is a row, it is shared by the parses from now on */
+static const sptr<Atom>& share(const sptr<Atom>& atom) {
+  auto* ra = dynamic_cast<RowAtom*>(atom.get());
+  if (ra != nullptr) ra->freeze();
+  return atom;
+}
 
-  if (ch == L_GROUP) {
-    Formula tf;
+ParseMemo::Entry* TeXParser::memoOf(int start, int end, const Formula& formula) {
+  if (_memo == nullptr || _arrayMode || !formula._xmlMap.empty() || !_macroScope->isDefault()) {
+    return nullptr;
+  }
+  // the state the parse depends on, then the text
+  const wchar_t state = (_isMathMode ? 1 : 0)
+                        | (_atIsLetter != 0 ? 2 : 0)
+                        | (_isPartial ? 4 : 0)
+                        | (_hideUnknownChar ? 8 : 0)
+                        | (formula._ignoreLatinFont ? 16 : 0);
+  const string& style = formula._textStyle;
+  wstring key;
+  key.reserve(end - start + style.size() + 2);
+  key += state;
+  key.append(style.begin(), style.end());
+  key += L'\0';
+  key += _latex.substr(start, end - start);
+  return &_memo->get(std::move(key));
+}
+
+sptr<Atom> TeXParser::getBracedGroup(ParseMemo::Entry*& memo) {
+  Formula tf;
+  const int end = _memo != nullptr ? _latex.matchingBrace(_pos) : -1;
+  memo = end >= 0 ? memoOf(_pos + 1, end, tf) : nullptr;
+  sptr<Atom> root;
+  if (memo != nullptr && memo->atom != nullptr) {
+    root = memo->atom;
+    _pos = end + 1;
+  } else {
     Formula* tmp = _formula;
     _formula = &tf;
     _pos++;
     _group++;
-    parse();
+    try {
+      parse();
+    } catch (...) {
+      // the parser may be used again (see TeXContext), it must not keep the local formula
+      _formula = tmp;
+      throw;
+    }
     _formula = tmp;
-    if (_formula->_root == nullptr) {
-      auto* rm = new RowAtom();
-      rm->add(tf._root);
-      return sptr<Atom>(rm);
+    root = tf._root;
+    // the group may have defined something
+    if (memo != nullptr && root != nullptr && _macroScope->isDefault()) {
+      memo->atom = share(root);
+    } else {
+      memo = nullptr;
     }
-    return tf._root;
+  }
+  if (_formula->_root == nullptr) {
+    auto* rm = new RowAtom();
+    rm->add(root);
+    return sptr<Atom>(rm);
+  }
+  return root;
+}
+
+sptr<Atom> TeXParser::getArgument() {
+  skipWhiteSpace();
+  wchar_t ch;
+  if (_pos < _len) ch = _latex[_pos];
+  else return sptrOf<EmptyAtom>();
+
+  if (ch == L_GROUP) {
+    ParseMemo::Entry* memo = nullptr;
+    return getBracedGroup(memo);
   }
 
   if (ch == ESCAPE) {
@@ -669,7 +742,7 @@ void TeXParser::preprocess(wstring& cmd, Args& args, int& pos) {
     preprocessNewCmd(cmd, args, pos);
   } else if (cmd == L"newenvironment" || cmd == L"renewenvironment") {
     preprocessNewCmd(cmd, args, pos);
-  } else if (NewCommandMacro::isMacro(cmd)) {
+  } else if (_macroScope->isMacro(cmd)) {
     inflateNewCmd(cmd, args, pos);
   } else if (cmd == L"begin") {
     inflateEnv(cmd, args, pos);
@@ -684,7 +757,7 @@ void TeXParser::preprocess(wstring& cmd, Args& args, int& pos) {
 
 void TeXParser::preprocessNewCmd(wstring& cmd, Args& args, int& pos) {
   // The macro must exists
-  auto mac = MacroInfo::get(cmd);
+  auto mac = _macroScope->get(cmd);
   getOptsArgs(mac->_argc, mac->_posOpts, args);
   mac->invoke(*this, args);
   _latex.erase(pos, _pos - pos);
@@ -694,7 +767,7 @@ void TeXParser::preprocessNewCmd(wstring& cmd, Args& args, int& pos) {
 
 void TeXParser::inflateNewCmd(wstring& cmd, Args& args, int& pos) {
   // The macro must exists
-  auto mac = MacroInfo::get(cmd);
+  auto mac = _macroScope->get(cmd);
   getOptsArgs(mac->_argc, mac->_posOpts, args);
   args[0] = cmd;
   try {
@@ -712,7 +785,7 @@ void TeXParser::inflateNewCmd(wstring& cmd, Args& args, int& pos) {
 void TeXParser::inflateEnv(wstring& cmd, Args& args, int& pos) {
   getOptsArgs(1, 0, args);
   wstring env = args[1] + L"@env";
-  auto mac = MacroInfo::get(env);
+  auto mac = _macroScope->get(env);
   if (mac == nullptr) {
     throw ex_parse(
       "Unknown environment: "
@@ -782,6 +855,21 @@ void TeXParser::preprocess() {
   _len = _latex.length();
 }
 
+void TeXParser::parseOrReuse() {
+  ParseMemo::Entry* memo = _len > 0 ? memoOf(0, _len, *_formula) : nullptr;
+  if (memo != nullptr && memo->atom != nullptr) {
+    _formula->_root = memo->atom;
+    _pos = _len;
+    return;
+  }
+  parse();
+  // the middle delimiters are taken from the formula by the fenced atom it belongs to
+  const auto& root = _formula->_root;
+  if (memo != nullptr && root != nullptr && _formula->_middle.empty() && _macroScope->isDefault()) {
+    memo->atom = share(root);
+  }
+}
+
 void TeXParser::parse() {
   if (_len == 0) {
     if (_formula->_root == nullptr && !_arrayMode)
@@ -840,13 +928,23 @@ void TeXParser::parse() {
         sptr<Atom> atom = processEscape();
         _formula->add(atom);
         auto* h = dynamic_cast<HlineAtom*>(atom.get());
-        if (_arrayMode && h != nullptr) ((ArrayFormula*) _formula)->addRow();
+        if (h != nullptr && _formula->isArrayMode()) ((ArrayFormula*) _formula)->addRow();
         if (_insertion) _insertion = false;
       }
         break;
       case L_GROUP: {
-        auto atom = getArgument();
-        if (atom != nullptr) atom->_type = AtomType::ordinary;
+        // the group is wrapped in a new row if the formula is empty, see getBracedGroup
+        const bool wrapped = _formula->_root == nullptr;
+        ParseMemo::Entry* memo = nullptr;
+        auto atom = getBracedGroup(memo);
+        if (memo != nullptr && !wrapped && memo->ordinary != nullptr) {
+          atom = memo->ordinary;
+        } else if (atom != nullptr) {
+          // the argument may be a shared symbol or a predefined formula, change the copy
+          atom = atom->clone();
+          atom->_type = AtomType::ordinary;
+          if (memo != nullptr && !wrapped) memo->ordinary = share(atom);
+        }
         _formula->add(atom);
       }
         break;
@@ -873,7 +971,7 @@ void TeXParser::parse() {
       }
         break;
       case '&': {
-        if (!_arrayMode) {
+        if (!_formula->isArrayMode()) {
           throw ex_parse("Character '&' is only available in array mode!");
         }
         ((ArrayFormula*) _formula)->addCol();
@@ -932,11 +1030,15 @@ sptr<Atom> TeXParser::convertCharacter(wchar_t c, bool oneChar) {
     // the unicode Greek Letters in math mode are not drawn with the Greek font
     if (c >= 945 && c <= 969) {
       // Greek small letter
-      return SymbolAtom::get(Formula::_symbolMappings[c]);
+      auto it = Formula::_symbolMappings.find(c);
+      if (it != Formula::_symbolMappings.end()) return SymbolAtom::get(it->second);
     } else if (c >= 913 && c <= 937) {
       // Greek capital letter
-      wstring ltx = utf82wide(Formula::_symbolFormulaMappings[c]);
-      return Formula(ltx)._root;
+      auto it = Formula::_symbolFormulaMappings.find(c);
+      if (it != Formula::_symbolFormulaMappings.end()) {
+        wstring ltx = utf82wide(it->second);
+        return Formula(ltx)._root;
+      }
     }
   }
 
@@ -954,12 +1056,6 @@ sptr<Atom> TeXParser::convertCharacter(wchar_t c, bool oneChar) {
     int idx = indexOf(DefaultTeXFont::_loadedAlphabets, block);
     __log << "block of char: " << c << " is " << idx << endl;
 #endif  // HAVE_LOG
-    bool exist = (indexOf(DefaultTeXFont::_loadedAlphabets, block) != -1);
-    if (!_isLoading && !exist) {
-      auto it = DefaultTeXFont::_registeredAlphabets.find(block);
-      if (it != DefaultTeXFont::_registeredAlphabets.end())
-        DefaultTeXFont::addAlphabet(DefaultTeXFont::_registeredAlphabets[block]);
-    }
 
     auto sit = Formula::_symbolMappings.find(c);
     auto fit = Formula::_symbolFormulaMappings.find(c);
@@ -972,8 +1068,10 @@ sptr<Atom> TeXParser::convertCharacter(wchar_t c, bool oneChar) {
         fit == Formula::_symbolFormulaMappings.end()) {
       FontInfos* fontInfos = nullptr;
       bool isLatin = UnicodeBlock::BASIC_LATIN == block;
-      if ((isLatin && Formula::isRegisteredBlock(UnicodeBlock::BASIC_LATIN)) || !isLatin) {
+      if (!isLatin) {
         fontInfos = Formula::getExternalFont(block);
+      } else if (!_formula->_ignoreLatinFont) {
+        fontInfos = Formula::findExternalFont(block);
       }
       if (fontInfos != nullptr) {
         if (oneChar) return sptrOf<TextRenderingAtom>(towstring(c), fontInfos);
@@ -1006,7 +1104,8 @@ sptr<Atom> TeXParser::convertCharacter(wchar_t c, bool oneChar) {
       if (!_isMathMode) {
         auto it = Formula::_symbolTextMappings.find(c);
         if (it != Formula::_symbolTextMappings.end()) {
-          auto atom = SymbolAtom::get(it->second);
+          // the symbols are shared, copy it before changing its unicode
+          auto atom = sptrOf<SymbolAtom>(*SymbolAtom::get(it->second));
           atom->setUnicode(c);
           return atom;
         }
@@ -1018,16 +1117,15 @@ sptr<Atom> TeXParser::convertCharacter(wchar_t c, bool oneChar) {
       }
 
       if (sit != Formula::_symbolMappings.end()) {
-        string symbolName = sit->second;
-        try {
-          return SymbolAtom::get(symbolName);
-        } catch (ex_symbol_not_found& e) {
+        const string& symbolName = sit->second;
+        auto sym = SymbolAtom::find(symbolName);
+        if (sym == nullptr) {
           throw ex_parse(
             "The character '" + tostring(c) +
-            "' was mapped to an unknown symbol with the name '" + symbolName + "'!",
-            e
+            "' was mapped to an unknown symbol with the name '" + symbolName + "'!"
           );
         }
+        return sym;
       }
     }
   } else {
@@ -1035,9 +1133,8 @@ sptr<Atom> TeXParser::convertCharacter(wchar_t c, bool oneChar) {
        * Alphanumeric character
        */
     FontInfos* infos = nullptr;
-    auto it = Formula::_externalFontMap.find(UnicodeBlock::BASIC_LATIN);
-    if (it != Formula::_externalFontMap.end()) {
-      infos = it->second;
+    if (!_formula->_ignoreLatinFont) infos = Formula::findExternalFont(UnicodeBlock::BASIC_LATIN);
+    if (infos != nullptr) {
       if (oneChar) return sptrOf<TextRenderingAtom>(towstring(c), infos);
 
       int start = _pos++;
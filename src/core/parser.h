@@ -6,6 +6,8 @@
 
 #include "atom/atom.h"
 #include "common.h"
+#include "core/memo.h"
+#include "core/tex_source.h"
 
 namespace tex {
 
@@ -21,10 +23,13 @@ class Formula;
 
 class MacroInfo;
 
+class MacroScope;
+
 /** This class implements a parser for latex formulas */
 class TeXParser {
 private:
-  std::wstring _latex;
+  // the parsed string, shares the buffer with the parsers of the enclosing formulas
+  TeXSource _latex;
   int _pos, _spos, _len;
   int _line, _col;
   int _group;
@@ -34,6 +39,10 @@ private:
   bool _isMathMode;
   bool _isPartial;
   bool _hideUnknownChar;
+  // the definitions of the document, shared with the parsers of nested formulas
+  sptr<MacroScope> _macroScope;
+  // the groups kept from the previous parses of the document, nullptr if none, see ParseMemo
+  ParseMemo* _memo = nullptr;
 
   /** escape character */
   static const wchar_t ESCAPE;
@@ -62,6 +71,19 @@ private:
   /** Preprocess parse string */
   void preprocess();
 
+  /**
+   * Get the memo entry of the group in the given part of the input parsed into the given
+   * formula, return nullptr if the groups are not kept or may not be parsed the same
+   * elsewhere
+   */
+  ParseMemo::Entry* memoOf(int start, int end, const Formula& formula);
+
+  /**
+   * Get the atom of the braced group at the current position, the entry is set if the group
+   * is kept in the memo
+   */
+  sptr<Atom> getBracedGroup(ParseMemo::Entry*& memo);
+
   sptr<Atom> getScripts(wchar_t first);
 
   std::wstring getCommand();
@@ -99,14 +121,13 @@ private:
 
   void init(
     bool isPartial,
-    const std::wstring& latex,
+    const TeXSource& latex,
     Formula* formula,
-    bool firstPass
+    bool firstPass,
+    const sptr<MacroScope>& scope = nullptr
   );
 
 public:
-  static bool _isLoading;
-
   Formula* _formula;
 
   /**
@@ -183,9 +204,39 @@ public:
     _isMathMode = isMathMode;
   }
 
+  /**
+   * Create a new TeXParser to parse a formula nested in the given parser, the
+   * definitions made by the parent are visible to it and vice versa
+   *
+   * @param parent the parser of the enclosing formula
+   * @param latex the string to be parsed, usually a part of the parent's string
+   * @param formula the formula to hold the atoms
+   * @param preprocess indicate if the parser must replace the user-defined macros by their content
+   * @param isMathMode a boolean to indicate if the parser must ignore or not the white space
+   *
+   * @throw ex_parse if the string could not be parsed correctly
+   */
+  TeXParser(
+    const TeXParser& parent,
+    const TeXSource& latex,
+    Formula* formula,
+    bool preprocess,
+    bool isMathMode
+  ) {
+    init(parent._isPartial, latex, formula, preprocess, parent._macroScope);
+    _isMathMode = isMathMode;
+    _memo = parent._memo;
+  }
+
+  /** Keep the groups in the given memo to reuse them in the next parses, see ParseMemo */
+  inline void setMemo(ParseMemo* memo) { _memo = memo; }
+
   /** Reset the parser with a new latex expression */
   void reset(const std::wstring& latex);
 
+  /** Get the definitions of the document */
+  inline MacroScope& getMacroScope() const { return *_macroScope; }
+
   /** Return true if we get a partial formula */
   inline bool isPartial() const { return _isPartial; }
 
@@ -240,8 +291,10 @@ public:
    * Forward from current position to get a balanced group.
    * <li> Forward to the end of the parse string if no group was in process
    * <li> Otherwise get the balanced group embraced by '{' and '}' and forward
+   *
+   * The returned group shares the buffer of this parser.
    */
-  std::wstring forwardBalancedGroup();
+  TeXSource forwardBalancedGroup();
 
   /**
    * Add a new row when the parser is in array mode
@@ -257,6 +310,14 @@ public:
    */
   void parse();
 
+  /**
+   * Parse the input like #parse, or take its atom from the memo if it was parsed in the same
+   * state before, see ParseMemo
+   *
+   * @throw ex_parse if an error is encountered during parse
+   */
+  void parseOrReuse();
+
   /**
    * Get the contents between two delimiters
    *
@@ -278,6 +339,19 @@ public:
    */
   std::wstring getGroup(wchar_t open, wchar_t close);
 
+  /**
+   * Get the contents between two delimiters, the same as getGroup but does not throw if
+   * the contents are not started with the opening character, used to probe the optional
+   * arguments and the arguments without braces.
+   *
+   * @param open the opening character
+   * @param close the closing character
+   * @param group the enclosed contents
+   * @return false if the contents are not started with the opening character, and the
+   *      position is unchanged
+   */
+  bool tryGetGroup(wchar_t open, wchar_t close, std::wstring& group);
+
   /**
    * Get the contents between two strings as in \\begin{foo}... \\end{foo}
    *
@@ -298,8 +372,8 @@ public:
    */
   sptr<Atom> getArgument();
 
-  /** Get the supscript argument */
-  std::wstring getOverArgument();
+  /** Get the supscript argument, it shares the buffer of this parser */
+  TeXSource getOverArgument();
 
   /**
    * Get the unit and length from given string. The string must be in the format: a digital
@@ -0,0 +1,120 @@
+#include "core/tex_source.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace tex;
+
+void TeXSource::Buffer::moveGap(size_t pos) {
+  if (pos == _gapStart) return;
+  wchar_t* t = &_text[0];
+  if (pos < _gapStart) {
+    // move [pos, gapStart) to the end of the gap
+    wmemmove(t + pos + _gapLen, t + pos, _gapStart - pos);
+  } else {
+    // move [gapEnd, pos + gapLen) to the start of the gap
+    wmemmove(t + _gapStart, t + _gapStart + _gapLen, pos - _gapStart);
+  }
+  _gapStart = pos;
+}
+
+void TeXSource::Buffer::index() {
+  const int len = (int) length();
+  _braces.assign(len, -1);
+  vector<int> opens;
+  for (int i = 0; i < len; i++) {
+    const wchar_t c = at(i);
+    if (c == L'\\') {
+      // the escaped character is never a group delimiter
+      i++;
+    } else if (c == L'{') {
+      opens.push_back(i);
+    } else if (c == L'}' && !opens.empty()) {
+      _braces[opens.back()] = i;
+      opens.pop_back();
+    }
+  }
+  _indexed = true;
+}
+
+TeXSource::TeXSource(wstring text) {
+  _len = text.length();
+  if (_len != 0) _buf = sptrOf<Buffer>(std::move(text));
+}
+
+TeXSource TeXSource::slice(size_t pos, size_t n) const {
+  if (pos >= _len) return TeXSource();
+  n = std::min(n, _len - pos);
+  if (n == 0) return TeXSource();
+  return TeXSource(_buf, _off + pos, n);
+}
+
+wstring TeXSource::substr(size_t pos, size_t n) const {
+  if (pos >= _len) return L"";
+  n = std::min(n, _len - pos);
+  const Buffer& b = *_buf;
+  const size_t s = _off + pos, e = s + n;
+  if (e <= b._gapStart) return b._text.substr(s, n);
+  if (s >= b._gapStart) return b._text.substr(s + b._gapLen, n);
+  wstring str;
+  str.reserve(n);
+  str.append(b._text, s, b._gapStart - s);
+  str.append(b._text, b._gapStart + b._gapLen, e - b._gapStart);
+  return str;
+}
+
+void TeXSource::replace(size_t pos, size_t n, const wstring& str) {
+  n = std::min(n, _len - pos);
+  if (_buf == nullptr || _buf.use_count() != 1 || _off != 0 || _len != _buf->length()) {
+    // shared or partially viewed buffer, make a new one for this view
+    wstring text;
+    text.reserve(_len - n + str.length());
+    text.append(substr(0, pos));
+    text.append(str);
+    text.append(substr(pos + n));
+    *this = TeXSource(std::move(text));
+    return;
+  }
+  // the only view of the buffer, edit in place
+  Buffer& b = *_buf;
+  b.moveGap(pos + n);
+  // the replaced part goes into the gap
+  b._gapStart -= n;
+  b._gapLen += n;
+  if (b._gapLen < str.length()) {
+    // grow the gap, keep some room for the following edits
+    const size_t grow = str.length() - b._gapLen + b._text.length() / 2 + 16;
+    b._text.insert(b._gapStart + b._gapLen, grow, L'\0');
+    b._gapLen += grow;
+  }
+  std::copy(str.begin(), str.end(), b._text.begin() + b._gapStart);
+  b._gapStart += str.length();
+  b._gapLen -= str.length();
+  b._indexed = false;
+  b._scanned = 0;
+  _len = b.length();
+}
+
+int TeXSource::matchingBrace(size_t pos) const {
+  Buffer& b = *_buf;
+  if (!b._indexed && b._scanned < b.length()) {
+    int depth = 0;
+    for (size_t i = pos; i < _len; i++) {
+      const wchar_t c = b.at(_off + i);
+      if (c == L'\\') {
+        i++;
+      } else if (c == L'{') {
+        depth++;
+      } else if (c == L'}' && --depth == 0) {
+        b._scanned += i - pos + 1;
+        return (int) i;
+      }
+    }
+    b._scanned += _len - pos;
+    return -1;
+  }
+  if (!b._indexed) b.index();
+  const int end = _buf->_braces[_off + pos];
+  if (end < 0 || (size_t) end >= _off + _len) return -1;
+  return end - (int) _off;
+}
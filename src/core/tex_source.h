@@ -0,0 +1,99 @@
+#ifndef TEX_SOURCE_H_INCLUDED
+#define TEX_SOURCE_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include "common.h"
+
+namespace tex {
+
+/**
+ * A view of a TeX source held by a shared buffer. Taking a part of the source (e.g. the
+ * argument of a command that will be parsed by a nested parser) shares the buffer instead of
+ * copying it. Editing a view (preprocessing, macro expansion) writes to the buffer in place if
+ * no other view shares it, otherwise the view gets its own buffer first, so a view never
+ * sees the changes made through another one.
+ *
+ * The buffer keeps a gap at the position of the last edit, the parser edits the string just
+ * behind its current position while expanding the macros, so an edit only moves the text
+ * between two successive edits instead of the whole tail of the string.
+ *
+ * The buffer caches the position of the closing brace that matches every opening brace, so
+ * balanced groups are found in constant time. The views are expected to begin at a token
+ * boundary (never just after an escape character), which is always the case for the views
+ * taken by the parser.
+ *
+ * A buffer is not thread-safe, the views of a document are used by the thread parsing it.
+ */
+class TeXSource {
+private:
+  struct Buffer {
+    // the text with a gap of _gapLen characters at _gapStart
+    std::wstring _text;
+    size_t _gapStart, _gapLen = 0;
+    // position of the matching '}' for every '{' in the text, -1 if not closed or not a '{'
+    std::vector<int> _braces;
+    bool _indexed = false;
+    // characters scanned to find the groups since the last edit
+    size_t _scanned = 0;
+
+    explicit Buffer(std::wstring text) : _text(std::move(text)), _gapStart(_text.length()) {}
+
+    inline wchar_t at(size_t i) const { return _text[i < _gapStart ? i : i + _gapLen]; }
+
+    inline size_t length() const { return _text.length() - _gapLen; }
+
+    void moveGap(size_t pos);
+
+    void index();
+  };
+
+  sptr<Buffer> _buf;
+  size_t _off = 0, _len = 0;
+
+  TeXSource(const sptr<Buffer>& buf, size_t off, size_t len) : _buf(buf), _off(off), _len(len) {}
+
+public:
+  static const size_t npos = std::wstring::npos;
+
+  TeXSource() = default;
+
+  TeXSource(std::wstring text);
+
+  TeXSource(const wchar_t* text) : TeXSource(std::wstring(text)) {}
+
+  inline size_t length() const { return _len; }
+
+  inline size_t size() const { return _len; }
+
+  inline bool empty() const { return _len == 0; }
+
+  inline wchar_t operator[](size_t i) const { return _buf->at(_off + i); }
+
+  /** Get a view of the given part of this source, the buffer is shared */
+  TeXSource slice(size_t pos, size_t n = npos) const;
+
+  /** Copy the given part of this source */
+  std::wstring substr(size_t pos, size_t n = npos) const;
+
+  /** Copy the whole source */
+  inline std::wstring str() const { return substr(0); }
+
+  /** Replace the given part of this source with the given string */
+  void replace(size_t pos, size_t n, const std::wstring& str);
+
+  inline void erase(size_t pos, size_t n) { replace(pos, n, L""); }
+
+  /**
+   * Get the position of the '}' that matches the '{' at the given position, return -1 if the
+   * group is not closed in this view. Right after an edit the group is scanned, the positions
+   * are indexed again once the scans have read as many characters as the whole text, so a
+   * source edited between every lookup (macro expansion) is not indexed again and again.
+   */
+  int matchingBrace(size_t pos) const;
+};
+
+}  // namespace tex
+
+#endif
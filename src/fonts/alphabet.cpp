@@ -1,5 +1,6 @@
 #include "fonts/alphabet.h"
 #include "common.h"
+#include "res/reg/builtin_alphabet_reg.h"
 
 using namespace tex;
 
@@ -57,6 +58,10 @@ const UnicodeBlock& UnicodeBlock::of(wchar_t c) {
 
 AlphabetRegistration::~AlphabetRegistration() {}
 
+__reg_alphabet_func AlphabetRegistration::getBuiltin() const {
+  return nullptr;
+}
+
 const std::vector<UnicodeBlock> CyrillicRegistration::_block = {UnicodeBlock::CYRILLIC};
 const std::string CyrillicRegistration::_package = "cyrillic";
 const std::string CyrillicRegistration::_font = "cyrillic/language_cyrillic.xml";
@@ -73,6 +78,10 @@ const std::string CyrillicRegistration::getTeXFontFile() const {
   return RES_BASE + "/" + _font;
 }
 
+__reg_alphabet_func CyrillicRegistration::getBuiltin() const {
+  return __alphabet_reg(cyrillic);
+}
+
 const std::vector<UnicodeBlock> GreekRegistration::_block = {
     UnicodeBlock::GREEK,
     UnicodeBlock::GREEK_EXTENDED};
@@ -91,3 +100,7 @@ const std::string GreekRegistration::getPackage() const {
 const std::string GreekRegistration::getTeXFontFile() const {
   return RES_BASE + "/" + _font;
 }
+
+__reg_alphabet_func GreekRegistration::getBuiltin() const {
+  return __alphabet_reg(greek);
+}
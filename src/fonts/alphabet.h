@@ -37,6 +37,9 @@ public:
   static const UnicodeBlock& of(wchar_t c);
 };
 
+/** Alphabet registration function, see res/alphabet_def.res.h */
+typedef void (*__reg_alphabet_func)(void);
+
 class AlphabetRegistration {
 public:
   virtual const std::vector<UnicodeBlock>& getUnicodeBlock() const = 0;
@@ -45,6 +48,12 @@ public:
 
   virtual const std::string getTeXFontFile() const = 0;
 
+  /**
+   * Get the function that registers this alphabet from the tables compiled into the library
+   * (see prebuilt/alphabet_def.py), or nullptr to parse it from its XML-files
+   */
+  virtual __reg_alphabet_func getBuiltin() const;
+
   virtual ~AlphabetRegistration();
 };
 
@@ -60,6 +69,8 @@ public:
   const std::string getPackage() const override;
 
   const std::string getTeXFontFile() const override;
+
+  __reg_alphabet_func getBuiltin() const override;
 };
 
 class GreekRegistration : public AlphabetRegistration {
@@ -74,8 +85,16 @@ public:
   const std::string getPackage() const override;
 
   const std::string getTeXFontFile() const override;
+
+  __reg_alphabet_func getBuiltin() const override;
 };
 
 }  // namespace tex
 
+#define __alphabet_reg(name) \
+  __reg_alphabet_##name
+
+#define DECL_ALPHABET_REG(name) \
+  extern void __alphabet_reg(name)()
+
 #endif  // ALPHABET_H_INCLUDED
@@ -10,15 +10,16 @@ namespace tex {
 struct Metrics {
   float width, height, depth, italic, size;
 
-  Metrics() = delete;
-
-  Metrics(const Metrics&) = delete;
+  Metrics() : width(0), height(0), depth(0), italic(0), size(0) {}
 
   explicit Metrics(float w, float h, float d, float i, float factor, float s)
     : width(w * factor), height(h * factor), depth(d * factor), italic(i * factor), size(s) {}
 };
 
-/** Represents a specific character in a specific font (identified by its font id) */
+/**
+ * Represents a specific character in a specific font (identified by its font id). A CharFont with
+ * negative font id represents "no character", e.g. the result of a failed ligature lookup.
+ */
 struct CharFont {
   wchar_t chr;
   int fontId, boldFontId;
@@ -29,6 +30,12 @@ struct CharFont {
 
   CharFont(wchar_t c, int f, int bf) : chr(c), fontId(f), boldFontId(bf) {}
 
+  /** Get a CharFont that represents no character */
+  static inline CharFont none() { return CharFont(0, -1); }
+
+  /** Test if this CharFont represents a character */
+  inline bool isValid() const { return fontId >= 0; }
+
 #ifdef HAVE_LOG
 
   friend std::ostream& operator<<(std::ostream& os, const CharFont& info);
@@ -36,75 +43,73 @@ struct CharFont {
 #endif
 };
 
-/** Class represents a character together with its font, font id and metric information */
+/**
+ * Class represents a character together with its font, font id and metric information. It is a
+ * small value type, copy it freely.
+ */
 class Char {
 private:
-  wchar_t _c;
-  int _fontCode;
   const Font* _font;
-  sptr<CharFont> _cf;
-  sptr<Metrics> _m;
+  CharFont _cf;
+  Metrics _m;
 
 public:
-  Char() = delete;
+  /** Create an empty char, represents a missing part of an Extension */
+  Char() : _font(nullptr), _cf(CharFont::none()) {}
 
-  Char(wchar_t c, const Font* f, int fc, const sptr<Metrics>& m);
+  Char(wchar_t c, const Font* f, int fc, const Metrics& m) : _font(f), _cf(c, fc), _m(m) {}
 
-  sptr<CharFont> getCharFont() const { return _cf; }
+  inline const CharFont& getCharFont() const { return _cf; }
 
-  inline wchar_t getChar() const { return _c; }
+  inline wchar_t getChar() const { return _cf.chr; }
 
   inline const Font* getFont() const { return _font; }
 
-  inline int getFontCode() const { return _fontCode; }
+  inline int getFontCode() const { return _cf.fontId; }
+
+  inline bool isValid() const { return _cf.isValid(); }
 
-  inline float getWidth() const { return _m->width; }
+  inline float getWidth() const { return _m.width; }
 
-  inline float getItalic() const { return _m->italic; }
+  inline float getItalic() const { return _m.italic; }
 
-  inline float getHeight() const { return _m->height; }
+  inline float getHeight() const { return _m.height; }
 
-  inline float getDepth() const { return _m->depth; }
+  inline float getDepth() const { return _m.depth; }
 
-  inline float getSize() const { return _m->size; }
+  inline float getSize() const { return _m.size; }
 };
 
 /**
  * Represents an extension character that is defined by Char-objects of it's 4
- * possible parts (null means part not present).
+ * possible parts (an empty Char means part not present).
  */
 class Extension {
 private:
-  const Char* const _top;
-  const Char* const _middle;
-  const Char* const _bottom;
-  const Char* const _repeat;
+  Char _top;
+  Char _middle;
+  Char _repeat;
+  Char _bottom;
 
 public:
-  Extension() = delete;
-
-  Extension(const Extension&) = delete;
-
-  Extension(Char* t, Char* m, Char* r, Char* b)
+  Extension(const Char& t, const Char& m, const Char& r, const Char& b)
     : _top(t), _middle(m), _repeat(r), _bottom(b) {}
 
-  inline bool hasTop() const { return _top != nullptr; }
-
-  inline bool hasMiddle() const { return _middle != nullptr; }
+  inline bool hasTop() const { return _top.isValid(); }
 
-  inline bool hasBottom() const { return _bottom != nullptr; }
+  inline bool hasMiddle() const { return _middle.isValid(); }
 
-  inline bool hasRepeat() const { return _repeat != nullptr; }
+  inline bool hasBottom() const { return _bottom.isValid(); }
 
-  inline const Char& getTop() const { return *_top; }
+  inline bool hasRepeat() const { return _repeat.isValid(); }
 
-  inline const Char& getMiddle() const { return *_middle; }
+  inline const Char& getTop() const { return _top; }
 
-  inline const Char& getRepeat() const { return *_repeat; }
+  inline const Char& getMiddle() const { return _middle; }
 
-  inline const Char& getBottom() const { return *_bottom; }
+  inline const Char& getRepeat() const { return _repeat; }
 
-  ~Extension();
+  inline const Char& getBottom() const { return _bottom; }
 };
 
 }  // namespace tex
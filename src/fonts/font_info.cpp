@@ -10,33 +10,26 @@ vector<FontInfo*> FontInfo::_infos;
 vector<string>    FontInfo::_names;
 
 void FontInfo::__register(const FontSet& set) {
-  const vector<FontReg>& regs = set.regs();
+  __register(set.regs());
+}
+
+void FontInfo::__register(const vector<FontReg>& regs) {
   for (auto r : regs) __predefine_name(r.name);
   for (auto r : regs) r.reg();
 }
 
 const float* const FontInfo::getMetrics(wchar_t ch) const {
-  return _metrics.isEmpty() ? nullptr : _metrics((float)ch) + 1;
+  const float* const item = _metrics(ch);
+  return item == nullptr ? nullptr : item + 1;
 }
 
 const int* const FontInfo::getExtension(wchar_t ch) const {
-  return _extensions.isEmpty() ? nullptr : _extensions((int)ch) + 1;
+  const int* const item = _extensions(ch);
+  return item == nullptr ? nullptr : item + 1;
 }
 
-//sptr<CharFont> FontInfo::getNextLarger(wchar_t ch) const {
-//  const int* const item = _nextLargers((int)ch);
-//  if (item == nullptr) return nullptr;
-//  return sptrOf<CharFont>(item[1], item[2]);
-//}
-
-//sptr<CharFont> FontInfo::getLigture(wchar_t left, wchar_t right) const {
-//  const wchar_t* const item = _lig(left, right);
-//  if (item == nullptr) return nullptr;
-//  return sptrOf<CharFont>(item[2], _id);
-//}
-
 float FontInfo::getKern(wchar_t left, wchar_t right, float factor) const {
-  const float* const item = _kern((float)left, (float)right);
+  const float* const item = _kern(left, right);
   if (item == nullptr) return 0;
   return item[2] * factor;
 }
@@ -55,7 +48,7 @@ void FontInfo::setVariousId(
 }
 
 const Font* FontInfo::getFont() {
-  if (_font == nullptr) _font = Font::create(_path, Formula::PIXELS_PER_POINT);
+  std::call_once(_fontFlag, [this] { _font = Font::create(_path, Formula::PIXELS_PER_POINT); });
   return _font;
 }
 
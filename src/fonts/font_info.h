@@ -1,15 +1,16 @@
 #ifndef FONT_INFO_H_INCLUDED
 #define FONT_INFO_H_INCLUDED
 
+#include <mutex>
+
 #include "common.h"
 #include "fonts/font_basic.h"
+#include "fonts/font_reg.h"
 #include "graphic/graphic.h"
 #include "utils/indexed_arr.h"
 
 namespace tex {
 
-class FontSet;
-
 class FontInfo {
 private:
   static std::vector<FontInfo*> _infos;
@@ -17,8 +18,11 @@ private:
 
   const int _id;    // id of this font info
   const Font* _font;  // font of this info
+  std::once_flag _fontFlag;  // the font is created on first use, from any thread
   const std::string _path;  // font file path
 
+  // all the tables are directly indexed by the character code if the font is
+  // dense enough, see IndexedArray
   IndexedArray<int, 5, 1> _extensions;   // extensions for big delimiter
   IndexedArray<int, 3, 1> _nextLargers;  // largers, e.g. sigma
   IndexedArray<float, 5, 1> _metrics;      // metrics
@@ -75,6 +79,9 @@ public:
 
   static void __register(const FontSet& set);
 
+  /** Register the given fonts, their names are defined first so they may refer to each other */
+  static void __register(const std::vector<FontReg>& regs);
+
   static void __free();
 
   inline void __metrics(const float* arr, int len, bool autoDelete = false) {
@@ -121,22 +128,18 @@ public:
 
   const int* const getExtension(wchar_t ch) const;
 
-  // FIXME
-  // workaround for the MSVC's LNK2019 error
-  // it should be implemented in the font_info.cpp file
-  sptr<CharFont> getNextLarger(wchar_t ch) const {
-    const int* const item = _nextLargers((int) ch);
-    if (item == nullptr) return nullptr;
-    return sptrOf<CharFont>(item[1], item[2]);
+  /** Get the next larger version of the given character, or CharFont::none() if no any */
+  CharFont getNextLarger(wchar_t ch) const {
+    const int* const item = _nextLargers(ch);
+    if (item == nullptr) return CharFont::none();
+    return CharFont(item[1], item[2]);
   }
 
-  // FIXME
-  // workaround for the MSVS's LNK2019 error
-  // it should be implemented in the font_info.cpp file
-  sptr<CharFont> getLigture(wchar_t left, wchar_t right) const {
+  /** Get the ligature of the given characters, or CharFont::none() if no any */
+  CharFont getLigture(wchar_t left, wchar_t right) const {
     const wchar_t* const item = _lig(left, right);
-    if (item == nullptr) return nullptr;
-    return sptrOf<CharFont>(item[2], _id);
+    if (item == nullptr) return CharFont::none();
+    return CharFont(item[2], _id);
   }
 
   float getKern(wchar_t left, wchar_t right, float factor) const;
@@ -16,7 +16,10 @@ const int TeXFont::NO_FONT = -1;
 string* DefaultTeXFont::_defaultTextStyleMappings;
 map<string, vector<CharFont*>> DefaultTeXFont::_textStyleMappings;
 map<string, CharFont*> DefaultTeXFont::_symbolMappings;
-map<string, float> DefaultTeXFont::_generalSettings;
+map<string, int> DefaultTeXFont::_symbolIds;
+vector<const CharFont*> DefaultTeXFont::_symbolTable;
+bool DefaultTeXFont::_symbolTableBuilt = false;
+__general_settings DefaultTeXFont::_generalSettings;
 vector<UnicodeBlock> DefaultTeXFont::_loadedAlphabets;
 map<UnicodeBlock, AlphabetRegistration*> DefaultTeXFont::_registeredAlphabets;
 
@@ -55,7 +58,10 @@ void DefaultTeXFont::__register_symbols_set(const SymbolsSet& set) {
 void DefaultTeXFont::__push_symbols(const __symbol_component* symbols, const int len) {
   for (int i = 0; i < len; i++) {
     const __symbol_component& c = symbols[i];
-    _symbolMappings[c.name] = new CharFont(c.code, c.font);
+    // an alphabet may map a symbol again, like DefaultTeXFontParser#parseSymbolMappings
+    CharFont*& f = _symbolMappings[c.name];
+    delete f;
+    f = new CharFont(c.code, c.font);
   }
 }
 
@@ -69,28 +75,36 @@ void DefaultTeXFont::addTeXFontDescription(
   parser.parseSymbolMappings(_symbolMappings);
 }
 
+bool DefaultTeXFont::isAlphabetLoaded(const vector<UnicodeBlock>& alphabet) {
+  for (const auto& block : alphabet) {
+    if (indexOf(_loadedAlphabets, block) != -1) return true;
+  }
+  return false;
+}
+
 void DefaultTeXFont::addAlphabet(
   const string& base,
   const vector<UnicodeBlock>& alphabet,
   const string& lang) {
-  bool b = false;
-  for (size_t i = 0; !b && i < alphabet.size(); i++) {
-    b = (indexOf(_loadedAlphabets, alphabet[i]) != -1) || b;
-  }
-  if (!b) {
-    TeXParser::_isLoading = true;
-    string file = lang;
-    addTeXFontDescription(base, file);
-    for (size_t i = 0; i < alphabet.size(); i++) {
-      _loadedAlphabets.push_back(alphabet[i]);
-    }
-    TeXParser::_isLoading = false;
-  }
+  if (isAlphabetLoaded(alphabet)) return;
+  addTeXFontDescription(base, lang);
+  for (const auto& block : alphabet) _loadedAlphabets.push_back(block);
+}
+
+void DefaultTeXFont::addAlphabet(__reg_alphabet_func reg, const vector<UnicodeBlock>& alphabet) {
+  if (isAlphabetLoaded(alphabet)) return;
+  reg();
+  for (const auto& block : alphabet) _loadedAlphabets.push_back(block);
 }
 
 void DefaultTeXFont::addAlphabet(AlphabetRegistration* reg) {
   try {
-    addAlphabet(reg->getPackage(), reg->getUnicodeBlock(), reg->getTeXFontFile());
+    const __reg_alphabet_func builtin = reg->getBuiltin();
+    if (builtin != nullptr) {
+      addAlphabet(builtin, reg->getUnicodeBlock());
+    } else {
+      addAlphabet(reg->getPackage(), reg->getUnicodeBlock(), reg->getTeXFontFile());
+    }
   } catch (ex_font_loaded& e) {
   } catch (ex_alphabet_registration& e) {
 #ifdef HAVE_LOG
@@ -100,15 +114,56 @@ void DefaultTeXFont::addAlphabet(AlphabetRegistration* reg) {
 }
 
 void DefaultTeXFont::registerAlphabet(AlphabetRegistration* reg) {
+  // the symbol table holds the mappings of the loaded alphabets, they cannot change anymore
+  if (_symbolTableBuilt) {
+    throw ex_invalid_state("Cannot register an alphabet after LaTeX::init!");
+  }
   const vector<UnicodeBlock>& blocks = reg->getUnicodeBlock();
   for (size_t i = 0; i < blocks.size(); i++) {
     _registeredAlphabets[blocks[i]] = reg;
   }
 }
 
+void DefaultTeXFont::loadRegisteredAlphabets() {
+  for (auto i : _registeredAlphabets) {
+    try {
+      addAlphabet(i.second);
+    } catch (ex_res_parse& e) {
+#ifdef HAVE_LOG
+      __dbg("%s", e.what());
+#endif  // HAVE_LOG
+    }
+  }
+}
+
+void DefaultTeXFont::buildSymbolTable() {
+  _symbolIds.clear();
+  _symbolTable.clear();
+  _symbolTable.reserve(_symbolMappings.size());
+  for (const auto& i : _symbolMappings) {
+    _symbolIds[i.first] = (int) _symbolTable.size();
+    _symbolTable.push_back(i.second);
+  }
+  _symbolTableBuilt = true;
+}
+
+int DefaultTeXFont::symbolId(const string& name) {
+  if (!_symbolTableBuilt) return -1;
+  const auto it = _symbolIds.find(name);
+  return it == _symbolIds.end() ? -1 : it->second;
+}
+
+float DefaultTeXFont::getParameter(const string& name) {
+  for (int i = 0; i < static_cast<int>(TeXParam::count); i++) {
+    if (name == _parameterNames[i]) return _parameters[i];
+  }
+  return 0;
+}
+
 sptr<TeXFont> DefaultTeXFont::copy() {
-  return sptrOf<DefaultTeXFont>(
-    _size, _factor, _isBold, _isRoman, _isSs, _isTt, _isIt);
+  auto tf = sptrOf<DefaultTeXFont>(_size, _factor, _isBold, _isRoman, _isSs, _isTt, _isIt);
+  tf->setSizeFactors(_textFactor, _scriptFactor, _scriptScriptFactor);
+  return tf;
 }
 
 Char DefaultTeXFont::getChar(wchar_t c, const vector<CharFont*>& cf, TexStyle style) {
@@ -204,15 +259,17 @@ Char DefaultTeXFont::getChar(
   return getChar(*(i->second), style);
 }
 
-sptr<Metrics> DefaultTeXFont::getMetrics(const CharFont& cf, float size) {
+Char DefaultTeXFont::getChar(int symbolId, TexStyle style) {
+  return getChar(*_symbolTable[symbolId], style);
+}
+
+Metrics DefaultTeXFont::getMetrics(const CharFont& cf, float size) {
   auto info = getInfo(cf.fontId);
   const float* m = info->getMetrics(cf.chr);
-  Metrics* met = new Metrics(
-    m[WIDTH], m[HEIGHT], m[DEPTH], m[IT], size * Formula::PIXELS_PER_POINT, size);
-  return sptr<Metrics>(met);
+  return Metrics(m[WIDTH], m[HEIGHT], m[DEPTH], m[IT], size * Formula::PIXELS_PER_POINT, size);
 }
 
-Extension* DefaultTeXFont::getExtension(const Char& c, TexStyle style) {
+Extension DefaultTeXFont::getExtension(const Char& c, TexStyle style) {
   const Font* f = c.getFont();
   int fc = c.getFontCode();
   float s = getSizeFactor(style);
@@ -220,16 +277,11 @@ Extension* DefaultTeXFont::getExtension(const Char& c, TexStyle style) {
   auto info = getInfo(fc);
   const int* ext = info->getExtension(c.getChar());
   // 4 parts of extensions, TOP, MID, REP, BOT
-  Char* parts[4] = {nullptr};
+  Char parts[4];
   for (int i = 0; i < 4; i++) {
-    if (ext[i] == NONE) {
-      parts[i] = nullptr;
-    } else {
-      auto m = getMetrics(CharFont(ext[i], fc), s);
-      parts[i] = new Char(ext[i], f, fc, m);
-    }
+    if (ext[i] != NONE) parts[i] = Char(ext[i], f, fc, getMetrics(CharFont(ext[i], fc), s));
   }
-  return new Extension(parts[TOP], parts[MID], parts[REP], parts[BOT]);
+  return Extension(parts[TOP], parts[MID], parts[REP], parts[BOT]);
 }
 
 float DefaultTeXFont::getKern(const CharFont& left, const CharFont& right, TexStyle style) {
@@ -240,36 +292,35 @@ float DefaultTeXFont::getKern(const CharFont& left, const CharFont& right, TexSt
   return 0;
 }
 
-sptr<CharFont> DefaultTeXFont::getLigature(const CharFont& left, const CharFont& right) {
+CharFont DefaultTeXFont::getLigature(const CharFont& left, const CharFont& right) {
   if (left.fontId == right.fontId) {
     auto info = getInfo(left.fontId);
     return info->getLigture(left.chr, right.chr);
   }
-  return nullptr;
+  return CharFont::none();
 }
 
 int DefaultTeXFont::getMuFontId() {
-  return _generalSettings[DefaultTeXFontParser::MUFONTID_ATTR];
+  return _generalSettings.muFontId;
 }
 
 Char DefaultTeXFont::getNextLarger(const Char& c, TexStyle style) {
   auto info = getInfo(c.getFontCode());
-  auto ch = info->getNextLarger(c.getChar());
-  auto newInfo = getInfo(ch->fontId);
-  return Char(ch->chr, newInfo->getFont(), ch->fontId, getMetrics(*ch, getSizeFactor(style)));
+  const CharFont ch = info->getNextLarger(c.getChar());
+  auto newInfo = getInfo(ch.fontId);
+  return Char(ch.chr, newInfo->getFont(), ch.fontId, getMetrics(ch, getSizeFactor(style)));
 }
 
 float DefaultTeXFont::getSpace(TexStyle style) {
-  int spaceFontId = _generalSettings[DefaultTeXFontParser::SPACEFONTID_ATTR];
-  auto info = getInfo(spaceFontId);
+  auto info = getInfo(_generalSettings.spaceFontId);
   return info->getSpace(getSizeFactor(style) * Formula::PIXELS_PER_POINT);
 }
 
 void DefaultTeXFont::setMathSizes(float ds, float ts, float ss, float sss) {
   if (!_magnificationEnable) return;
-  _generalSettings["scriptfactor"] = abs(ss / ds);
-  _generalSettings["scriptscriptfactor"] = abs(sss / ds);
-  _generalSettings["textfactor"] = abs(ts / ds);
+  _generalSettings.scriptFactor = abs(ss / ds);
+  _generalSettings.scriptScriptFactor = abs(sss / ds);
+  _generalSettings.textFactor = abs(ts / ds);
   TeXRender::_defaultSize = abs(ds);
 }
 
@@ -341,11 +392,22 @@ void DefaultTeXFont::log() {
   __log << endl;
   // parameters
   __log << "PARAMETERS:" << endl;
-  for (auto i : _parameters) __log << setw(20) << i.first << " : " << i.second << endl;
+  for (int i = 0; i < static_cast<int>(TeXParam::count); i++) {
+    __log << setw(20) << _parameterNames[i] << " : " << _parameters[i] << endl;
+  }
   __log << endl;
   // general settings
   __log << "GENERALSETTINGS:" << endl;
-  for (auto i : _generalSettings) __log << setw(20) << i.first << " : " << i.second << endl;
+  __log << setw(20) << "mufontid"
+        << " : " << _generalSettings.muFontId << endl;
+  __log << setw(20) << "spacefontid"
+        << " : " << _generalSettings.spaceFontId << endl;
+  __log << setw(20) << "textfactor"
+        << " : " << _generalSettings.textFactor << endl;
+  __log << setw(20) << "scriptfactor"
+        << " : " << _generalSettings.scriptFactor << endl;
+  __log << setw(20) << "scriptscriptfactor"
+        << " : " << _generalSettings.scriptScriptFactor << endl;
   __log << endl;
   // symbol mappings
   __log << "SYMBOL MAPPINGS:" << endl
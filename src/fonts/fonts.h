@@ -22,6 +22,39 @@ typedef struct {
   std::string name;
 } __symbol_component;
 
+/** The general settings of the DefaultTeXFont */
+typedef struct {
+  int muFontId;
+  int spaceFontId;
+  float textFactor;
+  float scriptFactor;
+  float scriptScriptFactor;
+} __general_settings;
+
+/** The TeX font parameters, indexes the DefaultTeXFont's parameter table */
+enum class TeXParam : i8 {
+  num1,
+  num2,
+  num3,
+  denom1,
+  denom2,
+  sup1,
+  sup2,
+  sup3,
+  sub1,
+  sub2,
+  supdrop,
+  subdrop,
+  axisheight,
+  defaultrulethickness,
+  bigopspacing1,
+  bigopspacing2,
+  bigopspacing3,
+  bigopspacing4,
+  bigopspacing5,
+  count
+};
+
 class SymbolsSet;
 
 /**
@@ -33,15 +66,22 @@ private:
   static std::string* _defaultTextStyleMappings;
   static std::map<std::string, std::vector<CharFont*>> _textStyleMappings;
   static std::map<std::string, CharFont*> _symbolMappings;
-  static std::map<std::string, float> _parameters;
-  static std::map<std::string, float> _generalSettings;
+  // the symbol mappings indexed by the symbol ids, built once after initialization
+  static std::map<std::string, int> _symbolIds;
+  static std::vector<const CharFont*> _symbolTable;
+  static bool _symbolTableBuilt;
+  static const float _parameters[static_cast<int>(TeXParam::count)];
+  static const char* const _parameterNames[static_cast<int>(TeXParam::count)];
+  static __general_settings _generalSettings;
   static bool _magnificationEnable;
 
   float _factor, _size;
+  // the size factors of the text, script and script-script styles, see #setSizeFactors
+  float _textFactor, _scriptFactor, _scriptScriptFactor;
 
   Char getChar(wchar_t c, const std::vector<CharFont*>& cf, TexStyle style);
 
-  sptr<Metrics> getMetrics(const CharFont& cf, float size);
+  Metrics getMetrics(const CharFont& cf, float size);
 
   inline FontInfo* getInfo(int id) { return FontInfo::__get(id); }
 
@@ -49,6 +89,9 @@ private:
 
   static void __default_text_style_mapping();
 
+  /** Test if one of the given blocks is already loaded */
+  static bool isAlphabetLoaded(const std::vector<UnicodeBlock>& alphabet);
+
 public:
   static std::vector<UnicodeBlock> _loadedAlphabets;
   static std::map<UnicodeBlock, AlphabetRegistration*> _registeredAlphabets;
@@ -74,6 +117,9 @@ public:
     bool it = false)
       : _size(pointSize),
         _factor(f),
+        _textFactor(_generalSettings.textFactor),
+        _scriptFactor(_generalSettings.scriptFactor),
+        _scriptScriptFactor(_generalSettings.scriptScriptFactor),
         _isBold(b),
         _isRoman(rm),
         _isSs(ss),
@@ -93,26 +139,65 @@ public:
     const std::vector<UnicodeBlock>& alphabet,
     const std::string& lang);
 
+  /** Add the alphabet of the given blocks from its compiled tables, see res/alphabet_def.res.h */
+  static void addAlphabet(__reg_alphabet_func reg, const std::vector<UnicodeBlock>& alphabet);
+
+  /**
+   * Register the alphabet of the given blocks, it is loaded by LaTeX::init (see
+   * #loadRegisteredAlphabets) and owned by this class from now on. The registration is
+   * from its compiled tables if it has some, from its XML-files otherwise.
+   *
+   * @throw ex_invalid_state if called after LaTeX::init, the font tables are read-only then
+   */
   static void registerAlphabet(AlphabetRegistration* reg);
 
-  inline static float getParameter(const std::string& name) {
-    auto it = _parameters.find(name);
-    if (it == _parameters.end()) return 0;
-    return it->second;
+  /**
+   * Load all the registered alphabets. The font tables are read-only after
+   * the initialization, so the alphabets are loaded here rather than on the
+   * first parsed character of its blocks.
+   */
+  static void loadRegisteredAlphabets();
+
+  /**
+   * Assign the dense ids to the symbol mappings. Called once all the alphabets
+   * are loaded, the symbol mappings are read-only after that.
+   */
+  static void buildSymbolTable();
+
+  /**
+   * Get the id of the symbol mapping with the given name, or -1 if not found or the symbol table
+   * has not been built yet
+   */
+  static int symbolId(const std::string& name);
+
+  static float getParameter(const std::string& name);
+
+  inline static float getParameter(TeXParam param) {
+    return _parameters[static_cast<int>(param)];
   }
 
   /**
    * Get the size factor of given style
    */
-  inline static float getSizeFactor(TexStyle style) {
+  inline float getSizeFactor(TexStyle style) const {
     if (style < TexStyle::text) return 1;
-    if (style < TexStyle::script) return _generalSettings["textfactor"];
-    if (style < TexStyle::scriptScript) return _generalSettings["scriptfactor"];
-    return _generalSettings["scriptscriptfactor"];
+    if (style < TexStyle::script) return _textFactor;
+    if (style < TexStyle::scriptScript) return _scriptFactor;
+    return _scriptScriptFactor;
+  }
+
+  /**
+   * Set the size factors of the text, script and script-script styles relative to the display
+   * style, they default to the ones set by #setMathSizes
+   */
+  inline void setSizeFactors(float text, float script, float scriptScript) {
+    _textFactor = text;
+    _scriptFactor = script;
+    _scriptScriptFactor = scriptScript;
   }
 
-  inline float styleParam(const std::string& name, TexStyle style) {
-    return getParameter(name) * getSizeFactor(style) * Formula::PIXELS_PER_POINT;
+  inline float styleParam(TeXParam param, TexStyle style) {
+    return getParameter(param) * getSizeFactor(style) * Formula::PIXELS_PER_POINT;
   }
 
   /************************************ get char ************************************************/
@@ -128,13 +213,15 @@ public:
 
   Char getChar(const std::string& symbolName, TexStyle style) override;
 
+  Char getChar(int symbolId, TexStyle style) override;
+
   /*********************************** font information *****************************************/
 
-  Extension* getExtension(const Char& c, TexStyle style) override;
+  Extension getExtension(const Char& c, TexStyle style) override;
 
   float getKern(const CharFont& left, const CharFont& right, TexStyle style) override;
 
-  sptr<CharFont> getLigature(const CharFont& left, const CharFont& right) override;
+  CharFont getLigature(const CharFont& left, const CharFont& right) override;
 
   Char getNextLarger(const Char& c, TexStyle style) override;
 
@@ -142,44 +229,44 @@ public:
 
   inline float getScaleFactor() override { return _factor; }
 
-  inline float getAxisHeight(TexStyle style) override { return styleParam("axisheight", style); }
+  inline float getAxisHeight(TexStyle style) override { return styleParam(TeXParam::axisheight, style); }
 
-  inline float getBigOpSpacing1(TexStyle style) override { return styleParam("bigopspacing1", style); }
+  inline float getBigOpSpacing1(TexStyle style) override { return styleParam(TeXParam::bigopspacing1, style); }
 
-  inline float getBigOpSpacing2(TexStyle style) override { return styleParam("bigopspacing2", style); }
+  inline float getBigOpSpacing2(TexStyle style) override { return styleParam(TeXParam::bigopspacing2, style); }
 
-  inline float getBigOpSpacing3(TexStyle style) override { return styleParam("bigopspacing3", style); }
+  inline float getBigOpSpacing3(TexStyle style) override { return styleParam(TeXParam::bigopspacing3, style); }
 
-  inline float getBigOpSpacing4(TexStyle style) override { return styleParam("bigopspacing4", style); }
+  inline float getBigOpSpacing4(TexStyle style) override { return styleParam(TeXParam::bigopspacing4, style); }
 
-  inline float getBigOpSpacing5(TexStyle style) override { return styleParam("bigopspacing5", style); }
+  inline float getBigOpSpacing5(TexStyle style) override { return styleParam(TeXParam::bigopspacing5, style); }
 
-  inline float getNum1(TexStyle style) override { return styleParam("num1", style); }
+  inline float getNum1(TexStyle style) override { return styleParam(TeXParam::num1, style); }
 
-  inline float getNum2(TexStyle style) override { return styleParam("num2", style); }
+  inline float getNum2(TexStyle style) override { return styleParam(TeXParam::num2, style); }
 
-  inline float getNum3(TexStyle style) override { return styleParam("num3", style); }
+  inline float getNum3(TexStyle style) override { return styleParam(TeXParam::num3, style); }
 
-  inline float getSub1(TexStyle style) override { return styleParam("sub1", style); }
+  inline float getSub1(TexStyle style) override { return styleParam(TeXParam::sub1, style); }
 
-  inline float getSub2(TexStyle style) override { return styleParam("sub2", style); }
+  inline float getSub2(TexStyle style) override { return styleParam(TeXParam::sub2, style); }
 
-  inline float getSubDrop(TexStyle style) override { return styleParam("subdrop", style); }
+  inline float getSubDrop(TexStyle style) override { return styleParam(TeXParam::subdrop, style); }
 
-  inline float getSup1(TexStyle style) override { return styleParam("sup1", style); }
+  inline float getSup1(TexStyle style) override { return styleParam(TeXParam::sup1, style); }
 
-  inline float getSup2(TexStyle style) override { return styleParam("sup2", style); }
+  inline float getSup2(TexStyle style) override { return styleParam(TeXParam::sup2, style); }
 
-  inline float getSup3(TexStyle style) override { return styleParam("sup3", style); }
+  inline float getSup3(TexStyle style) override { return styleParam(TeXParam::sup3, style); }
 
-  inline float getSupDrop(TexStyle style) override { return styleParam("supdrop", style); }
+  inline float getSupDrop(TexStyle style) override { return styleParam(TeXParam::supdrop, style); }
 
-  inline float getDenom1(TexStyle style) override { return styleParam("denom1", style); }
+  inline float getDenom1(TexStyle style) override { return styleParam(TeXParam::denom1, style); }
 
-  inline float getDenom2(TexStyle style) override { return styleParam("denom2", style); }
+  inline float getDenom2(TexStyle style) override { return styleParam(TeXParam::denom2, style); }
 
   inline float getDefaultRuleThickness(TexStyle style) override {
-    return styleParam("defaultrulethickness", style);
+    return styleParam(TeXParam::defaultrulethickness, style);
   }
 
   inline float getQuad(TexStyle style, int fontCode) override {
@@ -210,7 +297,7 @@ public:
 
   inline bool hasNextLarger(const Char& c) override {
     FontInfo* info = getInfo(c.getFontCode());
-    return info->getNextLarger(c.getChar()) != nullptr;
+    return info->getNextLarger(c.getChar()).isValid();
   }
 
   inline void setBold(bool bold) override { _isBold = bold; }
@@ -244,7 +331,8 @@ public:
   }
 
   /**
-   * Set the various sizes of the envrionment
+   * Set the various sizes of the envrionment, for all the renders built afterwards. It is not
+   * thread-safe, call it before parsing; \DeclareMathSizes sets them for one formula.
    */
   static void setMathSizes(
     float defaultSize,
@@ -252,10 +340,16 @@ public:
     float scriptStyleSize,
     float scriptsScriptStyleSize);
 
+  /**
+   * Set the magnification of all the renders built afterwards. It is not thread-safe, call it
+   * before parsing; \magnification sets it for one formula.
+   */
   static void setMagnification(float mag);
 
   static void enableMagnification(bool b);
 
+  inline static bool isMagnificationEnabled() { return _magnificationEnable; }
+
   /**
    * initialize the class (actually load resources), must be called before use
    */
@@ -68,6 +68,16 @@ public:
    */
   virtual Char getChar(const std::string& name, TexStyle style) = 0;
 
+  /**
+   * Get a Char-object for the symbol with the given id, see DefaultTeXFont::symbolId
+   * @param symbolId
+   *      the symbol id
+   * @param style
+   *      the style in which the atom should be drawn
+   * @return a Char-object for this symbol with metric information
+   */
+  virtual Char getChar(int symbolId, TexStyle style) = 0;
+
   /**
    * Get a Char-object specifying the given character in the default text style
    * with metric information depending on the given "style"
@@ -95,7 +105,7 @@ public:
    *      the style in which the atom should be drawn
    * @return an extension object containing the 4 possible parts
    */
-  virtual Extension* getExtension(const Char& c, TexStyle style) = 0;
+  virtual Extension getExtension(const Char& c, TexStyle style) = 0;
 
   /**
    * Get the kern value to be inserted between the given characters in the
@@ -116,9 +126,9 @@ public:
    *      left character
    * @param right
    *      right character
-   * @return a ligature replacing both characters (or null if no any ligature)
+   * @return a ligature replacing both characters (or CharFont::none() if no any ligature)
    */
-  virtual sptr<CharFont> getLigature(const CharFont& left, const CharFont& right) = 0;
+  virtual CharFont getLigature(const CharFont& left, const CharFont& right) = 0;
 
   /**
    * Get the id of mu font
@@ -0,0 +1,151 @@
+#include "glyph_cache.h"
+
+#include "fonts/font_info.h"
+
+using namespace std;
+using namespace tex;
+
+namespace {
+
+/** Estimate the size in bytes of the given glyph parts */
+size_t bytesOf(const GlyphOutline& outline) {
+  return sizeof(GlyphOutline) + 32 + outline.verbs.size() + outline.points.size() * sizeof(Point);
+}
+
+size_t bytesOf(const GlyphMask& mask) {
+  return sizeof(GlyphMask) + 32 + mask.coverage.size();
+}
+
+}  // namespace
+
+mutex GlyphCache::_fontsLock;
+unordered_map<string, i32> GlyphCache::_fonts;
+
+size_t GlyphCache::Key::Hash::operator()(const Key& k) const {
+  size_t h = hash<i32>()(k.font);
+  const auto mix = [&h](size_t v) { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+  mix(hash<u32>()(k.code));
+  mix(hash<u32>()(k.size));
+  return h;
+}
+
+GlyphCache::GlyphCache(size_t budget, size_t shards)
+  : _shardBudget(budget / max<size_t>(shards, 1)), _shards(max<size_t>(shards, 1)) {}
+
+GlyphCache& GlyphCache::instance() {
+  static GlyphCache cache;
+  return cache;
+}
+
+i32 GlyphCache::fontId(const string& file) {
+  lock_guard<mutex> guard(_fontsLock);
+  const auto it = _fonts.find(file);
+  if (it != _fonts.end()) return it->second;
+  i32 id = -1;
+  for (const FontInfo* info : FontInfo::__infos()) {
+    if (info != nullptr && info->getPath() == file) {
+      id = info->getId();
+      break;
+    }
+  }
+  if (id < 0) {
+    // below the ids of the other files
+    id = -1;
+    for (const auto& font : _fonts) id = min(id, font.second - 1);
+  }
+  _fonts[file] = id;
+  return id;
+}
+
+GlyphCache::Shard& GlyphCache::shardOf(const Key& key) {
+  // the low bits pick the bucket in the shard, take the high ones to pick the shard
+  const size_t h = Key::Hash()(key);
+  return _shards[(h >> (sizeof(size_t) * 4)) % _shards.size()];
+}
+
+GlyphCache::Entry& GlyphCache::entryOf(Shard& shard, const Key& key) {
+  const auto r = shard.entries.try_emplace(key);
+  if (r.second) shard.ring.push_back(key);
+  return r.first->second;
+}
+
+void GlyphCache::grow(Shard& shard, Entry& entry, size_t bytes) {
+  entry.bytes += bytes;
+  shard.bytes += bytes;
+  while (shard.bytes > _shardBudget && !shard.ring.empty()) {
+    if (shard.hand >= shard.ring.size()) shard.hand = 0;
+    const auto it = shard.entries.find(shard.ring[shard.hand]);
+    if (&it->second != &entry && !it->second.used.exchange(false, memory_order_relaxed)) {
+      shard.bytes -= it->second.bytes;
+      shard.entries.erase(it);
+      shard.ring[shard.hand] = shard.ring.back();
+      shard.ring.pop_back();
+    } else {
+      shard.hand++;
+    }
+    // the entry being grown is larger than the whole budget
+    if (shard.ring.size() == 1) break;
+  }
+}
+
+sptr<const GlyphOutline> GlyphCache::findOutline(const Key& key) {
+  Shard& shard = shardOf(key);
+  shared_lock<shared_mutex> guard(shard.lock);
+  const auto it = shard.entries.find(key);
+  if (it == shard.entries.end() || it->second.outline == nullptr) return nullptr;
+  it->second.used.store(true, memory_order_relaxed);
+  return it->second.outline;
+}
+
+sptr<const GlyphOutline> GlyphCache::putOutline(const Key& key, GlyphOutline&& outline) {
+  const size_t bytes = bytesOf(outline);
+  auto value = sptrOf<const GlyphOutline>(std::move(outline));
+  Shard& shard = shardOf(key);
+  unique_lock<shared_mutex> guard(shard.lock);
+  Entry& entry = entryOf(shard, key);
+  // built by another thread in the meantime
+  if (entry.outline != nullptr) return entry.outline;
+  entry.outline = value;
+  grow(shard, entry, bytes);
+  return value;
+}
+
+sptr<const GlyphMask> GlyphCache::findMask(const Key& key, int subpixel) {
+  Shard& shard = shardOf(key);
+  shared_lock<shared_mutex> guard(shard.lock);
+  const auto it = shard.entries.find(key);
+  if (it == shard.entries.end() || it->second.masks[subpixel] == nullptr) return nullptr;
+  it->second.used.store(true, memory_order_relaxed);
+  return it->second.masks[subpixel];
+}
+
+sptr<const GlyphMask> GlyphCache::putMask(const Key& key, int subpixel, GlyphMask&& mask) {
+  const size_t bytes = bytesOf(mask);
+  auto value = sptrOf<const GlyphMask>(std::move(mask));
+  Shard& shard = shardOf(key);
+  unique_lock<shared_mutex> guard(shard.lock);
+  Entry& entry = entryOf(shard, key);
+  if (entry.masks[subpixel] != nullptr) return entry.masks[subpixel];
+  entry.masks[subpixel] = value;
+  grow(shard, entry, bytes);
+  return value;
+}
+
+void GlyphCache::clear() {
+  for (auto& shard : _shards) {
+    unique_lock<shared_mutex> guard(shard.lock);
+    shard.entries.clear();
+    shard.ring.clear();
+    shard.hand = 0;
+    shard.bytes = 0;
+  }
+}
+
+size_t GlyphCache::bytes() {
+  size_t bytes = 0;
+  for (auto& shard : _shards) {
+    shared_lock<shared_mutex> guard(shard.lock);
+    bytes += shard.bytes;
+  }
+  return bytes;
+}
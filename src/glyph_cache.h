@@ -0,0 +1,204 @@
+#ifndef GLYPH_CACHE_H_INCLUDED
+#define GLYPH_CACHE_H_INCLUDED
+
+#include "common.h"
+#include "graphic/graphic_basic.h"
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tex {
+
+/**
+ * The outline of a glyph in pixels, relative to its origin with the y-axis pointing down, as
+ * a sequence of verbs and the points they take.
+ */
+struct GlyphOutline {
+  enum Verb : u8 {
+    move,   // 1 point, starts a contour
+    line,   // 1 point
+    quad,   // 2 points, the control point and the end
+    close   // no point, closes the contour
+  };
+
+  std::vector<u8> verbs;
+  std::vector<Point> points;
+
+  inline void moveTo(const Point& p) {
+    verbs.push_back(move);
+    points.push_back(p);
+  }
+
+  inline void lineTo(const Point& p) {
+    verbs.push_back(line);
+    points.push_back(p);
+  }
+
+  inline void quadTo(const Point& c, const Point& p) {
+    verbs.push_back(quad);
+    points.push_back(c);
+    points.push_back(p);
+  }
+
+  inline void closePath() { verbs.push_back(close); }
+
+  inline bool isEmpty() const { return verbs.empty(); }
+
+  /**
+   * Replay the outline translated by (dx, dy) into the given sink, it must have the methods
+   * moveTo(Point), lineTo(Point), quadTo(Point, Point) and close()
+   */
+  template <typename Sink>
+  void replay(Sink& sink, float dx = 0, float dy = 0) const {
+    const Point* p = points.data();
+    for (u8 v : verbs) {
+      switch (v) {
+        case move:
+          sink.moveTo(Point(p[0].x + dx, p[0].y + dy));
+          p++;
+          break;
+        case line:
+          sink.lineTo(Point(p[0].x + dx, p[0].y + dy));
+          p++;
+          break;
+        case quad:
+          sink.quadTo(Point(p[0].x + dx, p[0].y + dy), Point(p[1].x + dx, p[1].y + dy));
+          p += 2;
+          break;
+        default:
+          sink.close();
+          break;
+      }
+    }
+  }
+};
+
+/** The alpha mask of a rasterized glyph, its box in pixels is relative to its origin */
+struct GlyphMask {
+  int left = 0, top = 0, width = 0, height = 0;
+  std::vector<u8> coverage;
+};
+
+/**
+ * A cache of glyph shapes shared by all the renders and all the backends. The glyphs are
+ * keyed by the font they come from, the character code and the size in pixels per em
+ * (quantized to 1/64 pixel), each one holds its outline and the masks it is rasterized to
+ * (one per horizontal sub-pixel offset of 1/4 pixel), both are built by the backends on the
+ * first miss and handed out as shared pointers, so they stay valid after they are evicted.
+ *
+ * The cache is split into shards, looking a glyph up takes a shared lock on its shard so the
+ * threads drawing the same glyphs do not wait for each other. A shard evicts the glyphs that
+ * were not looked up recently (with the clock algorithm) once it goes over its part of the
+ * budget.
+ */
+class GlyphCache {
+public:
+  static constexpr int SIZE_STEPS = 64;
+  static constexpr int SUBPIXEL_STEPS = 4;
+
+  struct Key {
+    // the id of the FontInfo of the glyph, see GlyphCache#fontId
+    i32 font;
+    u32 code;
+    u32 size;
+
+    inline bool operator==(const Key& k) const {
+      return font == k.font && code == k.code && size == k.size;
+    }
+
+    struct Hash {
+      size_t operator()(const Key& k) const;
+    };
+  };
+
+private:
+  struct Entry {
+    sptr<const GlyphOutline> outline;
+    sptr<const GlyphMask> masks[SUBPIXEL_STEPS];
+    size_t bytes = 0;
+    // set on lookups, cleared when the clock hand passes
+    mutable std::atomic<bool> used;
+
+    Entry() : used(true) {}
+  };
+
+  struct Shard {
+    std::shared_mutex lock;
+    std::unordered_map<Key, Entry, Key::Hash> entries;
+    // the keys in the order the clock hand visits them
+    std::vector<Key> ring;
+    size_t hand = 0;
+    size_t bytes = 0;
+  };
+
+  const size_t _shardBudget;
+  std::vector<Shard> _shards;
+
+  static std::mutex _fontsLock;
+  static std::unordered_map<std::string, i32> _fonts;
+
+  Shard& shardOf(const Key& key);
+
+  /** Get the entry of the given key, add it if absent, the shard must be locked exclusively */
+  Entry& entryOf(Shard& shard, const Key& key);
+
+  /** Account the given bytes to the entry and evict until the shard fits in its budget */
+  void grow(Shard& shard, Entry& entry, size_t bytes);
+
+public:
+  static constexpr size_t DEFAULT_BUDGET = 16 << 20;
+  static constexpr size_t DEFAULT_SHARDS = 16;
+
+  explicit GlyphCache(size_t budget = DEFAULT_BUDGET, size_t shards = DEFAULT_SHARDS);
+
+  GlyphCache(const GlyphCache&) = delete;
+
+  GlyphCache& operator=(const GlyphCache&) = delete;
+
+  /** The cache of the process */
+  static GlyphCache& instance();
+
+  /**
+   * Get the id of the font loaded from the given file: the id of its FontInfo, or a negative
+   * id for the files no FontInfo is loaded from (e.g. the fonts of the text), the same for
+   * the whole life of the process.
+   */
+  static i32 fontId(const std::string& file);
+
+  /** Make the key of the glyph of the given font and character at the given pixels per em */
+  static inline Key keyOf(i32 font, u32 code, float size) {
+    return {font, code, (u32) std::lround(size * SIZE_STEPS)};
+  }
+
+  /** The size in pixels per em of the given key */
+  static inline float sizeOf(const Key& key) { return (float) key.size / SIZE_STEPS; }
+
+  /** Get the outline of the given key if it is cached, return nullptr otherwise */
+  sptr<const GlyphOutline> findOutline(const Key& key);
+
+  /**
+   * Cache the outline of the given key, if another thread cached it in the meantime, that one
+   * is kept and returned instead
+   */
+  sptr<const GlyphOutline> putOutline(const Key& key, GlyphOutline&& outline);
+
+  /** Get the mask of the given key and sub-pixel offset if it is cached, nullptr otherwise */
+  sptr<const GlyphMask> findMask(const Key& key, int subpixel);
+
+  /** Cache the mask of the given key and sub-pixel offset, like #putOutline */
+  sptr<const GlyphMask> putMask(const Key& key, int subpixel, GlyphMask&& mask);
+
+  /** Drop all the cached glyphs, the glyphs held by the callers stay valid */
+  void clear();
+
+  /** The estimated size in bytes of the cached glyphs */
+  size_t bytes();
+};
+
+}  // namespace tex
+
+#endif  // GLYPH_CACHE_H_INCLUDED
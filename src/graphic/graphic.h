@@ -185,6 +185,24 @@ public:
    */
   virtual void drawText(const std::wstring& c, float x, float y) = 0;
 
+  /**
+   * Draw a run of glyphs with the given font in a single call, the font of the context is
+   * set to the given font afterwards. The glyphs are the character codes as #drawChar takes,
+   * the platforms map them to their glyph indices. The default implementation draws them
+   * one by one, the platforms override it to send the whole run to the backend at once.
+   *
+   * @param font the font of the glyphs
+   * @param glyphs the character codes of the glyphs
+   * @param positions the baseline aligned positions of the glyphs
+   * @param n the count of the glyphs
+   */
+  virtual void drawGlyphs(const Font* font, const u32* glyphs, const Point* positions, size_t n) {
+    if (getFont() != font) setFont(font);
+    for (size_t i = 0; i < n; i++) {
+      drawChar((wchar_t) glyphs[i], positions[i].x, positions[i].y);
+    }
+  }
+
   /**
    * Draw line
    * 
@@ -240,6 +258,27 @@ public:
   virtual void fillRoundRect(float x, float y, float w, float h, float rx, float ry) = 0;
 };
 
+/** A run of glyphs collected to be drawn in a single call, see Graphics2D#drawGlyphs */
+struct GlyphRun {
+  // max count of the glyphs drawn in one call
+  static constexpr size_t MAX = 64;
+
+  u32 glyphs[MAX];
+  Point positions[MAX];
+  size_t count = 0;
+
+  inline bool full() const { return count == MAX; }
+
+  inline void add(u32 glyph, const Point& position) {
+    glyphs[count] = glyph;
+    positions[count++] = position;
+  }
+
+  inline void draw(Graphics2D& g2, const Font* font) const {
+    g2.drawGlyphs(font, glyphs, positions, count);
+  }
+};
+
 }  // namespace tex
 
 #endif  // GRAPHIC_H_INCLUDED
@@ -1,9 +1,15 @@
 #include "latex.h"
 
+#include "box/box_factory.h"
+#include "core/command_table.h"
 #include "core/core.h"
 #include "core/formula.h"
 #include "core/macro.h"
+#include "core/memo.h"
 #include "fonts/fonts.h"
+
+#include <atomic>
+#include <thread>
 #if CLATEX_CXX17
 #include <filesystem>
 #endif
@@ -14,8 +20,123 @@ using namespace tex;
 string tex::RES_BASE = "res";
 static string CHECK_FILE = ".clatexmath-res_root";
 
-Formula* LaTeX::_formula = nullptr;
-TeXRenderBuilder* LaTeX::_builder = nullptr;
+bool LaTeX::_initialized = false;
+
+TeXContext::TeXContext() {
+  _formula = new Formula();
+  _builder = new TeXRenderBuilder();
+}
+
+TeXContext::~TeXContext() {
+  setIncremental(false);
+  delete _formula;
+  delete _builder;
+}
+
+void TeXContext::setIncremental(bool incremental) {
+  if (incremental == (_parseMemo != nullptr)) return;
+  if (incremental) {
+    _parseMemo = new ParseMemo();
+    _layoutCache = new LayoutCache();
+  } else {
+    delete _parseMemo;
+    delete _layoutCache;
+    _parseMemo = nullptr;
+    _layoutCache = nullptr;
+    _source.clear();
+  }
+  _formula->setMemo(_parseMemo);
+  _builder->setLayoutCache(_layoutCache);
+}
+
+void TeXContext::prepare(
+  const wstring& latex, int width, float textSize, float lineSpace, color fg,
+  TexStyle style, int type, const sptr<Arena>& arena
+) {
+  bool lined = true;
+  if (startswith(latex, L"$$") || startswith(latex, L"\\[")) {
+    lined = false;
+  }
+  Alignment align = lined ? Alignment::left : Alignment::center;
+  _formula->setLaTeX(latex);
+  _builder->setStyle(style)
+    .setType(type)
+    .setTextSize(textSize)
+    .setWidth(UnitType::pixel, width, align)
+    .setIsMaxWidth(lined)
+    .setLineSpace(UnitType::pixel, lineSpace)
+    .setForeground(fg)
+    .setArena(arena);
+}
+
+void TeXContext::release() {
+  _formula->_root = nullptr;
+  _formula->_middle.clear();
+}
+
+TeXRender* TeXContext::parse(
+  const wstring& latex, int width, float textSize, float lineSpace, color fg,
+  TexStyle style, int type
+) {
+  // the atoms die with the parse, but they are in the same arena as the boxes that may
+  // refer to them, unless they are kept for the next parse
+  const bool incremental = _parseMemo != nullptr;
+  const auto arena = _arenaEnabled && !incremental ? std::make_shared<Arena>() : nullptr;
+  ArenaScope scope(arena);
+  if (incremental) _source = latex;
+  TeXRender* render;
+  try {
+    prepare(latex, width, textSize, lineSpace, fg, style, type, arena);
+    render = _builder->build(*_formula);
+  } catch (...) {
+    // the atoms must not outlive their arena
+    release();
+    throw;
+  }
+  // the atoms are no longer needed once the boxes are built
+  release();
+  if (incremental) {
+    _parseMemo->sweep();
+    _layoutCache->sweep();
+  }
+  return render;
+}
+
+TeXRender* TeXContext::edit(
+  size_t pos, size_t count, const wstring& text,
+  int width, float textSize, float lineSpace, color fg, TexStyle style, int type
+) {
+  // the source is only kept in the incremental mode
+  if (_parseMemo == nullptr) {
+    throw ex_invalid_state("Cannot edit a formula without the incremental mode!");
+  }
+  pos = std::min(pos, _source.length());
+  // the groups that do not enclose the edit are found in the memo by their text
+  _source.replace(pos, count, text);
+  return parse(_source, width, textSize, lineSpace, fg, style, type);
+}
+
+TeXMetrics TeXContext::measure(
+  const wstring& latex, int width, float textSize, float lineSpace, TexStyle style, int type
+) {
+  const bool incremental = _parseMemo != nullptr;
+  const auto arena = _arenaEnabled && !incremental ? std::make_shared<Arena>() : nullptr;
+  ArenaScope scope(arena);
+  TeXMetrics metrics;
+  try {
+    prepare(latex, width, textSize, lineSpace, black, style, type, arena);
+    metrics = _builder->measure(*_formula);
+  } catch (...) {
+    release();
+    throw;
+  }
+  release();
+  if (incremental) {
+    _parseMemo->sweep();
+    _layoutCache->sweep();
+  }
+  return metrics;
+}
 
 string LaTeX::queryResourceLocation(string& custom_path) {
   queue<string> paths;
@@ -92,26 +213,28 @@ void LaTeX::init(string res_root_path) {
     }
   } catch (std::exception&) {
   }
-  if (_formula != nullptr) return;
+  if (_initialized) return;
 
   NewCommandMacro::_init_();
   DefaultTeXFont::_init_();
   Formula::_init_();
   TextRenderingBox::_init_();
+  XLeftRightArrowFactory::_init_();
+  // all the predefined tables are loaded
+  CommandTable::build();
+  Formula::buildPredefinedFormulas();
 
-  _formula = new Formula();
-  _builder = new TeXRenderBuilder();
+  _initialized = true;
 }
 
 void LaTeX::release() {
+  CommandTable::_free_();
   DefaultTeXFont::_free_();
   Formula::_free_();
   MacroInfo::_free_();
   NewCommandMacro::_free_();
   TextRenderingBox::_free_();
-
-  if (_formula != nullptr) delete _formula;
-  if (_builder != nullptr) delete _builder;
+  XLeftRightArrowFactory::_free_();
 }
 
 const string& LaTeX::getResRootPath() {
@@ -123,19 +246,44 @@ void LaTeX::setDebug(bool debug) {
 }
 
 TeXRender* LaTeX::parse(const wstring& latex, int width, float textSize, float lineSpace, color fg) {
-  bool lined = true;
-  if (startswith(latex, L"$$") || startswith(latex, L"\\[")) {
-    lined = false;
-  }
-  Alignment align = lined ? Alignment::left : Alignment::center;
-  _formula->setLaTeX(latex);
-  TeXRender* render =
-    _builder->setStyle(TexStyle::display)
-      .setTextSize(textSize)
-      .setWidth(UnitType::pixel, width, align)
-      .setIsMaxWidth(lined)
-      .setLineSpace(UnitType::pixel, lineSpace)
-      .setForeground(fg)
-      .build(*_formula);
-  return render;
+  TeXContext context;
+  return context.parse(latex, width, textSize, lineSpace, fg);
+}
+
+TeXMetrics LaTeX::measure(const wstring& latex, int width, float textSize, float lineSpace) {
+  TeXContext context;
+  return context.measure(latex, width, textSize, lineSpace);
+}
+
+vector<BatchResult> LaTeX::parseBatch(const vector<wstring>& tex, const BatchOptions& options) {
+  vector<BatchResult> results(tex.size());
+  if (tex.empty()) return results;
+
+  unsigned threads = options.threads;
+  if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+  threads = min(threads, (unsigned) tex.size());
+
+  // the formulas have very different costs, so the workers take them one by
+  // one rather than in fixed chunks
+  atomic<size_t> next(0);
+  auto work = [&]() {
+    TeXContext context;
+    for (size_t i = next++; i < tex.size(); i = next++) {
+      BatchResult& result = results[i];
+      try {
+        result.render = context.parse(
+          tex[i], options.width, options.textSize, options.lineSpace, options.fg);
+      } catch (exception& e) {
+        result.error = e.what();
+      }
+    }
+  };
+
+  vector<thread> workers;
+  workers.reserve(threads - 1);
+  for (unsigned i = 1; i < threads; i++) workers.emplace_back(work);
+  // the calling thread is one of the workers
+  work();
+  for (auto& t : workers) t.join();
+  return results;
 }
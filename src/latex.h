@@ -9,15 +9,148 @@
 #include <string>
 #include <queue>
 #include <sstream>
+#include <vector>
 
 namespace tex {
 
 class Formula;
 
+class ParseMemo;
+
+class LayoutCache;
+
+/**
+ * A parsing and rendering context. The static LaTeX::parse shares nothing
+ * between calls, but a worker that renders many formulas can keep its own
+ * context to reuse the formula and the builder. A context must not be used
+ * by two threads at the same time, while any number of contexts may render
+ * concurrently once LaTeX::init has returned.
+ */
+class TeXContext {
+private:
+  Formula* _formula;
+  TeXRenderBuilder* _builder;
+  bool _arenaEnabled = true;
+  // the groups and the boxes kept from a parse to the next one, nullptr if not incremental
+  ParseMemo* _parseMemo = nullptr;
+  LayoutCache* _layoutCache = nullptr;
+  // the formula of the last parse, if incremental
+  std::wstring _source;
+
+  /** Parse the formula and set up the builder for it */
+  void prepare(
+    const std::wstring& tex, int width, float textSize, float lineSpace, color fg,
+    TexStyle style, int type, const sptr<Arena>& arena);
+
+  /** Release the atoms of the last parse, they may be allocated from its arena */
+  void release();
+
+public:
+  TeXContext();
+
+  /**
+   * Allocate the atoms and the boxes of every render from an arena owned by the render
+   * (default), or one by one if disabled. See Arena.
+   */
+  inline void setArenaEnabled(bool enabled) {
+    _arenaEnabled = enabled;
+  }
+
+  /**
+   * Keep the groups of the formulas and their boxes from a parse to the next one (disabled by
+   * default), for an editor that parses its formula again after every change: a braced group
+   * or an argument whose text did not change is not parsed again, and its box is not laid out
+   * again, so only the groups that enclose the change and the text around them are. The groups
+   * are not kept while the formula defines commands (see MacroScope#isDefault).
+   *
+   * The atoms and the boxes outlive the renders then, they are not allocated from arenas.
+   */
+  void setIncremental(bool incremental);
+
+  /**
+   * Build the renders so they can be laid out again at another width (disabled by default),
+   * see TeXRenderBuilder#setReflowable and TeXRender#reflow.
+   */
+  inline void setReflowable(bool reflowable) {
+    _builder->setReflowable(reflowable);
+  }
+
+  TeXContext(const TeXContext&) = delete;
+
+  TeXContext& operator=(const TeXContext&) = delete;
+
+  /**
+   * Parse TeX formatted string to TeXRender, it is safe to call this function
+   * from multiple threads after #init has returned.
+   *
+   * @param tex the TeX formatted string
+   * @param width the width of the 2D graphics context
+   * @param textSize the text size
+   * @param lineSpace the line space
+   * @param fg the foreground color
+   * @param style the style of the formula
+   * @param type the font type, see TeXRenderBuilder#TeXFontStyle, -1 for the default font
+   */
+  TeXRender* parse(
+    const std::wstring& tex, int width, float textSize, float lineSpace, color fg,
+    TexStyle style = TexStyle::display, int type = -1);
+
+  /**
+   * Replace the given part of the formula given to the last call of #parse (or of this function)
+   * with the given text and parse the result, like #parse. It is meant for the incremental mode,
+   * see #setIncremental.
+   *
+   * @param pos the position of the part to replace
+   * @param count the length of the part to replace
+   * @param text the text to put instead
+   *
+   * @throw ex_invalid_state if the incremental mode is disabled
+   */
+  TeXRender* edit(
+    size_t pos, size_t count, const std::wstring& text,
+    int width, float textSize, float lineSpace, color fg,
+    TexStyle style = TexStyle::display, int type = -1);
+
+  /** Get the formula of the last parse in the incremental mode, see #edit */
+  inline const std::wstring& getSource() const { return _source; }
+
+  /**
+   * Get the dimensions of the render #parse would return with the same arguments, without
+   * building it. It is cheaper than parsing when the formula is only placed, e.g. in a
+   * paragraph, and drawn later or not at all.
+   */
+  TeXMetrics measure(
+    const std::wstring& tex, int width, float textSize, float lineSpace,
+    TexStyle style = TexStyle::display, int type = -1);
+
+  ~TeXContext();
+};
+
+/** Options shared by all the formulas of a batch, see LaTeX#parseBatch */
+struct BatchOptions {
+  // the width of the 2D graphics context
+  int width = 720;
+  // the text size
+  float textSize = 20.f;
+  // the line space
+  float lineSpace = 20.f / 3;
+  // the foreground color
+  color fg = black;
+  // the number of worker threads, 0 means as many as the hardware supports
+  unsigned threads = 0;
+};
+
+/** The result of a formula in a batch */
+struct BatchResult {
+  // the render, nullptr if the formula could not be parsed
+  TeXRender* render = nullptr;
+  // the error message if the formula could not be parsed
+  std::string error;
+};
+
 class LaTeX {
 private:
-  static Formula* _formula;
-  static TeXRenderBuilder* _builder;
+  static bool _initialized;
 
 protected:
   static std::string queryResourceLocation(std::string& custom_path);
@@ -41,7 +174,8 @@ public:
   static void setDebug(bool debug);
 
   /**
-   * Parse TeX formatted string to TeXRender
+   * Parse TeX formatted string to TeXRender, it is safe to call this function
+   * from multiple threads after #init has returned.
    *
    * @param tex the TeX formatted string
    * @param width the width of the 2D graphics context
@@ -51,6 +185,26 @@ public:
    */
   static TeXRender* parse(const std::wstring& tex, int width, float textSize, float lineSpace, color fg);
 
+  /**
+   * Get the dimensions of the render #parse would return with the same arguments, without
+   * building it, see TeXContext#measure
+   */
+  static TeXMetrics measure(const std::wstring& tex, int width, float textSize, float lineSpace);
+
+  /**
+   * Parse a batch of TeX formatted strings on a pool of worker threads, each
+   * worker owns a TeXContext and takes the next formula once it has finished
+   * the current one. A formula that fails to parse does not stop the others.
+   *
+   * @param tex the TeX formatted strings
+   * @param options the options shared by all the formulas
+   * @return the results in the same order as the given strings, the caller
+   * takes the ownership of the renders
+   */
+  static std::vector<BatchResult> parseBatch(
+    const std::vector<std::wstring>& tex,
+    const BatchOptions& options = BatchOptions());
+
   /**
    * Release the LaTeX context
    */
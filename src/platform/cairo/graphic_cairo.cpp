@@ -295,6 +295,29 @@ void Graphics2D_cairo::drawText(const wstring& t, float x, float y) {
   _context->show_text(wide2utf8(t));
 }
 
+void Graphics2D_cairo::drawGlyphs(const Font* font, const u32* glyphs, const Point* positions, size_t n) {
+  if (_font != font) setFont(font);
+  _context->set_font_face(_font->getCairoFontFace());
+  _context->set_font_size(_font->getSize());
+  // map the characters to the glyph indices of the scaled font at once
+  wstring str(n, L'\0');
+  for (size_t i = 0; i < n; i++) str[i] = (wchar_t) glyphs[i];
+  vector<Cairo::Glyph> cg;
+  vector<Cairo::TextCluster> clusters;
+  Cairo::TextClusterFlags flags;
+  _context->get_scaled_font()->text_to_glyphs(0, 0, wide2utf8(str), cg, clusters, flags);
+  if (cg.size() != n) {
+    // the characters are not mapped one to one, draw them one by one
+    Graphics2D::drawGlyphs(font, glyphs, positions, n);
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    cg[i].x = positions[i].x;
+    cg[i].y = positions[i].y;
+  }
+  _context->show_glyphs(cg);
+}
+
 void Graphics2D_cairo::drawLine(float x1, float y1, float x2, float y2) {
   _context->move_to(x1, y1);
   _context->line_to(x2, y2);
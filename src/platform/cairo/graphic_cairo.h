@@ -116,6 +116,8 @@ public:
 
   void drawText(const wstring& t, float x, float y) override;
 
+  void drawGlyphs(const Font* font, const u32* glyphs, const Point* positions, size_t n) override;
+
   void drawLine(float x, float y1, float x2, float y2) override;
 
   void drawRect(float x, float y, float w, float h) override;
@@ -12,6 +12,7 @@
 #include <QColor>
 #include <QFont>
 #include <QFontDatabase>
+#include <QGlyphRun>
 #include <QPainter>
 #include <QPen>
 #include <QPointF>
@@ -106,6 +107,11 @@ QFont Font_qt::getQFont() const {
   return _font;
 }
 
+const QRawFont& Font_qt::getQRawFont() const {
+  if (!_rawFont.isValid()) _rawFont = QRawFont::fromFont(_font);
+  return _rawFont;
+}
+
 float Font_qt::getSize() const {
   return _font.pointSizeF();
 }
@@ -306,6 +312,32 @@ void Graphics2D_qt::drawText(const std::wstring& t, float x, float y) {
   _painter->drawText(QPointF(x, y), text);
 }
 
+void Graphics2D_qt::drawGlyphs(const Font* font, const u32* glyphs, const Point* positions, size_t n) {
+  if (_font != font) setFont(font);
+  QString text;
+  text.reserve((int) n);
+  bool bmp = true;
+  for (size_t i = 0; i < n && bmp; i++) {
+    bmp = glyphs[i] <= 0xffff;
+    text.append(QChar((ushort) glyphs[i]));
+  }
+  const QRawFont& raw = _font->getQRawFont();
+  QVector<quint32> indexes;
+  if (bmp) indexes = raw.glyphIndexesForString(text);
+  if (indexes.size() != (int) n) {
+    // the characters are not mapped one to one, draw them one by one
+    Graphics2D::drawGlyphs(font, glyphs, positions, n);
+    return;
+  }
+  QVector<QPointF> points((int) n);
+  for (size_t i = 0; i < n; i++) points[(int) i] = QPointF(positions[i].x, positions[i].y);
+  QGlyphRun run;
+  run.setRawFont(raw);
+  run.setGlyphIndexes(indexes);
+  run.setPositions(points);
+  _painter->drawGlyphRun(QPointF(0, 0), run);
+}
+
 void Graphics2D_qt::drawLine(float x1, float y1, float x2, float y2) {
   _painter->drawLine(QPointF(x1, y1), QPointF(x2, y2));
 }
@@ -12,6 +12,7 @@
 #include <QFont>
 #include <QMap>
 #include <QPainter>
+#include <QRawFont>
 #include <QString>
 
 namespace tex {
@@ -23,6 +24,8 @@ class Font_qt : public Font {
 
 private:
   QFont _font;
+  // the raw font to map the characters to the glyph indices, loaded on first use
+  mutable QRawFont _rawFont;
 
   static QMap<QString, QString> _loaded_families;
 
@@ -38,6 +41,8 @@ public:
 
   QFont getQFont() const;
 
+  const QRawFont& getQRawFont() const;
+
   virtual float getSize() const override;
 
   virtual sptr<Font> deriveFont(int style) const override;
@@ -119,6 +124,10 @@ public:
 
   virtual void drawText(const std::wstring& t, float x, float y) override;
 
+  virtual void drawGlyphs(
+    const Font* font, const u32* glyphs, const Point* positions, size_t n
+  ) override;
+
   virtual void drawLine(float x, float y1, float x2, float y2) override;
 
   virtual void drawRect(float x, float y, float w, float h) override;
@@ -0,0 +1,486 @@
+#include "config.h"
+
+#if defined(BUILD_RASTER) && !defined(MEM_CHECK)
+
+#include "platform/raster/graphic_raster.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace tex;
+using namespace std;
+
+namespace {
+
+/** Get the file of the bundled font that stands for the given family and style */
+string fontFile(const string& family, int style) {
+  string f = family;
+  transform(f.begin(), f.end(), f.begin(), [](unsigned char c) { return tolower(c); });
+  const bool bold = (style & BOLD) != 0, italic = (style & ITALIC) != 0;
+  string name;
+  if (f.find("mono") != string::npos || f.find("typewriter") != string::npos) {
+    name = "tt10";
+  } else if (f.find("sans") != string::npos) {
+    name = bold ? (italic ? "sbi10" : "sb10") : (italic ? "si10" : "ss10");
+  } else {
+    name = bold ? (italic ? "bi10" : "bx10") : (italic ? "i10" : "r10");
+  }
+  return RES_BASE + "/fonts/latin/" + name + ".ttf";
+}
+
+/** Record the contours of a glyph into an outline */
+class OutlineSink : public PathSink {
+private:
+  GlyphOutline& _outline;
+
+public:
+  explicit OutlineSink(GlyphOutline& outline) : _outline(outline) {}
+
+  void moveTo(const Point& p) override { _outline.moveTo(p); }
+
+  void lineTo(const Point& p) override { _outline.lineTo(p); }
+
+  void quadTo(const Point& c, const Point& p) override { _outline.quadTo(c, p); }
+
+  void close() override { _outline.closePath(); }
+};
+
+/** Divide by 255 with rounding, for v in [0, 255 * 255] */
+inline u32 div255(u32 v) {
+  return (v + 128 + ((v + 128) >> 8)) >> 8;
+}
+
+}  // namespace
+
+Font_raster::Font_raster(const string& file, float size)
+  : _face(TrueTypeFace::load(file)), _glyphFont(GlyphCache::fontId(file)),
+    _style(PLAIN), _size(size) {}
+
+Font_raster::Font_raster(const string& family, int style, float size)
+  : _face(TrueTypeFace::load(fontFile(family, style))),
+    _glyphFont(GlyphCache::fontId(fontFile(family, style))),
+    _family(family), _style(style), _size(size) {}
+
+sptr<const GlyphOutline> Font_raster::getOutline(const GlyphCache::Key& key) const {
+  GlyphCache& cache = GlyphCache::instance();
+  auto outline = cache.findOutline(key);
+  if (outline != nullptr) return outline;
+  // extract out of the lock, another thread may do the same, the first one wins
+  GlyphOutline o;
+  OutlineSink sink(o);
+  const float s = GlyphCache::sizeOf(key) / _face->unitsPerEm();
+  _face->outline(_face->glyphIndex(key.code), {s, 0, 0, -s, 0, 0}, sink);
+  return cache.putOutline(key, std::move(o));
+}
+
+int Font_raster::getStyle() const {
+  return _style;
+}
+
+float Font_raster::getSize() const {
+  return _size;
+}
+
+sptr<Font> Font_raster::deriveFont(int style) const {
+  if (_family.empty()) {
+    // a font loaded from a file has no variants
+    auto f = sptrOf<Font_raster>(*this);
+    f->_style = style;
+    return f;
+  }
+  return sptrOf<Font_raster>(_family, style, _size);
+}
+
+bool Font_raster::operator==(const Font& ft) const {
+  const auto& f = static_cast<const Font_raster&>(ft);
+  return _face == f._face && _style == f._style && _size == f._size;
+}
+
+bool Font_raster::operator!=(const Font& f) const {
+  return !(*this == f);
+}
+
+Font* Font::create(const string& file, float size) {
+  return new Font_raster(file, size);
+}
+
+sptr<Font> Font::_create(const string& name, int style, float size) {
+  return sptrOf<Font_raster>(name, style, size);
+}
+
+/**************************************************************************************************/
+
+TextLayout_raster::TextLayout_raster(const wstring& src, const sptr<Font_raster>& font)
+  : _font(font), _text(src) {}
+
+void TextLayout_raster::getBounds(Rect& r) {
+  const TrueTypeFace& face = *_font->getFace();
+  const float s = _font->unitScale();
+  float w = 0;
+  for (wchar_t c : _text) w += face.advance(face.glyphIndex((u32) c));
+  r.x = 0;
+  r.y = -face.ascent() * s;
+  r.w = w * s;
+  r.h = (face.ascent() + face.descent()) * s;
+}
+
+void TextLayout_raster::draw(Graphics2D& g2, float x, float y) {
+  const TrueTypeFace& face = *_font->getFace();
+  const float s = _font->unitScale();
+  vector<u32> glyphs(_text.size());
+  vector<Point> positions(_text.size());
+  float xPos = x;
+  for (size_t i = 0; i < _text.size(); i++) {
+    glyphs[i] = (u32) _text[i];
+    positions[i] = Point(xPos, y);
+    xPos += face.advance(face.glyphIndex(glyphs[i])) * s;
+  }
+  const Font* prev = g2.getFont();
+  g2.drawGlyphs(_font.get(), glyphs.data(), positions.data(), glyphs.size());
+  g2.setFont(prev);
+}
+
+sptr<TextLayout> TextLayout::create(const wstring& src, const sptr<Font>& font) {
+  sptr<Font_raster> f = static_pointer_cast<Font_raster>(font);
+  return sptrOf<TextLayout_raster>(src, f);
+}
+
+/**************************************************************************************************/
+
+Graphics2D_raster::Graphics2D_raster(
+  u8* pixels, int width, int height, int stride, PixelFormat format
+) : _pixels(pixels), _width(width), _height(height), _stride(stride), _format(format),
+    _color(black), _font(nullptr), _sx(1), _sy(1) {}
+
+void Graphics2D_raster::clear(color c) {
+  const u32 a = color_a(c);
+  const u8 px[4] = {
+    (u8) div255(color_r(c) * a), (u8) div255(color_g(c) * a), (u8) div255(color_b(c) * a), (u8) a
+  };
+  for (int y = 0; y < _height; y++) {
+    u8* row = _pixels + (size_t) y * _stride;
+    if (_format == PixelFormat::alpha8) {
+      fill(row, row + _width, px[3]);
+      continue;
+    }
+    for (int x = 0; x < _width; x++) copy(px, px + 4, row + 4 * x);
+  }
+}
+
+void Graphics2D_raster::blend(int x, int y, int w, int h, const u8* coverage, int stride) {
+  const u32 ca = color_a(_color);
+  if (ca == 0) return;
+  const u32 cr = color_r(_color), cg = color_g(_color), cb = color_b(_color);
+  const int x0 = max(x, 0), x1 = min(x + w, _width);
+  const int y0 = max(y, 0), y1 = min(y + h, _height);
+  for (int j = y0; j < y1; j++) {
+    const u8* cov = coverage + (size_t) (j - y) * stride + (x0 - x);
+    u8* row = _pixels + (size_t) j * _stride;
+    for (int i = x0; i < x1; i++, cov++) {
+      if (*cov == 0) continue;
+      // source-over with the premultiplied source: d = s * a + d * (1 - a)
+      const u32 a = div255(ca * *cov);
+      const u32 na = 255 - a;
+      if (_format == PixelFormat::alpha8) {
+        row[i] = (u8) (a + div255(row[i] * na));
+        continue;
+      }
+      u8* px = row + 4 * i;
+      px[0] = (u8) div255(cr * a + px[0] * na);
+      px[1] = (u8) div255(cg * a + px[1] * na);
+      px[2] = (u8) div255(cb * a + px[2] * na);
+      px[3] = (u8) (a + div255(px[3] * na));
+    }
+  }
+}
+
+void Graphics2D_raster::endContour() {
+  _contours.push_back(_path.size());
+}
+
+void Graphics2D_raster::addRect(float x, float y, float w, float h, bool reverse) {
+  if (reverse) {
+    _path.insert(_path.end(), {{x, y}, {x, y + h}, {x + w, y + h}, {x + w, y}});
+  } else {
+    _path.insert(_path.end(), {{x, y}, {x + w, y}, {x + w, y + h}, {x, y + h}});
+  }
+  endContour();
+}
+
+void Graphics2D_raster::addArc(float cx, float cy, float r, float a0, float a1) {
+  // about 1/10 pixel away from the circle
+  const float scale = max(hypot(_m.a, _m.b), hypot(_m.c, _m.d));
+  const int n = clamp((int) ceil(abs(a1 - a0) * sqrt(r * scale)), 1, 64);
+  for (int i = 0; i <= n; i++) {
+    const float a = a0 + (a1 - a0) * (float) i / (float) n;
+    _path.emplace_back(cx + r * cos(a), cy + r * sin(a));
+  }
+}
+
+void Graphics2D_raster::addRoundRect(float x, float y, float w, float h, float r, bool reverse) {
+  r = min(r, min(w, h) / 2);
+  if (r <= 0) {
+    addRect(x, y, w, h, reverse);
+    return;
+  }
+  const size_t start = _path.size();
+  const float pi = (float) PI;
+  addArc(x + r, y + r, r, pi, 1.5f * pi);
+  addArc(x + w - r, y + r, r, -0.5f * pi, 0);
+  addArc(x + w - r, y + h - r, r, 0, 0.5f * pi);
+  addArc(x + r, y + h - r, r, 0.5f * pi, pi);
+  if (reverse) std::reverse(_path.begin() + start, _path.end());
+  endContour();
+}
+
+void Graphics2D_raster::fillPath() {
+  float minX = F_MAX, minY = F_MAX, maxX = F_MIN, maxY = F_MIN;
+  for (auto& p : _path) {
+    p = _m.apply(p.x, p.y);
+    minX = min(minX, p.x);
+    minY = min(minY, p.y);
+    maxX = max(maxX, p.x);
+    maxY = max(maxY, p.y);
+  }
+  const int x0 = max((int) floor(minX), 0), y0 = max((int) floor(minY), 0);
+  const int x1 = min((int) ceil(maxX), _width), y1 = min((int) ceil(maxY), _height);
+  if (!_path.empty() && x0 < x1 && y0 < y1) {
+    _raster.reset(x0, y0, x1 - x0, y1 - y0);
+    size_t i = 0;
+    for (size_t end : _contours) {
+      if (i == end) continue;
+      _raster.moveTo(_path[i]);
+      for (i++; i < end; i++) _raster.lineTo(_path[i]);
+    }
+    blend(x0, y0, x1 - x0, y1 - y0, _raster.coverage(), x1 - x0);
+  }
+  _path.clear();
+  _contours.clear();
+}
+
+GlyphMask Graphics2D_raster::rasterize(const GlyphCache::Key& key, int subpixel) {
+  GlyphMask mask;
+  const auto outline = _font->getOutline(key);
+  if (outline->isEmpty()) return mask;
+  // the control points bound the curves
+  const float fx = (float) subpixel / GlyphCache::SUBPIXEL_STEPS;
+  float minX = F_MAX, minY = F_MAX, maxX = F_MIN, maxY = F_MIN;
+  for (const auto& p : outline->points) {
+    minX = min(minX, p.x + fx);
+    minY = min(minY, p.y);
+    maxX = max(maxX, p.x + fx);
+    maxY = max(maxY, p.y);
+  }
+  mask.left = (int) floor(minX);
+  mask.top = (int) floor(minY);
+  mask.width = (int) ceil(maxX) - mask.left;
+  mask.height = (int) ceil(maxY) - mask.top;
+  _raster.reset(mask.left, mask.top, mask.width, mask.height);
+  outline->replay(_raster, fx, 0);
+  const u8* coverage = _raster.coverage();
+  mask.coverage.assign(coverage, coverage + (size_t) mask.width * mask.height);
+  return mask;
+}
+
+void Graphics2D_raster::drawGlyph(u32 c, float x, float y) {
+  if (_font == nullptr) return;
+  const TrueTypeFace& face = *_font->getFace();
+  const float s = _font->unitScale();
+  // from the font units (y-axis up) to the device
+  const Affine g = _m * Affine{s, 0, 0, -s, x, y};
+
+  if (g.isAxisAligned() && g.a > 0 && g.a == -g.d) {
+    const auto key = _font->glyphKey(c, g.a * face.unitsPerEm());
+    if (key.size == 0) return;
+    // the baseline is snapped to the pixel grid, the origin to 1/4 pixel
+    int ix = (int) floor(g.e);
+    int q = (int) lround((g.e - (float) ix) * GlyphCache::SUBPIXEL_STEPS);
+    if (q == GlyphCache::SUBPIXEL_STEPS) {
+      ix++;
+      q = 0;
+    }
+    const int iy = (int) lround(g.f);
+    GlyphCache& cache = GlyphCache::instance();
+    auto mask = cache.findMask(key, q);
+    if (mask == nullptr) mask = cache.putMask(key, q, rasterize(key, q));
+    if (mask->coverage.empty()) return;
+    blend(
+      ix + mask->left, iy + mask->top, mask->width, mask->height,
+      mask->coverage.data(), mask->width
+    );
+    return;
+  }
+
+  // rotated, skewed or mirrored, rasterize the outline in place
+  const u16 glyph = face.glyphIndex(c);
+  const GlyphBounds b = face.bounds(glyph);
+  if (b.isEmpty()) return;
+  const Point corners[] = {
+    g.apply(b.xMin, b.yMin), g.apply(b.xMax, b.yMin),
+    g.apply(b.xMax, b.yMax), g.apply(b.xMin, b.yMax)
+  };
+  float minX = F_MAX, minY = F_MAX, maxX = F_MIN, maxY = F_MIN;
+  for (const auto& p : corners) {
+    minX = min(minX, p.x);
+    minY = min(minY, p.y);
+    maxX = max(maxX, p.x);
+    maxY = max(maxY, p.y);
+  }
+  const int x0 = max((int) floor(minX), 0), y0 = max((int) floor(minY), 0);
+  const int x1 = min((int) ceil(maxX), _width), y1 = min((int) ceil(maxY), _height);
+  if (x0 >= x1 || y0 >= y1) return;
+  _raster.reset(x0, y0, x1 - x0, y1 - y0);
+  face.outline(glyph, g, _raster);
+  blend(x0, y0, x1 - x0, y1 - y0, _raster.coverage(), x1 - x0);
+}
+
+void Graphics2D_raster::setColor(color c) {
+  _color = c;
+}
+
+color Graphics2D_raster::getColor() const {
+  return _color;
+}
+
+void Graphics2D_raster::setStroke(const Stroke& s) {
+  _stroke = s;
+}
+
+const Stroke& Graphics2D_raster::getStroke() const {
+  return _stroke;
+}
+
+void Graphics2D_raster::setStrokeWidth(float w) {
+  _stroke.lineWidth = w;
+}
+
+const Font* Graphics2D_raster::getFont() const {
+  return _font;
+}
+
+void Graphics2D_raster::setFont(const Font* font) {
+  _font = static_cast<const Font_raster*>(font);
+}
+
+void Graphics2D_raster::translate(float dx, float dy) {
+  _m.e += _m.a * dx + _m.c * dy;
+  _m.f += _m.b * dx + _m.d * dy;
+}
+
+void Graphics2D_raster::scale(float sx, float sy) {
+  _m.a *= sx;
+  _m.b *= sx;
+  _m.c *= sy;
+  _m.d *= sy;
+  _sx *= sx;
+  _sy *= sy;
+}
+
+void Graphics2D_raster::rotate(float angle) {
+  const float s = sin(angle), c = cos(angle);
+  const float a = _m.a * c + _m.c * s, b = _m.b * c + _m.d * s;
+  _m.c = _m.c * c - _m.a * s;
+  _m.d = _m.d * c - _m.b * s;
+  _m.a = a;
+  _m.b = b;
+}
+
+void Graphics2D_raster::rotate(float angle, float px, float py) {
+  translate(px, py);
+  rotate(angle);
+  translate(-px, -py);
+}
+
+void Graphics2D_raster::reset() {
+  _m = Affine();
+  _sx = _sy = 1;
+}
+
+float Graphics2D_raster::sx() const {
+  return _sx;
+}
+
+float Graphics2D_raster::sy() const {
+  return _sy;
+}
+
+void Graphics2D_raster::drawChar(wchar_t c, float x, float y) {
+  drawGlyph((u32) c, x, y);
+}
+
+void Graphics2D_raster::drawText(const wstring& c, float x, float y) {
+  if (_font == nullptr) return;
+  const TrueTypeFace& face = *_font->getFace();
+  const float s = _font->unitScale();
+  for (wchar_t ch : c) {
+    drawGlyph((u32) ch, x, y);
+    x += face.advance(face.glyphIndex((u32) ch)) * s;
+  }
+}
+
+void Graphics2D_raster::drawGlyphs(
+  const Font* font, const u32* glyphs, const Point* positions, size_t n
+) {
+  setFont(font);
+  for (size_t i = 0; i < n; i++) drawGlyph(glyphs[i], positions[i].x, positions[i].y);
+}
+
+void Graphics2D_raster::drawLine(float x1, float y1, float x2, float y2) {
+  const float h = _stroke.lineWidth / 2;
+  const float dx = x2 - x1, dy = y2 - y1;
+  const float len = hypot(dx, dy);
+  if (len == 0) {
+    if (_stroke.cap == CAP_ROUND) {
+      addArc(x1, y1, h, 0, 2 * (float) PI);
+      endContour();
+      fillPath();
+    }
+    return;
+  }
+  if (_stroke.cap == CAP_ROUND) {
+    const float a = atan2(dy, dx), pi = (float) PI;
+    addArc(x2, y2, h, a - pi / 2, a + pi / 2);
+    addArc(x1, y1, h, a + pi / 2, a + 1.5f * pi);
+  } else {
+    // the unit vector along the line, and the normal
+    const float ux = dx / len, uy = dy / len;
+    const float nx = -uy * h, ny = ux * h;
+    const float e = _stroke.cap == CAP_SQUARE ? h : 0;
+    const float ex = ux * e, ey = uy * e;
+    _path.insert(_path.end(), {
+      {x1 - ex - nx, y1 - ey - ny}, {x2 + ex - nx, y2 + ey - ny},
+      {x2 + ex + nx, y2 + ey + ny}, {x1 - ex + nx, y1 - ey + ny}
+    });
+  }
+  endContour();
+  fillPath();
+}
+
+void Graphics2D_raster::drawRect(float x, float y, float w, float h) {
+  const float l = _stroke.lineWidth / 2;
+  if (_stroke.join == JOIN_ROUND) addRoundRect(x - l, y - l, w + 2 * l, h + 2 * l, l, false);
+  else addRect(x - l, y - l, w + 2 * l, h + 2 * l, false);
+  if (w > 2 * l && h > 2 * l) addRect(x + l, y + l, w - 2 * l, h - 2 * l, true);
+  fillPath();
+}
+
+void Graphics2D_raster::fillRect(float x, float y, float w, float h) {
+  addRect(x, y, w, h, false);
+  fillPath();
+}
+
+void Graphics2D_raster::drawRoundRect(float x, float y, float w, float h, float rx, float ry) {
+  const float l = _stroke.lineWidth / 2, r = max(rx, ry);
+  addRoundRect(x - l, y - l, w + 2 * l, h + 2 * l, r + l, false);
+  if (w > 2 * l && h > 2 * l) {
+    addRoundRect(x + l, y + l, w - 2 * l, h - 2 * l, max(r - l, 0.f), true);
+  }
+  fillPath();
+}
+
+void Graphics2D_raster::fillRoundRect(float x, float y, float w, float h, float rx, float ry) {
+  addRoundRect(x, y, w, h, max(rx, ry), false);
+  fillPath();
+}
+
+#endif  // BUILD_RASTER && !MEM_CHECK
@@ -0,0 +1,195 @@
+#include "config.h"
+
+#if defined(BUILD_RASTER) && !defined(MEM_CHECK)
+
+#ifndef GRAPHIC_RASTER_H_INCLUDED
+#define GRAPHIC_RASTER_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include "glyph_cache.h"
+#include "graphic/graphic.h"
+#include "platform/raster/rasterizer.h"
+#include "platform/raster/true_type.h"
+
+namespace tex {
+
+/**
+ * A font of the raster backend, a TrueType face at a size. The fonts created by name are
+ * mapped to the bundled Computer Modern fonts (res/fonts/latin): the names that contain
+ * "mono" or "typewriter" to the typewriter, the names that contain "sans" to the sans-serif,
+ * the others to the roman.
+ */
+class Font_raster : public Font {
+private:
+  sptr<const TrueTypeFace> _face;
+  // the id of the font in the glyph cache
+  i32 _glyphFont;
+  std::string _family;
+  int _style;
+  float _size;
+
+public:
+  Font_raster(const std::string& file, float size);
+
+  Font_raster(const std::string& family, int style, float size);
+
+  inline const sptr<const TrueTypeFace>& getFace() const { return _face; }
+
+  /** The scale from the font units to the size of the font */
+  inline float unitScale() const { return _size / _face->unitsPerEm(); }
+
+  /** The key in the glyph cache of the given character drawn at the given pixels per em */
+  inline GlyphCache::Key glyphKey(u32 code, float size) const {
+    return GlyphCache::keyOf(_glyphFont, code, size);
+  }
+
+  /** Get the outline of the glyph of the given key, extract it on a miss of the glyph cache */
+  sptr<const GlyphOutline> getOutline(const GlyphCache::Key& key) const;
+
+  int getStyle() const;
+
+  float getSize() const override;
+
+  sptr<Font> deriveFont(int style) const override;
+
+  bool operator==(const Font& f) const override;
+
+  bool operator!=(const Font& f) const override;
+};
+
+/**************************************************************************************************/
+
+class TextLayout_raster : public TextLayout {
+private:
+  sptr<Font_raster> _font;
+  std::wstring _text;
+
+public:
+  TextLayout_raster(const std::wstring& src, const sptr<Font_raster>& font);
+
+  void getBounds(Rect& bounds) override;
+
+  void draw(Graphics2D& g2, float x, float y) override;
+};
+
+/**************************************************************************************************/
+
+/** The layout of the pixels of an image of the raster backend */
+enum class PixelFormat {
+  /** 1 byte per pixel, the alpha only */
+  alpha8,
+  /** 4 bytes per pixel in the order R, G, B, A, premultiplied by the alpha */
+  rgba8888
+};
+
+/**
+ * A graphics context that rasterizes straight into a pixel buffer owned by the caller, with no
+ * dependency on a GUI toolkit. The shapes are anti-aliased and blended with the source-over
+ * operator, the glyphs are drawn from the masks of the glyph cache when the transformation only
+ * scales and translates uniformly, from their outlines otherwise.
+ *
+ * A context belongs to one thread, the contexts of different threads share the fonts and the
+ * glyph cache. Drawing does not allocate once the scratch buffers have grown and the glyphs
+ * are in the cache.
+ */
+class Graphics2D_raster : public Graphics2D {
+private:
+  u8* _pixels;
+  int _width, _height, _stride;
+  PixelFormat _format;
+
+  color _color;
+  Stroke _stroke;
+  const Font_raster* _font;
+  Affine _m;
+  float _sx, _sy;
+
+  Rasterizer _raster;
+  // the path of the shapes in user space, and the end of each contour
+  std::vector<Point> _path;
+  std::vector<size_t> _contours;
+
+  void blend(int x, int y, int w, int h, const u8* coverage, int stride);
+
+  void endContour();
+
+  void addRect(float x, float y, float w, float h, bool reverse);
+
+  void addRoundRect(float x, float y, float w, float h, float r, bool reverse);
+
+  /** Add the arc of the circle (cx, cy, r) from the angle a0 to a1 (in radian) */
+  void addArc(float cx, float cy, float r, float a0, float a1);
+
+  void fillPath();
+
+  /** Rasterize the glyph of the given key at the given sub-pixel offset */
+  GlyphMask rasterize(const GlyphCache::Key& key, int subpixel);
+
+  void drawGlyph(u32 c, float x, float y);
+
+public:
+  /**
+   * Create a context that draws into the given pixels
+   *
+   * @param pixels the pixels, row by row, top to bottom
+   * @param width the width of the image in pixels
+   * @param height the height of the image in pixels
+   * @param stride the length of a row in bytes
+   * @param format the layout of the pixels
+   */
+  Graphics2D_raster(u8* pixels, int width, int height, int stride, PixelFormat format);
+
+  /** Fill the whole image with the given color, regardless of the transformation */
+  void clear(color c);
+
+  void setColor(color c) override;
+
+  color getColor() const override;
+
+  void setStroke(const Stroke& s) override;
+
+  const Stroke& getStroke() const override;
+
+  void setStrokeWidth(float w) override;
+
+  const Font* getFont() const override;
+
+  void setFont(const Font* font) override;
+
+  void translate(float dx, float dy) override;
+
+  void scale(float sx, float sy) override;
+
+  void rotate(float angle) override;
+
+  void rotate(float angle, float px, float py) override;
+
+  void reset() override;
+
+  float sx() const override;
+
+  float sy() const override;
+
+  void drawChar(wchar_t c, float x, float y) override;
+
+  void drawText(const std::wstring& c, float x, float y) override;
+
+  void drawGlyphs(const Font* font, const u32* glyphs, const Point* positions, size_t n) override;
+
+  void drawLine(float x1, float y1, float x2, float y2) override;
+
+  void drawRect(float x, float y, float w, float h) override;
+
+  void fillRect(float x, float y, float w, float h) override;
+
+  void drawRoundRect(float x, float y, float w, float h, float rx, float ry) override;
+
+  void fillRoundRect(float x, float y, float w, float h, float rx, float ry) override;
+};
+
+}  // namespace tex
+
+#endif  // GRAPHIC_RASTER_H_INCLUDED
+#endif  // BUILD_RASTER && !MEM_CHECK
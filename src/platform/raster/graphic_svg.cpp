@@ -0,0 +1,370 @@
+#include "config.h"
+
+#if defined(BUILD_RASTER) && !defined(MEM_CHECK)
+
+#include "platform/raster/graphic_svg.h"
+
+#include <cmath>
+
+using namespace tex;
+using namespace std;
+
+namespace {
+
+/** Append v with at most the given count of decimals, with no trailing zeros */
+void appendNum(string& out, float v, int decimals = 2) {
+  long scale = 1;
+  for (int i = 0; i < decimals; i++) scale *= 10;
+  long n = lround(v * (float) scale);
+  if (n < 0) {
+    out += '-';
+    n = -n;
+  }
+  char buf[32];
+  int i = sizeof(buf);
+  long fraction = n % scale;
+  if (fraction != 0) {
+    int digits = decimals;
+    for (; fraction % 10 == 0; digits--) fraction /= 10;
+    for (; digits > 0; digits--) {
+      buf[--i] = (char) ('0' + fraction % 10);
+      fraction /= 10;
+    }
+    buf[--i] = '.';
+  }
+  long integer = n / scale;
+  do {
+    buf[--i] = (char) ('0' + integer % 10);
+    integer /= 10;
+  } while (integer != 0);
+  out.append(buf + i, sizeof(buf) - i);
+}
+
+/** Append the color as #rgb or #rrggbb */
+void appendColor(string& out, color c) {
+  static const char* digits = "0123456789abcdef";
+  const u32 r = color_r(c), g = color_g(c), b = color_b(c);
+  out += '#';
+  if (r % 17 == 0 && g % 17 == 0 && b % 17 == 0) {
+    out += digits[r / 17];
+    out += digits[g / 17];
+    out += digits[b / 17];
+    return;
+  }
+  for (u32 v : {r, g, b}) {
+    out += digits[v >> 4];
+    out += digits[v & 0xf];
+  }
+}
+
+/** Write the contours of a glyph as the data of a path */
+class PathData {
+private:
+  string& _out;
+
+  void point(const Point& p) {
+    appendNum(_out, p.x);
+    // a minus sign separates the numbers as well
+    if (lround(p.y * 100) >= 0) _out += ' ';
+    appendNum(_out, p.y);
+  }
+
+public:
+  explicit PathData(string& out) : _out(out) {}
+
+  void moveTo(const Point& p) {
+    _out += 'M';
+    point(p);
+  }
+
+  void lineTo(const Point& p) {
+    _out += 'L';
+    point(p);
+  }
+
+  void quadTo(const Point& c, const Point& p) {
+    _out += 'Q';
+    point(c);
+    _out += ' ';
+    point(p);
+  }
+
+  void close() {
+    _out += 'Z';
+  }
+};
+
+}  // namespace
+
+Graphics2D_svg::Graphics2D_svg(string& out, float width, float height)
+  : _out(out), _color(black), _groupColor(black), _font(nullptr), _sx(1), _sy(1) {
+  _out += "<svg xmlns=\"http://www.w3.org/2000/svg\"";
+  attr("width", width);
+  attr("height", height);
+  _out += " viewBox=\"0 0 ";
+  appendNum(_out, width);
+  _out += ' ';
+  appendNum(_out, height);
+  _out += "\">";
+}
+
+void Graphics2D_svg::finish() {
+  if (_finished) return;
+  if (_inGroup) _out += "</g>";
+  _out += "</svg>";
+  _inGroup = false;
+  _finished = true;
+}
+
+void Graphics2D_svg::attr(const char* name, float v) {
+  _out += ' ';
+  _out += name;
+  _out += "=\"";
+  appendNum(_out, v);
+  _out += '"';
+}
+
+void Graphics2D_svg::group() {
+  if (_inGroup && _groupColor == _color) return;
+  if (_inGroup) _out += "</g>";
+  _out += "<g fill=\"";
+  appendColor(_out, _color);
+  _out += '"';
+  if (color_a(_color) != 0xff) attr("fill-opacity", (float) color_a(_color) / 255.f);
+  _out += '>';
+  _groupColor = _color;
+  _inGroup = true;
+}
+
+void Graphics2D_svg::matrixAttr(const Affine& m) {
+  _out += " transform=\"matrix(";
+  // the linear part needs more precision than the coordinates
+  for (float v : {m.a, m.b, m.c, m.d}) {
+    appendNum(_out, v, 4);
+    _out += ' ';
+  }
+  appendNum(_out, m.e);
+  _out += ' ';
+  appendNum(_out, m.f);
+  _out += ")\"";
+}
+
+bool Graphics2D_svg::transformAttr() {
+  if (_m.b == 0 && _m.c == 0) return false;
+  matrixAttr(_m);
+  return true;
+}
+
+void Graphics2D_svg::strokeAttrs() {
+  _out += " fill=\"none\" stroke=\"";
+  appendColor(_out, _color);
+  _out += '"';
+  if (color_a(_color) != 0xff) attr("stroke-opacity", (float) color_a(_color) / 255.f);
+  if (_stroke.cap == CAP_ROUND) _out += " stroke-linecap=\"round\"";
+  else if (_stroke.cap == CAP_SQUARE) _out += " stroke-linecap=\"square\"";
+  if (_stroke.join == JOIN_ROUND) _out += " stroke-linejoin=\"round\"";
+  else if (_stroke.join == JOIN_BEVEL) _out += " stroke-linejoin=\"bevel\"";
+}
+
+void Graphics2D_svg::drawGlyph(u32 c, float x, float y) {
+  if (_font == nullptr) return;
+  const TrueTypeFace& face = *_font->getFace();
+  const float s = _font->unitScale();
+  // from the font units (y-axis up) to the device
+  const Affine g = _m * Affine{s, 0, 0, -s, x, y};
+
+  // the glyph is defined at the scale of the device
+  const auto key = _font->glyphKey(c, sqrt(abs(g.a * g.d - g.b * g.c)) * face.unitsPerEm());
+  if (key.size == 0) return;
+  auto it = _glyphs.find(key);
+  if (it == _glyphs.end()) {
+    const auto outline = _font->getOutline(key);
+    if (outline->isEmpty()) return;
+    it = _glyphs.emplace(key, (u32) _glyphs.size()).first;
+    _out += "<defs><path id=\"g";
+    _out += to_string(it->second);
+    _out += "\" d=\"";
+    PathData data(_out);
+    outline->replay(data);
+    _out += "\"/></defs>";
+  }
+
+  group();
+  _out += "<use href=\"#g";
+  _out += to_string(it->second);
+  _out += '"';
+  // the transformation from the definition (y-axis down) to the device
+  const float q = (float) key.size / (GlyphCache::SIZE_STEPS * face.unitsPerEm());
+  const Affine t{g.a / q, g.b / q, -g.c / q, -g.d / q, g.e, g.f};
+  const float eps = 1e-3f;
+  if (abs(t.a - 1) < eps && abs(t.d - 1) < eps && abs(t.b) < eps && abs(t.c) < eps) {
+    attr("x", t.e);
+    attr("y", t.f);
+  } else {
+    matrixAttr(t);
+  }
+  _out += "/>";
+}
+
+void Graphics2D_svg::setColor(color c) {
+  _color = c;
+}
+
+color Graphics2D_svg::getColor() const {
+  return _color;
+}
+
+void Graphics2D_svg::setStroke(const Stroke& s) {
+  _stroke = s;
+}
+
+const Stroke& Graphics2D_svg::getStroke() const {
+  return _stroke;
+}
+
+void Graphics2D_svg::setStrokeWidth(float w) {
+  _stroke.lineWidth = w;
+}
+
+const Font* Graphics2D_svg::getFont() const {
+  return _font;
+}
+
+void Graphics2D_svg::setFont(const Font* font) {
+  _font = static_cast<const Font_raster*>(font);
+}
+
+void Graphics2D_svg::translate(float dx, float dy) {
+  _m.e += _m.a * dx + _m.c * dy;
+  _m.f += _m.b * dx + _m.d * dy;
+}
+
+void Graphics2D_svg::scale(float sx, float sy) {
+  _m.a *= sx;
+  _m.b *= sx;
+  _m.c *= sy;
+  _m.d *= sy;
+  _sx *= sx;
+  _sy *= sy;
+}
+
+void Graphics2D_svg::rotate(float angle) {
+  const float s = sin(angle), c = cos(angle);
+  const float a = _m.a * c + _m.c * s, b = _m.b * c + _m.d * s;
+  _m.c = _m.c * c - _m.a * s;
+  _m.d = _m.d * c - _m.b * s;
+  _m.a = a;
+  _m.b = b;
+}
+
+void Graphics2D_svg::rotate(float angle, float px, float py) {
+  translate(px, py);
+  rotate(angle);
+  translate(-px, -py);
+}
+
+void Graphics2D_svg::reset() {
+  _m = Affine();
+  _sx = _sy = 1;
+}
+
+float Graphics2D_svg::sx() const {
+  return _sx;
+}
+
+float Graphics2D_svg::sy() const {
+  return _sy;
+}
+
+void Graphics2D_svg::drawChar(wchar_t c, float x, float y) {
+  drawGlyph((u32) c, x, y);
+}
+
+void Graphics2D_svg::drawText(const wstring& c, float x, float y) {
+  if (_font == nullptr) return;
+  const TrueTypeFace& face = *_font->getFace();
+  const float s = _font->unitScale();
+  for (wchar_t ch : c) {
+    drawGlyph((u32) ch, x, y);
+    x += face.advance(face.glyphIndex((u32) ch)) * s;
+  }
+}
+
+void Graphics2D_svg::drawGlyphs(
+  const Font* font, const u32* glyphs, const Point* positions, size_t n
+) {
+  setFont(font);
+  for (size_t i = 0; i < n; i++) drawGlyph(glyphs[i], positions[i].x, positions[i].y);
+}
+
+void Graphics2D_svg::drawLine(float x1, float y1, float x2, float y2) {
+  group();
+  _out += "<line";
+  float width = _stroke.lineWidth;
+  if (!transformAttr()) {
+    const Point p1 = _m.apply(x1, y1), p2 = _m.apply(x2, y2);
+    x1 = p1.x, y1 = p1.y, x2 = p2.x, y2 = p2.y;
+    width *= sqrt(abs(_m.a * _m.d));
+  }
+  attr("x1", x1);
+  attr("y1", y1);
+  attr("x2", x2);
+  attr("y2", y2);
+  strokeAttrs();
+  attr("stroke-width", width);
+  _out += "/>";
+}
+
+void Graphics2D_svg::drawRect(float x, float y, float w, float h) {
+  drawRoundRect(x, y, w, h, 0, 0);
+}
+
+void Graphics2D_svg::fillRect(float x, float y, float w, float h) {
+  fillRoundRect(x, y, w, h, 0, 0);
+}
+
+void Graphics2D_svg::drawRoundRect(float x, float y, float w, float h, float rx, float ry) {
+  group();
+  _out += "<rect";
+  float width = _stroke.lineWidth;
+  if (!transformAttr()) {
+    const Point p1 = _m.apply(x, y), p2 = _m.apply(x + w, y + h);
+    x = min(p1.x, p2.x), y = min(p1.y, p2.y);
+    w = abs(p2.x - p1.x), h = abs(p2.y - p1.y);
+    rx *= abs(_m.a), ry *= abs(_m.d);
+    width *= sqrt(abs(_m.a * _m.d));
+  }
+  attr("x", x);
+  attr("y", y);
+  attr("width", w);
+  attr("height", h);
+  if (rx > 0 || ry > 0) {
+    attr("rx", rx);
+    attr("ry", ry);
+  }
+  strokeAttrs();
+  attr("stroke-width", width);
+  _out += "/>";
+}
+
+void Graphics2D_svg::fillRoundRect(float x, float y, float w, float h, float rx, float ry) {
+  group();
+  _out += "<rect";
+  if (!transformAttr()) {
+    const Point p1 = _m.apply(x, y), p2 = _m.apply(x + w, y + h);
+    x = min(p1.x, p2.x), y = min(p1.y, p2.y);
+    w = abs(p2.x - p1.x), h = abs(p2.y - p1.y);
+    rx *= abs(_m.a), ry *= abs(_m.d);
+  }
+  attr("x", x);
+  attr("y", y);
+  attr("width", w);
+  attr("height", h);
+  if (rx > 0 || ry > 0) {
+    attr("rx", rx);
+    attr("ry", ry);
+  }
+  _out += "/>";
+}
+
+#endif  // BUILD_RASTER && !MEM_CHECK
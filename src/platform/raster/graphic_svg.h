@@ -0,0 +1,119 @@
+#include "config.h"
+
+#if defined(BUILD_RASTER) && !defined(MEM_CHECK)
+
+#ifndef GRAPHIC_SVG_H_INCLUDED
+#define GRAPHIC_SVG_H_INCLUDED
+
+#include <string>
+#include <unordered_map>
+
+#include "graphic/graphic.h"
+#include "platform/raster/graphic_raster.h"
+
+namespace tex {
+
+/**
+ * A graphics context that writes the drawing as an SVG document, appended to a buffer
+ * supplied by the caller (it may be reused from document to document to avoid allocations).
+ * The document is opened by the constructor and closed by #finish.
+ *
+ * Each distinct glyph (a glyph of a face at a size) is written once as a path in a defs
+ * element, right before its first use, and then referenced with use elements. The glyphs and
+ * the shapes are written in absolute coordinates, a transform attribute is only written when
+ * the context is rotated or skewed. The color is set on groups of consecutive elements.
+ *
+ * It uses the fonts of the raster backend (see Font_raster) to get the outlines of the glyphs,
+ * from the glyph cache.
+ */
+class Graphics2D_svg : public Graphics2D {
+private:
+  std::string& _out;
+  // the ids of the glyphs defined in the document
+  std::unordered_map<GlyphCache::Key, u32, GlyphCache::Key::Hash> _glyphs;
+  bool _finished = false;
+
+  color _color;
+  // the color of the opened group
+  color _groupColor;
+  bool _inGroup = false;
+  Stroke _stroke;
+  const Font_raster* _font;
+  Affine _m;
+  float _sx, _sy;
+
+  void attr(const char* name, float v);
+
+  /** Open a group with the current color if it differs from the opened one */
+  void group();
+
+  void matrixAttr(const Affine& m);
+
+  /** Write the transform attribute if the context rotates or skews its content */
+  bool transformAttr();
+
+  /** Write the stroke attributes of the shapes */
+  void strokeAttrs();
+
+  void drawGlyph(u32 c, float x, float y);
+
+public:
+  /**
+   * Start a document of the given size (in pixels) in the buffer
+   *
+   * @param out the buffer to append the document to
+   */
+  Graphics2D_svg(std::string& out, float width, float height);
+
+  /** Close the document, nothing can be drawn afterwards */
+  void finish();
+
+  void setColor(color c) override;
+
+  color getColor() const override;
+
+  void setStroke(const Stroke& s) override;
+
+  const Stroke& getStroke() const override;
+
+  void setStrokeWidth(float w) override;
+
+  const Font* getFont() const override;
+
+  void setFont(const Font* font) override;
+
+  void translate(float dx, float dy) override;
+
+  void scale(float sx, float sy) override;
+
+  void rotate(float angle) override;
+
+  void rotate(float angle, float px, float py) override;
+
+  void reset() override;
+
+  float sx() const override;
+
+  float sy() const override;
+
+  void drawChar(wchar_t c, float x, float y) override;
+
+  void drawText(const std::wstring& c, float x, float y) override;
+
+  void drawGlyphs(const Font* font, const u32* glyphs, const Point* positions, size_t n) override;
+
+  void drawLine(float x1, float y1, float x2, float y2) override;
+
+  void drawRect(float x, float y, float w, float h) override;
+
+  void fillRect(float x, float y, float w, float h) override;
+
+  void drawRoundRect(float x, float y, float w, float h, float rx, float ry) override;
+
+  void fillRoundRect(float x, float y, float w, float h, float rx, float ry) override;
+};
+
+}  // namespace tex
+
+#endif  // GRAPHIC_SVG_H_INCLUDED
+#endif  // BUILD_RASTER && !MEM_CHECK
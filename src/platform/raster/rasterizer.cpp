@@ -0,0 +1,124 @@
+#include "config.h"
+
+#if defined(BUILD_RASTER) && !defined(MEM_CHECK)
+
+#include "platform/raster/rasterizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace tex;
+using namespace std;
+
+void Rasterizer::reset(int x, int y, int w, int h) {
+  _x = x;
+  _y = y;
+  _w = max(w, 0);
+  _h = max(h, 0);
+  // 2 more cells for each row, the edges at the right border spill over
+  _cells.assign((size_t) (_w + 2) * _h, 0.f);
+  _start = _last = Point();
+}
+
+void Rasterizer::addCells(int row, float x0, float x1, float d) {
+  float* cells = &_cells[(size_t) row * (_w + 2)];
+  if (x0 > x1) swap(x0, x1);
+  const int x0i = (int) x0;
+  const float x0f = x0 - (float) x0i;
+  const int x1i = (int) ceil(x1);
+  if (x1i <= x0i + 1) {
+    // the edge is within one cell, split its area with the next one
+    const float xm = 0.5f * (x0 + x1) - (float) x0i;
+    cells[x0i] += d - d * xm;
+    cells[x0i + 1] += d * xm;
+    return;
+  }
+  const float s = 1.f / (x1 - x0);
+  const float a0 = 0.5f * s * (1 - x0f) * (1 - x0f);
+  const float x1f = x1 - (float) x1i + 1;
+  const float am = 0.5f * s * x1f * x1f;
+  cells[x0i] += d * a0;
+  if (x1i == x0i + 2) {
+    cells[x0i + 1] += d * (1 - a0 - am);
+  } else {
+    const float a1 = s * (1.5f - x0f);
+    cells[x0i + 1] += d * (a1 - a0);
+    for (int i = x0i + 2; i < x1i - 1; i++) cells[i] += d * s;
+    const float a2 = a1 + (float) (x1i - x0i - 3) * s;
+    cells[x1i - 1] += d * (1 - a2 - am);
+  }
+  cells[x1i] += d * am;
+}
+
+void Rasterizer::edge(Point p0, Point p1) {
+  p0.x -= (float) _x;
+  p0.y -= (float) _y;
+  p1.x -= (float) _x;
+  p1.y -= (float) _y;
+  if (p0.y == p1.y) return;
+  float dir = 1;
+  if (p0.y > p1.y) {
+    swap(p0, p1);
+    dir = -1;
+  }
+  const float dxdy = (p1.x - p0.x) / (p1.y - p0.y);
+  const float w = (float) _w;
+  const int r0 = max(0, (int) floor(p0.y));
+  const int r1 = min(_h, (int) ceil(p1.y));
+  for (int row = r0; row < r1; row++) {
+    const float top = max((float) row, p0.y);
+    const float bottom = min((float) row + 1, p1.y);
+    // the parts out of the box horizontally are pushed to its borders, the coverage to their
+    // right is the same
+    const float xa = clamp(p0.x + (top - p0.y) * dxdy, 0.f, w);
+    const float xb = clamp(p0.x + (bottom - p0.y) * dxdy, 0.f, w);
+    addCells(row, xa, xb, (bottom - top) * dir);
+  }
+}
+
+void Rasterizer::moveTo(const Point& p) {
+  close();
+  _start = _last = p;
+}
+
+void Rasterizer::lineTo(const Point& p) {
+  edge(_last, p);
+  _last = p;
+}
+
+void Rasterizer::quadTo(const Point& c, const Point& p) {
+  // subdivide so the distance from the curve is under 1/16 pixel
+  const float ddx = _last.x - 2 * c.x + p.x;
+  const float ddy = _last.y - 2 * c.y + p.y;
+  const float dev = sqrt(ddx * ddx + ddy * ddy);
+  const int n = min(1 + (int) sqrt(dev * 2), 32);
+  const Point p0 = _last;
+  for (int i = 1; i < n; i++) {
+    const float t = (float) i / (float) n, u = 1 - t;
+    const float a = u * u, b = 2 * u * t, e = t * t;
+    lineTo({a * p0.x + b * c.x + e * p.x, a * p0.y + b * c.y + e * p.y});
+  }
+  lineTo(p);
+}
+
+void Rasterizer::close() {
+  if (_last.x != _start.x || _last.y != _start.y) edge(_last, _start);
+  _last = _start;
+}
+
+const u8* Rasterizer::coverage() {
+  close();
+  _mask.resize((size_t) _w * _h);
+  for (int row = 0; row < _h; row++) {
+    const float* cells = &_cells[(size_t) row * (_w + 2)];
+    u8* mask = &_mask[(size_t) row * _w];
+    float acc = 0;
+    for (int i = 0; i < _w; i++) {
+      acc += cells[i];
+      mask[i] = (u8) (min(abs(acc), 1.f) * 255.f + 0.5f);
+    }
+  }
+  return _mask.data();
+}
+
+#endif  // BUILD_RASTER && !MEM_CHECK
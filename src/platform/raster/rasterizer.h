@@ -0,0 +1,102 @@
+#include "config.h"
+
+#if defined(BUILD_RASTER) && !defined(MEM_CHECK)
+
+#ifndef RASTERIZER_H_INCLUDED
+#define RASTERIZER_H_INCLUDED
+
+#include <vector>
+
+#include "graphic/graphic.h"
+
+namespace tex {
+
+/** An affine transformation: x' = a * x + c * y + e, y' = b * x + d * y + f */
+struct Affine {
+  float a = 1, b = 0, c = 0, d = 1, e = 0, f = 0;
+
+  inline Point apply(float x, float y) const {
+    return {a * x + c * y + e, b * x + d * y + f};
+  }
+
+  /** Test if the transformation only scales and translates */
+  inline bool isAxisAligned() const { return b == 0 && c == 0; }
+
+  /** Concatenate the transformation t, it is applied before this one */
+  Affine operator*(const Affine& t) const {
+    return {
+      a * t.a + c * t.b, b * t.a + d * t.b,
+      a * t.c + c * t.d, b * t.c + d * t.d,
+      a * t.e + c * t.f + e, b * t.e + d * t.f + f
+    };
+  }
+};
+
+/** Receives the contours of a path, the coordinates are in device pixels */
+class PathSink {
+public:
+  /** Start a new contour at p, the previous one is closed */
+  virtual void moveTo(const Point& p) = 0;
+
+  virtual void lineTo(const Point& p) = 0;
+
+  /** Add a quadratic Bézier curve from the current point to p with the control point c */
+  virtual void quadTo(const Point& c, const Point& p) = 0;
+
+  /** Close the current contour */
+  virtual void close() = 0;
+
+  virtual ~PathSink() = default;
+};
+
+/**
+ * A scanline rasterizer that accumulates the signed area covered by the edges of a path into
+ * a buffer of cells, the coverage of a pixel is the running sum of the cells of its row
+ * (non-zero winding, anti-aliased). The path is clipped to the box given to #reset, the
+ * buffers are kept between the paths, so rasterizing does not allocate once they have grown
+ * to the size of the largest box.
+ *
+ * A rasterizer is not thread-safe, each graphics context owns one.
+ */
+class Rasterizer : public PathSink {
+private:
+  std::vector<float> _cells;
+  std::vector<u8> _mask;
+  int _x = 0, _y = 0, _w = 0, _h = 0;
+  Point _start, _last;
+
+  void addCells(int row, float x0, float x1, float d);
+
+  void edge(Point p0, Point p1);
+
+public:
+  /** Start a new path, clipped to the box (x, y, w, h) in device pixels */
+  void reset(int x, int y, int w, int h);
+
+  inline int x() const { return _x; }
+
+  inline int y() const { return _y; }
+
+  inline int width() const { return _w; }
+
+  inline int height() const { return _h; }
+
+  void moveTo(const Point& p) override;
+
+  void lineTo(const Point& p) override;
+
+  void quadTo(const Point& c, const Point& p) override;
+
+  void close() override;
+
+  /**
+   * Close the path and compute the coverage of the box, a row-major mask of width() x height()
+   * bytes, valid until the next call to #reset.
+   */
+  const u8* coverage();
+};
+
+}  // namespace tex
+
+#endif  // RASTERIZER_H_INCLUDED
+#endif  // BUILD_RASTER && !MEM_CHECK
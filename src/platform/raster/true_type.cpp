@@ -0,0 +1,331 @@
+#include "config.h"
+
+#if defined(BUILD_RASTER) && !defined(MEM_CHECK)
+
+#include "platform/raster/true_type.h"
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include "utils/exceptions.h"
+
+using namespace tex;
+using namespace std;
+
+namespace {
+
+/** A point of a simple glyph in font units */
+struct GlyphPoint {
+  float x, y;
+  bool on;
+};
+
+// flags of the points of a simple glyph
+constexpr u8 ON_CURVE = 0x01;
+constexpr u8 X_SHORT = 0x02;
+constexpr u8 Y_SHORT = 0x04;
+constexpr u8 REPEAT = 0x08;
+constexpr u8 X_SAME = 0x10;
+constexpr u8 Y_SAME = 0x20;
+
+// flags of the components of a composite glyph
+constexpr u16 ARGS_ARE_WORDS = 0x0001;
+constexpr u16 ARGS_ARE_XY = 0x0002;
+constexpr u16 HAS_SCALE = 0x0008;
+constexpr u16 MORE_COMPONENTS = 0x0020;
+constexpr u16 HAS_XY_SCALE = 0x0040;
+constexpr u16 HAS_2X2 = 0x0080;
+
+// composite glyphs nested deeper than this are considered broken
+constexpr int MAX_DEPTH = 8;
+
+inline Point mid(const Point& a, const Point& b) {
+  return {(a.x + b.x) / 2, (a.y + b.y) / 2};
+}
+
+}  // namespace
+
+u16 TrueTypeFace::u16At(size_t off) const {
+  if (off + 2 > _data.size()) return 0;
+  return (u16) ((_data[off] << 8) | _data[off + 1]);
+}
+
+u32 TrueTypeFace::u32At(size_t off) const {
+  if (off + 4 > _data.size()) return 0;
+  return ((u32) _data[off] << 24) | ((u32) _data[off + 1] << 16)
+         | ((u32) _data[off + 2] << 8) | (u32) _data[off + 3];
+}
+
+TrueTypeFace::TrueTypeFace(vector<u8>&& data) : _data(std::move(data)) {
+  const u16 tables = u16At(4);
+  u32 head = 0, maxp = 0, hhea = 0;
+  for (u16 i = 0; i < tables; i++) {
+    const size_t rec = 12 + 16 * (size_t) i;
+    if (rec + 16 > _data.size()) break;
+    const char* tag = (const char*) &_data[rec];
+    const u32 off = u32At(rec + 8);
+    if (strncmp(tag, "head", 4) == 0) head = off;
+    else if (strncmp(tag, "maxp", 4) == 0) maxp = off;
+    else if (strncmp(tag, "hhea", 4) == 0) hhea = off;
+    else if (strncmp(tag, "hmtx", 4) == 0) _hmtx = off;
+    else if (strncmp(tag, "loca", 4) == 0) _loca = off;
+    else if (strncmp(tag, "cmap", 4) == 0) _cmap = off;
+    else if (strncmp(tag, "glyf", 4) == 0) {
+      _glyf = off;
+      _glyfLen = u32At(rec + 12);
+    }
+  }
+  if (head == 0 || maxp == 0 || hhea == 0 || _hmtx == 0 || _loca == 0 || _glyf == 0) {
+    throw ex_res_parse("Not a TrueType font with glyf outlines!");
+  }
+  _unitsPerEm = (float) u16At(head + 18);
+  if (_unitsPerEm == 0) _unitsPerEm = 1000;
+  _longLoca = u16At(head + 50) != 0;
+  _glyphs = u16At(maxp + 4);
+  _ascent = (float) (i16) u16At(hhea + 4);
+  _descent = -(float) (i16) u16At(hhea + 6);
+  _hMetrics = u16At(hhea + 34);
+
+  // keep the format 4 sub-table, of the Windows Unicode encoding if any
+  const u32 cmap = _cmap;
+  _cmap = 0;
+  const u16 subtables = u16At(cmap + 2);
+  for (u16 i = 0; i < subtables; i++) {
+    const size_t rec = cmap + 4 + 8 * (size_t) i;
+    const u16 platform = u16At(rec), encoding = u16At(rec + 2);
+    const u32 off = cmap + u32At(rec + 4);
+    if (u16At(off) != 4) continue;
+    if (platform == 3 && encoding == 1) {
+      _cmap = off;
+      break;
+    }
+    if (platform == 0 && _cmap == 0) _cmap = off;
+  }
+}
+
+sptr<const TrueTypeFace> TrueTypeFace::load(const string& file) {
+  static mutex lock;
+  static map<string, sptr<const TrueTypeFace>> faces;
+  lock_guard<mutex> guard(lock);
+  const auto it = faces.find(file);
+  if (it != faces.end()) return it->second;
+
+  ifstream in(file, ios::binary);
+  if (!in) throw ex_res_parse("Cannot read the font file '" + file + "'!");
+  vector<u8> data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+  auto face = sptrOf<const TrueTypeFace>(std::move(data));
+  faces[file] = face;
+  return face;
+}
+
+u16 TrueTypeFace::glyphIndex(u32 c) const {
+  if (_cmap == 0 || c > 0xffff) return 0;
+  const u32 segs = u16At(_cmap + 6) / 2;
+  const u32 ends = _cmap + 14;
+  const u32 starts = ends + 2 * segs + 2;
+  const u32 deltas = starts + 2 * segs;
+  const u32 ranges = deltas + 2 * segs;
+  // the segments are sorted by their end codes
+  u32 lo = 0, hi = segs;
+  while (lo < hi) {
+    const u32 m = (lo + hi) / 2;
+    if (u16At(ends + 2 * m) < c) lo = m + 1;
+    else hi = m;
+  }
+  if (lo == segs || u16At(starts + 2 * lo) > c) return 0;
+  const u16 delta = u16At(deltas + 2 * lo);
+  const u16 range = u16At(ranges + 2 * lo);
+  if (range == 0) return (u16) (c + delta);
+  const u16 g = u16At(ranges + 2 * lo + range + 2 * (c - u16At(starts + 2 * lo)));
+  return g == 0 ? 0 : (u16) (g + delta);
+}
+
+float TrueTypeFace::advance(u16 glyph) const {
+  if (_hMetrics == 0) return 0;
+  const u16 i = glyph < _hMetrics ? glyph : (u16) (_hMetrics - 1);
+  return (float) u16At(_hmtx + 4 * (size_t) i);
+}
+
+u32 TrueTypeFace::glyphOffset(u16 glyph, u32& len) const {
+  len = 0;
+  if (glyph >= _glyphs) return 0;
+  u32 start, end;
+  if (_longLoca) {
+    start = u32At(_loca + 4 * (size_t) glyph);
+    end = u32At(_loca + 4 * (size_t) glyph + 4);
+  } else {
+    start = 2 * (u32) u16At(_loca + 2 * (size_t) glyph);
+    end = 2 * (u32) u16At(_loca + 2 * (size_t) glyph + 2);
+  }
+  if (end <= start || end > _glyfLen) return 0;
+  len = end - start;
+  return _glyf + start;
+}
+
+GlyphBounds TrueTypeFace::bounds(u16 glyph) const {
+  GlyphBounds b;
+  u32 len;
+  const u32 off = glyphOffset(glyph, len);
+  if (off == 0 || len < 10) return b;
+  b.xMin = (i16) u16At(off + 2);
+  b.yMin = (i16) u16At(off + 4);
+  b.xMax = (i16) u16At(off + 6);
+  b.yMax = (i16) u16At(off + 8);
+  return b;
+}
+
+void TrueTypeFace::outline(u16 glyph, const Affine& m, PathSink& sink) const {
+  outline(glyph, m, sink, 0);
+}
+
+void TrueTypeFace::outline(u16 glyph, const Affine& m, PathSink& sink, int depth) const {
+  u32 len;
+  const u32 off = glyphOffset(glyph, len);
+  if (off == 0 || len < 10 || depth > MAX_DEPTH) return;
+  const u32 end = off + len;
+  const i16 contours = (i16) u16At(off);
+
+  if (contours < 0) {
+    // a composite glyph, draw its components with their own transformations
+    u32 p = off + 10;
+    u16 flags;
+    do {
+      if (p + 4 > end) return;
+      flags = u16At(p);
+      const u16 component = u16At(p + 2);
+      p += 4;
+      float dx = 0, dy = 0;
+      if (flags & ARGS_ARE_WORDS) {
+        if (flags & ARGS_ARE_XY) {
+          dx = (float) (i16) u16At(p);
+          dy = (float) (i16) u16At(p + 2);
+        }
+        p += 4;
+      } else {
+        if (p + 2 > end) return;
+        if (flags & ARGS_ARE_XY) {
+          dx = (float) (int8_t) _data[p];
+          dy = (float) (int8_t) _data[p + 1];
+        }
+        p += 2;
+      }
+      // the scales are in F2Dot14
+      Affine t;
+      if (flags & HAS_SCALE) {
+        t.a = t.d = (float) (i16) u16At(p) / 16384.f;
+        p += 2;
+      } else if (flags & HAS_XY_SCALE) {
+        t.a = (float) (i16) u16At(p) / 16384.f;
+        t.d = (float) (i16) u16At(p + 2) / 16384.f;
+        p += 4;
+      } else if (flags & HAS_2X2) {
+        t.a = (float) (i16) u16At(p) / 16384.f;
+        t.b = (float) (i16) u16At(p + 2) / 16384.f;
+        t.c = (float) (i16) u16At(p + 4) / 16384.f;
+        t.d = (float) (i16) u16At(p + 6) / 16384.f;
+        p += 8;
+      }
+      t.e = dx;
+      t.f = dy;
+      outline(component, m * t, sink, depth + 1);
+    } while (flags & MORE_COMPONENTS);
+    return;
+  }
+
+  // a simple glyph: the end points of the contours, the instructions, then the flags and the
+  // coordinates of the points
+  const u32 endPts = off + 10;
+  if (contours == 0 || endPts + 2 * (u32) contours + 2 > end) return;
+  const u16 count = (u16) (u16At(endPts + 2 * (contours - 1)) + 1);
+  u32 p = endPts + 2 * contours;
+  p += 2 + u16At(p);
+
+  static thread_local vector<GlyphPoint> points;
+  static thread_local vector<u8> flags;
+  points.resize(count);
+  flags.resize(count);
+  for (u16 i = 0; i < count;) {
+    if (p >= end) return;
+    const u8 f = _data[p++];
+    u8 repeat = 0;
+    if (f & REPEAT) {
+      if (p >= end) return;
+      repeat = _data[p++];
+    }
+    for (u16 k = 0; k <= repeat && i < count; k++) flags[i++] = f;
+  }
+  i32 v = 0;
+  for (u16 i = 0; i < count; i++) {
+    const u8 f = flags[i];
+    if (f & X_SHORT) {
+      if (p >= end) return;
+      const u8 dx = _data[p++];
+      v += (f & X_SAME) ? dx : -dx;
+    } else if (!(f & X_SAME)) {
+      v += (i16) u16At(p);
+      p += 2;
+    }
+    points[i].x = (float) v;
+    points[i].on = (f & ON_CURVE) != 0;
+  }
+  v = 0;
+  for (u16 i = 0; i < count; i++) {
+    const u8 f = flags[i];
+    if (f & Y_SHORT) {
+      if (p >= end) return;
+      const u8 dy = _data[p++];
+      v += (f & Y_SAME) ? dy : -dy;
+    } else if (!(f & Y_SAME)) {
+      v += (i16) u16At(p);
+      p += 2;
+    }
+    points[i].y = (float) v;
+  }
+  if (p > end) return;
+
+  u16 first = 0;
+  for (i16 c = 0; c < contours; c++) {
+    const u16 last = u16At(endPts + 2 * c);
+    if (last < first || last >= count) return;
+    const u16 n = (u16) (last - first + 1);
+    const auto at = [&](u16 i) {
+      const GlyphPoint& gp = points[first + i];
+      return m.apply(gp.x, gp.y);
+    };
+    const auto on = [&](u16 i) { return points[first + i].on; };
+    // start from an on-curve point, or from the middle of 2 off-curve points
+    u16 s = 0, e = n;
+    Point start;
+    if (on(0)) {
+      start = at(0);
+      s = 1;
+    } else if (on((u16) (n - 1))) {
+      start = at((u16) (n - 1));
+      e = (u16) (n - 1);
+    } else {
+      start = mid(at(0), at((u16) (n - 1)));
+    }
+    sink.moveTo(start);
+    bool hasControl = false;
+    Point control;
+    for (u16 i = s; i < e; i++) {
+      const Point pt = at(i);
+      if (on(i)) {
+        if (hasControl) sink.quadTo(control, pt);
+        else sink.lineTo(pt);
+        hasControl = false;
+      } else {
+        if (hasControl) sink.quadTo(control, mid(control, pt));
+        control = pt;
+        hasControl = true;
+      }
+    }
+    if (hasControl) sink.quadTo(control, start);
+    sink.close();
+    first = (u16) (last + 1);
+  }
+}
+
+#endif  // BUILD_RASTER && !MEM_CHECK
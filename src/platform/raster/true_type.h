@@ -0,0 +1,91 @@
+#include "config.h"
+
+#if defined(BUILD_RASTER) && !defined(MEM_CHECK)
+
+#ifndef TRUE_TYPE_H_INCLUDED
+#define TRUE_TYPE_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include "platform/raster/rasterizer.h"
+
+namespace tex {
+
+/** The bounding box of a glyph in font units, y goes up */
+struct GlyphBounds {
+  i16 xMin = 0, yMin = 0, xMax = 0, yMax = 0;
+
+  inline bool isEmpty() const { return xMin >= xMax || yMin >= yMax; }
+};
+
+/**
+ * A TrueType font with quadratic (glyf) outlines loaded in memory. Only the tables the
+ * rasterizer needs are read: the character map (format 4), the outlines and the horizontal
+ * metrics, the hinting instructions are ignored. A face is immutable once loaded, it is shared
+ * by all the fonts and all the threads that use the same file.
+ */
+class TrueTypeFace {
+private:
+  std::vector<u8> _data;
+  u32 _cmap = 0, _glyf = 0, _loca = 0, _hmtx = 0;
+  u32 _glyfLen = 0;
+  u16 _glyphs = 0, _hMetrics = 0;
+  bool _longLoca = false;
+  float _unitsPerEm = 1000;
+  float _ascent = 0, _descent = 0;
+
+  u16 u16At(size_t off) const;
+
+  u32 u32At(size_t off) const;
+
+  /** Get the offset and the length of the glyph in the glyf table, 0 if it has no outline */
+  u32 glyphOffset(u16 glyph, u32& len) const;
+
+  void outline(u16 glyph, const Affine& m, PathSink& sink, int depth) const;
+
+public:
+  /**
+   * Load a face from the given data
+   *
+   * @throw ex_res_parse if the data is not a TrueType font with glyf outlines
+   */
+  explicit TrueTypeFace(std::vector<u8>&& data);
+
+  /**
+   * Get the face of the given file, the faces are loaded once and kept for the whole run of
+   * the program. This function is thread-safe.
+   *
+   * @throw ex_res_parse if the file cannot be read or is not a TrueType font
+   */
+  static sptr<const TrueTypeFace> load(const std::string& file);
+
+  inline float unitsPerEm() const { return _unitsPerEm; }
+
+  /** The ascent in font units, positive */
+  inline float ascent() const { return _ascent; }
+
+  /** The descent in font units, positive */
+  inline float descent() const { return _descent; }
+
+  /** Get the glyph index of the given character, 0 (the missing glyph) if it is not mapped */
+  u16 glyphIndex(u32 c) const;
+
+  /** Get the advance width of the glyph in font units */
+  float advance(u16 glyph) const;
+
+  /** Get the bounding box of the glyph, empty if it has no outline */
+  GlyphBounds bounds(u16 glyph) const;
+
+  /**
+   * Send the contours of the glyph to the given sink
+   *
+   * @param m the transformation from the font units to the device pixels
+   */
+  void outline(u16 glyph, const Affine& m, PathSink& sink) const;
+};
+
+}  // namespace tex
+
+#endif  // TRUE_TYPE_H_INCLUDED
+#endif  // BUILD_RASTER && !MEM_CHECK
@@ -4,6 +4,7 @@
 
 #include "platform/skia/graphic_skia.h"
 
+#include <core/SkTextBlob.h>
 #include <utility>
 
 using namespace tex;
@@ -258,6 +259,21 @@ void Graphics2D_skia::drawText(const wstring &t, float x, float y) {
   _canvas->drawString(str.c_str(), x, y, _font->getSkFont(), _paint);
 }
 
+void Graphics2D_skia::drawGlyphs(const Font *font, const u32 *glyphs, const Point *positions, size_t n) {
+  if (_font != font) setFont(font);
+  const SkFont skFont = _font->getSkFont();
+  SkTextBlobBuilder builder;
+  const auto &run = builder.allocRunPos(skFont, (int) n);
+  // the characters are in UTF-32, one glyph for each character
+  skFont.textToGlyphs(glyphs, n * sizeof(u32), SkTextEncoding::kUTF32, run.glyphs, (int) n);
+  for (size_t i = 0; i < n; i++) {
+    run.pos[2 * i] = positions[i].x;
+    run.pos[2 * i + 1] = positions[i].y;
+  }
+  _paint.setStyle(SkPaint::kFill_Style);
+  _canvas->drawTextBlob(builder.make(), 0, 0, _paint);
+}
+
 void Graphics2D_skia::drawLine(float x1, float y1, float x2, float y2) {
   _paint.setStyle(SkPaint::kStroke_Style);
   _canvas->drawLine(x1, y1, x2, y2, _paint);
@@ -125,6 +125,10 @@ public:
 
   virtual void drawText(const std::wstring &t, float x, float y) override;
 
+  virtual void drawGlyphs(
+    const Font *font, const u32 *glyphs, const Point *positions, size_t n
+  ) override;
+
   virtual void drawLine(float x, float y1, float x2, float y2) override;
 
   virtual void drawRect(float x, float y, float w, float h) override;
@@ -3,6 +3,8 @@
 #include "atom/atom.h"
 #include "core/core.h"
 #include "core/formula.h"
+#include "core/macro.h"
+#include "core/memo.h"
 
 using namespace std;
 using namespace tex;
@@ -11,11 +13,11 @@ const color TeXRender::_defaultcolor = black;
 float TeXRender::_defaultSize = -1;
 float TeXRender::_magFactor = 0;
 
-TeXRender::TeXRender(const sptr<Box>& box, float textSize, bool trueValues) {
+TeXRender::TeXRender(const sptr<Box>& box, float textSize, bool trueValues, float magFactor) {
   _box = box;
   if (_defaultSize != -1) _textSize = _defaultSize;
-  if (_magFactor != 0) {
-    _textSize = textSize * std::abs(_magFactor);
+  if (magFactor != 0) {
+    _textSize = textSize * std::abs(magFactor);
   } else {
     _textSize = textSize;
   }
@@ -98,23 +100,29 @@ float TeXRender::getBaseline() const {
 }
 
 void TeXRender::setTextSize(float textSize) {
+  invalidate();
   _textSize = textSize;
 }
 
 void TeXRender::setForeground(color fg) {
+  invalidate();
   _fg = fg;
 }
 
-Insets TeXRender::getInsets() {
+Insets TeXRender::getInsets() const {
   return _insets;
 }
 
 void TeXRender::setInsets(const Insets& insets, bool trueval) {
+  invalidate();
   _insets = insets;
   if (!trueval) _insets += (int) (0.18f * _textSize);
 }
 
 void TeXRender::setWidth(int width, Alignment align) {
+  invalidate();
+  // the layout does not know the new width
+  _layout = nullptr;
   float diff = width - getWidth();
   // FIXME
   // only care if new width larger than old
@@ -123,7 +131,25 @@ void TeXRender::setWidth(int width, Alignment align) {
   }
 }
 
+sptr<Box> TeXRender::arrange(const Layout& layout, float width) {
+  if (!layout.split) {
+    return sptrOf<HBox>(layout.box, layout.isMaxWidth ? layout.box->_width : width, layout.align);
+  }
+  auto split = BoxSplitter::split(layout.box, width, layout.lineSpace, layout.breaking);
+  return sptrOf<HBox>(split, layout.isMaxWidth ? split->_width : width, layout.align);
+}
+
+bool TeXRender::reflow(int width) {
+  if (_layout == nullptr || width <= 0) return false;
+  invalidate();
+  _box = arrange(*_layout, (float) width * _layout->pixel);
+  return true;
+}
+
 void TeXRender::setHeight(int height, Alignment align) {
+  invalidate();
+  // the layout does not know the new height
+  _layout = nullptr;
   float diff = height - getHeight();
   // FIXME
   // only care if new height larger than old
@@ -132,7 +158,24 @@ void TeXRender::setHeight(int height, Alignment align) {
   }
 }
 
-void TeXRender::draw(Graphics2D& g2, int x, int y) {
+void TeXRender::invalidate() {
+  lock_guard<mutex> lock(_listMutex);
+  _list = nullptr;
+  _listCompiled = false;
+}
+
+sptr<const DisplayList> TeXRender::getDisplayList() const {
+  lock_guard<mutex> lock(_listMutex);
+  if (!_listCompiled) {
+    DisplayListRecorder recorder;
+    drawTree(recorder, 0, 0);
+    _list = recorder.finish();
+    _listCompiled = true;
+  }
+  return _list;
+}
+
+void TeXRender::drawTree(Graphics2D& g2, int x, int y) const {
   color old = g2.getColor();
   g2.scale(_textSize, _textSize);
   if (!isTransparent(_fg)) {
@@ -149,6 +192,16 @@ void TeXRender::draw(Graphics2D& g2, int x, int y) {
   g2.setColor(old);
 }
 
+void TeXRender::draw(Graphics2D& g2, int x, int y) const {
+  const auto list = getDisplayList();
+  if (list == nullptr) {
+    drawTree(g2, x, y);
+    return;
+  }
+  list->replay(g2, (float) x, (float) y);
+  g2.reset();
+}
+
 DefaultTeXFont* TeXRenderBuilder::createFont(float size, int type) {
   DefaultTeXFont* tf = new DefaultTeXFont(size);
   if (type == 0) tf->setSs(false);
@@ -161,10 +214,24 @@ DefaultTeXFont* TeXRenderBuilder::createFont(float size, int type) {
 }
 
 TeXRender* TeXRenderBuilder::build(Formula& f) {
-  return build(f._root);
+  _scope = &f.getMacroScope();
+  try {
+    auto* render = build(f._root);
+    _scope = nullptr;
+    return render;
+  } catch (...) {
+    _scope = nullptr;
+    throw;
+  }
+}
+
+float TeXRenderBuilder::magFactor() const {
+  return _scope != nullptr ? _scope->_magFactor : TeXRender::_magFactor;
 }
 
-TeXRender* TeXRenderBuilder::build(const sptr<Atom>& fc) {
+sptr<Box> TeXRenderBuilder::layout(
+  const sptr<Atom>& fc, bool measuring, TeXRender::Layout* keep
+) {
   sptr<Atom> f = fc;
   if (f == nullptr) f = sptrOf<EmptyAtom>();
   if (_textSize == -1) {
@@ -176,36 +243,93 @@ TeXRender* TeXRenderBuilder::build(const sptr<Atom>& fc) {
     ? new DefaultTeXFont(_textSize)
     : createFont(_textSize, _type)
   );
+  if (_scope != nullptr && _scope->_textFactor != 0) {
+    font->setSizeFactors(_scope->_textFactor, _scope->_scriptFactor, _scope->_scriptScriptFactor);
+  }
   sptr<TeXFont> tf(font);
   Environment* env;
   if (_widthUnit != UnitType::none && _textWidth != 0) {
-    env = new Environment(_style, tf, _widthUnit, _textWidth);
+    env = new Environment(_style, *tf, _widthUnit, _textWidth);
   } else {
-    env = new Environment(_style, tf);
+    env = new Environment(_style, *tf);
   }
 
   if (_lineSpaceUnit != UnitType::none) {
     env->setInterline(_lineSpaceUnit, _lineSpace);
   }
+  env->setMeasuring(measuring);
+  env->setBreakEverywhere(_scope != nullptr ? _scope->_breakEverywhere : RowAtom::_breakEveywhere);
+  // the boxes are kept for the formulas laid out with the default settings only
+  env->setLayoutCache(_scope == nullptr || _scope->isDefaultLayout() ? _layoutCache : nullptr);
+  // the repeated sub-expressions are laid out once
+  BoxMemo memo;
+  env->setBoxMemo(&memo);
 
+  // the formula cannot be reflowed if the atoms are laid out in the text width
+  bool widthUsed = false;
+  env->trackTextWidth(&widthUsed);
   auto box = f->createBox(*env);
-  TeXRender* render;
+  env->trackTextWidth(nullptr);
   if (_widthUnit != UnitType::none && _textWidth != 0) {
-    HBox* hb;
-    if (_lineSpaceUnit != UnitType::none && _lineSpace != 0) {
-      float space = _lineSpace * SpaceAtom::getFactor(_lineSpaceUnit, *env);
-      auto split = BoxSplitter::split(box, env->getTextWidth(), space);
-      hb = new HBox(split, _isMaxWidth ? split->_width : env->getTextWidth(), _align);
-    } else {
-      hb = new HBox(box, _isMaxWidth ? box->_width : env->getTextWidth(), _align);
-    }
-    render = new TeXRender(sptr<Box>(hb), _textSize, _trueValues);
-  } else {
-    render = new TeXRender(box, _textSize, _trueValues);
+    TeXRender::Layout l;
+    l.box = box;
+    l.pixel = SpaceAtom::getFactor(UnitType::pixel, *env);
+    l.align = _align;
+    l.isMaxWidth = _isMaxWidth;
+    l.split = _lineSpaceUnit != UnitType::none && _lineSpace != 0;
+    if (l.split) l.lineSpace = _lineSpace * SpaceAtom::getFactor(_lineSpaceUnit, *env);
+    l.breaking = _lineBreaking;
+    box = TeXRender::arrange(l, env->getTextWidth());
+    if (keep != nullptr && !widthUsed) *keep = std::move(l);
   }
 
-  if (!isTransparent(_fg)) render->setForeground(_fg);
-
   delete env;
+  return box;
+}
+
+TeXRender* TeXRenderBuilder::build(const sptr<Atom>& f) {
+  ArenaScope scope(_arena != nullptr ? _arena : Arena::current());
+  TeXRender::Layout l;
+  auto* render = new TeXRender(
+    layout(f, false, _reflowable ? &l : nullptr),
+    _textSize,
+    _trueValues,
+    magFactor()
+  );
+  // the debug boxes are added into the groups of the tree, it cannot be laid out again
+  if (l.box != nullptr && !Box::DEBUG) {
+    render->_layout = std::make_shared<const TeXRender::Layout>(std::move(l));
+  }
+  if (!isTransparent(_fg)) render->setForeground(_fg);
+  // one arena per render
+  render->_arena = std::move(_arena);
   return render;
 }
+
+TeXMetrics TeXRenderBuilder::measure(Formula& f) {
+  _scope = &f.getMacroScope();
+  try {
+    const auto m = measure(f._root);
+    _scope = nullptr;
+    return m;
+  } catch (...) {
+    _scope = nullptr;
+    throw;
+  }
+}
+
+TeXMetrics TeXRenderBuilder::measure(const sptr<Atom>& f) {
+  ArenaScope scope(_arena != nullptr ? _arena : Arena::current());
+  const auto box = layout(f, true);
+  // the same as the getters of the render that would be built
+  const float mag = magFactor();
+  const float size = mag != 0 ? _textSize * std::abs(mag) : _textSize;
+  const int insets = _trueValues ? 0 : (int) (0.18f * _textSize);
+  TeXMetrics m;
+  m.width = (int) (box->_width * size + 2 * insets);
+  m.height = (int) ((box->_height + box->_depth) * size + 2 * insets);
+  m.depth = (int) (box->_depth * size + insets);
+  m.baseline = (box->_height * size + insets) / ((box->_height + box->_depth) * size + 2 * insets);
+  _arena = nullptr;
+  return m;
+}
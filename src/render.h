@@ -2,9 +2,11 @@
 #define RENDER_H_INCLUDED
 
 #include <functional>
+#include <mutex>
 
 #include "utils/enums.h"
 #include "box/box.h"
+#include "box/display_list.h"
 #include "graphic/graphic.h"
 
 namespace tex {
@@ -17,16 +19,58 @@ class Box;
 
 class Atom;
 
+class LayoutCache;
+
+class MacroScope;
+
 using BoxFilter = std::function<bool(const sptr<Box>&)>;
 
+/** The dimensions of a formula in pixels, the same as the getters of its TeXRender */
+struct TeXMetrics {
+  int width = 0;
+  // the height plus the depth, see TeXRender#getHeight
+  int height = 0;
+  int depth = 0;
+  // the position of the baseline relative to the height, see TeXRender#getBaseline
+  float baseline = 0;
+};
+
 class TeXRender {
 private:
+  /** What is needed to lay the formula out again at another width, see #reflow */
+  struct Layout {
+    // the box of the formula before it is broken into lines and aligned
+    sptr<Box> box;
+    // the size of a pixel and the space between the lines, in the units of the boxes
+    float pixel = 0, lineSpace = 0;
+    Alignment align = Alignment::none;
+    bool isMaxWidth = false;
+    // if the formula is broken into lines
+    bool split = false;
+    LineBreaking breaking = LineBreaking::optimal;
+  };
+
   static const color _defaultcolor;
 
+  // the arena the boxes are allocated from, nullptr if they are allocated one by one, it is
+  // declared first to be destroyed after the boxes
+  sptr<Arena> _arena;
   sptr<Box> _box;
   float _textSize;
   color _fg = black;
   Insets _insets;
+  // the box tree compiled on the first draw, see #getDisplayList
+  mutable std::mutex _listMutex;
+  mutable sptr<const DisplayList> _list;
+  mutable bool _listCompiled = false;
+  // nullptr if the render cannot be reflowed, see TeXRenderBuilder#setReflowable
+  sptr<const Layout> _layout;
+
+  void invalidate();
+
+  void drawTree(Graphics2D& g2, int x, int y) const;
+
+  friend class TeXRenderBuilder;
 
   void buildDebug(
     const sptr<BoxGroup>& parent,
@@ -36,14 +80,25 @@ private:
 
   static sptr<BoxGroup> wrap(const sptr<Box>& box);
 
+  /** Break the box of the given layout into lines and align it in the given width */
+  static sptr<Box> arrange(const Layout& layout, float width);
+
 public:
   static float _defaultSize;
   static float _magFactor;
 
-  TeXRender(const sptr<Box>& box, float textSize, bool trueValues = false);
+  /** @param magFactor the magnification factor, 0 if none, see DefaultTeXFont#setMagnification */
+  TeXRender(
+    const sptr<Box>& box, float textSize, bool trueValues = false, float magFactor = _magFactor);
 
   float getTextSize() const;
 
+  /** Get the root box of this render, it must not outlive the render if it has an arena */
+  inline const sptr<Box>& getBox() const { return _box; }
+
+  /** Get the arena the boxes of this render are allocated from, nullptr if none */
+  inline const sptr<Arena>& getArena() const { return _arena; }
+
   int getHeight() const;
 
   int getDepth() const;
@@ -56,15 +111,43 @@ public:
 
   void setForeground(color fg);
 
-  Insets getInsets();
+  Insets getInsets() const;
 
   void setInsets(const Insets& insets, bool trueval = false);
 
+  /**
+   * Widen the render to the given width if it is narrower. The render cannot be reflowed
+   * afterwards, see #reflow.
+   */
   void setWidth(int width, Alignment align);
 
+  /**
+   * Heighten the render to the given height if it is lower. The render cannot be reflowed
+   * afterwards, see #reflow.
+   */
   void setHeight(int height, Alignment align);
 
-  void draw(Graphics2D& g2, int x, int y);
+  /**
+   * Lay the formula out again at the given width (in pixels, as given to LaTeX#parse): the
+   * box tree built from the formula is kept, only the line breaks and the alignment are done
+   * again, so it is much cheaper than parsing the formula again, e.g. on each resize.
+   *
+   * @return false if the render cannot be reflowed: it was not built reflowable (see
+   * TeXRenderBuilder#setReflowable), it was built without a width, it has parts laid out in
+   * the width (e.g. the multline environment), it was built in the debug mode (see
+   * LaTeX#setDebug) or it was resized by #setWidth or #setHeight; the render is left
+   * unchanged then
+   */
+  bool reflow(int width);
+
+  /**
+   * Get the display list compiled from the box tree, nullptr if the tree cannot be
+   * flattened. It is compiled on the first call and dropped when the render is changed.
+   */
+  sptr<const DisplayList> getDisplayList() const;
+
+  /** Draw this render at (x, y), replays the display list if the tree can be flattened */
+  void draw(Graphics2D& g2, int x, int y) const;
 };
 
 class TeXRenderBuilder {
@@ -74,9 +157,23 @@ private:
   UnitType _widthUnit = UnitType::none;
   UnitType _lineSpaceUnit = UnitType::none;
   float _textSize = 0, _textWidth = 0, _lineSpace = 0;
-  bool _trueValues = false, _isMaxWidth = false;
+  bool _trueValues = false, _isMaxWidth = false, _reflowable = false;
   color _fg = black;
   Alignment _align = Alignment::none;
+  LineBreaking _lineBreaking = LineBreaking::optimal;
+  sptr<Arena> _arena;
+  LayoutCache* _layoutCache = nullptr;
+  // the settings of the formula being built, nullptr if none, see #build(Formula&)
+  const MacroScope* _scope = nullptr;
+
+  /** Get the magnification factor of the formula being built, 0 if none */
+  float magFactor() const;
+
+  /**
+   * Create the box of the given formula, only measured if measuring is true. If the formula
+   * is laid out in a width and keep is not nullptr, what is needed to reflow it is put there.
+   */
+  sptr<Box> layout(const sptr<Atom>& f, bool measuring, TeXRender::Layout* keep = nullptr);
 
 public:
   // TODO declaration conflict with TypefaceStyle defined in graphic/graphic.h
@@ -106,6 +203,34 @@ public:
     return *this;
   }
 
+  /**
+   * Allocate the boxes from the given arena, the render owns it once built. The atoms to
+   * build from should be allocated from the same arena, see ArenaScope.
+   */
+  inline TeXRenderBuilder& setArena(const sptr<Arena>& arena) {
+    _arena = arena;
+    return *this;
+  }
+
+  /**
+   * Take the boxes of the atoms kept from the previous layouts from the given cache, and keep
+   * the new ones there (nullptr for none), see LayoutCache
+   */
+  inline TeXRenderBuilder& setLayoutCache(LayoutCache* cache) {
+    _layoutCache = cache;
+    return *this;
+  }
+
+  /**
+   * Keep the box tree of the formula before it is broken into lines in the render, so it can
+   * be reflowed (see TeXRender#reflow). Disabled by default, the render holds a second tree
+   * then.
+   */
+  inline TeXRenderBuilder& setReflowable(bool reflowable) {
+    _reflowable = reflowable;
+    return *this;
+  }
+
   inline TeXRenderBuilder& setForeground(color c) {
     _fg = c;
     return *this;
@@ -167,10 +292,27 @@ public:
     return *this;
   }
 
+  /** Set how the formula is broken into lines if it is wider than the width (optimal by default) */
+  inline TeXRenderBuilder& setLineBreaking(LineBreaking breaking) {
+    _lineBreaking = breaking;
+    return *this;
+  }
+
   TeXRender* build(const sptr<Atom>& f);
 
+  /** Build the given formula with the settings it made, see \magnification for example */
   TeXRender* build(Formula& f);
 
+  /**
+   * Get the dimensions of the render #build would return, without building it: the boxes are
+   * laid out in the measuring mode (see Environment#isMeasuring), so the texts that are not
+   * in the fonts of the formulas are measured and dropped at once, and the boxes are dropped
+   * with the arena (if any) before returning.
+   */
+  TeXMetrics measure(const sptr<Atom>& f);
+
+  TeXMetrics measure(Formula& f);
+
   static DefaultTeXFont* createFont(float size, int type);
 };
 
@@ -0,0 +1,122 @@
+#include "render_cache.h"
+
+#include "latex.h"
+
+#include <functional>
+
+using namespace std;
+using namespace tex;
+
+bool RenderKey::operator==(const RenderKey& k) const {
+  return width == k.width
+         && textSize == k.textSize
+         && lineSpace == k.lineSpace
+         && fg == k.fg
+         && style == k.style
+         && type == k.type
+         && tex == k.tex;
+}
+
+size_t RenderKey::Hash::operator()(const RenderKey& k) const {
+  size_t h = hash<wstring>()(k.tex);
+  const auto mix = [&h](size_t v) { h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2); };
+  mix(hash<int>()(k.width));
+  mix(hash<float>()(k.textSize));
+  mix(hash<float>()(k.lineSpace));
+  mix(hash<color>()(k.fg));
+  mix(hash<int>()((int) k.style));
+  mix(hash<int>()(k.type));
+  return h;
+}
+
+RenderCache::RenderCache(size_t budget, size_t shards)
+  : _shardBudget(budget / max<size_t>(shards, 1)),
+    _shards(max<size_t>(shards, 1)),
+    _hits(0), _misses(0), _evictions(0) {}
+
+RenderCache::Shard& RenderCache::shardOf(const RenderKey& key) {
+  // the low bits pick the bucket in the shard, take the high ones to pick the shard
+  const size_t h = RenderKey::Hash()(key);
+  return _shards[(h >> (sizeof(size_t) * 4)) % _shards.size()];
+}
+
+sptr<const TeXRender> RenderCache::find(const RenderKey& key) {
+  Shard& shard = shardOf(key);
+  lock_guard<mutex> guard(shard.lock);
+  auto it = shard.index.find(key);
+  if (it == shard.index.end()) return nullptr;
+  shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+  return it->second->render;
+}
+
+sptr<const TeXRender> RenderCache::get(const RenderKey& key) {
+  auto cached = find(key);
+  if (cached != nullptr) {
+    _hits++;
+    return cached;
+  }
+  _misses++;
+
+  TeXContext context;
+  sptr<const TeXRender> render(context.parse(
+    key.tex, key.width, key.textSize, key.lineSpace, key.fg, key.style, key.type));
+  const size_t bytes = estimateBytes(*render) + sizeof(Entry) + key.tex.length() * sizeof(wchar_t);
+  if (bytes > _shardBudget) return render;
+
+  Shard& shard = shardOf(key);
+  lock_guard<mutex> guard(shard.lock);
+  auto it = shard.index.find(key);
+  if (it != shard.index.end()) {
+    // built by another thread in the meantime
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    return it->second->render;
+  }
+  shard.entries.push_front({key, render, bytes});
+  shard.index[key] = shard.entries.begin();
+  shard.bytes += bytes;
+  while (shard.bytes > _shardBudget) {
+    const Entry& last = shard.entries.back();
+    shard.bytes -= last.bytes;
+    shard.index.erase(last.key);
+    shard.entries.pop_back();
+    _evictions++;
+  }
+  return render;
+}
+
+void RenderCache::clear() {
+  for (auto& shard : _shards) {
+    lock_guard<mutex> guard(shard.lock);
+    shard.index.clear();
+    shard.entries.clear();
+    shard.bytes = 0;
+  }
+}
+
+RenderCacheStats RenderCache::stats() {
+  RenderCacheStats s;
+  s.hits = _hits;
+  s.misses = _misses;
+  s.evictions = _evictions;
+  for (auto& shard : _shards) {
+    lock_guard<mutex> guard(shard.lock);
+    s.bytes += shard.bytes;
+    s.entries += shard.index.size();
+  }
+  return s;
+}
+
+size_t RenderCache::estimateBytes(const TeXRender& render) {
+  if (render.getArena() != nullptr) return sizeof(TeXRender) + render.getArena()->bytes();
+  // every box is held by a shared pointer, count its control block and a typical box
+  static const size_t BOX_BYTES = 32 + sizeof(Box) + 32;
+  size_t bytes = sizeof(TeXRender);
+  vector<sptr<Box>> stack{render.getBox()};
+  while (!stack.empty()) {
+    const auto box = std::move(stack.back());
+    stack.pop_back();
+    bytes += BOX_BYTES;
+    for (auto& child : box->descendants()) stack.push_back(std::move(child));
+  }
+  return bytes;
+}
@@ -0,0 +1,108 @@
+#ifndef RENDER_CACHE_H_INCLUDED
+#define RENDER_CACHE_H_INCLUDED
+
+#include "common.h"
+#include "render.h"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tex {
+
+/** The source and the parameters a render is built from, see TeXContext#parse */
+struct RenderKey {
+  std::wstring tex;
+  int width = 720;
+  float textSize = 20.f;
+  float lineSpace = 20.f / 3;
+  color fg = black;
+  TexStyle style = TexStyle::display;
+  // the font type, see TeXRenderBuilder#TeXFontStyle, -1 for the default font
+  int type = -1;
+
+  bool operator==(const RenderKey& k) const;
+
+  struct Hash {
+    size_t operator()(const RenderKey& k) const;
+  };
+};
+
+/** The counters of a RenderCache */
+struct RenderCacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;
+  // the estimated size in bytes of the cached renders
+  size_t bytes = 0;
+  size_t entries = 0;
+};
+
+/**
+ * A bounded least-recently-used cache of renders. A render in the cache is shared by all
+ * the callers asking for the same key, it must not be changed, so the cache hands out
+ * const renders. The cache is split into shards that are locked separately, the shard of a
+ * key is picked by its hash, so the threads rendering different formulas rarely wait for
+ * each other. A formula is parsed outside of the locks, two threads missing the same key at
+ * the same time both parse it and the first one to finish is kept.
+ *
+ * The budget is the estimated size in bytes of the box trees of the renders, split evenly
+ * between the shards, the least recently used renders of a shard are dropped once the shard
+ * goes over its part. A render larger than the part of a shard is returned but not cached.
+ */
+class RenderCache {
+private:
+  struct Entry {
+    RenderKey key;
+    sptr<const TeXRender> render;
+    size_t bytes;
+  };
+
+  struct Shard {
+    std::mutex lock;
+    // the most recently used comes first
+    std::list<Entry> entries;
+    std::unordered_map<RenderKey, std::list<Entry>::iterator, RenderKey::Hash> index;
+    size_t bytes = 0;
+  };
+
+  const size_t _shardBudget;
+  std::vector<Shard> _shards;
+  std::atomic<size_t> _hits, _misses, _evictions;
+
+  Shard& shardOf(const RenderKey& key);
+
+public:
+  static constexpr size_t DEFAULT_BUDGET = 64 << 20;
+  static constexpr size_t DEFAULT_SHARDS = 16;
+
+  explicit RenderCache(size_t budget = DEFAULT_BUDGET, size_t shards = DEFAULT_SHARDS);
+
+  RenderCache(const RenderCache&) = delete;
+
+  RenderCache& operator=(const RenderCache&) = delete;
+
+  /**
+   * Get the render of the given key, parse the formula if it is not cached. The parse
+   * errors are thrown to the caller and nothing is cached.
+   */
+  sptr<const TeXRender> get(const RenderKey& key);
+
+  /** Get the render of the given key if it is cached, return nullptr otherwise */
+  sptr<const TeXRender> find(const RenderKey& key);
+
+  /** Drop all the cached renders, the renders held by the callers stay valid */
+  void clear();
+
+  RenderCacheStats stats();
+
+  /** Estimate the size in bytes of the given render */
+  static size_t estimateBytes(const TeXRender& render);
+};
+
+}  // namespace tex
+
+#endif  // RENDER_CACHE_H_INCLUDED
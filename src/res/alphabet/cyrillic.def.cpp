@@ -0,0 +1,331 @@
+// Generated by prebuilt/alphabet_def.py from res/cyrillic, do not edit
+
+#include "res/alphabet_def.res.h"
+
+DECL_FONT_REG(wnr10);
+DECL_FONT_REG(wnti10);
+DECL_FONT_REG(wntt10);
+DECL_FONT_REG(wnss10);
+DECL_FONT_REG(wnssi10);
+DECL_FONT_REG(wnssbx10);
+DECL_FONT_REG(wnbx10);
+DECL_FONT_REG(wnbxti10);
+
+DEF_ALPHABET(cyrillic)
+
+FONTS_START
+FONT(wnr10),
+FONT(wnti10),
+FONT(wntt10),
+FONT(wnss10),
+FONT(wnssi10),
+FONT(wnssbx10),
+FONT(wnbx10),
+FONT(wnbxti10)
+FONTS_END
+
+SYMBOLS_START
+SYM(ordinary, "dotlessi"),
+SYM(accent, "cyrbreve"),
+SYM(accent, "cyrddot"),
+SYM(ordinary, "CYRA"),
+SYM(ordinary, "CYRB"),
+SYM(ordinary, "CYRV"),
+SYM(ordinary, "CYRG"),
+SYM(ordinary, "CYRD"),
+SYM(ordinary, "CYRE"),
+SYM(ordinary, "CYRYO"),
+SYM(ordinary, "CYRZH"),
+SYM(ordinary, "CYRZ"),
+SYM(ordinary, "CYRE"),
+SYM(ordinary, "CYRI"),
+SYM(ordinary, "CYRIO"),
+SYM(ordinary, "CYRK"),
+SYM(ordinary, "CYRL"),
+SYM(ordinary, "CYRM"),
+SYM(ordinary, "CYRN"),
+SYM(ordinary, "CYRO"),
+SYM(ordinary, "CYRP"),
+SYM(ordinary, "CYRR"),
+SYM(ordinary, "CYRS"),
+SYM(ordinary, "CYRT"),
+SYM(ordinary, "CYRU"),
+SYM(ordinary, "CYRF"),
+SYM(ordinary, "CYRH"),
+SYM(ordinary, "CYRC"),
+SYM(ordinary, "CYRCH"),
+SYM(ordinary, "CYRSH"),
+SYM(ordinary, "CYRSHCH"),
+SYM(ordinary, "CYRHRDSN"),
+SYM(ordinary, "CYRY"),
+SYM(ordinary, "CYRSFTSN"),
+SYM(ordinary, "CYREREV"),
+SYM(ordinary, "CYRYU"),
+SYM(ordinary, "CYRYA"),
+SYM(ordinary, "cyra"),
+SYM(ordinary, "cyrb"),
+SYM(ordinary, "cyrv"),
+SYM(ordinary, "cyrg"),
+SYM(ordinary, "cyrd"),
+SYM(ordinary, "cyre"),
+SYM(ordinary, "cyryo"),
+SYM(ordinary, "cyrzh"),
+SYM(ordinary, "cyrz"),
+SYM(ordinary, "cyre"),
+SYM(ordinary, "cyri"),
+SYM(ordinary, "cyrio"),
+SYM(ordinary, "cyrk"),
+SYM(ordinary, "cyrl"),
+SYM(ordinary, "cyrm"),
+SYM(ordinary, "cyrn"),
+SYM(ordinary, "cyro"),
+SYM(ordinary, "cyrp"),
+SYM(ordinary, "cyrr"),
+SYM(ordinary, "cyrs"),
+SYM(ordinary, "cyrt"),
+SYM(ordinary, "cyru"),
+SYM(ordinary, "cyrf"),
+SYM(ordinary, "cyrh"),
+SYM(ordinary, "cyrc"),
+SYM(ordinary, "cyrch"),
+SYM(ordinary, "cyrsh"),
+SYM(ordinary, "cyrshch"),
+SYM(ordinary, "cyrhrdsn"),
+SYM(ordinary, "cyry"),
+SYM(ordinary, "cyrsftsn"),
+SYM(ordinary, "cyrerev"),
+SYM(ordinary, "cyryu"),
+SYM(ordinary, "cyrya"),
+SYM(ordinary, "CYRIE"),
+SYM(ordinary, "CYRII"),
+SYM(ordinary, "cyrie"),
+SYM(ordinary, "cyrii"),
+SYM(ordinary, "CYRDJE"),
+SYM(ordinary, "CYRDZE"),
+SYM(ordinary, "CYRJE"),
+SYM(ordinary, "CYRLJE"),
+SYM(ordinary, "CYRNJE"),
+SYM(ordinary, "CYRTSHE"),
+SYM(ordinary, "CYRDZHE"),
+SYM(ordinary, "CYRIZH"),
+SYM(ordinary, "CYRYAT"),
+SYM(ordinary, "CYRFITA"),
+SYM(ordinary, "cyrdje"),
+SYM(ordinary, "cyrdze"),
+SYM(ordinary, "cyrje"),
+SYM(ordinary, "cyrlje"),
+SYM(ordinary, "cyrnje"),
+SYM(ordinary, "cyrtshe"),
+SYM(ordinary, "cyrdzhe"),
+SYM(ordinary, "cyrizh"),
+SYM(ordinary, "cyryat"),
+SYM(ordinary, "cyrfita")
+SYMBOLS_END
+
+CHAR_SYMBOLS_START
+C(305, "dotlessi", nullptr),
+C(1040, "CYRA", nullptr),
+C(1041, "CYRB", nullptr),
+C(1042, "CYRV", nullptr),
+C(1043, "CYRG", nullptr),
+C(1044, "CYRD", nullptr),
+C(1045, "CYRE", nullptr),
+C(1025, "CYRYO", nullptr),
+C(1046, "CYRZH", nullptr),
+C(1047, "CYRZ", nullptr),
+C(1048, "CYRI", nullptr),
+C(1049, "CYRIO", nullptr),
+C(1050, "CYRK", nullptr),
+C(1051, "CYRL", nullptr),
+C(1052, "CYRM", nullptr),
+C(1053, "CYRN", nullptr),
+C(1054, "CYRO", nullptr),
+C(1055, "CYRP", nullptr),
+C(1056, "CYRR", nullptr),
+C(1057, "CYRS", nullptr),
+C(1058, "CYRT", nullptr),
+C(1059, "CYRU", nullptr),
+C(1060, "CYRF", nullptr),
+C(1061, "CYRH", nullptr),
+C(1062, "CYRC", nullptr),
+C(1063, "CYRCH", nullptr),
+C(1064, "CYRSH", nullptr),
+C(1065, "CYRSHCH", nullptr),
+C(1066, "CYRHRDSN", nullptr),
+C(1067, "CYRY", nullptr),
+C(1068, "CYRSFTSN", nullptr),
+C(1069, "CYREREV", nullptr),
+C(1070, "CYRYU", nullptr),
+C(1071, "CYRYA", nullptr),
+C(1072, "cyra", nullptr),
+C(1073, "cyrb", nullptr),
+C(1074, "cyrv", nullptr),
+C(1075, "cyrg", nullptr),
+C(1076, "cyrd", nullptr),
+C(1077, "cyre", nullptr),
+C(1105, "cyryo", nullptr),
+C(1078, "cyrzh", nullptr),
+C(1079, "cyrz", nullptr),
+C(1080, "cyri", nullptr),
+C(1081, "cyrio", nullptr),
+C(1082, "cyrk", nullptr),
+C(1083, "cyrl", nullptr),
+C(1084, "cyrm", nullptr),
+C(1085, "cyrn", nullptr),
+C(1086, "cyro", nullptr),
+C(1087, "cyrp", nullptr),
+C(1088, "cyrr", nullptr),
+C(1089, "cyrs", nullptr),
+C(1090, "cyrt", nullptr),
+C(1091, "cyru", nullptr),
+C(1092, "cyrf", nullptr),
+C(1093, "cyrh", nullptr),
+C(1094, "cyrc", nullptr),
+C(1095, "cyrch", nullptr),
+C(1096, "cyrsh", nullptr),
+C(1097, "cyrshch", nullptr),
+C(1098, "cyrhrdsn", nullptr),
+C(1099, "cyry", nullptr),
+C(1100, "cyrsftsn", nullptr),
+C(1101, "cyrerev", nullptr),
+C(1102, "cyryu", nullptr),
+C(1103, "cyrya", nullptr),
+C(1028, "CYRIE", nullptr),
+C(1030, "CYRII", nullptr),
+C(1108, "cyrie", nullptr),
+C(1110, "cyrii", nullptr),
+C(1026, "CYRDJE", nullptr),
+C(1029, "CYRDZE", nullptr),
+C(1032, "CYRJE", nullptr),
+C(1033, "CYRLJE", nullptr),
+C(1034, "CYRNJE", nullptr),
+C(1035, "CYRTSHE", nullptr),
+C(1039, "CYRDZHE", nullptr),
+C(1140, "CYRIZH", nullptr),
+C(1122, "CYRYAT", nullptr),
+C(1138, "CYRFITA", nullptr),
+C(1106, "cyrdje", nullptr),
+C(1109, "cyrdze", nullptr),
+C(1112, "cyrje", nullptr),
+C(1113, "cyrlje", nullptr),
+C(1114, "cyrnje", nullptr),
+C(1115, "cyrtshe", nullptr),
+C(1119, "cyrdzhe", nullptr),
+C(1141, "cyrizh", nullptr),
+C(1123, "cyryat", nullptr),
+C(1139, "cyrfita", nullptr)
+CHAR_SYMBOLS_END
+
+CHAR_FORMULAS_START
+C(1024, "\\`\\CYRE", nullptr),
+C(1027, "\\'\\CYRG", nullptr),
+C(1031, "\\cyrddot\\CYRII", nullptr),
+C(1111, "\\cyrddot\\dotlessi", nullptr),
+C(1027, "\\'\\CYRG", nullptr),
+C(1027, "\\'\\CYRK", nullptr),
+C(1037, "\\`\\CYRI", nullptr),
+C(1038, "\\cyrbreve\\CYRU", nullptr),
+C(1104, "\\`\\cyre", nullptr),
+C(1107, "\\'\\cyrg", nullptr),
+C(1116, "\\'\\cyrk", nullptr),
+C(1117, "\\`\\cyri", nullptr),
+C(1118, "\\cyrbreve\\cyru", nullptr)
+CHAR_FORMULAS_END
+
+SYMBOL_MAPPINGS_START
+M(wnr10, 305, "dotlessi"),
+M(wnr10, 1040, "CYRA"),
+M(wnr10, 1041, "CYRB"),
+M(wnr10, 1042, "CYRV"),
+M(wnr10, 1043, "CYRG"),
+M(wnr10, 1044, "CYRD"),
+M(wnr10, 1045, "CYRE"),
+M(wnr10, 1025, "CYRYO"),
+M(wnr10, 1046, "CYRZH"),
+M(wnr10, 1047, "CYRZ"),
+M(wnr10, 1048, "CYRI"),
+M(wnr10, 1049, "CYRIO"),
+M(wnr10, 1050, "CYRK"),
+M(wnr10, 1051, "CYRL"),
+M(wnr10, 1052, "CYRM"),
+M(wnr10, 1053, "CYRN"),
+M(wnr10, 1054, "CYRO"),
+M(wnr10, 1055, "CYRP"),
+M(wnr10, 1056, "CYRR"),
+M(wnr10, 1057, "CYRS"),
+M(wnr10, 1058, "CYRT"),
+M(wnr10, 1059, "CYRU"),
+M(wnr10, 1060, "CYRF"),
+M(wnr10, 1061, "CYRH"),
+M(wnr10, 1062, "CYRC"),
+M(wnr10, 1063, "CYRCH"),
+M(wnr10, 1064, "CYRSH"),
+M(wnr10, 1065, "CYRSHCH"),
+M(wnr10, 1066, "CYRHRDSN"),
+M(wnr10, 1067, "CYRY"),
+M(wnr10, 1068, "CYRSFTSN"),
+M(wnr10, 1069, "CYREREV"),
+M(wnr10, 1070, "CYRYU"),
+M(wnr10, 1071, "CYRYA"),
+M(wnr10, 1072, "cyra"),
+M(wnr10, 1073, "cyrb"),
+M(wnr10, 1074, "cyrv"),
+M(wnr10, 1075, "cyrg"),
+M(wnr10, 1076, "cyrd"),
+M(wnr10, 1077, "cyre"),
+M(wnr10, 1105, "cyryo"),
+M(wnr10, 1078, "cyrzh"),
+M(wnr10, 1079, "cyrz"),
+M(wnr10, 1080, "cyri"),
+M(wnr10, 1081, "cyrio"),
+M(wnr10, 1082, "cyrk"),
+M(wnr10, 1083, "cyrl"),
+M(wnr10, 1084, "cyrm"),
+M(wnr10, 1085, "cyrn"),
+M(wnr10, 1086, "cyro"),
+M(wnr10, 1087, "cyrp"),
+M(wnr10, 1088, "cyrr"),
+M(wnr10, 1089, "cyrs"),
+M(wnr10, 1090, "cyrt"),
+M(wnr10, 1091, "cyru"),
+M(wnr10, 1092, "cyrf"),
+M(wnr10, 1093, "cyrh"),
+M(wnr10, 1094, "cyrc"),
+M(wnr10, 1095, "cyrch"),
+M(wnr10, 1096, "cyrsh"),
+M(wnr10, 1097, "cyrshch"),
+M(wnr10, 1098, "cyrhrdsn"),
+M(wnr10, 1099, "cyry"),
+M(wnr10, 1100, "cyrsftsn"),
+M(wnr10, 1101, "cyrerev"),
+M(wnr10, 1102, "cyryu"),
+M(wnr10, 1103, "cyrya"),
+M(wnr10, 1028, "CYRIE"),
+M(wnr10, 1030, "CYRII"),
+M(wnr10, 1108, "cyrie"),
+M(wnr10, 1110, "cyrii"),
+M(wnr10, 1026, "CYRDJE"),
+M(wnr10, 1029, "CYRDZE"),
+M(wnr10, 1032, "CYRJE"),
+M(wnr10, 1033, "CYRLJE"),
+M(wnr10, 1034, "CYRNJE"),
+M(wnr10, 1035, "CYRTSHE"),
+M(wnr10, 1039, "CYRDZHE"),
+M(wnr10, 1140, "CYRIZH"),
+M(wnr10, 1122, "CYRYAT"),
+M(wnr10, 1138, "CYRFITA"),
+M(wnr10, 1106, "cyrdje"),
+M(wnr10, 1109, "cyrdze"),
+M(wnr10, 1112, "cyrje"),
+M(wnr10, 1113, "cyrlje"),
+M(wnr10, 1114, "cyrnje"),
+M(wnr10, 1115, "cyrtshe"),
+M(wnr10, 1119, "cyrdzhe"),
+M(wnr10, 1141, "cyrizh"),
+M(wnr10, 1123, "cyryat"),
+M(wnr10, 1139, "cyrfita"),
+M(wnr10, 774, "cyrbreve"),
+M(wnr10, 776, "cyrddot")
+SYMBOL_MAPPINGS_END
+
+END_DEF_ALPHABET
@@ -0,0 +1,710 @@
+// Generated by prebuilt/alphabet_def.py from res/greek, do not edit
+
+#include "res/alphabet_def.res.h"
+
+DECL_FONT_REG(fcmbipg);
+DECL_FONT_REG(fcmbpg);
+DECL_FONT_REG(fcmripg);
+DECL_FONT_REG(fcmrpg);
+DECL_FONT_REG(fcsbpg);
+DECL_FONT_REG(fcsropg);
+DECL_FONT_REG(fcsrpg);
+DECL_FONT_REG(fctrpg);
+
+DEF_ALPHABET(greek)
+
+FONTS_START
+FONT(fcmbipg),
+FONT(fcmbpg),
+FONT(fcmripg),
+FONT(fcmrpg),
+FONT(fcsbpg),
+FONT(fcsropg),
+FONT(fcsrpg),
+FONT(fctrpg)
+FONTS_END
+
+SYMBOLS_START
+SYM(accent, "\315\264"),
+SYM(accent, "\315\265"),
+SYM(accent, "\315\272"),
+SYM(accent, "\316\204"),
+SYM(accent, "\316\205"),
+SYM(accent, "\316\207"),
+SYM(ordinary, "\316\220"),
+SYM(ordinary, "\316\221"),
+SYM(ordinary, "\316\222"),
+SYM(ordinary, "\316\223"),
+SYM(ordinary, "\316\224"),
+SYM(ordinary, "\316\225"),
+SYM(ordinary, "\316\226"),
+SYM(ordinary, "\316\227"),
+SYM(ordinary, "\316\230"),
+SYM(ordinary, "\316\231"),
+SYM(ordinary, "\316\232"),
+SYM(ordinary, "\316\233"),
+SYM(ordinary, "\316\234"),
+SYM(ordinary, "\316\235"),
+SYM(ordinary, "\316\236"),
+SYM(ordinary, "\316\237"),
+SYM(ordinary, "\316\240"),
+SYM(ordinary, "\316\241"),
+SYM(ordinary, "\316\243"),
+SYM(ordinary, "\316\244"),
+SYM(ordinary, "\316\245"),
+SYM(ordinary, "\316\246"),
+SYM(ordinary, "\316\247"),
+SYM(ordinary, "\316\250"),
+SYM(ordinary, "\316\251"),
+SYM(ordinary, "\316\252"),
+SYM(ordinary, "\316\253"),
+SYM(ordinary, "\316\254"),
+SYM(ordinary, "\316\255"),
+SYM(ordinary, "\316\256"),
+SYM(ordinary, "\316\257"),
+SYM(ordinary, "\316\260"),
+SYM(ordinary, "\316\261"),
+SYM(ordinary, "\316\262"),
+SYM(ordinary, "\316\263"),
+SYM(ordinary, "\316\264"),
+SYM(ordinary, "\316\265"),
+SYM(ordinary, "\316\266"),
+SYM(ordinary, "\316\267"),
+SYM(ordinary, "\316\270"),
+SYM(ordinary, "\316\271"),
+SYM(ordinary, "\316\272"),
+SYM(ordinary, "\316\273"),
+SYM(ordinary, "\316\274"),
+SYM(ordinary, "\316\275"),
+SYM(ordinary, "\316\276"),
+SYM(ordinary, "\316\277"),
+SYM(ordinary, "\317\200"),
+SYM(ordinary, "\317\201"),
+SYM(ordinary, "\317\202"),
+SYM(ordinary, "\317\203"),
+SYM(ordinary, "\317\204"),
+SYM(ordinary, "\317\205"),
+SYM(ordinary, "\317\206"),
+SYM(ordinary, "\317\207"),
+SYM(ordinary, "\317\210"),
+SYM(ordinary, "\317\211"),
+SYM(ordinary, "\317\212"),
+SYM(ordinary, "\317\213"),
+SYM(ordinary, "\317\214"),
+SYM(ordinary, "\317\215"),
+SYM(ordinary, "\317\216"),
+SYM(ordinary, "\317\221"),
+SYM(ordinary, "\317\230"),
+SYM(ordinary, "\317\231"),
+SYM(ordinary, "\317\232"),
+SYM(ordinary, "\317\233"),
+SYM(ordinary, "\317\234"),
+SYM(ordinary, "\317\235"),
+SYM(ordinary, "\317\237"),
+SYM(ordinary, "\317\240"),
+SYM(ordinary, "\317\241"),
+SYM(ordinary, "\341\274\200"),
+SYM(ordinary, "\341\274\201"),
+SYM(ordinary, "\341\274\202"),
+SYM(ordinary, "\341\274\203"),
+SYM(ordinary, "\341\274\204"),
+SYM(ordinary, "\341\274\205"),
+SYM(ordinary, "\341\274\206"),
+SYM(ordinary, "\341\274\207"),
+SYM(ordinary, "\341\274\220"),
+SYM(ordinary, "\341\274\221"),
+SYM(ordinary, "\341\274\222"),
+SYM(ordinary, "\341\274\223"),
+SYM(ordinary, "\341\274\224"),
+SYM(ordinary, "\341\274\225"),
+SYM(ordinary, "\341\274\240"),
+SYM(ordinary, "\341\274\241"),
+SYM(ordinary, "\341\274\242"),
+SYM(ordinary, "\341\274\243"),
+SYM(ordinary, "\341\274\244"),
+SYM(ordinary, "\341\274\245"),
+SYM(ordinary, "\341\274\246"),
+SYM(ordinary, "\341\274\247"),
+SYM(ordinary, "\341\274\260"),
+SYM(ordinary, "\341\274\261"),
+SYM(ordinary, "\341\274\262"),
+SYM(ordinary, "\341\274\263"),
+SYM(ordinary, "\341\274\264"),
+SYM(ordinary, "\341\274\265"),
+SYM(ordinary, "\341\274\266"),
+SYM(ordinary, "\341\274\267"),
+SYM(ordinary, "\341\275\200"),
+SYM(ordinary, "\341\275\201"),
+SYM(ordinary, "\341\275\202"),
+SYM(ordinary, "\341\275\203"),
+SYM(ordinary, "\341\275\204"),
+SYM(ordinary, "\341\275\205"),
+SYM(ordinary, "\341\275\220"),
+SYM(ordinary, "\341\275\221"),
+SYM(ordinary, "\341\275\222"),
+SYM(ordinary, "\341\275\223"),
+SYM(ordinary, "\341\275\224"),
+SYM(ordinary, "\341\275\225"),
+SYM(ordinary, "\341\275\226"),
+SYM(ordinary, "\341\275\227"),
+SYM(ordinary, "\341\275\240"),
+SYM(ordinary, "\341\275\241"),
+SYM(ordinary, "\341\275\242"),
+SYM(ordinary, "\341\275\243"),
+SYM(ordinary, "\341\275\244"),
+SYM(ordinary, "\341\275\245"),
+SYM(ordinary, "\341\275\246"),
+SYM(ordinary, "\341\275\247"),
+SYM(ordinary, "\341\275\260"),
+SYM(ordinary, "\341\275\262"),
+SYM(ordinary, "\341\275\264"),
+SYM(ordinary, "\341\275\266"),
+SYM(ordinary, "\341\275\270"),
+SYM(ordinary, "\341\275\272"),
+SYM(ordinary, "\341\275\274"),
+SYM(ordinary, "\341\276\200"),
+SYM(ordinary, "\341\276\201"),
+SYM(ordinary, "\341\276\202"),
+SYM(ordinary, "\341\276\203"),
+SYM(ordinary, "\341\276\204"),
+SYM(ordinary, "\341\276\205"),
+SYM(ordinary, "\341\276\206"),
+SYM(ordinary, "\341\276\207"),
+SYM(ordinary, "\341\276\220"),
+SYM(ordinary, "\341\276\221"),
+SYM(ordinary, "\341\276\222"),
+SYM(ordinary, "\341\276\223"),
+SYM(ordinary, "\341\276\224"),
+SYM(ordinary, "\341\276\225"),
+SYM(ordinary, "\341\276\226"),
+SYM(ordinary, "\341\276\227"),
+SYM(ordinary, "\341\276\240"),
+SYM(ordinary, "\341\276\241"),
+SYM(ordinary, "\341\276\242"),
+SYM(ordinary, "\341\276\243"),
+SYM(ordinary, "\341\276\244"),
+SYM(ordinary, "\341\276\245"),
+SYM(ordinary, "\341\276\246"),
+SYM(ordinary, "\341\276\247"),
+SYM(ordinary, "\341\276\262"),
+SYM(ordinary, "\341\276\263"),
+SYM(ordinary, "\341\276\264"),
+SYM(ordinary, "\341\276\266"),
+SYM(ordinary, "\341\276\267"),
+SYM(ordinary, "\341\276\274"),
+SYM(accent, "\341\276\276"),
+SYM(accent, "\341\276\277"),
+SYM(accent, "\341\277\200"),
+SYM(accent, "\341\277\201"),
+SYM(ordinary, "\341\277\202"),
+SYM(ordinary, "\341\277\203"),
+SYM(ordinary, "\341\277\204"),
+SYM(ordinary, "\341\277\206"),
+SYM(ordinary, "\341\277\207"),
+SYM(ordinary, "\341\277\214"),
+SYM(accent, "\341\277\215"),
+SYM(accent, "\341\277\216"),
+SYM(accent, "\341\277\217"),
+SYM(ordinary, "\341\277\222"),
+SYM(ordinary, "\341\277\226"),
+SYM(ordinary, "\341\277\227"),
+SYM(accent, "\341\277\235"),
+SYM(accent, "\341\277\236"),
+SYM(accent, "\341\277\237"),
+SYM(ordinary, "\341\277\242"),
+SYM(ordinary, "\341\277\244"),
+SYM(ordinary, "\341\277\245"),
+SYM(ordinary, "\341\277\246"),
+SYM(ordinary, "\341\277\247"),
+SYM(accent, "\341\277\255"),
+SYM(accent, "\341\277\257"),
+SYM(ordinary, "\341\277\262"),
+SYM(ordinary, "\341\277\263"),
+SYM(ordinary, "\341\277\264"),
+SYM(ordinary, "\341\277\266"),
+SYM(ordinary, "\341\277\267"),
+SYM(ordinary, "\341\277\274"),
+SYM(accent, "\341\277\276"),
+SYM(accent, "\342\200\231")
+SYMBOLS_END
+
+CHAR_SYMBOLS_START
+C(884, "\315\264", nullptr),
+C(885, "\315\265", nullptr),
+C(890, "\315\272", nullptr),
+C(900, "\316\204", nullptr),
+C(901, "\316\205", nullptr),
+C(903, "\316\207", nullptr),
+C(912, "\316\220", nullptr),
+C(938, "\316\252", nullptr),
+C(939, "\316\253", nullptr),
+C(940, "\316\254", nullptr),
+C(941, "\316\255", nullptr),
+C(942, "\316\256", nullptr),
+C(943, "\316\257", nullptr),
+C(944, "\316\260", nullptr),
+C(970, "\317\212", nullptr),
+C(971, "\317\213", nullptr),
+C(972, "\317\214", nullptr),
+C(973, "\317\215", nullptr),
+C(974, "\317\216", nullptr),
+C(984, "\317\230", nullptr),
+C(985, "\317\231", nullptr),
+C(986, "\317\232", nullptr),
+C(987, "\317\233", nullptr),
+C(988, "\317\234", nullptr),
+C(989, "\317\235", nullptr),
+C(991, "\317\237", nullptr),
+C(992, "\317\240", nullptr),
+C(993, "\317\241", nullptr),
+C(7936, "\341\274\200", nullptr),
+C(7937, "\341\274\201", nullptr),
+C(7938, "\341\274\202", nullptr),
+C(7939, "\341\274\203", nullptr),
+C(7940, "\341\274\204", nullptr),
+C(7941, "\341\274\205", nullptr),
+C(7942, "\341\274\206", nullptr),
+C(7943, "\341\274\207", nullptr),
+C(7952, "\341\274\220", nullptr),
+C(7953, "\341\274\221", nullptr),
+C(7954, "\341\274\222", nullptr),
+C(7955, "\341\274\223", nullptr),
+C(7956, "\341\274\224", nullptr),
+C(7957, "\341\274\225", nullptr),
+C(7968, "\341\274\240", nullptr),
+C(7969, "\341\274\241", nullptr),
+C(7970, "\341\274\242", nullptr),
+C(7971, "\341\274\243", nullptr),
+C(7972, "\341\274\244", nullptr),
+C(7973, "\341\274\245", nullptr),
+C(7974, "\341\274\246", nullptr),
+C(7975, "\341\274\247", nullptr),
+C(7984, "\341\274\260", nullptr),
+C(7985, "\341\274\261", nullptr),
+C(7986, "\341\274\262", nullptr),
+C(7987, "\341\274\263", nullptr),
+C(7988, "\341\274\264", nullptr),
+C(7989, "\341\274\265", nullptr),
+C(7990, "\341\274\266", nullptr),
+C(7991, "\341\274\267", nullptr),
+C(8000, "\341\275\200", nullptr),
+C(8001, "\341\275\201", nullptr),
+C(8002, "\341\275\202", nullptr),
+C(8003, "\341\275\203", nullptr),
+C(8004, "\341\275\204", nullptr),
+C(8005, "\341\275\205", nullptr),
+C(8016, "\341\275\220", nullptr),
+C(8017, "\341\275\221", nullptr),
+C(8018, "\341\275\222", nullptr),
+C(8019, "\341\275\223", nullptr),
+C(8020, "\341\275\224", nullptr),
+C(8021, "\341\275\225", nullptr),
+C(8022, "\341\275\226", nullptr),
+C(8023, "\341\275\227", nullptr),
+C(8032, "\341\275\240", nullptr),
+C(8033, "\341\275\241", nullptr),
+C(8034, "\341\275\242", nullptr),
+C(8035, "\341\275\243", nullptr),
+C(8036, "\341\275\244", nullptr),
+C(8037, "\341\275\245", nullptr),
+C(8038, "\341\275\246", nullptr),
+C(8039, "\341\275\247", nullptr),
+C(8048, "\341\275\260", nullptr),
+C(8050, "\341\275\262", nullptr),
+C(8052, "\341\275\264", nullptr),
+C(8054, "\341\275\266", nullptr),
+C(8056, "\341\275\270", nullptr),
+C(8058, "\341\275\272", nullptr),
+C(8060, "\341\275\274", nullptr),
+C(8064, "\341\276\200", nullptr),
+C(8065, "\341\276\201", nullptr),
+C(8066, "\341\276\202", nullptr),
+C(8067, "\341\276\203", nullptr),
+C(8068, "\341\276\204", nullptr),
+C(8069, "\341\276\205", nullptr),
+C(8070, "\341\276\206", nullptr),
+C(8071, "\341\276\207", nullptr),
+C(8080, "\341\276\220", nullptr),
+C(8081, "\341\276\221", nullptr),
+C(8082, "\341\276\222", nullptr),
+C(8083, "\341\276\223", nullptr),
+C(8084, "\341\276\224", nullptr),
+C(8085, "\341\276\225", nullptr),
+C(8086, "\341\276\226", nullptr),
+C(8087, "\341\276\227", nullptr),
+C(8096, "\341\276\240", nullptr),
+C(8097, "\341\276\241", nullptr),
+C(8098, "\341\276\242", nullptr),
+C(8099, "\341\276\243", nullptr),
+C(8100, "\341\276\244", nullptr),
+C(8101, "\341\276\245", nullptr),
+C(8102, "\341\276\246", nullptr),
+C(8103, "\341\276\247", nullptr),
+C(8114, "\341\276\262", nullptr),
+C(8115, "\341\276\263", nullptr),
+C(8116, "\341\276\264", nullptr),
+C(8118, "\341\276\266", nullptr),
+C(8119, "\341\276\267", nullptr),
+C(8124, "\341\276\274", nullptr),
+C(8125, "\341\276\277", nullptr),
+C(8126, "\341\276\276", nullptr),
+C(8127, "\341\276\277", nullptr),
+C(8128, "\341\277\200", nullptr),
+C(8129, "\341\277\201", nullptr),
+C(8130, "\341\277\202", nullptr),
+C(8131, "\341\277\203", nullptr),
+C(8132, "\341\277\204", nullptr),
+C(8134, "\341\277\206", nullptr),
+C(8135, "\341\277\207", nullptr),
+C(8140, "\341\277\214", nullptr),
+C(8141, "\341\277\215", nullptr),
+C(8142, "\341\277\216", nullptr),
+C(8143, "\341\277\217", nullptr),
+C(8146, "\341\277\222", nullptr),
+C(8150, "\341\277\226", nullptr),
+C(8151, "\341\277\227", nullptr),
+C(8157, "\341\277\235", nullptr),
+C(8158, "\341\277\236", nullptr),
+C(8159, "\341\277\237", nullptr),
+C(8162, "\341\277\242", nullptr),
+C(8164, "\341\277\244", nullptr),
+C(8165, "\341\277\245", nullptr),
+C(8166, "\341\277\246", nullptr),
+C(8167, "\341\277\247", nullptr),
+C(8173, "\341\277\255", nullptr),
+C(8174, "\316\205", nullptr),
+C(8175, "\341\277\257", nullptr),
+C(8178, "\341\277\262", nullptr),
+C(8179, "\341\277\263", nullptr),
+C(8180, "\341\277\264", nullptr),
+C(8182, "\341\277\266", nullptr),
+C(8183, "\341\277\267", nullptr),
+C(8188, "\341\277\274", nullptr),
+C(8189, "\315\264", nullptr),
+C(8190, "\341\277\276", nullptr),
+C(8217, "\342\200\231", nullptr)
+CHAR_SYMBOLS_END
+
+CHAR_FORMULAS_START
+C(902, "\\grkaccent{\315\264}{\\phantom{\316\271}}\\!\\!A", nullptr),
+C(904, "\\grkaccent{\315\264}{\\phantom{\316\271}}\316\225", nullptr),
+C(905, "\\grkaccent{\315\264}{\\phantom{\316\271}}H", nullptr),
+C(906, "\\grkaccent{\315\264}{\\phantom{\316\271}}\316\231", nullptr),
+C(908, "\\grkaccent{\315\264}{\\phantom{\316\271}}\\!\316\237", nullptr),
+C(910, "\\grkaccent{\315\264}{\\phantom{\316\271}}\316\245", nullptr),
+C(911, "\\grkaccent{\315\264}{\\phantom{\316\271}}\\!\316\251", nullptr),
+C(7944, "\342\200\231\316\221", nullptr),
+C(7945, "\341\277\276\316\221", nullptr),
+C(7946, "\341\277\215\316\221", nullptr),
+C(7947, "\341\277\235\316\221", nullptr),
+C(7948, "\341\277\216\316\221", nullptr),
+C(7949, "\341\277\236\316\221", nullptr),
+C(7950, "\341\277\217\316\221", nullptr),
+C(7951, "\341\277\237\316\221", nullptr),
+C(7960, "\342\200\231\316\225", nullptr),
+C(7961, "\341\277\276\316\225", nullptr),
+C(7962, "\341\277\215\316\225", nullptr),
+C(7963, "\341\277\235\316\225", nullptr),
+C(7964, "\341\277\216\316\225", nullptr),
+C(7965, "\341\277\236\316\225", nullptr),
+C(7976, "\342\200\231\316\227", nullptr),
+C(7977, "\341\277\276\316\227", nullptr),
+C(7978, "\341\277\215\316\227", nullptr),
+C(7979, "\341\277\235\316\227", nullptr),
+C(7980, "\341\277\216\316\227", nullptr),
+C(7981, "\341\277\236\316\227", nullptr),
+C(7982, "\341\277\217\316\227", nullptr),
+C(7983, "\341\277\237\316\227", nullptr),
+C(7992, "\342\200\231\316\231", nullptr),
+C(7993, "\341\277\276\316\231", nullptr),
+C(7994, "\341\277\215\316\231", nullptr),
+C(7995, "\341\277\235\316\231", nullptr),
+C(7996, "\341\277\216\316\231", nullptr),
+C(7997, "\341\277\236\316\231", nullptr),
+C(7998, "\341\277\217\316\231", nullptr),
+C(7999, "\341\277\237\316\231", nullptr),
+C(8008, "\342\200\231\316\237", nullptr),
+C(8009, "\341\277\276\316\237", nullptr),
+C(8010, "\341\277\215\316\237", nullptr),
+C(8011, "\341\277\235\316\237", nullptr),
+C(8012, "\341\277\216\316\237", nullptr),
+C(8013, "\341\277\236\316\237", nullptr),
+C(8025, "\341\277\276\316\245", nullptr),
+C(8026, "\341\277\235\316\245", nullptr),
+C(8027, "\341\277\236\316\245", nullptr),
+C(8028, "\341\277\237\316\245", nullptr),
+C(8040, "\342\200\231\316\251", nullptr),
+C(8041, "\341\277\276\316\251", nullptr),
+C(8042, "\341\277\215\316\251", nullptr),
+C(8043, "\341\277\235\316\251", nullptr),
+C(8044, "\341\277\216\316\251", nullptr),
+C(8045, "\341\277\236\316\251", nullptr),
+C(8046, "\341\277\217\316\251", nullptr),
+C(8047, "\341\277\237\316\251", nullptr),
+C(8049, "\\grkaccent{\316\204}\316\261", nullptr),
+C(8051, "\\grkaccent{\316\204}\316\265", nullptr),
+C(8053, "\\grkaccent{\316\204}\316\267", nullptr),
+C(8055, "\\grkaccent{\316\204}\316\271", nullptr),
+C(8057, "\\grkaccent{\316\204}\316\277", nullptr),
+C(8059, "\\grkaccent{\316\204}\317\205", nullptr),
+C(8061, "\\grkaccent{\316\204}\317\211", nullptr),
+C(8072, "\342\200\231\341\276\274", nullptr),
+C(8073, "\341\277\276\341\276\274", nullptr),
+C(8074, "\341\277\215\341\276\274", nullptr),
+C(8075, "\341\277\235\341\276\274", nullptr),
+C(8076, "\341\277\216\341\276\274", nullptr),
+C(8077, "\341\277\236\341\276\274", nullptr),
+C(8078, "\341\277\217\341\276\274", nullptr),
+C(8079, "\341\277\237\341\276\274", nullptr),
+C(8088, "\342\200\231\341\277\214", nullptr),
+C(8089, "\341\277\276\341\277\214", nullptr),
+C(8090, "\341\277\215\341\277\214", nullptr),
+C(8091, "\341\277\235\341\277\214", nullptr),
+C(8092, "\341\277\216\341\277\214", nullptr),
+C(8093, "\341\277\236\341\277\214", nullptr),
+C(8094, "\341\277\217\341\277\214", nullptr),
+C(8095, "\341\277\237\341\277\214", nullptr),
+C(8100, "\\grkaccent{\341\277\216}\341\277\263", nullptr),
+C(8104, "\342\200\231\341\277\274", nullptr),
+C(8105, "\341\277\276\341\277\274", nullptr),
+C(8106, "\341\277\215\341\277\274", nullptr),
+C(8107, "\341\277\235\341\277\274", nullptr),
+C(8108, "\341\277\216\341\277\274", nullptr),
+C(8109, "\341\277\236\341\277\274", nullptr),
+C(8110, "\341\277\217\341\277\274", nullptr),
+C(8111, "\341\277\237\341\277\274", nullptr),
+C(8112, "\\u \316\261", nullptr),
+C(8113, "\\= \316\261", nullptr),
+C(8120, "\\u \316\221", nullptr),
+C(8121, "\\= \316\221", nullptr),
+C(8122, "\\grkaccent{\341\277\257}{\\vphantom{\316\271}}\316\221", nullptr),
+C(8123, "\\grkaccent{\315\264}{\\vphantom{\316\271}}\\!\\!\316\221", nullptr),
+C(8136, "\\grkaccent{\341\277\257}{\\vphantom{\316\271}}\316\225", nullptr),
+C(8137, "\\grkaccent{\315\264}{\\vphantom{\316\271}}\316\225", nullptr),
+C(8138, "\\grkaccent{\341\277\257}{\\vphantom{\316\271}}\316\227", nullptr),
+C(8139, "\\grkaccent{\315\264}{\\vphantom{\316\271}}\316\227", nullptr),
+C(8144, "\\u \316\271", nullptr),
+C(8145, "\\= \316\271", nullptr),
+C(8147, "\\grkaccent{\316\205}\316\271", nullptr),
+C(8152, "\\u \316\231", nullptr),
+C(8153, "\\= \316\231", nullptr),
+C(8154, "\\grkaccent{\341\277\257}{\\phantom{\316\271}}\316\231", nullptr),
+C(8155, "\\grkaccent{\315\264}{\\phantom{\316\271}}\316\231", nullptr),
+C(8160, "\\u \317\205", nullptr),
+C(8161, "\\= \317\205", nullptr),
+C(8163, "\\grkaccent{\316\205}\317\205", nullptr),
+C(8168, "\\u \316\245", nullptr),
+C(8169, "\\= \316\245", nullptr),
+C(8170, "\\grkaccent{\341\277\257}{\\phantom{\316\271}}\316\245", nullptr),
+C(8171, "\\grkaccent{\315\264}{\\phantom{\316\271}}\316\245", nullptr),
+C(8184, "\\grkaccent{\341\277\257}{\\vphantom{\316\271}}\316\237", nullptr),
+C(8185, "\\grkaccent{\315\264}{\\vphantom{\316\271}}\\!\316\237", nullptr),
+C(8186, "\\grkaccent{\341\277\257}{\\vphantom{\316\271}}\316\251", nullptr),
+C(8187, "\\grkaccent{\315\264}{\\vphantom{\316\271}}\\!\316\251", nullptr)
+CHAR_FORMULAS_END
+
+SYMBOL_MAPPINGS_START
+M(fcmrpg, 884, "\315\264"),
+M(fcmrpg, 885, "\315\265"),
+M(fcmrpg, 890, "\315\272"),
+M(fcmrpg, 900, "\316\204"),
+M(fcmrpg, 901, "\316\205"),
+M(fcmrpg, 903, "\316\207"),
+M(fcmrpg, 912, "\316\220"),
+M(fcmrpg, 913, "\316\221"),
+M(fcmrpg, 914, "\316\222"),
+M(fcmrpg, 915, "\316\223"),
+M(fcmrpg, 916, "\316\224"),
+M(fcmrpg, 917, "\316\225"),
+M(fcmrpg, 918, "\316\226"),
+M(fcmrpg, 919, "\316\227"),
+M(fcmrpg, 920, "\316\230"),
+M(fcmrpg, 921, "\316\231"),
+M(fcmrpg, 922, "\316\232"),
+M(fcmrpg, 923, "\316\233"),
+M(fcmrpg, 924, "\316\234"),
+M(fcmrpg, 925, "\316\235"),
+M(fcmrpg, 926, "\316\236"),
+M(fcmrpg, 927, "\316\237"),
+M(fcmrpg, 928, "\316\240"),
+M(fcmrpg, 929, "\316\241"),
+M(fcmrpg, 931, "\316\243"),
+M(fcmrpg, 932, "\316\244"),
+M(fcmrpg, 933, "\316\245"),
+M(fcmrpg, 934, "\316\246"),
+M(fcmrpg, 935, "\316\247"),
+M(fcmrpg, 936, "\316\250"),
+M(fcmrpg, 937, "\316\251"),
+M(fcmrpg, 938, "\316\252"),
+M(fcmrpg, 939, "\316\253"),
+M(fcmrpg, 940, "\316\254"),
+M(fcmrpg, 941, "\316\255"),
+M(fcmrpg, 942, "\316\256"),
+M(fcmrpg, 943, "\316\257"),
+M(fcmrpg, 944, "\316\260"),
+M(fcmrpg, 945, "\316\261"),
+M(fcmrpg, 946, "\316\262"),
+M(fcmrpg, 947, "\316\263"),
+M(fcmrpg, 948, "\316\264"),
+M(fcmrpg, 949, "\316\265"),
+M(fcmrpg, 950, "\316\266"),
+M(fcmrpg, 951, "\316\267"),
+M(fcmrpg, 952, "\316\270"),
+M(fcmrpg, 953, "\316\271"),
+M(fcmrpg, 954, "\316\272"),
+M(fcmrpg, 955, "\316\273"),
+M(fcmrpg, 956, "\316\274"),
+M(fcmrpg, 957, "\316\275"),
+M(fcmrpg, 958, "\316\276"),
+M(fcmrpg, 959, "\316\277"),
+M(fcmrpg, 960, "\317\200"),
+M(fcmrpg, 961, "\317\201"),
+M(fcmrpg, 962, "\317\202"),
+M(fcmrpg, 963, "\317\203"),
+M(fcmrpg, 964, "\317\204"),
+M(fcmrpg, 965, "\317\205"),
+M(fcmrpg, 966, "\317\206"),
+M(fcmrpg, 967, "\317\207"),
+M(fcmrpg, 968, "\317\210"),
+M(fcmrpg, 969, "\317\211"),
+M(fcmrpg, 970, "\317\212"),
+M(fcmrpg, 971, "\317\213"),
+M(fcmrpg, 972, "\317\214"),
+M(fcmrpg, 973, "\317\215"),
+M(fcmrpg, 974, "\317\216"),
+M(fcmrpg, 977, "\317\221"),
+M(fcmrpg, 984, "\317\230"),
+M(fcmrpg, 985, "\317\231"),
+M(fcmrpg, 986, "\317\232"),
+M(fcmrpg, 987, "\317\233"),
+M(fcmrpg, 988, "\317\234"),
+M(fcmrpg, 989, "\317\235"),
+M(fcmrpg, 991, "\317\237"),
+M(fcmrpg, 992, "\317\240"),
+M(fcmrpg, 993, "\317\241"),
+M(fcmrpg, 7936, "\341\274\200"),
+M(fcmrpg, 7937, "\341\274\201"),
+M(fcmrpg, 7938, "\341\274\202"),
+M(fcmrpg, 7939, "\341\274\203"),
+M(fcmrpg, 7940, "\341\274\204"),
+M(fcmrpg, 7941, "\341\274\205"),
+M(fcmrpg, 7942, "\341\274\206"),
+M(fcmrpg, 7943, "\341\274\207"),
+M(fcmrpg, 7952, "\341\274\220"),
+M(fcmrpg, 7953, "\341\274\221"),
+M(fcmrpg, 7954, "\341\274\222"),
+M(fcmrpg, 7955, "\341\274\223"),
+M(fcmrpg, 7956, "\341\274\224"),
+M(fcmrpg, 7957, "\341\274\225"),
+M(fcmrpg, 7968, "\341\274\240"),
+M(fcmrpg, 7969, "\341\274\241"),
+M(fcmrpg, 7970, "\341\274\242"),
+M(fcmrpg, 7971, "\341\274\243"),
+M(fcmrpg, 7972, "\341\274\244"),
+M(fcmrpg, 7973, "\341\274\245"),
+M(fcmrpg, 7974, "\341\274\246"),
+M(fcmrpg, 7975, "\341\274\247"),
+M(fcmrpg, 7984, "\341\274\260"),
+M(fcmrpg, 7985, "\341\274\261"),
+M(fcmrpg, 7986, "\341\274\262"),
+M(fcmrpg, 7987, "\341\274\263"),
+M(fcmrpg, 7988, "\341\274\264"),
+M(fcmrpg, 7989, "\341\274\265"),
+M(fcmrpg, 7990, "\341\274\266"),
+M(fcmrpg, 7991, "\341\274\267"),
+M(fcmrpg, 8000, "\341\275\200"),
+M(fcmrpg, 8001, "\341\275\201"),
+M(fcmrpg, 8002, "\341\275\202"),
+M(fcmrpg, 8003, "\341\275\203"),
+M(fcmrpg, 8004, "\341\275\204"),
+M(fcmrpg, 8005, "\341\275\205"),
+M(fcmrpg, 8016, "\341\275\220"),
+M(fcmrpg, 8017, "\341\275\221"),
+M(fcmrpg, 8018, "\341\275\222"),
+M(fcmrpg, 8019, "\341\275\223"),
+M(fcmrpg, 8020, "\341\275\224"),
+M(fcmrpg, 8021, "\341\275\225"),
+M(fcmrpg, 8022, "\341\275\226"),
+M(fcmrpg, 8023, "\341\275\227"),
+M(fcmrpg, 8032, "\341\275\240"),
+M(fcmrpg, 8033, "\341\275\241"),
+M(fcmrpg, 8034, "\341\275\242"),
+M(fcmrpg, 8035, "\341\275\243"),
+M(fcmrpg, 8036, "\341\275\244"),
+M(fcmrpg, 8037, "\341\275\245"),
+M(fcmrpg, 8038, "\341\275\246"),
+M(fcmrpg, 8039, "\341\275\247"),
+M(fcmrpg, 8048, "\341\275\260"),
+M(fcmrpg, 8050, "\341\275\262"),
+M(fcmrpg, 8052, "\341\275\264"),
+M(fcmrpg, 8054, "\341\275\266"),
+M(fcmrpg, 8056, "\341\275\270"),
+M(fcmrpg, 8058, "\341\275\272"),
+M(fcmrpg, 8060, "\341\275\274"),
+M(fcmrpg, 8064, "\341\276\200"),
+M(fcmrpg, 8065, "\341\276\201"),
+M(fcmrpg, 8066, "\341\276\202"),
+M(fcmrpg, 8067, "\341\276\203"),
+M(fcmrpg, 8068, "\341\276\204"),
+M(fcmrpg, 8069, "\341\276\205"),
+M(fcmrpg, 8070, "\341\276\206"),
+M(fcmrpg, 8071, "\341\276\207"),
+M(fcmrpg, 8080, "\341\276\220"),
+M(fcmrpg, 8081, "\341\276\221"),
+M(fcmrpg, 8082, "\341\276\222"),
+M(fcmrpg, 8083, "\341\276\223"),
+M(fcmrpg, 8084, "\341\276\224"),
+M(fcmrpg, 8085, "\341\276\225"),
+M(fcmrpg, 8086, "\341\276\226"),
+M(fcmrpg, 8087, "\341\276\227"),
+M(fcmrpg, 8096, "\341\276\240"),
+M(fcmrpg, 8097, "\341\276\241"),
+M(fcmrpg, 8098, "\341\276\242"),
+M(fcmrpg, 8099, "\341\276\243"),
+M(fcmrpg, 8100, "\341\276\244"),
+M(fcmrpg, 8101, "\341\276\245"),
+M(fcmrpg, 8102, "\341\276\246"),
+M(fcmrpg, 8103, "\341\276\247"),
+M(fcmrpg, 8114, "\341\276\262"),
+M(fcmrpg, 8115, "\341\276\263"),
+M(fcmrpg, 8116, "\341\276\264"),
+M(fcmrpg, 8118, "\341\276\266"),
+M(fcmrpg, 8119, "\341\276\267"),
+M(fcmrpg, 8124, "\341\276\274"),
+M(fcmrpg, 8126, "\341\276\276"),
+M(fcmrpg, 8127, "\341\276\277"),
+M(fcmrpg, 8128, "\341\277\200"),
+M(fcmrpg, 8129, "\341\277\201"),
+M(fcmrpg, 8130, "\341\277\202"),
+M(fcmrpg, 8131, "\341\277\203"),
+M(fcmrpg, 8132, "\341\277\204"),
+M(fcmrpg, 8134, "\341\277\206"),
+M(fcmrpg, 8135, "\341\277\207"),
+M(fcmrpg, 8140, "\341\277\214"),
+M(fcmrpg, 8141, "\341\277\215"),
+M(fcmrpg, 8142, "\341\277\216"),
+M(fcmrpg, 8143, "\341\277\217"),
+M(fcmrpg, 8146, "\341\277\222"),
+M(fcmrpg, 8150, "\341\277\226"),
+M(fcmrpg, 8151, "\341\277\227"),
+M(fcmrpg, 8157, "\341\277\235"),
+M(fcmrpg, 8158, "\341\277\236"),
+M(fcmrpg, 8159, "\341\277\237"),
+M(fcmrpg, 8162, "\341\277\242"),
+M(fcmrpg, 8164, "\341\277\244"),
+M(fcmrpg, 8165, "\341\277\245"),
+M(fcmrpg, 8166, "\341\277\246"),
+M(fcmrpg, 8167, "\341\277\247"),
+M(fcmrpg, 8173, "\341\277\255"),
+M(fcmrpg, 8175, "\341\277\257"),
+M(fcmrpg, 8178, "\341\277\262"),
+M(fcmrpg, 8179, "\341\277\263"),
+M(fcmrpg, 8180, "\341\277\264"),
+M(fcmrpg, 8182, "\341\277\266"),
+M(fcmrpg, 8183, "\341\277\267"),
+M(fcmrpg, 8188, "\341\277\274"),
+M(fcmrpg, 8190, "\341\277\276"),
+M(fcmrpg, 8217, "\342\200\231")
+SYMBOL_MAPPINGS_END
+
+END_DEF_ALPHABET
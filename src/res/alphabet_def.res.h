@@ -0,0 +1,111 @@
+#ifndef ALPHABET_DEF_RES_H_INCLUDED
+#define ALPHABET_DEF_RES_H_INCLUDED
+
+#include "atom/atom_char.h"
+#include "core/formula.h"
+#include "fonts/fonts.h"
+#include "fonts/font_reg.h"
+#include "res/reg/builtin_alphabet_reg.h"
+
+/**
+ * The tables of an alphabet, generated from its XML-files by prebuilt/alphabet_def.py. They
+ * register the same things as DefaultTeXFont#addAlphabet parsing the XML-files, in the same
+ * order: the fonts, the symbols, the character mappings and the symbol mappings.
+ */
+
+namespace tex {
+
+typedef struct {
+  const char* name;
+  AtomType type;
+  bool del;
+} __alphabet_symbol;
+
+typedef struct {
+  int code;
+  const char* value;
+  // the mapping in text mode, nullptr if none
+  const char* text;
+} __alphabet_char;
+
+}  // namespace tex
+
+#define __len(x) ((int)(sizeof(x) / sizeof((x)[0])))
+
+#define DEF_ALPHABET(name) \
+  void __alphabet_reg(name)() {
+
+#define END_DEF_ALPHABET }
+
+#define __start_alphabet_def(type) \
+  {                                \
+    const type x[] = {
+
+/**
+ * Define the fonts of this alphabet, each one is defined by a font table (see
+ * res/font_def.res.h).
+ *
+ *      [font-id]
+ */
+#define FONTS_START \
+  {                 \
+    const std::vector<tex::FontReg> x = {
+#define FONT(name) {#name, __font_reg(name)}
+#define FONTS_END               \
+  }                             \
+  ;                             \
+  tex::FontInfo::__register(x); \
+  }
+
+/**
+ * Define the symbols of this alphabet.
+ *
+ *      SYM(atom-type, symbol-name) or DEL(atom-type, symbol-name) for a delimiter
+ */
+#define SYMBOLS_START __start_alphabet_def(tex::__alphabet_symbol)
+#define SYM(type, name) {name, tex::AtomType::type, false}
+#define DEL(type, name) {name, tex::AtomType::type, true}
+#define SYMBOLS_END                                                                      \
+  }                                                                                      \
+  ;                                                                                      \
+  for (const auto& s : x) {                                                              \
+    tex::SymbolAtom::addSymbolAtom(tex::sptrOf<tex::SymbolAtom>(s.name, s.type, s.del)); \
+  }                                                                                      \
+  }
+
+/**
+ * Define the characters mapped to a symbol (CHAR_SYMBOLS) or to a formula (CHAR_FORMULAS).
+ *
+ *      [code, symbol-or-formula, text-or-nullptr]
+ */
+#define C(code, value, text) {code, value, text}
+
+#define __push_char_mappings(map)                                              \
+  }                                                                            \
+  ;                                                                            \
+  for (const auto& c : x) {                                                    \
+    tex::Formula::map[c.code] = c.value;                                       \
+    if (c.text != nullptr) tex::Formula::_symbolTextMappings[c.code] = c.text; \
+  }                                                                            \
+  }
+
+#define CHAR_SYMBOLS_START __start_alphabet_def(tex::__alphabet_char)
+#define CHAR_SYMBOLS_END   __push_char_mappings(_symbolMappings)
+
+#define CHAR_FORMULAS_START __start_alphabet_def(tex::__alphabet_char)
+#define CHAR_FORMULAS_END   __push_char_mappings(_symbolFormulaMappings)
+
+/**
+ * Define the symbol mappings of this alphabet, the font is one of the fonts of the alphabet.
+ *
+ *      [font-id, code, symbol-name]
+ */
+#define SYMBOL_MAPPINGS_START __start_alphabet_def(tex::__symbol_component)
+#define M(font, code, name) {tex::FontInfo::__id(#font), code, name}
+#define SYMBOL_MAPPINGS_END                         \
+  }                                                 \
+  ;                                                 \
+  tex::DefaultTeXFont::__push_symbols(x, __len(x)); \
+  }
+
+#endif
@@ -2,39 +2,62 @@
 
 /**
  * General parameters used in the TeX algorithms, 
- * specific for the computer modern font family
+ * specific for the computer modern font family,
+ * indexed by tex::TeXParam
  */
-std::map<std::string, float> tex::DefaultTeXFont::_parameters = {
-    {"num1", 0.676508f},
-    {"num2", 0.393732f},
-    {"num3", 0.443731f},
-    {"denom1", 0.685951f},
-    {"denom2", 0.344841f},
-    {"sup1", 0.412892f},
-    {"sup2", 0.362892f},
-    {"sup3", 0.288889f},
-    {"sub1", 0.15f},
-    {"sub2", 0.247217f},
-    {"supdrop", 0.386108f},
-    {"subdrop", 0.05f},
-    {"axisheight", 0.25f},
-    {"defaultrulethickness", 0.039999f},
-    {"bigopspacing1", 0.111112f},
-    {"bigopspacing2", 0.166667f},
-    {"bigopspacing3", 0.2f},
-    {"bigopspacing4", 0.6f},
-    {"bigopspacing5", 0.1f},
+const float tex::DefaultTeXFont::_parameters[] = {
+    0.676508f, // num1
+    0.393732f, // num2
+    0.443731f, // num3
+    0.685951f, // denom1
+    0.344841f, // denom2
+    0.412892f, // sup1
+    0.362892f, // sup2
+    0.288889f, // sup3
+    0.15f,     // sub1
+    0.247217f, // sub2
+    0.386108f, // supdrop
+    0.05f,     // subdrop
+    0.25f,     // axisheight
+    0.039999f, // defaultrulethickness
+    0.111112f, // bigopspacing1
+    0.166667f, // bigopspacing2
+    0.2f,      // bigopspacing3
+    0.6f,      // bigopspacing4
+    0.1f,      // bigopspacing5
+};
+
+const char* const tex::DefaultTeXFont::_parameterNames[] = {
+    "num1",
+    "num2",
+    "num3",
+    "denom1",
+    "denom2",
+    "sup1",
+    "sup2",
+    "sup3",
+    "sub1",
+    "sub2",
+    "supdrop",
+    "subdrop",
+    "axisheight",
+    "defaultrulethickness",
+    "bigopspacing1",
+    "bigopspacing2",
+    "bigopspacing3",
+    "bigopspacing4",
+    "bigopspacing5",
 };
 
 #define __id(name) FontInfo::__id(#name)
 
 void tex::DefaultTeXFont::__default_general_settings() {
   tex::DefaultTeXFont::_generalSettings = {
-      {"mufontid", static_cast<float>(__id(cmsy10))},
-      {"spacefontid", static_cast<float>(__id(cmr10))},
-      {"textfactor", 1.f},
-      {"scriptfactor", 0.7f},
-      {"scriptscriptfactor", 0.5f},
+      __id(cmsy10),  // mufontid
+      __id(cmr10),   // spacefontid
+      1.f,           // textfactor
+      0.7f,          // scriptfactor
+      0.5f,          // scriptscriptfactor
   };
 }
 
@@ -0,0 +1,2026 @@
+// Generated by prebuilt/alphabet_def.py from res/greek/fcmbipg.xml, do not edit
+
+#include "res/font_def.res.h"
+
+DEF_FONT(fcmbipg, greek/fcmbipg.ttf, 204)
+
+xHeight(0.451) quad(1) space(0.355)
+
+ss(fcsbpg) tt(fctrpg)
+
+METRICS_START
+32, 0.355, 0.0, 0, 0,
+168, 0.255, 0.644, 0, 0.216,
+884, 0.224, 0.714, 0, 0.144,
+885, 0.224, 0.005, 0.215, 0,
+890, 0.128, -0.032, 0.211, 0.064,
+900, 0.192, 0.714, 0, 0.15,
+901, 0.319, 0.714, 0, 0.206,
+903, 0.319, 0.446, 0, 0.021,
+912, 0.287, 0.714, 0.006, 0.188,
+913, 0.869, 0.7, 0, 0,
+914, 0.818, 0.689, 0, 0.046,
+915, 0.691, 0.681, 0, 0.102,
+916, 0.958, 0.699, 0, 0,
+917, 0.755, 0.681, 0, 0.086,
+918, 0.703, 0.688, 0, 0.115,
+919, 0.9, 0.687, 0, 0.144,
+920, 0.894, 0.699, 0.011, 0.04,
+921, 0.436, 0.687, 0, 0.15,
+922, 0.901, 0.687, 0, 0.119,
+923, 0.805, 0.699, 0, 0,
+924, 1.091, 0.688, 0, 0.143,
+925, 0.9, 0.687, 0, 0.144,
+926, 0.766, 0.676, 0, 0.117,
+927, 0.864, 0.699, 0.011, 0.041,
+928, 0.9, 0.681, 0, 0.142,
+929, 0.786, 0.687, 0, 0.073,
+931, 0.83, 0.688, 0, 0.089,
+932, 0.8, 0.676, 0, 0.118,
+933, 0.805, 0.687, 0, 0.166,
+934, 0.83, 0.687, 0, 0.031,
+935, 0.869, 0.687, 0, 0.101,
+936, 0.894, 0.687, 0, 0.077,
+937, 0.83, 0.698, 0, 0.065,
+938, 0.436, 0.893, 0, 0.219,
+939, 0.805, 0.893, 0, 0.166,
+940, 0.639, 0.714, 0.006, 0,
+941, 0.447, 0.714, 0.006, 0.055,
+942, 0.594, 0.713, 0.214, 0.026,
+943, 0.287, 0.714, 0.006, 0.101,
+944, 0.575, 0.738, 0.005, 0.07,
+945, 0.639, 0.452, 0.006, 0,
+946, 0.511, 0.702, 0.212, 0.082,
+947, 0.575, 0.46, 0.224, 0.058,
+948, 0.537, 0.702, 0.005, 0.029,
+949, 0.447, 0.451, 0.006, 0.051,
+950, 0.479, 0.696, 0.188, 0.06,
+951, 0.594, 0.452, 0.214, 0.026,
+952, 0.591, 0.702, 0.006, 0.075,
+953, 0.287, 0.445, 0.006, 0.011,
+954, 0.607, 0.458, 0.006, 0.063,
+955, 0.517, 0.701, 0.006, 0.014,
+956, 0.575, 0.445, 0.235, 0.001,
+957, 0.479, 0.451, 0.01, 0.06,
+958, 0.479, 0.696, 0.188, 0.031,
+959, 0.543, 0.452, 0.006, 0.019,
+960, 0.655, 0.452, 0.006, 0.076,
+961, 0.543, 0.451, 0.212, 0.022,
+962, 0.479, 0.452, 0.159, 0.034,
+963, 0.575, 0.476, 0.005, 0.076,
+964, 0.527, 0.484, 0.005, 0.074,
+965, 0.594, 0.462, 0.005, 0.018,
+966, 0.671, 0.452, 0.218, 0.031,
+967, 0.543, 0.452, 0.217, 0.022,
+968, 0.639, 0.454, 0.213, 0.042,
+969, 0.766, 0.446, 0.006, 0,
+970, 0.287, 0.638, 0.006, 0.192,
+971, 0.575, 0.638, 0.005, 0.071,
+972, 0.543, 0.714, 0.006, 0.019,
+973, 0.575, 0.713, 0.005, 0.037,
+974, 0.766, 0.713, 0.006, 0,
+984, 0.575, 0.694, 0.003, 0.096,
+985, 0.575, 0.451, 0.222, 0.003,
+986, 0.894, 0.677, 0, 0.118,
+987, 0.575, 0.504, 0.106, 0.08,
+988, 0.723, 0.681, 0, 0.102,
+989, 0.575, 0.696, 0, 0.14,
+991, 0.447, 0.696, 0.211, 0.047,
+992, 0.881, 0.705, 0, 0,
+993, 0.83, 0.701, 0.028, 0,
+7936, 0.639, 0.695, 0.006, 0,
+7937, 0.639, 0.696, 0.006, 0,
+7938, 0.639, 0.713, 0.006, 0,
+7939, 0.639, 0.713, 0.006, 0,
+7940, 0.639, 0.713, 0.006, 0,
+7941, 0.639, 0.714, 0.006, 0,
+7942, 0.639, 0.724, 0.006, 0.037,
+7943, 0.639, 0.724, 0.006, 0.037,
+7952, 0.447, 0.695, 0.006, 0.051,
+7953, 0.447, 0.696, 0.006, 0.051,
+7954, 0.447, 0.713, 0.006, 0.061,
+7955, 0.447, 0.714, 0.006, 0.061,
+7956, 0.447, 0.714, 0.006, 0.102,
+7957, 0.447, 0.713, 0.006, 0.102,
+7968, 0.594, 0.695, 0.214, 0.026,
+7969, 0.594, 0.696, 0.214, 0.026,
+7970, 0.594, 0.713, 0.214, 0.026,
+7971, 0.594, 0.714, 0.214, 0.026,
+7972, 0.594, 0.714, 0.214, 0.026,
+7973, 0.594, 0.713, 0.214, 0.026,
+7974, 0.594, 0.723, 0.214, 0.066,
+7975, 0.594, 0.723, 0.214, 0.066,
+7984, 0.287, 0.695, 0.006, 0.102,
+7985, 0.287, 0.696, 0.006, 0.072,
+7986, 0.287, 0.713, 0.006, 0.108,
+7987, 0.287, 0.714, 0.006, 0.108,
+7988, 0.287, 0.714, 0.006, 0.149,
+7989, 0.287, 0.713, 0.006, 0.149,
+7990, 0.287, 0.724, 0.006, 0.2,
+7991, 0.287, 0.724, 0.006, 0.2,
+8000, 0.543, 0.695, 0.006, 0.024,
+8001, 0.543, 0.696, 0.006, 0.019,
+8002, 0.543, 0.713, 0.006, 0.019,
+8003, 0.543, 0.714, 0.006, 0.019,
+8004, 0.543, 0.714, 0.006, 0.054,
+8005, 0.543, 0.713, 0.006, 0.054,
+8016, 0.575, 0.695, 0.005, 0.037,
+8017, 0.575, 0.696, 0.005, 0.037,
+8018, 0.575, 0.714, 0.005, 0.037,
+8019, 0.575, 0.714, 0.005, 0.037,
+8020, 0.575, 0.713, 0.005, 0.037,
+8021, 0.575, 0.714, 0.005, 0.037,
+8022, 0.575, 0.724, 0.005, 0.081,
+8023, 0.575, 0.724, 0.005, 0.081,
+8032, 0.766, 0.695, 0.006, 0,
+8033, 0.766, 0.696, 0.006, 0,
+8034, 0.766, 0.713, 0.006, 0,
+8035, 0.766, 0.714, 0.006, 0,
+8036, 0.766, 0.714, 0.006, 0,
+8037, 0.766, 0.714, 0.006, 0,
+8038, 0.766, 0.724, 0.006, 0.027,
+8039, 0.766, 0.724, 0.006, 0.027,
+8048, 0.639, 0.713, 0.006, 0,
+8050, 0.447, 0.714, 0.006, 0.051,
+8052, 0.594, 0.714, 0.214, 0.026,
+8054, 0.287, 0.714, 0.006, 0.018,
+8056, 0.543, 0.714, 0.006, 0.019,
+8058, 0.575, 0.714, 0.005, 0.037,
+8060, 0.766, 0.714, 0.006, 0,
+8064, 0.639, 0.695, 0.211, 0,
+8065, 0.639, 0.696, 0.211, 0,
+8066, 0.639, 0.713, 0.211, 0,
+8067, 0.639, 0.713, 0.211, 0,
+8068, 0.639, 0.713, 0.211, 0,
+8069, 0.639, 0.714, 0.211, 0,
+8070, 0.639, 0.724, 0.211, 0.037,
+8071, 0.639, 0.724, 0.211, 0.037,
+8080, 0.594, 0.695, 0.214, 0.026,
+8081, 0.594, 0.696, 0.214, 0.026,
+8082, 0.594, 0.713, 0.214, 0.026,
+8083, 0.594, 0.714, 0.214, 0.026,
+8084, 0.594, 0.714, 0.214, 0.026,
+8085, 0.594, 0.713, 0.214, 0.026,
+8086, 0.594, 0.723, 0.214, 0.066,
+8087, 0.594, 0.723, 0.214, 0.066,
+8096, 0.766, 0.695, 0.211, 0,
+8097, 0.766, 0.696, 0.211, 0,
+8098, 0.766, 0.713, 0.211, 0,
+8099, 0.766, 0.714, 0.211, 0,
+8100, 0.766, 0.714, 0.211, 0,
+8101, 0.766, 0.714, 0.211, 0,
+8102, 0.766, 0.724, 0.211, 0.027,
+8103, 0.766, 0.724, 0.211, 0.027,
+8114, 0.639, 0.713, 0.211, 0,
+8115, 0.639, 0.452, 0.211, 0,
+8116, 0.639, 0.714, 0.211, 0,
+8118, 0.639, 0.636, 0.006, 0.011,
+8119, 0.639, 0.636, 0.211, 0.011,
+8124, 0.869, 0.7, 0.211, 0,
+8126, 0.255, 0.157, 0.155, 0.006,
+8127, 0.255, 0.695, 0, 0.168,
+8128, 0.383, 0.635, 0, 0.16,
+8129, 0.511, 0.723, 0, 0.122,
+8130, 0.594, 0.714, 0.214, 0.026,
+8131, 0.594, 0.452, 0.214, 0.026,
+8132, 0.594, 0.713, 0.214, 0.026,
+8134, 0.594, 0.636, 0.214, 0.04,
+8135, 0.594, 0.636, 0.214, 0.04,
+8140, 0.9, 0.687, 0.211, 0.144,
+8141, 0.319, 0.713, 0, 0.125,
+8142, 0.319, 0.714, 0, 0.166,
+8143, 0.383, 0.724, 0, 0.186,
+8146, 0.287, 0.714, 0.006, 0.188,
+8150, 0.287, 0.636, 0.006, 0.174,
+8151, 0.287, 0.724, 0.006, 0.2,
+8157, 0.319, 0.714, 0, 0.125,
+8158, 0.319, 0.713, 0, 0.166,
+8159, 0.383, 0.724, 0, 0.186,
+8162, 0.575, 0.739, 0.005, 0.07,
+8164, 0.543, 0.695, 0.212, 0.024,
+8165, 0.543, 0.696, 0.212, 0.022,
+8166, 0.575, 0.636, 0.005, 0.055,
+8167, 0.575, 0.724, 0.005, 0.081,
+8173, 0.319, 0.714, 0, 0.206,
+8175, 0.192, 0.714, 0, 0.131,
+8178, 0.766, 0.714, 0.211, 0,
+8179, 0.766, 0.446, 0.211, 0,
+8180, 0.766, 0.713, 0.211, 0,
+8182, 0.766, 0.635, 0.006, 0.001,
+8183, 0.766, 0.635, 0.211, 0.001,
+8188, 0.83, 0.698, 0.211, 0.065,
+8190, 0.255, 0.696, 0, 0.106,
+8217, 0.319, 0.696, 0, 0.095,
+9001, 0.473, 0.751, 0.25, 0.091,
+9002, 0.473, 0.751, 0.25, 0
+METRICS_END
+
+KERNS_START
+900, 913, -0.128,
+900, 927, -0.064,
+900, 937, -0.032,
+900, 8124, -0.128,
+900, 8188, -0.032,
+912, 947, -0.08,
+912, 951, -0.019,
+912, 952, -0.038,
+912, 954, -0.064,
+912, 957, -0.064,
+912, 959, -0.032,
+912, 962, -0.032,
+912, 963, -0.032,
+912, 964, -0.096,
+912, 967, -0.064,
+912, 972, -0.032,
+912, 993, -0.192,
+912, 8000, -0.032,
+912, 8001, -0.032,
+912, 8004, -0.032,
+912, 8005, -0.032,
+912, 8056, -0.032,
+913, 920, -0.096,
+913, 927, -0.096,
+913, 932, -0.096,
+913, 933, -0.16,
+913, 934, -0.096,
+913, 936, -0.141,
+913, 939, -0.16,
+913, 957, -0.112,
+915, 913, -0.153,
+915, 916, -0.128,
+915, 923, -0.141,
+915, 8124, -0.153,
+916, 927, -0.038,
+916, 933, -0.16,
+916, 939, -0.16,
+920, 913, -0.096,
+920, 933, -0.096,
+920, 939, -0.096,
+920, 8124, -0.096,
+922, 927, -0.096,
+923, 927, -0.038,
+923, 933, -0.115,
+923, 939, -0.115,
+925, 913, -0.096,
+925, 8124, -0.096,
+927, 913, -0.096,
+927, 931, -0.064,
+927, 8124, -0.096,
+929, 913, -0.192,
+929, 8124, -0.192,
+931, 913, -0.032,
+931, 8124, -0.032,
+932, 913, -0.096,
+932, 8124, -0.096,
+933, 913, -0.16,
+933, 916, -0.16,
+933, 923, -0.16,
+933, 8124, -0.16,
+934, 913, -0.096,
+934, 8124, -0.096,
+936, 913, -0.141,
+936, 8124, -0.141,
+939, 913, -0.16,
+939, 916, -0.16,
+939, 923, -0.16,
+939, 8124, -0.16,
+940, 947, -0.096,
+940, 952, -0.096,
+940, 957, -0.096,
+940, 959, -0.032,
+940, 960, -0.051,
+940, 964, -0.096,
+940, 965, -0.096,
+940, 967, -0.096,
+940, 968, -0.032,
+940, 972, -0.032,
+940, 973, -0.096,
+940, 8056, -0.032,
+940, 8058, -0.096,
+941, 940, -0.032,
+941, 945, -0.032,
+941, 948, -0.032,
+941, 963, -0.032,
+941, 965, -0.032,
+941, 967, -0.01,
+941, 973, -0.032,
+941, 993, -0.192,
+941, 8048, -0.032,
+941, 8058, -0.032,
+941, 8114, -0.032,
+941, 8115, -0.032,
+941, 8116, -0.032,
+941, 8118, -0.032,
+941, 8119, -0.032,
+941, 8166, -0.032,
+942, 957, -0.032,
+942, 965, -0.032,
+942, 973, -0.032,
+942, 8058, -0.032,
+942, 8166, -0.032,
+943, 947, -0.08,
+943, 951, -0.019,
+943, 952, -0.038,
+943, 954, -0.064,
+943, 957, -0.064,
+943, 959, -0.032,
+943, 962, -0.032,
+943, 963, -0.032,
+943, 964, -0.096,
+943, 967, -0.064,
+943, 972, -0.032,
+943, 993, -0.192,
+943, 8000, -0.032,
+943, 8001, -0.032,
+943, 8004, -0.032,
+943, 8005, -0.032,
+943, 8056, -0.032,
+944, 952, -0.032,
+944, 956, -0.013,
+944, 957, -0.045,
+944, 967, -0.032,
+944, 968, 0.032,
+944, 993, -0.192,
+945, 947, -0.096,
+945, 952, -0.096,
+945, 957, -0.109,
+945, 959, -0.032,
+945, 960, -0.051,
+945, 964, -0.096,
+945, 965, -0.096,
+945, 967, -0.096,
+945, 968, -0.032,
+945, 972, -0.032,
+945, 973, -0.096,
+945, 993, -0.255,
+945, 8016, -0.096,
+945, 8018, -0.096,
+945, 8020, -0.096,
+945, 8021, -0.096,
+945, 8022, -0.096,
+945, 8023, -0.096,
+945, 8056, -0.032,
+945, 8058, -0.096,
+945, 8166, -0.096,
+946, 941, 0.032,
+946, 943, 0.032,
+946, 949, 0.032,
+946, 953, 0.032,
+946, 959, 0.032,
+946, 964, 0.032,
+946, 966, 0.032,
+946, 967, -0.032,
+946, 968, 0.064,
+946, 972, 0.032,
+946, 993, -0.064,
+946, 8050, 0.032,
+946, 8054, 0.032,
+946, 8056, 0.032,
+946, 8150, 0.032,
+947, 967, 0.019,
+947, 993, -0.192,
+948, 940, -0.032,
+948, 945, -0.032,
+948, 947, -0.096,
+948, 956, -0.051,
+948, 957, -0.045,
+948, 960, -0.032,
+948, 965, -0.032,
+948, 967, -0.019,
+948, 973, -0.032,
+948, 993, -0.192,
+948, 8048, -0.032,
+948, 8058, -0.032,
+948, 8114, -0.032,
+948, 8115, -0.032,
+948, 8116, -0.032,
+948, 8118, -0.032,
+948, 8119, -0.032,
+948, 8166, -0.032,
+949, 940, -0.032,
+949, 945, -0.032,
+949, 948, -0.032,
+949, 963, -0.032,
+949, 965, -0.032,
+949, 967, -0.01,
+949, 973, -0.032,
+949, 993, -0.192,
+949, 8048, -0.032,
+949, 8058, -0.032,
+949, 8114, -0.032,
+949, 8115, -0.032,
+949, 8116, -0.032,
+949, 8118, -0.032,
+949, 8119, -0.032,
+949, 8166, -0.032,
+950, 940, -0.096,
+950, 941, -0.096,
+950, 942, -0.096,
+950, 945, -0.096,
+950, 947, -0.128,
+950, 948, -0.064,
+950, 949, -0.096,
+950, 951, -0.096,
+950, 952, -0.064,
+950, 956, -0.064,
+950, 957, -0.102,
+950, 959, -0.096,
+950, 960, -0.096,
+950, 963, -0.096,
+950, 964, -0.096,
+950, 965, -0.096,
+950, 966, -0.096,
+950, 967, -0.096,
+950, 968, -0.032,
+950, 969, -0.096,
+950, 972, -0.096,
+950, 973, -0.096,
+950, 974, -0.096,
+950, 993, -0.064,
+950, 8048, -0.096,
+950, 8050, -0.096,
+950, 8052, -0.096,
+950, 8056, -0.096,
+950, 8058, -0.096,
+950, 8060, -0.096,
+950, 8114, -0.096,
+950, 8115, -0.096,
+950, 8116, -0.096,
+950, 8118, -0.096,
+950, 8119, -0.096,
+950, 8130, -0.096,
+950, 8131, -0.096,
+950, 8132, -0.096,
+950, 8134, -0.096,
+950, 8135, -0.096,
+950, 8166, -0.096,
+950, 8178, -0.096,
+950, 8179, -0.096,
+950, 8180, -0.096,
+950, 8182, -0.096,
+950, 8183, -0.096,
+951, 957, -0.032,
+951, 965, -0.032,
+951, 973, -0.032,
+951, 993, -0.192,
+951, 8058, -0.032,
+951, 8166, -0.032,
+952, 941, 0.032,
+952, 943, 0.032,
+952, 949, 0.032,
+952, 953, 0.032,
+952, 968, 0.032,
+952, 993, -0.064,
+952, 8050, 0.032,
+952, 8054, 0.032,
+952, 8150, 0.032,
+953, 947, -0.08,
+953, 951, -0.019,
+953, 952, -0.038,
+953, 954, -0.064,
+953, 957, -0.064,
+953, 959, -0.032,
+953, 962, -0.032,
+953, 963, -0.032,
+953, 964, -0.096,
+953, 967, -0.064,
+953, 972, -0.032,
+953, 993, -0.192,
+953, 8000, -0.032,
+953, 8001, -0.032,
+953, 8004, -0.032,
+953, 8005, -0.032,
+953, 8056, -0.032,
+954, 946, 0.032,
+954, 957, -0.032,
+954, 993, -0.192,
+955, 940, -0.016,
+955, 945, -0.016,
+955, 947, -0.16,
+955, 952, -0.051,
+955, 956, 0.016,
+955, 957, -0.096,
+955, 963, -0.032,
+955, 964, -0.032,
+955, 965, -0.064,
+955, 967, -0.064,
+955, 973, -0.064,
+955, 993, -0.192,
+955, 8048, -0.016,
+955, 8058, -0.064,
+955, 8114, -0.016,
+955, 8115, -0.016,
+955, 8116, -0.016,
+955, 8118, -0.016,
+955, 8119, -0.016,
+955, 8166, -0.064,
+956, 940, -0.064,
+956, 945, -0.064,
+956, 947, -0.096,
+956, 950, -0.032,
+956, 952, -0.07,
+956, 957, -0.096,
+956, 959, -0.032,
+956, 960, -0.032,
+956, 963, -0.032,
+956, 965, -0.064,
+956, 966, -0.032,
+956, 967, -0.067,
+956, 969, -0.032,
+956, 972, -0.032,
+956, 973, -0.064,
+956, 974, -0.032,
+956, 993, -0.255,
+956, 8048, -0.064,
+956, 8056, -0.032,
+956, 8058, -0.064,
+956, 8060, -0.032,
+956, 8114, -0.064,
+956, 8115, -0.064,
+956, 8116, -0.064,
+956, 8118, -0.064,
+956, 8119, -0.064,
+956, 8166, -0.064,
+956, 8178, -0.032,
+956, 8179, -0.032,
+956, 8180, -0.032,
+956, 8182, -0.032,
+956, 8183, -0.032,
+957, 940, -0.026,
+957, 945, -0.026,
+957, 955, -0.051,
+957, 957, -0.032,
+957, 959, -0.032,
+957, 961, -0.006,
+957, 969, 0.01,
+957, 972, -0.032,
+957, 974, 0.01,
+957, 993, -0.192,
+957, 8048, -0.026,
+957, 8056, -0.032,
+957, 8060, 0.01,
+957, 8114, -0.026,
+957, 8115, -0.026,
+957, 8116, -0.026,
+957, 8118, -0.026,
+957, 8119, -0.026,
+957, 8178, 0.01,
+957, 8179, 0.01,
+957, 8180, 0.01,
+957, 8182, 0.01,
+957, 8183, 0.01,
+958, 940, -0.032,
+958, 941, -0.064,
+958, 945, -0.032,
+958, 947, -0.045,
+958, 949, -0.064,
+958, 959, -0.064,
+958, 963, -0.064,
+958, 964, -0.032,
+958, 965, -0.032,
+958, 966, -0.045,
+958, 967, -0.032,
+958, 972, -0.064,
+958, 973, -0.032,
+958, 993, -0.064,
+958, 8048, -0.032,
+958, 8050, -0.064,
+958, 8056, -0.064,
+958, 8058, -0.032,
+958, 8114, -0.032,
+958, 8115, -0.032,
+958, 8116, -0.032,
+958, 8118, -0.032,
+958, 8119, -0.032,
+958, 8166, -0.032,
+959, 947, -0.032,
+959, 955, -0.032,
+959, 956, -0.013,
+959, 957, -0.045,
+959, 964, -0.038,
+959, 965, -0.064,
+959, 967, -0.032,
+959, 973, -0.064,
+959, 993, -0.192,
+959, 8058, -0.064,
+959, 8166, -0.064,
+960, 943, 0.032,
+960, 953, 0.032,
+960, 954, 0.032,
+960, 959, -0.064,
+960, 968, 0.032,
+960, 972, -0.064,
+960, 993, -0.192,
+960, 8054, 0.032,
+960, 8056, -0.064,
+960, 8150, 0.032,
+961, 943, 0.032,
+961, 947, -0.064,
+961, 950, 0.032,
+961, 953, 0.032,
+961, 957, -0.057,
+961, 959, 0.032,
+961, 963, 0.032,
+961, 967, -0.013,
+961, 968, 0.019,
+961, 972, 0.032,
+961, 993, -0.192,
+961, 8054, 0.032,
+961, 8056, 0.032,
+961, 8150, 0.032,
+963, 940, -0.051,
+963, 945, -0.051,
+963, 959, -0.032,
+963, 961, -0.032,
+963, 969, -0.032,
+963, 972, -0.032,
+963, 974, -0.032,
+963, 993, -0.192,
+963, 8048, -0.051,
+963, 8056, -0.032,
+963, 8060, -0.032,
+963, 8114, -0.051,
+963, 8115, -0.051,
+963, 8116, -0.051,
+963, 8118, -0.051,
+963, 8119, -0.051,
+963, 8164, -0.032,
+963, 8165, -0.032,
+963, 8178, -0.032,
+963, 8179, -0.032,
+963, 8180, -0.032,
+963, 8182, -0.032,
+963, 8183, -0.032,
+964, 940, -0.032,
+964, 941, -0.032,
+964, 945, -0.032,
+964, 949, -0.032,
+964, 959, -0.032,
+964, 967, -0.032,
+964, 969, -0.032,
+964, 972, -0.032,
+964, 974, -0.032,
+964, 993, -0.192,
+964, 8048, -0.032,
+964, 8050, -0.032,
+964, 8056, -0.032,
+964, 8060, -0.032,
+964, 8114, -0.032,
+964, 8115, -0.032,
+964, 8116, -0.032,
+964, 8118, -0.032,
+964, 8119, -0.032,
+964, 8178, -0.032,
+964, 8179, -0.032,
+964, 8180, -0.032,
+964, 8182, -0.032,
+964, 8183, -0.032,
+965, 952, -0.032,
+965, 956, -0.013,
+965, 957, -0.045,
+965, 967, -0.032,
+965, 968, 0.032,
+965, 993, -0.192,
+966, 942, -0.032,
+966, 947, -0.064,
+966, 951, -0.032,
+966, 956, -0.045,
+966, 957, -0.045,
+966, 964, -0.032,
+966, 965, -0.064,
+966, 967, -0.013,
+966, 973, -0.064,
+966, 993, -0.192,
+966, 8052, -0.032,
+966, 8058, -0.064,
+966, 8130, -0.032,
+966, 8131, -0.032,
+966, 8132, -0.032,
+966, 8134, -0.064,
+966, 8135, -0.064,
+966, 8166, -0.064,
+967, 940, -0.077,
+967, 941, -0.032,
+967, 942, -0.067,
+967, 943, -0.032,
+967, 945, -0.077,
+967, 947, -0.051,
+967, 948, -0.077,
+967, 949, -0.032,
+967, 951, -0.067,
+967, 952, -0.064,
+967, 953, -0.032,
+967, 954, -0.064,
+967, 955, -0.077,
+967, 957, -0.096,
+967, 958, -0.051,
+967, 959, -0.096,
+967, 960, -0.051,
+967, 961, -0.051,
+967, 963, -0.045,
+967, 964, -0.051,
+967, 965, -0.051,
+967, 966, -0.096,
+967, 968, -0.032,
+967, 969, -0.077,
+967, 972, -0.096,
+967, 973, -0.051,
+967, 974, -0.077,
+967, 993, -0.192,
+967, 8048, -0.077,
+967, 8050, -0.032,
+967, 8052, -0.067,
+967, 8054, -0.032,
+967, 8056, -0.096,
+967, 8058, -0.051,
+967, 8060, -0.077,
+967, 8114, -0.077,
+967, 8115, -0.077,
+967, 8116, -0.077,
+967, 8118, -0.077,
+967, 8119, -0.077,
+967, 8130, -0.067,
+967, 8131, -0.067,
+967, 8132, -0.067,
+967, 8134, -0.067,
+967, 8135, -0.067,
+967, 8150, -0.032,
+967, 8166, -0.051,
+967, 8178, -0.077,
+967, 8179, -0.077,
+967, 8180, -0.077,
+967, 8182, -0.077,
+967, 8183, -0.077,
+968, 947, -0.045,
+968, 965, -0.064,
+968, 967, -0.006,
+968, 973, -0.064,
+968, 993, -0.192,
+968, 8058, -0.064,
+968, 8166, -0.064,
+969, 941, 0.032,
+969, 947, -0.128,
+969, 949, 0.032,
+969, 956, -0.032,
+969, 957, -0.032,
+969, 958, 0.032,
+969, 964, -0.054,
+969, 965, -0.032,
+969, 967, -0.032,
+969, 973, -0.032,
+969, 993, -0.192,
+969, 8050, 0.032,
+969, 8058, -0.032,
+969, 8166, -0.032,
+970, 947, -0.08,
+970, 951, -0.019,
+970, 952, -0.038,
+970, 954, -0.064,
+970, 957, -0.064,
+970, 959, -0.032,
+970, 962, -0.032,
+970, 963, -0.032,
+970, 964, -0.096,
+970, 967, -0.064,
+970, 972, -0.032,
+970, 993, -0.192,
+970, 8000, -0.032,
+970, 8001, -0.032,
+970, 8004, -0.032,
+970, 8005, -0.032,
+970, 8056, -0.032,
+971, 952, -0.032,
+971, 956, -0.013,
+971, 957, -0.045,
+971, 967, -0.032,
+971, 968, 0.032,
+971, 993, -0.192,
+972, 947, -0.032,
+972, 955, -0.032,
+972, 956, -0.013,
+972, 957, -0.045,
+972, 964, -0.038,
+972, 965, -0.064,
+972, 967, -0.032,
+972, 973, -0.064,
+972, 993, -0.192,
+972, 8058, -0.064,
+972, 8166, -0.064,
+973, 952, -0.032,
+973, 956, -0.013,
+973, 957, -0.045,
+973, 967, -0.032,
+973, 968, 0.032,
+973, 993, -0.192,
+974, 941, 0.032,
+974, 947, -0.128,
+974, 949, 0.032,
+974, 956, -0.032,
+974, 957, -0.032,
+974, 958, 0.032,
+974, 964, -0.054,
+974, 965, -0.032,
+974, 967, -0.032,
+974, 973, -0.032,
+974, 8050, 0.032,
+974, 8058, -0.032,
+974, 8166, -0.032,
+985, 993, -0.255,
+987, 993, -0.192,
+991, 993, -0.192,
+993, 993, -0.192,
+7936, 947, -0.096,
+7936, 952, -0.096,
+7936, 957, -0.096,
+7936, 959, -0.032,
+7936, 960, -0.051,
+7936, 964, -0.096,
+7936, 965, -0.096,
+7936, 967, -0.096,
+7936, 968, -0.032,
+7936, 972, -0.032,
+7936, 973, -0.096,
+7936, 8056, -0.032,
+7936, 8058, -0.096,
+7937, 947, -0.096,
+7937, 952, -0.096,
+7937, 957, -0.096,
+7937, 959, -0.032,
+7937, 960, -0.051,
+7937, 964, -0.096,
+7937, 965, -0.096,
+7937, 967, -0.096,
+7937, 968, -0.032,
+7937, 972, -0.032,
+7937, 973, -0.096,
+7937, 8056, -0.032,
+7937, 8058, -0.096,
+7938, 947, -0.096,
+7938, 952, -0.096,
+7938, 957, -0.096,
+7938, 959, -0.032,
+7938, 960, -0.051,
+7938, 964, -0.096,
+7938, 965, -0.096,
+7938, 967, -0.096,
+7938, 968, -0.032,
+7938, 972, -0.032,
+7938, 973, -0.096,
+7938, 8056, -0.032,
+7938, 8058, -0.096,
+7939, 947, -0.096,
+7939, 952, -0.096,
+7939, 957, -0.096,
+7939, 959, -0.032,
+7939, 960, -0.051,
+7939, 964, -0.096,
+7939, 965, -0.096,
+7939, 967, -0.096,
+7939, 968, -0.032,
+7939, 972, -0.032,
+7939, 973, -0.096,
+7939, 8056, -0.032,
+7939, 8058, -0.096,
+7940, 947, -0.096,
+7940, 952, -0.096,
+7940, 957, -0.096,
+7940, 959, -0.032,
+7940, 960, -0.051,
+7940, 964, -0.096,
+7940, 965, -0.096,
+7940, 967, -0.096,
+7940, 968, -0.032,
+7940, 972, -0.032,
+7940, 973, -0.096,
+7940, 8056, -0.032,
+7940, 8058, -0.096,
+7941, 947, -0.096,
+7941, 952, -0.096,
+7941, 957, -0.051,
+7941, 959, -0.032,
+7941, 960, -0.051,
+7941, 964, -0.096,
+7941, 965, -0.096,
+7941, 967, -0.096,
+7941, 968, -0.032,
+7941, 972, -0.032,
+7941, 973, -0.096,
+7941, 8056, -0.032,
+7941, 8058, -0.096,
+7942, 947, -0.096,
+7942, 952, -0.096,
+7942, 957, -0.096,
+7942, 959, -0.032,
+7942, 960, -0.051,
+7942, 964, -0.096,
+7942, 965, -0.096,
+7942, 967, -0.096,
+7942, 968, -0.032,
+7942, 972, -0.032,
+7942, 973, -0.096,
+7942, 8056, -0.032,
+7942, 8058, -0.096,
+7943, 947, -0.096,
+7943, 952, -0.096,
+7943, 957, -0.096,
+7943, 959, -0.032,
+7943, 960, -0.051,
+7943, 964, -0.096,
+7943, 965, -0.096,
+7943, 967, -0.096,
+7943, 968, -0.032,
+7943, 972, -0.032,
+7943, 973, -0.096,
+7943, 8056, -0.032,
+7943, 8058, -0.096,
+7952, 940, -0.032,
+7952, 945, -0.032,
+7952, 948, -0.032,
+7952, 963, -0.032,
+7952, 965, -0.032,
+7952, 967, -0.01,
+7952, 973, -0.032,
+7952, 993, -0.192,
+7952, 8048, -0.032,
+7952, 8058, -0.032,
+7952, 8114, -0.032,
+7952, 8115, -0.032,
+7952, 8116, -0.032,
+7952, 8118, -0.032,
+7952, 8119, -0.032,
+7952, 8166, -0.032,
+7953, 940, -0.032,
+7953, 945, -0.032,
+7953, 948, -0.032,
+7953, 963, -0.032,
+7953, 965, -0.032,
+7953, 967, -0.01,
+7953, 973, -0.032,
+7953, 993, -0.192,
+7953, 8048, -0.032,
+7953, 8058, -0.032,
+7953, 8114, -0.032,
+7953, 8115, -0.032,
+7953, 8116, -0.032,
+7953, 8118, -0.032,
+7953, 8119, -0.032,
+7953, 8166, -0.032,
+7954, 940, -0.032,
+7954, 945, -0.032,
+7954, 948, -0.032,
+7954, 963, -0.032,
+7954, 965, -0.032,
+7954, 967, -0.01,
+7954, 973, -0.032,
+7954, 993, -0.192,
+7954, 8048, -0.032,
+7954, 8058, -0.032,
+7954, 8114, -0.032,
+7954, 8115, -0.032,
+7954, 8116, -0.032,
+7954, 8118, -0.032,
+7954, 8119, -0.032,
+7954, 8166, -0.032,
+7955, 940, -0.032,
+7955, 945, -0.032,
+7955, 948, -0.032,
+7955, 963, -0.032,
+7955, 965, -0.032,
+7955, 967, -0.01,
+7955, 973, -0.032,
+7955, 993, -0.192,
+7955, 8048, -0.032,
+7955, 8058, -0.032,
+7955, 8114, -0.032,
+7955, 8115, -0.032,
+7955, 8116, -0.032,
+7955, 8118, -0.032,
+7955, 8119, -0.032,
+7955, 8166, -0.032,
+7956, 940, -0.032,
+7956, 945, -0.032,
+7956, 948, -0.032,
+7956, 963, -0.032,
+7956, 965, -0.032,
+7956, 967, -0.01,
+7956, 973, -0.032,
+7956, 993, -0.192,
+7956, 8048, -0.032,
+7956, 8058, -0.032,
+7956, 8114, -0.032,
+7956, 8115, -0.032,
+7956, 8116, -0.032,
+7956, 8118, -0.032,
+7956, 8119, -0.032,
+7956, 8166, -0.032,
+7957, 940, -0.032,
+7957, 945, -0.032,
+7957, 948, -0.032,
+7957, 963, -0.032,
+7957, 965, -0.032,
+7957, 967, -0.01,
+7957, 973, -0.032,
+7957, 993, -0.192,
+7957, 8048, -0.032,
+7957, 8058, -0.032,
+7957, 8114, -0.032,
+7957, 8115, -0.032,
+7957, 8116, -0.032,
+7957, 8118, -0.032,
+7957, 8119, -0.032,
+7957, 8166, -0.032,
+7968, 957, -0.032,
+7968, 965, -0.032,
+7968, 973, -0.032,
+7968, 8058, -0.032,
+7968, 8166, -0.032,
+7969, 957, -0.032,
+7969, 965, -0.032,
+7969, 973, -0.032,
+7969, 8058, -0.032,
+7969, 8166, -0.032,
+7970, 957, -0.032,
+7970, 965, -0.032,
+7970, 973, -0.032,
+7970, 8058, -0.032,
+7970, 8166, -0.032,
+7971, 957, -0.032,
+7971, 965, -0.032,
+7971, 973, -0.032,
+7971, 8058, -0.032,
+7971, 8166, -0.032,
+7972, 957, -0.032,
+7972, 965, -0.032,
+7972, 973, -0.032,
+7972, 8058, -0.032,
+7972, 8166, -0.032,
+7973, 957, -0.032,
+7973, 965, -0.032,
+7973, 973, -0.032,
+7973, 8058, -0.032,
+7973, 8166, -0.032,
+7974, 957, -0.032,
+7974, 965, -0.032,
+7974, 973, -0.032,
+7974, 8058, -0.032,
+7974, 8166, -0.032,
+7975, 957, -0.032,
+7975, 965, -0.032,
+7975, 973, -0.032,
+7975, 8058, -0.032,
+7975, 8166, -0.032,
+7984, 947, -0.08,
+7984, 951, -0.019,
+7984, 952, -0.038,
+7984, 954, -0.064,
+7984, 957, -0.064,
+7984, 959, -0.032,
+7984, 962, -0.032,
+7984, 963, -0.032,
+7984, 964, -0.096,
+7984, 967, -0.064,
+7984, 972, -0.032,
+7984, 993, -0.192,
+7984, 8000, -0.032,
+7984, 8001, -0.032,
+7984, 8004, -0.032,
+7984, 8005, -0.032,
+7984, 8056, -0.032,
+7985, 947, -0.08,
+7985, 951, -0.019,
+7985, 952, -0.038,
+7985, 954, -0.064,
+7985, 957, -0.064,
+7985, 959, -0.032,
+7985, 962, -0.032,
+7985, 963, -0.032,
+7985, 964, -0.096,
+7985, 967, -0.064,
+7985, 972, -0.032,
+7985, 993, -0.192,
+7985, 8000, -0.032,
+7985, 8001, -0.032,
+7985, 8004, -0.032,
+7985, 8005, -0.032,
+7985, 8056, -0.032,
+7988, 947, -0.08,
+7988, 951, -0.019,
+7988, 952, -0.038,
+7988, 954, -0.064,
+7988, 957, -0.064,
+7988, 959, -0.032,
+7988, 962, -0.032,
+7988, 963, -0.032,
+7988, 964, -0.096,
+7988, 967, -0.064,
+7988, 972, -0.032,
+7988, 993, -0.192,
+7988, 8000, -0.032,
+7988, 8001, -0.032,
+7988, 8004, -0.032,
+7988, 8005, -0.032,
+7988, 8056, -0.032,
+7989, 947, -0.08,
+7989, 951, -0.019,
+7989, 952, -0.038,
+7989, 954, -0.064,
+7989, 957, -0.064,
+7989, 959, -0.032,
+7989, 962, -0.032,
+7989, 963, -0.032,
+7989, 964, -0.096,
+7989, 967, -0.064,
+7989, 972, -0.032,
+7989, 993, -0.192,
+7989, 8000, -0.032,
+7989, 8001, -0.032,
+7989, 8004, -0.032,
+7989, 8005, -0.032,
+7989, 8056, -0.032,
+7990, 947, -0.08,
+7990, 951, -0.019,
+7990, 952, -0.038,
+7990, 954, -0.064,
+7990, 957, -0.064,
+7990, 959, -0.032,
+7990, 962, -0.032,
+7990, 963, -0.032,
+7990, 964, -0.096,
+7990, 967, -0.064,
+7990, 972, -0.032,
+7990, 993, -0.192,
+7990, 8000, -0.032,
+7990, 8001, -0.032,
+7990, 8004, -0.032,
+7990, 8005, -0.032,
+7990, 8056, -0.032,
+7991, 947, -0.08,
+7991, 951, -0.019,
+7991, 952, -0.038,
+7991, 954, -0.064,
+7991, 957, -0.064,
+7991, 959, -0.032,
+7991, 962, -0.032,
+7991, 963, -0.032,
+7991, 964, -0.096,
+7991, 967, -0.064,
+7991, 972, -0.032,
+7991, 993, -0.192,
+7991, 8000, -0.032,
+7991, 8001, -0.032,
+7991, 8004, -0.032,
+7991, 8005, -0.032,
+7991, 8056, -0.032,
+8000, 947, -0.032,
+8000, 955, -0.032,
+8000, 956, -0.013,
+8000, 957, -0.045,
+8000, 964, -0.038,
+8000, 965, -0.064,
+8000, 967, -0.032,
+8000, 973, -0.064,
+8000, 993, -0.192,
+8000, 8058, -0.064,
+8000, 8166, -0.064,
+8001, 947, -0.032,
+8001, 955, -0.032,
+8001, 956, -0.013,
+8001, 957, -0.045,
+8001, 964, -0.038,
+8001, 965, -0.064,
+8001, 967, -0.032,
+8001, 973, -0.064,
+8001, 993, -0.192,
+8001, 8058, -0.064,
+8001, 8166, -0.064,
+8002, 947, -0.032,
+8002, 955, -0.032,
+8002, 956, -0.013,
+8002, 957, -0.045,
+8002, 964, -0.038,
+8002, 965, -0.064,
+8002, 967, -0.032,
+8002, 973, -0.064,
+8002, 993, -0.192,
+8002, 8058, -0.064,
+8002, 8166, -0.064,
+8003, 947, -0.032,
+8003, 955, -0.032,
+8003, 956, -0.013,
+8003, 957, -0.045,
+8003, 964, -0.038,
+8003, 965, -0.064,
+8003, 967, -0.032,
+8003, 973, -0.064,
+8003, 993, -0.192,
+8003, 8058, -0.064,
+8003, 8166, -0.064,
+8004, 947, -0.032,
+8004, 955, -0.032,
+8004, 956, -0.013,
+8004, 957, -0.045,
+8004, 964, -0.038,
+8004, 965, -0.064,
+8004, 967, -0.032,
+8004, 973, -0.064,
+8004, 993, -0.192,
+8004, 8058, -0.064,
+8004, 8166, -0.064,
+8005, 947, -0.032,
+8005, 955, -0.032,
+8005, 956, -0.013,
+8005, 957, -0.045,
+8005, 964, -0.038,
+8005, 965, -0.064,
+8005, 967, -0.032,
+8005, 973, -0.064,
+8005, 993, -0.192,
+8005, 8058, -0.064,
+8005, 8166, -0.064,
+8016, 952, -0.032,
+8016, 956, -0.013,
+8016, 957, -0.045,
+8016, 967, -0.032,
+8016, 968, 0.032,
+8016, 993, -0.192,
+8017, 952, -0.032,
+8017, 956, -0.013,
+8017, 957, -0.045,
+8017, 967, -0.032,
+8017, 968, 0.032,
+8017, 993, -0.192,
+8018, 952, -0.032,
+8018, 956, -0.013,
+8018, 957, -0.045,
+8018, 967, -0.032,
+8018, 968, 0.032,
+8018, 993, -0.192,
+8019, 952, -0.032,
+8019, 956, -0.013,
+8019, 957, -0.045,
+8019, 967, -0.032,
+8019, 968, 0.032,
+8019, 993, -0.192,
+8020, 952, -0.032,
+8020, 956, -0.013,
+8020, 957, -0.045,
+8020, 967, -0.032,
+8020, 968, 0.032,
+8020, 993, -0.192,
+8021, 952, -0.032,
+8021, 956, -0.013,
+8021, 957, -0.045,
+8021, 967, -0.032,
+8021, 968, 0.032,
+8021, 993, -0.192,
+8022, 952, -0.032,
+8022, 956, -0.013,
+8022, 957, -0.045,
+8022, 967, -0.032,
+8022, 968, 0.032,
+8022, 993, -0.192,
+8023, 952, -0.032,
+8023, 956, -0.013,
+8023, 957, -0.045,
+8023, 967, -0.032,
+8023, 968, 0.032,
+8023, 993, -0.192,
+8032, 941, 0.032,
+8032, 947, -0.128,
+8032, 949, 0.032,
+8032, 956, -0.032,
+8032, 957, -0.032,
+8032, 958, 0.032,
+8032, 964, -0.054,
+8032, 965, -0.032,
+8032, 967, -0.032,
+8032, 973, -0.032,
+8032, 8050, 0.032,
+8032, 8058, -0.032,
+8032, 8166, -0.032,
+8033, 941, 0.032,
+8033, 947, -0.128,
+8033, 949, 0.032,
+8033, 956, -0.032,
+8033, 957, -0.032,
+8033, 958, 0.032,
+8033, 964, -0.054,
+8033, 965, -0.032,
+8033, 967, -0.032,
+8033, 973, -0.032,
+8033, 8050, 0.032,
+8033, 8058, -0.032,
+8033, 8166, -0.032,
+8034, 941, 0.032,
+8034, 947, -0.128,
+8034, 949, 0.032,
+8034, 956, -0.032,
+8034, 957, -0.032,
+8034, 958, 0.032,
+8034, 964, -0.054,
+8034, 965, -0.032,
+8034, 967, -0.032,
+8034, 973, -0.032,
+8034, 8050, 0.032,
+8034, 8058, -0.032,
+8034, 8166, -0.032,
+8035, 941, 0.032,
+8035, 947, -0.128,
+8035, 949, 0.032,
+8035, 956, -0.032,
+8035, 957, -0.032,
+8035, 958, 0.032,
+8035, 964, -0.054,
+8035, 965, -0.032,
+8035, 967, -0.032,
+8035, 973, -0.032,
+8035, 8050, 0.032,
+8035, 8058, -0.032,
+8035, 8166, -0.032,
+8036, 941, 0.032,
+8036, 947, -0.128,
+8036, 949, 0.032,
+8036, 956, -0.032,
+8036, 957, -0.032,
+8036, 958, 0.032,
+8036, 964, -0.054,
+8036, 965, -0.032,
+8036, 967, -0.032,
+8036, 973, -0.032,
+8036, 8050, 0.032,
+8036, 8058, -0.032,
+8036, 8166, -0.032,
+8037, 941, 0.032,
+8037, 947, -0.128,
+8037, 949, 0.032,
+8037, 956, -0.032,
+8037, 957, -0.032,
+8037, 958, 0.032,
+8037, 964, -0.054,
+8037, 965, -0.032,
+8037, 967, -0.032,
+8037, 973, -0.032,
+8037, 8050, 0.032,
+8037, 8058, -0.032,
+8037, 8166, -0.032,
+8038, 941, 0.032,
+8038, 947, -0.128,
+8038, 949, 0.032,
+8038, 956, -0.032,
+8038, 957, -0.032,
+8038, 958, 0.032,
+8038, 964, -0.054,
+8038, 965, -0.032,
+8038, 967, -0.032,
+8038, 973, -0.032,
+8038, 8050, 0.032,
+8038, 8058, -0.032,
+8038, 8166, -0.032,
+8039, 941, 0.032,
+8039, 947, -0.128,
+8039, 949, 0.032,
+8039, 956, -0.032,
+8039, 957, -0.032,
+8039, 958, 0.032,
+8039, 964, -0.054,
+8039, 965, -0.032,
+8039, 967, -0.032,
+8039, 973, -0.032,
+8039, 8050, 0.032,
+8039, 8058, -0.032,
+8039, 8166, -0.032,
+8048, 947, -0.096,
+8048, 952, -0.096,
+8048, 957, -0.096,
+8048, 959, -0.032,
+8048, 960, -0.051,
+8048, 964, -0.096,
+8048, 965, -0.096,
+8048, 967, -0.096,
+8048, 968, -0.032,
+8048, 972, -0.032,
+8048, 973, -0.096,
+8048, 8056, -0.032,
+8048, 8058, -0.096,
+8050, 940, -0.032,
+8050, 945, -0.032,
+8050, 948, -0.032,
+8050, 963, -0.032,
+8050, 965, -0.032,
+8050, 967, -0.01,
+8050, 973, -0.032,
+8050, 993, -0.192,
+8050, 8048, -0.032,
+8050, 8058, -0.032,
+8050, 8114, -0.032,
+8050, 8115, -0.032,
+8050, 8116, -0.032,
+8050, 8118, -0.032,
+8050, 8119, -0.032,
+8050, 8166, -0.032,
+8052, 957, -0.032,
+8052, 965, -0.032,
+8052, 973, -0.032,
+8052, 8058, -0.032,
+8052, 8166, -0.032,
+8054, 947, -0.08,
+8054, 951, -0.019,
+8054, 952, -0.038,
+8054, 954, -0.064,
+8054, 957, -0.064,
+8054, 959, -0.032,
+8054, 962, -0.032,
+8054, 963, -0.032,
+8054, 964, -0.096,
+8054, 967, -0.064,
+8054, 972, -0.032,
+8054, 993, -0.192,
+8054, 8000, -0.032,
+8054, 8001, -0.032,
+8054, 8004, -0.032,
+8054, 8005, -0.032,
+8054, 8056, -0.032,
+8056, 947, -0.032,
+8056, 955, -0.032,
+8056, 956, -0.013,
+8056, 957, -0.045,
+8056, 964, -0.038,
+8056, 965, -0.064,
+8056, 967, -0.032,
+8056, 973, -0.064,
+8056, 993, -0.192,
+8056, 8058, -0.064,
+8056, 8166, -0.064,
+8058, 952, -0.032,
+8058, 956, -0.013,
+8058, 957, -0.045,
+8058, 967, -0.032,
+8058, 968, 0.032,
+8058, 993, -0.192,
+8060, 941, 0.032,
+8060, 947, -0.128,
+8060, 949, 0.032,
+8060, 956, -0.032,
+8060, 957, -0.032,
+8060, 958, 0.032,
+8060, 964, -0.054,
+8060, 965, -0.032,
+8060, 967, -0.032,
+8060, 973, -0.032,
+8060, 8050, 0.032,
+8060, 8058, -0.032,
+8060, 8166, -0.032,
+8064, 947, -0.096,
+8064, 952, -0.096,
+8064, 957, -0.096,
+8064, 959, -0.032,
+8064, 960, -0.051,
+8064, 964, -0.096,
+8064, 965, -0.096,
+8064, 967, -0.096,
+8064, 968, -0.032,
+8064, 972, -0.032,
+8064, 973, -0.096,
+8064, 8056, -0.032,
+8064, 8058, -0.096,
+8065, 947, -0.096,
+8065, 952, -0.096,
+8065, 957, -0.096,
+8065, 959, -0.032,
+8065, 960, -0.051,
+8065, 964, -0.096,
+8065, 965, -0.096,
+8065, 967, -0.096,
+8065, 968, -0.032,
+8065, 972, -0.032,
+8065, 973, -0.096,
+8065, 8056, -0.032,
+8065, 8058, -0.096,
+8066, 947, -0.096,
+8066, 952, -0.096,
+8066, 957, -0.096,
+8066, 959, -0.032,
+8066, 960, -0.051,
+8066, 964, -0.096,
+8066, 965, -0.096,
+8066, 967, -0.096,
+8066, 968, -0.032,
+8066, 972, -0.032,
+8066, 973, -0.096,
+8066, 8056, -0.032,
+8066, 8058, -0.096,
+8067, 947, -0.096,
+8067, 952, -0.096,
+8067, 957, -0.096,
+8067, 959, -0.032,
+8067, 960, -0.051,
+8067, 964, -0.096,
+8067, 965, -0.096,
+8067, 967, -0.096,
+8067, 968, -0.032,
+8067, 972, -0.032,
+8067, 973, -0.096,
+8067, 8056, -0.032,
+8067, 8058, -0.096,
+8068, 947, -0.096,
+8068, 952, -0.096,
+8068, 957, -0.096,
+8068, 959, -0.032,
+8068, 960, -0.051,
+8068, 964, -0.096,
+8068, 965, -0.096,
+8068, 967, -0.096,
+8068, 968, -0.032,
+8068, 972, -0.032,
+8068, 973, -0.096,
+8068, 8056, -0.032,
+8068, 8058, -0.096,
+8069, 947, -0.096,
+8069, 952, -0.096,
+8069, 957, -0.051,
+8069, 959, -0.032,
+8069, 960, -0.051,
+8069, 964, -0.096,
+8069, 965, -0.096,
+8069, 967, -0.096,
+8069, 968, -0.032,
+8069, 972, -0.032,
+8069, 973, -0.096,
+8069, 8056, -0.032,
+8069, 8058, -0.096,
+8070, 947, -0.096,
+8070, 952, -0.096,
+8070, 957, -0.096,
+8070, 959, -0.032,
+8070, 960, -0.051,
+8070, 964, -0.096,
+8070, 965, -0.096,
+8070, 967, -0.096,
+8070, 968, -0.032,
+8070, 972, -0.032,
+8070, 973, -0.096,
+8070, 8056, -0.032,
+8070, 8058, -0.096,
+8071, 947, -0.096,
+8071, 952, -0.096,
+8071, 957, -0.096,
+8071, 959, -0.032,
+8071, 960, -0.051,
+8071, 964, -0.096,
+8071, 965, -0.096,
+8071, 967, -0.096,
+8071, 968, -0.032,
+8071, 972, -0.032,
+8071, 973, -0.096,
+8071, 8056, -0.032,
+8071, 8058, -0.096,
+8080, 957, -0.032,
+8080, 965, -0.032,
+8080, 973, -0.032,
+8080, 8058, -0.032,
+8080, 8166, -0.032,
+8081, 957, -0.032,
+8081, 965, -0.032,
+8081, 973, -0.032,
+8081, 8058, -0.032,
+8081, 8166, -0.032,
+8082, 957, -0.032,
+8082, 965, -0.032,
+8082, 973, -0.032,
+8082, 8058, -0.032,
+8082, 8166, -0.032,
+8083, 957, -0.032,
+8083, 965, -0.032,
+8083, 973, -0.032,
+8083, 8058, -0.032,
+8083, 8166, -0.032,
+8084, 957, -0.032,
+8084, 965, -0.032,
+8084, 973, -0.032,
+8084, 8058, -0.032,
+8084, 8166, -0.032,
+8085, 957, -0.032,
+8085, 965, -0.032,
+8085, 973, -0.032,
+8085, 8058, -0.032,
+8085, 8166, -0.032,
+8086, 957, -0.032,
+8086, 965, -0.032,
+8086, 973, -0.032,
+8086, 8058, -0.032,
+8086, 8166, -0.032,
+8087, 957, -0.032,
+8087, 965, -0.032,
+8087, 973, -0.032,
+8087, 8058, -0.032,
+8087, 8166, -0.032,
+8096, 941, 0.032,
+8096, 947, -0.128,
+8096, 949, 0.032,
+8096, 956, -0.032,
+8096, 957, -0.032,
+8096, 958, 0.032,
+8096, 964, -0.054,
+8096, 965, -0.032,
+8096, 967, -0.032,
+8096, 973, -0.032,
+8096, 8050, 0.032,
+8096, 8058, -0.032,
+8096, 8166, -0.032,
+8097, 941, 0.032,
+8097, 947, -0.128,
+8097, 949, 0.032,
+8097, 956, -0.032,
+8097, 957, -0.032,
+8097, 958, 0.032,
+8097, 964, -0.054,
+8097, 965, -0.032,
+8097, 967, -0.032,
+8097, 973, -0.032,
+8097, 8050, 0.032,
+8097, 8058, -0.032,
+8097, 8166, -0.032,
+8098, 941, 0.032,
+8098, 947, -0.128,
+8098, 949, 0.032,
+8098, 956, -0.032,
+8098, 957, -0.032,
+8098, 958, 0.032,
+8098, 964, -0.054,
+8098, 965, -0.032,
+8098, 967, -0.032,
+8098, 973, -0.032,
+8098, 8050, 0.032,
+8098, 8058, -0.032,
+8098, 8166, -0.032,
+8099, 941, 0.032,
+8099, 947, -0.128,
+8099, 949, 0.032,
+8099, 956, -0.032,
+8099, 957, -0.032,
+8099, 958, 0.032,
+8099, 964, -0.054,
+8099, 965, -0.032,
+8099, 967, -0.032,
+8099, 973, -0.032,
+8099, 8050, 0.032,
+8099, 8058, -0.032,
+8099, 8166, -0.032,
+8100, 941, 0.032,
+8100, 947, -0.128,
+8100, 949, 0.032,
+8100, 956, -0.032,
+8100, 957, -0.032,
+8100, 958, 0.032,
+8100, 964, -0.054,
+8100, 965, -0.032,
+8100, 967, -0.032,
+8100, 973, -0.032,
+8100, 8050, 0.032,
+8100, 8058, -0.032,
+8100, 8166, -0.032,
+8101, 941, 0.032,
+8101, 947, -0.128,
+8101, 949, 0.032,
+8101, 956, -0.032,
+8101, 957, -0.032,
+8101, 958, 0.032,
+8101, 964, -0.054,
+8101, 965, -0.032,
+8101, 967, -0.032,
+8101, 973, -0.032,
+8101, 8050, 0.032,
+8101, 8058, -0.032,
+8101, 8166, -0.032,
+8102, 941, 0.032,
+8102, 947, -0.128,
+8102, 949, 0.032,
+8102, 956, -0.032,
+8102, 957, -0.032,
+8102, 958, 0.032,
+8102, 964, -0.054,
+8102, 965, -0.032,
+8102, 967, -0.032,
+8102, 973, -0.032,
+8102, 8050, 0.032,
+8102, 8058, -0.032,
+8102, 8166, -0.032,
+8103, 941, 0.032,
+8103, 947, -0.128,
+8103, 949, 0.032,
+8103, 956, -0.032,
+8103, 957, -0.032,
+8103, 958, 0.032,
+8103, 964, -0.054,
+8103, 965, -0.032,
+8103, 967, -0.032,
+8103, 973, -0.032,
+8103, 8050, 0.032,
+8103, 8058, -0.032,
+8103, 8166, -0.032,
+8114, 947, -0.096,
+8114, 952, -0.096,
+8114, 957, -0.096,
+8114, 959, -0.032,
+8114, 960, -0.051,
+8114, 964, -0.096,
+8114, 965, -0.096,
+8114, 967, -0.096,
+8114, 968, -0.032,
+8114, 972, -0.032,
+8114, 973, -0.096,
+8114, 8056, -0.032,
+8114, 8058, -0.096,
+8115, 947, -0.096,
+8115, 952, -0.096,
+8115, 957, -0.109,
+8115, 959, -0.032,
+8115, 960, -0.051,
+8115, 964, -0.096,
+8115, 965, -0.096,
+8115, 967, -0.096,
+8115, 968, -0.032,
+8115, 972, -0.032,
+8115, 973, -0.096,
+8115, 993, -0.255,
+8115, 8016, -0.096,
+8115, 8018, -0.096,
+8115, 8020, -0.096,
+8115, 8021, -0.096,
+8115, 8022, -0.096,
+8115, 8023, -0.096,
+8115, 8056, -0.032,
+8115, 8058, -0.096,
+8115, 8166, -0.096,
+8116, 947, -0.096,
+8116, 952, -0.096,
+8116, 957, -0.096,
+8116, 959, -0.032,
+8116, 960, -0.051,
+8116, 964, -0.096,
+8116, 965, -0.096,
+8116, 967, -0.096,
+8116, 968, -0.032,
+8116, 972, -0.032,
+8116, 973, -0.096,
+8116, 8056, -0.032,
+8116, 8058, -0.096,
+8118, 947, -0.096,
+8118, 952, -0.096,
+8118, 957, -0.096,
+8118, 959, -0.032,
+8118, 960, -0.051,
+8118, 964, -0.096,
+8118, 965, -0.096,
+8118, 967, -0.096,
+8118, 968, -0.032,
+8118, 972, -0.032,
+8118, 973, -0.096,
+8118, 8056, -0.032,
+8118, 8058, -0.096,
+8119, 947, -0.096,
+8119, 952, -0.096,
+8119, 957, -0.096,
+8119, 959, -0.032,
+8119, 960, -0.051,
+8119, 964, -0.096,
+8119, 965, -0.096,
+8119, 967, -0.096,
+8119, 968, -0.032,
+8119, 972, -0.032,
+8119, 973, -0.096,
+8119, 8056, -0.032,
+8119, 8058, -0.096,
+8124, 920, -0.096,
+8124, 927, -0.096,
+8124, 932, -0.096,
+8124, 933, -0.16,
+8124, 934, -0.096,
+8124, 936, -0.141,
+8124, 939, -0.16,
+8124, 957, -0.112,
+8127, 913, -0.16,
+8127, 927, -0.064,
+8127, 937, -0.032,
+8127, 8124, -0.16,
+8127, 8188, -0.032,
+8128, 913, -0.128,
+8128, 8124, -0.128,
+8130, 957, -0.032,
+8130, 965, -0.032,
+8130, 973, -0.032,
+8130, 8058, -0.032,
+8130, 8166, -0.032,
+8131, 957, -0.032,
+8131, 965, -0.032,
+8131, 973, -0.032,
+8131, 993, -0.192,
+8131, 8058, -0.032,
+8131, 8166, -0.032,
+8132, 957, -0.032,
+8132, 965, -0.032,
+8132, 973, -0.032,
+8132, 8058, -0.032,
+8132, 8166, -0.032,
+8134, 957, -0.032,
+8134, 965, -0.032,
+8134, 973, -0.032,
+8134, 8058, -0.032,
+8134, 8166, -0.032,
+8135, 957, -0.032,
+8135, 965, -0.032,
+8135, 973, -0.032,
+8135, 8058, -0.032,
+8135, 8166, -0.032,
+8141, 913, -0.096,
+8141, 927, -0.032,
+8141, 8124, -0.096,
+8142, 913, -0.096,
+8142, 927, -0.032,
+8142, 8124, -0.096,
+8143, 913, -0.128,
+8143, 8124, -0.128,
+8146, 947, -0.08,
+8146, 951, -0.019,
+8146, 952, -0.038,
+8146, 954, -0.064,
+8146, 957, -0.064,
+8146, 959, -0.032,
+8146, 962, -0.032,
+8146, 963, -0.032,
+8146, 964, -0.096,
+8146, 967, -0.064,
+8146, 972, -0.032,
+8146, 993, -0.192,
+8146, 8000, -0.032,
+8146, 8001, -0.032,
+8146, 8004, -0.032,
+8146, 8005, -0.032,
+8146, 8056, -0.032,
+8150, 947, -0.08,
+8150, 951, -0.019,
+8150, 952, -0.038,
+8150, 954, -0.064,
+8150, 957, -0.064,
+8150, 959, -0.032,
+8150, 962, -0.032,
+8150, 963, -0.032,
+8150, 964, -0.096,
+8150, 967, -0.064,
+8150, 972, -0.032,
+8150, 993, -0.192,
+8150, 8000, -0.032,
+8150, 8001, -0.032,
+8150, 8004, -0.032,
+8150, 8005, -0.032,
+8150, 8056, -0.032,
+8151, 947, -0.08,
+8151, 951, -0.019,
+8151, 952, -0.038,
+8151, 954, -0.064,
+8151, 957, -0.064,
+8151, 959, -0.032,
+8151, 962, -0.032,
+8151, 963, -0.032,
+8151, 964, -0.096,
+8151, 967, -0.064,
+8151, 972, -0.032,
+8151, 993, -0.192,
+8151, 8000, -0.032,
+8151, 8001, -0.032,
+8151, 8004, -0.032,
+8151, 8005, -0.032,
+8151, 8056, -0.032,
+8157, 913, -0.096,
+8157, 927, -0.032,
+8157, 8124, -0.096,
+8158, 913, -0.096,
+8158, 927, -0.032,
+8158, 8124, -0.096,
+8159, 913, -0.128,
+8159, 8124, -0.128,
+8162, 952, -0.032,
+8162, 956, -0.013,
+8162, 957, -0.045,
+8162, 967, -0.032,
+8162, 968, 0.032,
+8162, 993, -0.192,
+8164, 943, 0.032,
+8164, 947, -0.064,
+8164, 950, 0.032,
+8164, 953, 0.032,
+8164, 957, -0.057,
+8164, 959, 0.032,
+8164, 963, 0.032,
+8164, 967, -0.013,
+8164, 968, 0.019,
+8164, 972, 0.032,
+8164, 993, -0.192,
+8164, 8054, 0.032,
+8164, 8056, 0.032,
+8164, 8150, 0.032,
+8165, 943, 0.032,
+8165, 947, -0.064,
+8165, 950, 0.032,
+8165, 953, 0.032,
+8165, 957, -0.057,
+8165, 959, 0.032,
+8165, 963, 0.032,
+8165, 967, -0.013,
+8165, 968, 0.019,
+8165, 972, 0.032,
+8165, 993, -0.192,
+8165, 8054, 0.032,
+8165, 8056, 0.032,
+8165, 8150, 0.032,
+8166, 952, -0.032,
+8166, 956, -0.013,
+8166, 957, -0.045,
+8166, 967, -0.032,
+8166, 968, 0.032,
+8166, 993, -0.192,
+8167, 952, -0.032,
+8167, 956, -0.013,
+8167, 957, -0.045,
+8167, 967, -0.032,
+8167, 968, 0.032,
+8167, 993, -0.192,
+8175, 913, -0.128,
+8175, 927, -0.064,
+8175, 937, -0.032,
+8175, 8124, -0.128,
+8175, 8188, -0.032,
+8178, 941, 0.032,
+8178, 947, -0.128,
+8178, 949, 0.032,
+8178, 956, -0.032,
+8178, 957, -0.032,
+8178, 958, 0.032,
+8178, 964, -0.054,
+8178, 965, -0.032,
+8178, 967, -0.032,
+8178, 973, -0.032,
+8178, 8050, 0.032,
+8178, 8058, -0.032,
+8178, 8166, -0.032,
+8179, 941, 0.032,
+8179, 947, -0.128,
+8179, 949, 0.032,
+8179, 956, -0.032,
+8179, 957, -0.032,
+8179, 958, 0.032,
+8179, 964, -0.054,
+8179, 965, -0.032,
+8179, 967, -0.032,
+8179, 973, -0.032,
+8179, 993, -0.192,
+8179, 8050, 0.032,
+8179, 8058, -0.032,
+8179, 8166, -0.032,
+8180, 941, 0.032,
+8180, 947, -0.128,
+8180, 949, 0.032,
+8180, 956, -0.032,
+8180, 957, -0.032,
+8180, 958, 0.032,
+8180, 964, -0.054,
+8180, 965, -0.032,
+8180, 967, -0.032,
+8180, 973, -0.032,
+8180, 8050, 0.032,
+8180, 8058, -0.032,
+8180, 8166, -0.032,
+8182, 941, 0.032,
+8182, 947, -0.128,
+8182, 949, 0.032,
+8182, 956, -0.032,
+8182, 957, -0.032,
+8182, 958, 0.032,
+8182, 964, -0.054,
+8182, 965, -0.032,
+8182, 967, -0.032,
+8182, 973, -0.032,
+8182, 8050, 0.032,
+8182, 8058, -0.032,
+8182, 8166, -0.032,
+8183, 941, 0.032,
+8183, 947, -0.128,
+8183, 949, 0.032,
+8183, 956, -0.032,
+8183, 957, -0.032,
+8183, 958, 0.032,
+8183, 964, -0.054,
+8183, 965, -0.032,
+8183, 967, -0.032,
+8183, 973, -0.032,
+8183, 8050, 0.032,
+8183, 8058, -0.032,
+8183, 8166, -0.032,
+8190, 913, -0.192,
+8190, 927, -0.064,
+8190, 937, -0.032,
+8190, 8124, -0.192,
+8190, 8188, -0.032
+KERNS_END
+
+END
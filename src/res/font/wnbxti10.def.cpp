@@ -0,0 +1,663 @@
+// Generated by prebuilt/alphabet_def.py from res/cyrillic/wnbxti10.xml, do not edit
+
+#include "res/font_def.res.h"
+
+DEF_FONT(wnbxti10, cyrillic/wnbxti10.ttf, 95)
+
+xHeight(0.444445) quad(1.182211) space(0.414441)
+
+roman(wnbx10) ss(wnssbx10) tt(wntt10)
+
+METRICS_START
+171, 0.649994, 0.472223, 0, 0.008611,
+187, 0.649994, 0.472223, 0, 0,
+305, 0.355553, 0.444445, 0, 0.094261,
+774, 0.591105, 0.652727, 0, 0.092905,
+776, 0.591105, 0.686111, 0, 0.112642,
+1025, 0.756659, 0.894394, 0, 0.114306,
+1026, 0.943324, 0.686111, 0, 0.12903,
+1028, 0.826658, 0.686111, 0, 0.142084,
+1029, 0.649994, 0.686111, 0, 0.11264,
+1030, 0.471664, 0.686111, 0, 0.156807,
+1032, 0.61055, 0.686111, 0, 0.145001,
+1033, 1.198877, 0.686111, 0, 0.032991,
+1034, 1.198877, 0.686111, 0, 0.032991,
+1035, 0.870825, 0.686111, 0, 0.084864,
+1039, 0.894992, 0.686111, 0.194445, 0.172084,
+1040, 0.865547, 0.686111, 0, 0,
+1041, 0.81666, 0.686111, 0, 0.055418,
+1042, 0.81666, 0.686111, 0, 0.069758,
+1043, 0.697771, 0.686111, 0, 0.12903,
+1044, 0.894992, 0.686111, 0.194445, 0.172084,
+1045, 0.756659, 0.686111, 0, 0.114306,
+1046, 1.318319, 0.686111, 0, 0.142084,
+1047, 0.708882, 0.686111, 0, 0.099202,
+1048, 0.894992, 0.686111, 0, 0.172084,
+1049, 0.894992, 0.894394, 0, 0.172084,
+1050, 0.894992, 0.686111, 0, 0.142084,
+1051, 0.894992, 0.686111, 0, 0.172084,
+1052, 1.072767, 0.686111, 0, 0.172084,
+1053, 0.894992, 0.686111, 0, 0.172084,
+1054, 0.854991, 0.686111, 0, 0.090625,
+1055, 0.894992, 0.686111, 0, 0.172084,
+1056, 0.787214, 0.686111, 0, 0.099202,
+1057, 0.826658, 0.686111, 0, 0.142084,
+1058, 0.796103, 0.686111, 0, 0.12903,
+1059, 0.865547, 0.686111, 0, 0.186251,
+1060, 0.944435, 0.686111, 0, 0.090625,
+1061, 0.865547, 0.686111, 0, 0.156807,
+1062, 0.894992, 0.686111, 0.194445, 0.172084,
+1063, 0.894992, 0.686111, 0, 0.172084,
+1064, 1.293599, 0.686111, 0, 0.172084,
+1065, 1.293599, 0.686111, 0.194445, 0.172084,
+1066, 0.988047, 0.686111, 0, 0.032991,
+1067, 1.101102, 0.686111, 0, 0.172084,
+1068, 0.81666, 0.686111, 0, 0.032991,
+1069, 0.826658, 0.686111, 0, 0.090625,
+1070, 1.236933, 0.686111, 0, 0.090625,
+1071, 0.894992, 0.686111, 0, 0.172084,
+1072, 0.570494, 0.444445, 0, 0.094261,
+1073, 0.549883, 0.694445, 0, 0.167501,
+1074, 0.570494, 0.444445, 0, 0.085002,
+1075, 0.488052, 0.444445, 0, 0.085002,
+1076, 0.549883, 0.694445, 0, 0.112694,
+1077, 0.511606, 0.444445, 0, 0.085002,
+1078, 1.209432, 0.444445, 0, 0.052223,
+1079, 0.532217, 0.444445, 0, 0.052223,
+1080, 0.649994, 0.444445, 0, 0.094261,
+1081, 0.649994, 0.652727, 0, 0.094261,
+1082, 0.591105, 0.444445, 0, 0.111112,
+1083, 0.62055, 0.444445, 0, 0.094261,
+1084, 0.856104, 0.444445, 0, 0.094261,
+1085, 0.649994, 0.444445, 0, 0.094261,
+1086, 0.549883, 0.444445, 0, 0.078611,
+1087, 0.649994, 0.444445, 0, 0.094261,
+1088, 0.585216, 0.444445, 0.194445, 0.078611,
+1089, 0.511606, 0.444445, 0, 0.052223,
+1090, 0.944435, 0.444445, 0, 0.094261,
+1091, 0.591105, 0.444445, 0.194445, 0.105001,
+1092, 0.785437, 0.694445, 0.194445, 0.078611,
+1093, 0.648885, 0.444445, 0, 0.1258335,
+1094, 0.655884, 0.444445, 0.194445, 0.094261,
+1095, 0.62055, 0.444445, 0, 0.094261,
+1096, 0.944435, 0.444445, 0, 0.094261,
+1097, 0.950325, 0.444445, 0.194445, 0.094261,
+1098, 0.561663, 0.444445, 0, 0.078611,
+1099, 0.767771, 0.444445, 0, 0.094261,
+1100, 0.591105, 0.444445, 0, 0.078611,
+1101, 0.511606, 0.444445, 0, 0.078611,
+1102, 0.835492, 0.444445, 0, 0.078611,
+1103, 0.62055, 0.444445, 0, 0.094261,
+1105, 0.511606, 0.686111, 0, 0.085002,
+1106, 0.532217, 0.694445, 0.194445, 0.077777,
+1108, 0.511606, 0.444445, 0, 0.081667,
+1109, 0.486941, 0.444445, 0, 0.081667,
+1110, 0.355553, 0.693255, 0, 0.113872,
+1112, 0.355553, 0.693255, 0.194445, 0.167204,
+1113, 0.797215, 0.444445, 0, 0.078611,
+1114, 0.82666, 0.444445, 0, 0.078611,
+1115, 0.591105, 0.694445, 0, 0.094261,
+1119, 0.62055, 0.444445, 0.194445, 0.094261,
+1122, 0.934436, 0.75, 0, 0.099202,
+1123, 0.826658, 0.444445, 0, 0.078611,
+1138, 0.885547, 0.686111, 0, 0.090625,
+1139, 0.532217, 0.444445, 0, 0.078611,
+1140, 0.934436, 0.686111, 0, 0.186251,
+1141, 0.723051, 0.444445, 0, 0.1258335
+METRICS_END
+
+LIGTURES_START
+1044, 1032, 1026,
+1044, 1112, 1026,
+1047, 1061, 1046,
+1047, 1093, 1046,
+1050, 1061, 1061,
+1050, 1093, 1061,
+1051, 1032, 1033,
+1051, 1112, 1033,
+1053, 1032, 1034,
+1053, 1112, 1034,
+1057, 1061, 1064,
+1057, 1093, 1064,
+1058, 1057, 1062,
+1058, 1089, 1062,
+1062, 1061, 1063,
+1062, 1093, 1063,
+1064, 1062, 0,
+1064, 1063, 1065,
+1064, 1094, 0,
+1064, 1095, 1065,
+1067, 1040, 1071,
+1067, 1059, 1070,
+1067, 1072, 1071,
+1067, 1091, 1070,
+1076, 1112, 1106,
+1079, 1093, 1078,
+1082, 1093, 1093,
+1083, 1112, 1113,
+1085, 1112, 1114,
+1089, 1093, 1096,
+1090, 1089, 1094,
+1094, 1093, 1095,
+1096, 1094, 0,
+1096, 1095, 1097,
+1099, 1072, 1103,
+1099, 1091, 1102
+LIGTURES_END
+
+KERNS_START
+1026, 1026, -0.088333,
+1026, 1028, -0.029445,
+1026, 1035, -0.088333,
+1026, 1046, -0.029445,
+1026, 1054, -0.029445,
+1026, 1057, -0.029445,
+1026, 1058, -0.088333,
+1026, 1059, -0.088333,
+1026, 1060, -0.029445,
+1026, 1061, -0.029445,
+1026, 1063, -0.088333,
+1026, 1066, -0.088333,
+1026, 1080, -0.029445,
+1026, 1081, -0.029445,
+1026, 1082, -0.029445,
+1026, 1085, -0.029445,
+1026, 1087, -0.029445,
+1026, 1090, -0.029445,
+1026, 1091, -0.029445,
+1026, 1094, -0.029445,
+1026, 1096, -0.029445,
+1026, 1097, -0.029445,
+1026, 1098, -0.029445,
+1026, 1099, -0.029445,
+1026, 1100, -0.029445,
+1026, 1102, -0.029445,
+1026, 1110, -0.029445,
+1026, 1114, -0.029445,
+1026, 1122, -0.088333,
+1026, 1123, -0.029445,
+1026, 1138, -0.029445,
+1026, 1140, -0.117777,
+1026, 1141, -0.029445,
+1030, 1030, 0.029445,
+1033, 1026, -0.088333,
+1033, 1028, -0.029445,
+1033, 1035, -0.088333,
+1033, 1046, -0.029445,
+1033, 1054, -0.029445,
+1033, 1057, -0.029445,
+1033, 1058, -0.088333,
+1033, 1059, -0.088333,
+1033, 1060, -0.029445,
+1033, 1061, -0.029445,
+1033, 1063, -0.088333,
+1033, 1066, -0.088333,
+1033, 1080, -0.029445,
+1033, 1081, -0.029445,
+1033, 1082, -0.029445,
+1033, 1085, -0.029445,
+1033, 1087, -0.029445,
+1033, 1090, -0.029445,
+1033, 1091, -0.029445,
+1033, 1094, -0.029445,
+1033, 1096, -0.029445,
+1033, 1097, -0.029445,
+1033, 1098, -0.029445,
+1033, 1099, -0.029445,
+1033, 1100, -0.029445,
+1033, 1102, -0.029445,
+1033, 1110, -0.029445,
+1033, 1114, -0.029445,
+1033, 1122, -0.088333,
+1033, 1123, -0.029445,
+1033, 1138, -0.029445,
+1033, 1140, -0.117777,
+1033, 1141, -0.029445,
+1034, 1026, -0.088333,
+1034, 1028, -0.029445,
+1034, 1035, -0.088333,
+1034, 1046, -0.029445,
+1034, 1054, -0.029445,
+1034, 1057, -0.029445,
+1034, 1058, -0.088333,
+1034, 1059, -0.088333,
+1034, 1060, -0.029445,
+1034, 1061, -0.029445,
+1034, 1063, -0.088333,
+1034, 1066, -0.088333,
+1034, 1080, -0.029445,
+1034, 1081, -0.029445,
+1034, 1082, -0.029445,
+1034, 1085, -0.029445,
+1034, 1087, -0.029445,
+1034, 1090, -0.029445,
+1034, 1091, -0.029445,
+1034, 1094, -0.029445,
+1034, 1096, -0.029445,
+1034, 1097, -0.029445,
+1034, 1098, -0.029445,
+1034, 1099, -0.029445,
+1034, 1100, -0.029445,
+1034, 1102, -0.029445,
+1034, 1110, -0.029445,
+1034, 1114, -0.029445,
+1034, 1122, -0.088333,
+1034, 1123, -0.029445,
+1034, 1138, -0.029445,
+1034, 1140, -0.117777,
+1034, 1141, -0.029445,
+1040, 1026, -0.088333,
+1040, 1028, -0.029445,
+1040, 1035, -0.088333,
+1040, 1054, -0.029445,
+1040, 1057, -0.029445,
+1040, 1058, -0.088333,
+1040, 1059, -0.088333,
+1040, 1060, -0.029445,
+1040, 1063, -0.088333,
+1040, 1066, -0.088333,
+1040, 1080, -0.029445,
+1040, 1081, -0.029445,
+1040, 1082, -0.029445,
+1040, 1085, -0.029445,
+1040, 1087, -0.029445,
+1040, 1090, -0.029445,
+1040, 1091, -0.029445,
+1040, 1094, -0.029445,
+1040, 1096, -0.029445,
+1040, 1097, -0.029445,
+1040, 1098, -0.029445,
+1040, 1099, -0.029445,
+1040, 1100, -0.029445,
+1040, 1102, -0.029445,
+1040, 1110, -0.029445,
+1040, 1114, -0.029445,
+1040, 1122, -0.088333,
+1040, 1123, -0.029445,
+1040, 1138, -0.029445,
+1040, 1140, -0.117777,
+1040, 1141, -0.029445,
+1043, 1033, -0.029445,
+1043, 1040, -0.088333,
+1043, 1044, -0.088333,
+1043, 1051, -0.029445,
+1043, 1071, -0.088333,
+1043, 1072, -0.088333,
+1043, 1077, -0.088333,
+1043, 1080, -0.088333,
+1043, 1081, -0.088333,
+1043, 1083, -0.088333,
+1043, 1084, -0.088333,
+1043, 1086, -0.088333,
+1043, 1089, -0.088333,
+1043, 1091, -0.088333,
+1043, 1092, -0.088333,
+1043, 1094, -0.088333,
+1043, 1096, -0.088333,
+1043, 1097, -0.088333,
+1043, 1098, -0.088333,
+1043, 1099, -0.088333,
+1043, 1100, -0.088333,
+1043, 1105, -0.088333,
+1043, 1108, -0.088333,
+1043, 1113, -0.088333,
+1043, 1139, -0.088333,
+1043, 1141, -0.088333,
+1046, 1028, -0.029445,
+1046, 1054, -0.029445,
+1046, 1057, -0.029445,
+1046, 1060, -0.029445,
+1046, 1095, -0.029445,
+1046, 1138, -0.029445,
+1050, 1028, -0.029445,
+1050, 1054, -0.029445,
+1050, 1057, -0.029445,
+1050, 1060, -0.029445,
+1050, 1095, -0.029445,
+1050, 1138, -0.029445,
+1054, 1040, -0.029445,
+1054, 1044, -0.029445,
+1054, 1046, -0.029445,
+1054, 1059, -0.029445,
+1054, 1061, -0.029445,
+1054, 1071, -0.029445,
+1054, 1140, -0.029445,
+1056, 1033, -0.088333,
+1056, 1040, -0.088333,
+1056, 1044, -0.088333,
+1056, 1051, -0.088333,
+1056, 1071, -0.088333,
+1056, 1072, -0.029445,
+1056, 1076, -0.088333,
+1056, 1077, -0.029445,
+1056, 1083, -0.088333,
+1056, 1086, -0.029445,
+1056, 1105, -0.029445,
+1056, 1113, -0.088333,
+1056, 1139, -0.029445,
+1058, 1033, -0.029445,
+1058, 1040, -0.088333,
+1058, 1044, -0.088333,
+1058, 1051, -0.029445,
+1058, 1071, -0.088333,
+1058, 1072, -0.088333,
+1058, 1077, -0.088333,
+1058, 1080, -0.088333,
+1058, 1081, -0.088333,
+1058, 1083, -0.088333,
+1058, 1084, -0.088333,
+1058, 1086, -0.088333,
+1058, 1089, -0.088333,
+1058, 1091, -0.088333,
+1058, 1092, -0.088333,
+1058, 1094, -0.088333,
+1058, 1096, -0.088333,
+1058, 1097, -0.088333,
+1058, 1098, -0.088333,
+1058, 1099, -0.088333,
+1058, 1100, -0.088333,
+1058, 1105, -0.088333,
+1058, 1108, -0.088333,
+1058, 1113, -0.088333,
+1058, 1139, -0.088333,
+1058, 1141, -0.088333,
+1059, 1028, -0.029445,
+1059, 1033, -0.058888,
+1059, 1040, -0.088333,
+1059, 1044, -0.058888,
+1059, 1051, -0.058888,
+1059, 1054, -0.029445,
+1059, 1057, -0.029445,
+1059, 1060, -0.029445,
+1059, 1071, -0.088333,
+1059, 1072, -0.088333,
+1059, 1077, -0.088333,
+1059, 1080, -0.117777,
+1059, 1081, -0.117777,
+1059, 1083, -0.117777,
+1059, 1084, -0.117777,
+1059, 1086, -0.088333,
+1059, 1089, -0.088333,
+1059, 1091, -0.117777,
+1059, 1094, -0.117777,
+1059, 1096, -0.117777,
+1059, 1097, -0.117777,
+1059, 1098, -0.117777,
+1059, 1099, -0.117777,
+1059, 1100, -0.117777,
+1059, 1105, -0.088333,
+1059, 1108, -0.088333,
+1059, 1113, -0.117777,
+1059, 1138, -0.029445,
+1059, 1139, -0.088333,
+1059, 1141, -0.117777,
+1060, 1040, -0.029445,
+1060, 1044, -0.029445,
+1060, 1046, -0.029445,
+1060, 1059, -0.029445,
+1060, 1061, -0.029445,
+1060, 1071, -0.029445,
+1060, 1140, -0.029445,
+1061, 1028, -0.029445,
+1061, 1054, -0.029445,
+1061, 1057, -0.029445,
+1061, 1060, -0.029445,
+1061, 1095, -0.029445,
+1061, 1138, -0.029445,
+1066, 1026, -0.088333,
+1066, 1028, -0.029445,
+1066, 1035, -0.088333,
+1066, 1046, -0.029445,
+1066, 1054, -0.029445,
+1066, 1057, -0.029445,
+1066, 1058, -0.088333,
+1066, 1059, -0.088333,
+1066, 1060, -0.029445,
+1066, 1061, -0.029445,
+1066, 1063, -0.088333,
+1066, 1066, -0.088333,
+1066, 1080, -0.029445,
+1066, 1081, -0.029445,
+1066, 1082, -0.029445,
+1066, 1085, -0.029445,
+1066, 1087, -0.029445,
+1066, 1090, -0.029445,
+1066, 1091, -0.029445,
+1066, 1094, -0.029445,
+1066, 1096, -0.029445,
+1066, 1097, -0.029445,
+1066, 1098, -0.029445,
+1066, 1099, -0.029445,
+1066, 1100, -0.029445,
+1066, 1102, -0.029445,
+1066, 1110, -0.029445,
+1066, 1114, -0.029445,
+1066, 1122, -0.088333,
+1066, 1123, -0.029445,
+1066, 1138, -0.029445,
+1066, 1140, -0.117777,
+1066, 1141, -0.029445,
+1068, 1026, -0.088333,
+1068, 1028, -0.029445,
+1068, 1035, -0.088333,
+1068, 1046, -0.029445,
+1068, 1054, -0.029445,
+1068, 1057, -0.029445,
+1068, 1058, -0.088333,
+1068, 1059, -0.088333,
+1068, 1060, -0.029445,
+1068, 1061, -0.029445,
+1068, 1063, -0.088333,
+1068, 1066, -0.088333,
+1068, 1080, -0.029445,
+1068, 1081, -0.029445,
+1068, 1082, -0.029445,
+1068, 1085, -0.029445,
+1068, 1087, -0.029445,
+1068, 1090, -0.029445,
+1068, 1091, -0.029445,
+1068, 1094, -0.029445,
+1068, 1096, -0.029445,
+1068, 1097, -0.029445,
+1068, 1098, -0.029445,
+1068, 1099, -0.029445,
+1068, 1100, -0.029445,
+1068, 1102, -0.029445,
+1068, 1110, -0.029445,
+1068, 1114, -0.029445,
+1068, 1122, -0.088333,
+1068, 1123, -0.029445,
+1068, 1138, -0.029445,
+1068, 1140, -0.117777,
+1068, 1141, -0.029445,
+1069, 1040, -0.029445,
+1069, 1044, -0.029445,
+1069, 1046, -0.029445,
+1069, 1059, -0.029445,
+1069, 1061, -0.029445,
+1069, 1071, -0.029445,
+1069, 1140, -0.029445,
+1070, 1040, -0.029445,
+1070, 1044, -0.029445,
+1070, 1046, -0.029445,
+1070, 1059, -0.029445,
+1070, 1061, -0.029445,
+1070, 1071, -0.029445,
+1070, 1140, -0.029445,
+1073, 1072, -0.058888,
+1073, 1083, -0.029445,
+1073, 1084, -0.029445,
+1073, 1092, -0.058888,
+1073, 1113, -0.029445,
+1077, 1072, -0.058888,
+1077, 1083, -0.029445,
+1077, 1084, -0.029445,
+1077, 1092, -0.058888,
+1077, 1113, -0.029445,
+1083, 1083, -0.029445,
+1083, 1084, -0.029445,
+1083, 1095, -0.088333,
+1083, 1098, -0.029445,
+1083, 1113, -0.029445,
+1083, 1141, -0.029445,
+1086, 1072, -0.058888,
+1086, 1083, -0.029445,
+1086, 1084, -0.029445,
+1086, 1092, -0.058888,
+1086, 1113, -0.029445,
+1088, 1072, -0.058888,
+1088, 1083, -0.029445,
+1088, 1084, -0.029445,
+1088, 1092, -0.058888,
+1088, 1113, -0.029445,
+1089, 1072, -0.058888,
+1089, 1083, -0.029445,
+1089, 1084, -0.029445,
+1089, 1092, -0.058888,
+1089, 1113, -0.029445,
+1092, 1072, -0.058888,
+1092, 1083, -0.029445,
+1092, 1084, -0.029445,
+1092, 1092, -0.058888,
+1092, 1113, -0.029445,
+1098, 1083, -0.029445,
+1098, 1084, -0.029445,
+1098, 1086, -0.029445,
+1098, 1092, -0.029445,
+1098, 1095, -0.088333,
+1098, 1098, -0.029445,
+1098, 1108, -0.029445,
+1098, 1113, -0.029445,
+1098, 1139, -0.029445,
+1098, 1141, -0.029445,
+1100, 1083, -0.029445,
+1100, 1084, -0.029445,
+1100, 1086, -0.029445,
+1100, 1092, -0.029445,
+1100, 1095, -0.088333,
+1100, 1098, -0.029445,
+1100, 1108, -0.029445,
+1100, 1113, -0.029445,
+1100, 1139, -0.029445,
+1100, 1141, -0.029445,
+1101, 1072, -0.058888,
+1101, 1083, -0.029445,
+1101, 1084, -0.029445,
+1101, 1092, -0.058888,
+1101, 1113, -0.029445,
+1102, 1072, -0.058888,
+1102, 1083, -0.029445,
+1102, 1084, -0.029445,
+1102, 1092, -0.058888,
+1102, 1113, -0.029445,
+1105, 1072, -0.058888,
+1105, 1083, -0.029445,
+1105, 1084, -0.029445,
+1105, 1092, -0.058888,
+1105, 1113, -0.029445,
+1113, 1083, -0.029445,
+1113, 1084, -0.029445,
+1113, 1086, -0.029445,
+1113, 1092, -0.029445,
+1113, 1095, -0.088333,
+1113, 1098, -0.029445,
+1113, 1108, -0.029445,
+1113, 1113, -0.029445,
+1113, 1139, -0.029445,
+1113, 1141, -0.029445,
+1114, 1083, -0.029445,
+1114, 1084, -0.029445,
+1114, 1086, -0.029445,
+1114, 1092, -0.029445,
+1114, 1095, -0.088333,
+1114, 1098, -0.029445,
+1114, 1108, -0.029445,
+1114, 1113, -0.029445,
+1114, 1139, -0.029445,
+1114, 1141, -0.029445,
+1122, 1026, -0.088333,
+1122, 1028, -0.029445,
+1122, 1035, -0.088333,
+1122, 1046, -0.029445,
+1122, 1054, -0.029445,
+1122, 1057, -0.029445,
+1122, 1058, -0.088333,
+1122, 1059, -0.088333,
+1122, 1060, -0.029445,
+1122, 1061, -0.029445,
+1122, 1063, -0.088333,
+1122, 1066, -0.088333,
+1122, 1080, -0.029445,
+1122, 1081, -0.029445,
+1122, 1082, -0.029445,
+1122, 1085, -0.029445,
+1122, 1087, -0.029445,
+1122, 1090, -0.029445,
+1122, 1091, -0.029445,
+1122, 1094, -0.029445,
+1122, 1096, -0.029445,
+1122, 1097, -0.029445,
+1122, 1098, -0.029445,
+1122, 1099, -0.029445,
+1122, 1100, -0.029445,
+1122, 1102, -0.029445,
+1122, 1110, -0.029445,
+1122, 1114, -0.029445,
+1122, 1122, -0.088333,
+1122, 1123, -0.029445,
+1122, 1138, -0.029445,
+1122, 1140, -0.117777,
+1122, 1141, -0.029445,
+1123, 1083, -0.029445,
+1123, 1084, -0.029445,
+1123, 1086, -0.029445,
+1123, 1092, -0.029445,
+1123, 1095, -0.088333,
+1123, 1098, -0.029445,
+1123, 1108, -0.029445,
+1123, 1113, -0.029445,
+1123, 1139, -0.029445,
+1123, 1141, -0.029445,
+1138, 1040, -0.029445,
+1138, 1044, -0.029445,
+1138, 1046, -0.029445,
+1138, 1059, -0.029445,
+1138, 1061, -0.029445,
+1138, 1071, -0.029445,
+1138, 1140, -0.029445,
+1139, 1072, -0.058888,
+1139, 1083, -0.029445,
+1139, 1084, -0.029445,
+1139, 1092, -0.058888,
+1139, 1113, -0.029445,
+1140, 1028, -0.029445,
+1140, 1040, -0.117777,
+1140, 1054, -0.029445,
+1140, 1057, -0.029445,
+1140, 1060, -0.029445,
+1140, 1071, -0.117777,
+1140, 1072, -0.088333,
+1140, 1077, -0.088333,
+1140, 1080, -0.117777,
+1140, 1081, -0.117777,
+1140, 1083, -0.117777,
+1140, 1084, -0.117777,
+1140, 1086, -0.088333,
+1140, 1091, -0.117777,
+1140, 1094, -0.117777,
+1140, 1096, -0.117777,
+1140, 1097, -0.117777,
+1140, 1098, -0.117777,
+1140, 1099, -0.117777,
+1140, 1100, -0.117777,
+1140, 1105, -0.088333,
+1140, 1113, -0.117777,
+1140, 1138, -0.029445,
+1140, 1139, -0.088333,
+1140, 1141, -0.117777,
+1141, 1083, -0.088333,
+1141, 1084, -0.088333,
+1141, 1113, -0.088333
+KERNS_END
+
+END
@@ -0,0 +1,557 @@
+// Generated by prebuilt/alphabet_def.py from res/cyrillic/wnssbx10.xml, do not edit
+
+#include "res/font_def.res.h"
+
+DEF_FONT(wnssbx10, cyrillic/wnssbx10.ttf, 95)
+
+xHeight(0.458333) quad(1.100006) space(0.366669)
+
+roman(wnbx10) tt(wntt10)
+
+METRICS_START
+171, 0.733337, 0.5, 0, 0,
+187, 0.733337, 0.5, 0, 0,
+305, 0.255557, 0.458333, 0, 0,
+774, 0.550003, 0.6666155, 0, 0,
+776, 0.550003, 0.694445, 0, 0,
+1025, 0.64167, 0.902727, 0, 0,
+1026, 0.886116, 0.694445, 0, 0,
+1028, 0.702782, 0.694445, 0, 0,
+1029, 0.6111145, 0.694445, 0, 0,
+1030, 0.330557, 0.694445, 0, 0,
+1032, 0.519447, 0.694445, 0, 0,
+1033, 1.15834, 0.694445, 0, 0,
+1034, 1.115285, 0.694445, 0, 0,
+1035, 0.840283, 0.694445, 0, 0,
+1039, 0.763893, 0.694445, 0.194445, 0,
+1040, 0.733337, 0.694445, 0, 0,
+1041, 0.733337, 0.694445, 0, 0,
+1042, 0.733337, 0.694445, 0, 0,
+1043, 0.580559, 0.694445, 0, 0,
+1044, 0.850004, 0.694445, 0.194445, 0,
+1045, 0.64167, 0.694445, 0, 0,
+1046, 1.214895, 0.694445, 0, 0,
+1047, 0.672226, 0.694445, 0, 0,
+1048, 0.763893, 0.694445, 0, 0,
+1049, 0.763893, 0.902727, 0, 0,
+1050, 0.763893, 0.694445, 0, 0,
+1051, 0.806949, 0.694445, 0, 0,
+1052, 0.977783, 0.694445, 0, 0,
+1053, 0.763893, 0.694445, 0, 0,
+1054, 0.794449, 0.694445, 0, 0,
+1055, 0.763893, 0.694445, 0, 0,
+1056, 0.702782, 0.694445, 0, 0,
+1057, 0.702782, 0.694445, 0, 0,
+1058, 0.733337, 0.694445, 0, 0,
+1059, 0.733337, 0.694445, 0, 0.015279,
+1060, 0.916672, 0.694445, 0, 0,
+1061, 0.733337, 0.694445, 0, 0,
+1062, 0.806949, 0.694445, 0.194445, 0,
+1063, 0.763893, 0.694445, 0, 0,
+1064, 1.206952, 0.694445, 0, 0,
+1065, 1.250008, 0.694445, 0.194445, 0,
+1066, 0.940283, 0.694445, 0, 0,
+1067, 0.977783, 0.694445, 0, 0,
+1068, 0.733337, 0.694445, 0, 0,
+1069, 0.702782, 0.694445, 0, 0,
+1070, 1.143062, 0.694445, 0, 0,
+1071, 0.702782, 0.694445, 0, 0,
+1072, 0.525003, 0.458333, 0, 0,
+1073, 0.550003, 0.694445, 0, 0,
+1074, 0.525003, 0.458333, 0, 0,
+1075, 0.433336, 0.458333, 0, 0.015279,
+1076, 0.636114, 0.458333, 0.162038, 0,
+1077, 0.511114, 0.458333, 0, 0,
+1078, 0.80556, 0.458333, 0, 0,
+1079, 0.488892, 0.458333, 0, 0.006111,
+1080, 0.59167, 0.458333, 0, 0,
+1081, 0.59167, 0.6666155, 0, 0,
+1082, 0.530559, 0.458333, 0, 0,
+1083, 0.598615, 0.458333, 0, 0,
+1084, 0.744449, 0.458333, 0, 0,
+1085, 0.561114, 0.458333, 0, 0,
+1086, 0.550003, 0.458333, 0, 0,
+1087, 0.561114, 0.458333, 0, 0,
+1088, 0.561114, 0.458333, 0.194445, 0,
+1089, 0.488892, 0.458333, 0, 0,
+1090, 0.488892, 0.458333, 0, 0.02139,
+1091, 0.500003, 0.458333, 0.194445, 0.015279,
+1092, 0.836118, 0.694445, 0.194445, 0,
+1093, 0.500003, 0.458333, 0, 0,
+1094, 0.62917, 0.458333, 0.162038, 0,
+1095, 0.59167, 0.458333, 0, 0,
+1096, 0.836116, 0.458333, 0, 0,
+1097, 0.873616, 0.458333, 0.162038, 0,
+1098, 0.64167, 0.458333, 0, 0,
+1099, 0.744449, 0.458333, 0, 0,
+1100, 0.525003, 0.458333, 0, 0,
+1101, 0.488892, 0.458333, 0, 0,
+1102, 0.800005, 0.458333, 0, 0,
+1103, 0.555559, 0.458333, 0, 0,
+1105, 0.511114, 0.694445, 0, 0,
+1106, 0.530559, 0.694445, 0.194445, 0,
+1108, 0.48278, 0.458333, 0, 0,
+1109, 0.421669, 0.458333, 0, 0,
+1110, 0.255557, 0.694445, 0, 0,
+1112, 0.286113, 0.694445, 0.194445, 0,
+1113, 0.852783, 0.458333, 0, 0,
+1114, 0.845839, 0.458333, 0, 0,
+1115, 0.561114, 0.694445, 0, 0,
+1119, 0.59167, 0.458333, 0.162038, 0,
+1122, 0.85556, 0.75, 0, 0,
+1123, 0.550003, 0.6666155, 0, 0,
+1138, 0.85556, 0.694445, 0, 0,
+1139, 0.550003, 0.458333, 0, 0,
+1140, 0.794449, 0.694445, 0, 0.015279,
+1141, 0.562503, 0.458333, 0, 0.015279
+METRICS_END
+
+LIGTURES_START
+1044, 1032, 1026,
+1044, 1112, 1026,
+1047, 1061, 1046,
+1047, 1093, 1046,
+1050, 1061, 1061,
+1050, 1093, 1061,
+1051, 1032, 1033,
+1051, 1112, 1033,
+1053, 1032, 1034,
+1053, 1112, 1034,
+1057, 1061, 1064,
+1057, 1093, 1064,
+1058, 1057, 1062,
+1058, 1089, 1062,
+1062, 1061, 1063,
+1062, 1093, 1063,
+1064, 1062, 0,
+1064, 1063, 1065,
+1064, 1094, 0,
+1064, 1095, 1065,
+1067, 1040, 1071,
+1067, 1059, 1070,
+1067, 1072, 1071,
+1067, 1091, 1070,
+1076, 1112, 1106,
+1079, 1093, 1078,
+1082, 1093, 1093,
+1083, 1112, 1113,
+1085, 1112, 1114,
+1089, 1093, 1096,
+1090, 1089, 1094,
+1094, 1093, 1095,
+1096, 1094, 0,
+1096, 1095, 1097,
+1099, 1072, 1103,
+1099, 1091, 1102
+LIGTURES_END
+
+KERNS_START
+1026, 1026, -0.091667,
+1026, 1028, -0.030556,
+1026, 1035, -0.091667,
+1026, 1046, -0.030556,
+1026, 1054, -0.030556,
+1026, 1057, -0.030556,
+1026, 1058, -0.091667,
+1026, 1059, -0.030556,
+1026, 1060, -0.030556,
+1026, 1061, -0.030556,
+1026, 1063, -0.091667,
+1026, 1066, -0.091667,
+1026, 1090, -0.030556,
+1026, 1095, -0.091667,
+1026, 1098, -0.030556,
+1026, 1122, -0.091667,
+1026, 1123, -0.030556,
+1026, 1138, -0.030556,
+1026, 1140, -0.091667,
+1030, 1030, 0.030556,
+1033, 1026, -0.091667,
+1033, 1028, -0.030556,
+1033, 1035, -0.091667,
+1033, 1046, -0.030556,
+1033, 1054, -0.030556,
+1033, 1057, -0.030556,
+1033, 1058, -0.091667,
+1033, 1059, -0.030556,
+1033, 1060, -0.030556,
+1033, 1061, -0.030556,
+1033, 1063, -0.091667,
+1033, 1066, -0.091667,
+1033, 1090, -0.030556,
+1033, 1095, -0.091667,
+1033, 1098, -0.030556,
+1033, 1122, -0.091667,
+1033, 1123, -0.030556,
+1033, 1138, -0.030556,
+1033, 1140, -0.091667,
+1034, 1026, -0.091667,
+1034, 1028, -0.030556,
+1034, 1035, -0.091667,
+1034, 1046, -0.030556,
+1034, 1054, -0.030556,
+1034, 1057, -0.030556,
+1034, 1058, -0.091667,
+1034, 1059, -0.030556,
+1034, 1060, -0.030556,
+1034, 1061, -0.030556,
+1034, 1063, -0.091667,
+1034, 1066, -0.091667,
+1034, 1090, -0.030556,
+1034, 1095, -0.091667,
+1034, 1098, -0.030556,
+1034, 1122, -0.091667,
+1034, 1123, -0.030556,
+1034, 1138, -0.030556,
+1034, 1140, -0.091667,
+1040, 1026, -0.091667,
+1040, 1028, -0.030556,
+1040, 1035, -0.091667,
+1040, 1054, -0.030556,
+1040, 1057, -0.030556,
+1040, 1058, -0.091667,
+1040, 1059, -0.030556,
+1040, 1060, -0.030556,
+1040, 1063, -0.091667,
+1040, 1066, -0.091667,
+1040, 1090, -0.030556,
+1040, 1095, -0.091667,
+1040, 1098, -0.030556,
+1040, 1122, -0.091667,
+1040, 1123, -0.030556,
+1040, 1138, -0.030556,
+1040, 1140, -0.091667,
+1043, 1033, -0.061111,
+1043, 1040, -0.091667,
+1043, 1044, -0.091667,
+1043, 1051, -0.061111,
+1043, 1072, -0.091667,
+1043, 1076, -0.091667,
+1043, 1077, -0.091667,
+1043, 1083, -0.091667,
+1043, 1086, -0.091667,
+1043, 1089, -0.091667,
+1043, 1092, -0.091667,
+1043, 1103, -0.091667,
+1043, 1105, -0.091667,
+1043, 1108, -0.091667,
+1043, 1113, -0.091667,
+1043, 1139, -0.091667,
+1046, 1028, -0.030556,
+1046, 1054, -0.030556,
+1046, 1057, -0.030556,
+1046, 1060, -0.030556,
+1046, 1090, -0.030556,
+1046, 1095, -0.030556,
+1046, 1098, -0.030556,
+1046, 1123, -0.030556,
+1046, 1138, -0.030556,
+1050, 1028, -0.030556,
+1050, 1054, -0.030556,
+1050, 1057, -0.030556,
+1050, 1060, -0.030556,
+1050, 1090, -0.030556,
+1050, 1095, -0.030556,
+1050, 1098, -0.030556,
+1050, 1123, -0.030556,
+1050, 1138, -0.030556,
+1054, 1040, -0.030556,
+1054, 1044, -0.030556,
+1054, 1046, -0.030556,
+1054, 1059, -0.030556,
+1054, 1061, -0.030556,
+1054, 1140, -0.030556,
+1056, 1033, -0.091667,
+1056, 1040, -0.091667,
+1056, 1044, -0.091667,
+1056, 1051, -0.091667,
+1056, 1072, -0.030556,
+1056, 1076, -0.091667,
+1056, 1077, -0.030556,
+1056, 1083, -0.091667,
+1056, 1086, -0.030556,
+1056, 1105, -0.030556,
+1056, 1113, -0.091667,
+1056, 1139, -0.030556,
+1058, 1033, -0.061111,
+1058, 1040, -0.091667,
+1058, 1044, -0.091667,
+1058, 1051, -0.061111,
+1058, 1072, -0.091667,
+1058, 1076, -0.091667,
+1058, 1077, -0.091667,
+1058, 1083, -0.091667,
+1058, 1086, -0.091667,
+1058, 1089, -0.091667,
+1058, 1092, -0.091667,
+1058, 1103, -0.091667,
+1058, 1105, -0.091667,
+1058, 1108, -0.091667,
+1058, 1113, -0.091667,
+1058, 1139, -0.091667,
+1059, 1028, -0.030556,
+1059, 1033, -0.061111,
+1059, 1040, -0.030556,
+1059, 1044, -0.061111,
+1059, 1051, -0.061111,
+1059, 1054, -0.030556,
+1059, 1057, -0.030556,
+1059, 1060, -0.030556,
+1059, 1072, -0.030556,
+1059, 1076, -0.091667,
+1059, 1077, -0.030556,
+1059, 1083, -0.091667,
+1059, 1086, -0.030556,
+1059, 1089, -0.030556,
+1059, 1103, -0.091667,
+1059, 1105, -0.030556,
+1059, 1108, -0.030556,
+1059, 1113, -0.091667,
+1059, 1138, -0.030556,
+1059, 1139, -0.030556,
+1060, 1040, -0.030556,
+1060, 1044, -0.030556,
+1060, 1046, -0.030556,
+1060, 1059, -0.030556,
+1060, 1061, -0.030556,
+1060, 1140, -0.030556,
+1061, 1028, -0.030556,
+1061, 1054, -0.030556,
+1061, 1057, -0.030556,
+1061, 1060, -0.030556,
+1061, 1090, -0.030556,
+1061, 1095, -0.030556,
+1061, 1098, -0.030556,
+1061, 1123, -0.030556,
+1061, 1138, -0.030556,
+1066, 1026, -0.091667,
+1066, 1028, -0.030556,
+1066, 1035, -0.091667,
+1066, 1046, -0.030556,
+1066, 1054, -0.030556,
+1066, 1057, -0.030556,
+1066, 1058, -0.091667,
+1066, 1059, -0.030556,
+1066, 1060, -0.030556,
+1066, 1061, -0.030556,
+1066, 1063, -0.091667,
+1066, 1066, -0.091667,
+1066, 1090, -0.030556,
+1066, 1095, -0.091667,
+1066, 1098, -0.030556,
+1066, 1122, -0.091667,
+1066, 1123, -0.030556,
+1066, 1138, -0.030556,
+1066, 1140, -0.091667,
+1068, 1026, -0.091667,
+1068, 1028, -0.030556,
+1068, 1035, -0.091667,
+1068, 1046, -0.030556,
+1068, 1054, -0.030556,
+1068, 1057, -0.030556,
+1068, 1058, -0.091667,
+1068, 1059, -0.030556,
+1068, 1060, -0.030556,
+1068, 1061, -0.030556,
+1068, 1063, -0.091667,
+1068, 1066, -0.091667,
+1068, 1090, -0.030556,
+1068, 1095, -0.091667,
+1068, 1098, -0.030556,
+1068, 1122, -0.091667,
+1068, 1123, -0.030556,
+1068, 1138, -0.030556,
+1068, 1140, -0.091667,
+1069, 1040, -0.030556,
+1069, 1044, -0.030556,
+1069, 1046, -0.030556,
+1069, 1059, -0.030556,
+1069, 1061, -0.030556,
+1069, 1140, -0.030556,
+1070, 1040, -0.030556,
+1070, 1044, -0.030556,
+1070, 1046, -0.030556,
+1070, 1059, -0.030556,
+1070, 1061, -0.030556,
+1070, 1140, -0.030556,
+1072, 1091, -0.030556,
+1072, 1095, -0.030556,
+1073, 1076, -0.030556,
+1073, 1078, -0.030556,
+1073, 1093, -0.030556,
+1073, 1103, -0.030556,
+1075, 1076, -0.030556,
+1075, 1083, -0.030556,
+1075, 1103, -0.030556,
+1075, 1113, -0.030556,
+1078, 1072, -0.030556,
+1078, 1077, -0.030556,
+1078, 1086, -0.030556,
+1078, 1089, -0.030556,
+1078, 1105, -0.030556,
+1078, 1108, -0.030556,
+1078, 1139, -0.030556,
+1082, 1072, -0.030556,
+1082, 1077, -0.030556,
+1082, 1086, -0.030556,
+1082, 1089, -0.030556,
+1082, 1105, -0.030556,
+1082, 1108, -0.030556,
+1082, 1139, -0.030556,
+1086, 1076, -0.030556,
+1086, 1078, -0.030556,
+1086, 1093, -0.030556,
+1086, 1103, -0.030556,
+1088, 1076, -0.030556,
+1088, 1078, -0.030556,
+1088, 1093, -0.030556,
+1088, 1103, -0.030556,
+1089, 1076, -0.030556,
+1089, 1078, -0.030556,
+1089, 1093, -0.030556,
+1089, 1103, -0.030556,
+1090, 1076, -0.030556,
+1090, 1083, -0.030556,
+1090, 1103, -0.030556,
+1090, 1113, -0.030556,
+1091, 1072, -0.030556,
+1091, 1076, -0.061111,
+1091, 1077, -0.030556,
+1091, 1083, -0.061111,
+1091, 1086, -0.030556,
+1091, 1089, -0.030556,
+1091, 1103, -0.030556,
+1091, 1105, -0.030556,
+1091, 1108, -0.030556,
+1091, 1113, -0.061111,
+1091, 1139, -0.030556,
+1092, 1076, -0.030556,
+1092, 1078, -0.030556,
+1092, 1093, -0.030556,
+1092, 1103, -0.030556,
+1093, 1072, -0.030556,
+1093, 1077, -0.030556,
+1093, 1086, -0.030556,
+1093, 1089, -0.030556,
+1093, 1105, -0.030556,
+1093, 1108, -0.030556,
+1093, 1139, -0.030556,
+1098, 1086, -0.030556,
+1098, 1090, -0.030556,
+1098, 1091, -0.061111,
+1098, 1092, -0.030556,
+1098, 1095, -0.091667,
+1098, 1098, -0.030556,
+1098, 1108, -0.030556,
+1098, 1123, -0.030556,
+1098, 1139, -0.030556,
+1098, 1141, -0.061111,
+1100, 1086, -0.030556,
+1100, 1090, -0.030556,
+1100, 1091, -0.061111,
+1100, 1092, -0.030556,
+1100, 1095, -0.091667,
+1100, 1098, -0.030556,
+1100, 1108, -0.030556,
+1100, 1123, -0.030556,
+1100, 1139, -0.030556,
+1100, 1141, -0.061111,
+1101, 1076, -0.030556,
+1101, 1078, -0.030556,
+1101, 1093, -0.030556,
+1101, 1103, -0.030556,
+1102, 1076, -0.030556,
+1102, 1078, -0.030556,
+1102, 1093, -0.030556,
+1102, 1103, -0.030556,
+1113, 1086, -0.030556,
+1113, 1090, -0.030556,
+1113, 1091, -0.061111,
+1113, 1092, -0.030556,
+1113, 1095, -0.091667,
+1113, 1098, -0.030556,
+1113, 1108, -0.030556,
+1113, 1123, -0.030556,
+1113, 1139, -0.030556,
+1113, 1141, -0.061111,
+1114, 1086, -0.030556,
+1114, 1090, -0.030556,
+1114, 1091, -0.061111,
+1114, 1092, -0.030556,
+1114, 1095, -0.091667,
+1114, 1098, -0.030556,
+1114, 1108, -0.030556,
+1114, 1123, -0.030556,
+1114, 1139, -0.030556,
+1114, 1141, -0.061111,
+1122, 1026, -0.091667,
+1122, 1028, -0.030556,
+1122, 1035, -0.091667,
+1122, 1046, -0.030556,
+1122, 1054, -0.030556,
+1122, 1057, -0.030556,
+1122, 1058, -0.091667,
+1122, 1059, -0.030556,
+1122, 1060, -0.030556,
+1122, 1061, -0.030556,
+1122, 1063, -0.091667,
+1122, 1066, -0.091667,
+1122, 1090, -0.030556,
+1122, 1095, -0.091667,
+1122, 1098, -0.030556,
+1122, 1122, -0.091667,
+1122, 1123, -0.030556,
+1122, 1138, -0.030556,
+1122, 1140, -0.091667,
+1123, 1086, -0.030556,
+1123, 1090, -0.030556,
+1123, 1091, -0.061111,
+1123, 1092, -0.030556,
+1123, 1095, -0.091667,
+1123, 1098, -0.030556,
+1123, 1108, -0.030556,
+1123, 1123, -0.030556,
+1123, 1139, -0.030556,
+1123, 1141, -0.061111,
+1138, 1040, -0.030556,
+1138, 1044, -0.030556,
+1138, 1046, -0.030556,
+1138, 1059, -0.030556,
+1138, 1061, -0.030556,
+1138, 1140, -0.030556,
+1139, 1076, -0.030556,
+1139, 1078, -0.030556,
+1139, 1093, -0.030556,
+1139, 1103, -0.030556,
+1140, 1028, -0.030556,
+1140, 1033, -0.061111,
+1140, 1040, -0.091667,
+1140, 1044, -0.061111,
+1140, 1051, -0.061111,
+1140, 1054, -0.030556,
+1140, 1057, -0.030556,
+1140, 1060, -0.030556,
+1140, 1072, -0.030556,
+1140, 1076, -0.091667,
+1140, 1077, -0.030556,
+1140, 1083, -0.091667,
+1140, 1086, -0.030556,
+1140, 1103, -0.091667,
+1140, 1105, -0.030556,
+1140, 1113, -0.091667,
+1140, 1138, -0.030556,
+1140, 1139, -0.030556,
+1141, 1072, -0.030556,
+1141, 1076, -0.061111,
+1141, 1077, -0.030556,
+1141, 1083, -0.061111,
+1141, 1086, -0.030556,
+1141, 1089, -0.030556,
+1141, 1103, -0.030556,
+1141, 1105, -0.030556,
+1141, 1108, -0.030556,
+1141, 1113, -0.061111,
+1141, 1139, -0.030556
+KERNS_END
+
+END
@@ -0,0 +1,557 @@
+// Generated by prebuilt/alphabet_def.py from res/cyrillic/wnssi10.xml, do not edit
+
+#include "res/font_def.res.h"
+
+DEF_FONT(wnssi10, cyrillic/wnssi10.ttf, 95)
+
+xHeight(0.444445) quad(1.000003) space(0.333334)
+
+roman(wnti10) bold(wnssbx10) tt(wntt10)
+
+METRICS_START
+171, 0.666669, 0.438889, 0, 0.02018,
+187, 0.666669, 0.438889, 0, 0,
+305, 0.23889, 0.444445, 0, 0.04169,
+774, 0.500002, 0.652727, 0, 0.085962,
+776, 0.500002, 0.660319, 0, 0.059799,
+1025, 0.597224, 0.902727, 0, 0.119829,
+1026, 0.8194475, 0.694445, 0, 0.1337185,
+1028, 0.638891, 0.694445, 0, 0.119829,
+1029, 0.555557, 0.694445, 0, 0.0920515,
+1030, 0.277781, 0.694445, 0, 0.1337185,
+1032, 0.472224, 0.694445, 0, 0.080938,
+1033, 1.037504, 0.694445, 0, 0.02595,
+1034, 1.020838, 0.694445, 0, 0.02595,
+1035, 0.763891, 0.694445, 0, 0.0920515,
+1039, 0.694448, 0.694445, 0.194445, 0.080938,
+1040, 0.66667, 0.694445, 0, 0,
+1041, 0.66667, 0.694445, 0, 0.064273,
+1042, 0.66667, 0.694445, 0, 0.05515,
+1043, 0.541669, 0.694445, 0, 0.1337185,
+1044, 0.727783, 0.694445, 0.194445, 0.080938,
+1045, 0.597224, 0.694445, 0, 0.119829,
+1046, 1.111117, 0.694445, 0, 0.119829,
+1047, 0.611113, 0.694445, 0, 0.082927,
+1048, 0.694448, 0.694445, 0, 0.080938,
+1049, 0.694448, 0.902727, 0, 0.080938,
+1050, 0.694448, 0.694445, 0, 0.119829,
+1051, 0.711116, 0.694445, 0, 0.080938,
+1052, 0.875005, 0.694445, 0, 0.080938,
+1053, 0.694448, 0.694445, 0, 0.080938,
+1054, 0.736113, 0.694445, 0, 0.075546,
+1055, 0.694448, 0.694445, 0, 0.080938,
+1056, 0.638891, 0.694445, 0, 0.082927,
+1057, 0.638891, 0.694445, 0, 0.119829,
+1058, 0.680557, 0.694445, 0, 0.1337185,
+1059, 0.66667, 0.694445, 0, 0.161496,
+1060, 0.833336, 0.694445, 0, 0.075546,
+1061, 0.66667, 0.694445, 0, 0.1337185,
+1062, 0.711116, 0.694445, 0.194445, 0.080938,
+1063, 0.694448, 0.694445, 0, 0.080938,
+1064, 1.083339, 0.694445, 0, 0.080938,
+1065, 1.100006, 0.694445, 0.194445, 0.080938,
+1066, 0.868059, 0.694445, 0, 0.02595,
+1067, 0.888895, 0.694445, 0, 0.080938,
+1068, 0.66667, 0.694445, 0, 0.02595,
+1069, 0.638891, 0.694445, 0, 0.075546,
+1070, 1.04167, 0.694445, 0, 0.075546,
+1071, 0.645836, 0.694445, 0, 0.080938,
+1072, 0.480557, 0.444445, 0, 0.009807,
+1073, 0.500002, 0.694445, 0, 0.094829,
+1074, 0.480557, 0.444445, 0, 0.0389,
+1075, 0.404167, 0.444445, 0, 0.108357,
+1076, 0.538892, 0.444445, 0.162038, 0.04169,
+1077, 0.444446, 0.444445, 0, 0.067778,
+1078, 0.7388935, 0.444445, 0, 0.083357,
+1079, 0.444446, 0.444445, 0, 0.050013,
+1080, 0.537503, 0.444445, 0, 0.04169,
+1081, 0.537503, 0.652727, 0, 0.04169,
+1082, 0.488892, 0.444445, 0, 0.083357,
+1083, 0.527781, 0.444445, 0, 0.04169,
+1084, 0.669447, 0.444445, 0, 0.04169,
+1085, 0.516668, 0.444445, 0, 0.04169,
+1086, 0.500002, 0.444445, 0, 0.066129,
+1087, 0.516668, 0.444445, 0, 0.04169,
+1088, 0.516668, 0.444445, 0.194445, 0.0389,
+1089, 0.444446, 0.444445, 0, 0.083357,
+1090, 0.458334, 0.444445, 0, 0.113913,
+1091, 0.461113, 0.444445, 0.194445, 0.108357,
+1092, 0.76667, 0.694445, 0.194445, 0.0389,
+1093, 0.461113, 0.444445, 0, 0.09169,
+1094, 0.5486145, 0.444445, 0.162038, 0.04169,
+1095, 0.537503, 0.444445, 0, 0.04169,
+1096, 0.76667, 0.444445, 0, 0.04169,
+1097, 0.7777815, 0.444445, 0.162038, 0.04169,
+1098, 0.590279, 0.444445, 0, 0.0389,
+1099, 0.683336, 0.444445, 0, 0.04169,
+1100, 0.480557, 0.444445, 0, 0.0389,
+1101, 0.444446, 0.444445, 0, 0.060573,
+1102, 0.730558, 0.444445, 0, 0.066129,
+1103, 0.515279, 0.444445, 0, 0.04169,
+1105, 0.444446, 0.660319, 0, 0.067778,
+1106, 0.488892, 0.694445, 0.194445, 0.066129,
+1108, 0.43889, 0.444445, 0, 0.083357,
+1109, 0.383334, 0.444445, 0, 0.077802,
+1110, 0.23889, 0.679365, 0, 0.09718,
+1112, 0.266668, 0.679365, 0.194445, 0.091624,
+1113, 0.755559, 0.444445, 0, 0.0389,
+1114, 0.765282, 0.444445, 0, 0.0389,
+1115, 0.516668, 0.694445, 0, 0.017778,
+1119, 0.537503, 0.444445, 0.162038, 0.04169,
+1122, 0.7777815, 0.75, 0, 0.082927,
+1123, 0.500002, 0.652727, 0, 0.030568,
+1138, 0.777781, 0.694445, 0, 0.075546,
+1139, 0.500002, 0.444445, 0, 0.03835,
+1140, 0.722226, 0.694445, 0, 0.161496,
+1141, 0.491667, 0.444445, 0, 0.108357
+METRICS_END
+
+LIGTURES_START
+1044, 1032, 1026,
+1044, 1112, 1026,
+1047, 1061, 1046,
+1047, 1093, 1046,
+1050, 1061, 1061,
+1050, 1093, 1061,
+1051, 1032, 1033,
+1051, 1112, 1033,
+1053, 1032, 1034,
+1053, 1112, 1034,
+1057, 1061, 1064,
+1057, 1093, 1064,
+1058, 1057, 1062,
+1058, 1089, 1062,
+1062, 1061, 1063,
+1062, 1093, 1063,
+1064, 1062, 0,
+1064, 1063, 1065,
+1064, 1094, 0,
+1064, 1095, 1065,
+1067, 1040, 1071,
+1067, 1059, 1070,
+1067, 1072, 1071,
+1067, 1091, 1070,
+1076, 1112, 1106,
+1079, 1093, 1078,
+1082, 1093, 1093,
+1083, 1112, 1113,
+1085, 1112, 1114,
+1089, 1093, 1096,
+1090, 1089, 1094,
+1094, 1093, 1095,
+1096, 1094, 0,
+1096, 1095, 1097,
+1099, 1072, 1103,
+1099, 1091, 1102
+LIGTURES_END
+
+KERNS_START
+1026, 1026, -0.083334,
+1026, 1028, -0.027779,
+1026, 1035, -0.083334,
+1026, 1046, -0.027779,
+1026, 1054, -0.027779,
+1026, 1057, -0.027779,
+1026, 1058, -0.083334,
+1026, 1059, -0.027779,
+1026, 1060, -0.027779,
+1026, 1061, -0.027779,
+1026, 1063, -0.083334,
+1026, 1066, -0.083334,
+1026, 1090, -0.027779,
+1026, 1095, -0.083334,
+1026, 1098, -0.027779,
+1026, 1122, -0.083334,
+1026, 1123, -0.027779,
+1026, 1138, -0.027779,
+1026, 1140, -0.083334,
+1030, 1030, 0.027779,
+1033, 1026, -0.083334,
+1033, 1028, -0.027779,
+1033, 1035, -0.083334,
+1033, 1046, -0.027779,
+1033, 1054, -0.027779,
+1033, 1057, -0.027779,
+1033, 1058, -0.083334,
+1033, 1059, -0.027779,
+1033, 1060, -0.027779,
+1033, 1061, -0.027779,
+1033, 1063, -0.083334,
+1033, 1066, -0.083334,
+1033, 1090, -0.027779,
+1033, 1095, -0.083334,
+1033, 1098, -0.027779,
+1033, 1122, -0.083334,
+1033, 1123, -0.027779,
+1033, 1138, -0.027779,
+1033, 1140, -0.083334,
+1034, 1026, -0.083334,
+1034, 1028, -0.027779,
+1034, 1035, -0.083334,
+1034, 1046, -0.027779,
+1034, 1054, -0.027779,
+1034, 1057, -0.027779,
+1034, 1058, -0.083334,
+1034, 1059, -0.027779,
+1034, 1060, -0.027779,
+1034, 1061, -0.027779,
+1034, 1063, -0.083334,
+1034, 1066, -0.083334,
+1034, 1090, -0.027779,
+1034, 1095, -0.083334,
+1034, 1098, -0.027779,
+1034, 1122, -0.083334,
+1034, 1123, -0.027779,
+1034, 1138, -0.027779,
+1034, 1140, -0.083334,
+1040, 1026, -0.083334,
+1040, 1028, -0.027779,
+1040, 1035, -0.083334,
+1040, 1054, -0.027779,
+1040, 1057, -0.027779,
+1040, 1058, -0.083334,
+1040, 1059, -0.027779,
+1040, 1060, -0.027779,
+1040, 1063, -0.083334,
+1040, 1066, -0.083334,
+1040, 1090, -0.027779,
+1040, 1095, -0.083334,
+1040, 1098, -0.027779,
+1040, 1122, -0.083334,
+1040, 1123, -0.027779,
+1040, 1138, -0.027779,
+1040, 1140, -0.083334,
+1043, 1033, -0.055555,
+1043, 1040, -0.083334,
+1043, 1044, -0.083334,
+1043, 1051, -0.055555,
+1043, 1072, -0.083334,
+1043, 1076, -0.083334,
+1043, 1077, -0.083334,
+1043, 1083, -0.083334,
+1043, 1086, -0.083334,
+1043, 1089, -0.083334,
+1043, 1092, -0.083334,
+1043, 1103, -0.083334,
+1043, 1105, -0.083334,
+1043, 1108, -0.083334,
+1043, 1113, -0.083334,
+1043, 1139, -0.083334,
+1046, 1028, -0.027779,
+1046, 1054, -0.027779,
+1046, 1057, -0.027779,
+1046, 1060, -0.027779,
+1046, 1090, -0.027779,
+1046, 1095, -0.027779,
+1046, 1098, -0.027779,
+1046, 1123, -0.027779,
+1046, 1138, -0.027779,
+1050, 1028, -0.027779,
+1050, 1054, -0.027779,
+1050, 1057, -0.027779,
+1050, 1060, -0.027779,
+1050, 1090, -0.027779,
+1050, 1095, -0.027779,
+1050, 1098, -0.027779,
+1050, 1123, -0.027779,
+1050, 1138, -0.027779,
+1054, 1040, -0.027779,
+1054, 1044, -0.027779,
+1054, 1046, -0.027779,
+1054, 1059, -0.027779,
+1054, 1061, -0.027779,
+1054, 1140, -0.027779,
+1056, 1033, -0.083334,
+1056, 1040, -0.083334,
+1056, 1044, -0.083334,
+1056, 1051, -0.083334,
+1056, 1072, -0.027779,
+1056, 1076, -0.083334,
+1056, 1077, -0.027779,
+1056, 1083, -0.083334,
+1056, 1086, -0.027779,
+1056, 1105, -0.027779,
+1056, 1113, -0.083334,
+1056, 1139, -0.027779,
+1058, 1033, -0.055555,
+1058, 1040, -0.083334,
+1058, 1044, -0.083334,
+1058, 1051, -0.055555,
+1058, 1072, -0.083334,
+1058, 1076, -0.083334,
+1058, 1077, -0.083334,
+1058, 1083, -0.083334,
+1058, 1086, -0.083334,
+1058, 1089, -0.083334,
+1058, 1092, -0.083334,
+1058, 1103, -0.083334,
+1058, 1105, -0.083334,
+1058, 1108, -0.083334,
+1058, 1113, -0.083334,
+1058, 1139, -0.083334,
+1059, 1028, -0.027779,
+1059, 1033, -0.055555,
+1059, 1040, -0.027779,
+1059, 1044, -0.055555,
+1059, 1051, -0.055555,
+1059, 1054, -0.027779,
+1059, 1057, -0.027779,
+1059, 1060, -0.027779,
+1059, 1072, -0.027779,
+1059, 1076, -0.083334,
+1059, 1077, -0.027779,
+1059, 1083, -0.083334,
+1059, 1086, -0.027779,
+1059, 1089, -0.027779,
+1059, 1103, -0.083334,
+1059, 1105, -0.027779,
+1059, 1108, -0.027779,
+1059, 1113, -0.083334,
+1059, 1138, -0.027779,
+1059, 1139, -0.027779,
+1060, 1040, -0.027779,
+1060, 1044, -0.027779,
+1060, 1046, -0.027779,
+1060, 1059, -0.027779,
+1060, 1061, -0.027779,
+1060, 1140, -0.027779,
+1061, 1028, -0.027779,
+1061, 1054, -0.027779,
+1061, 1057, -0.027779,
+1061, 1060, -0.027779,
+1061, 1090, -0.027779,
+1061, 1095, -0.027779,
+1061, 1098, -0.027779,
+1061, 1123, -0.027779,
+1061, 1138, -0.027779,
+1066, 1026, -0.083334,
+1066, 1028, -0.027779,
+1066, 1035, -0.083334,
+1066, 1046, -0.027779,
+1066, 1054, -0.027779,
+1066, 1057, -0.027779,
+1066, 1058, -0.083334,
+1066, 1059, -0.027779,
+1066, 1060, -0.027779,
+1066, 1061, -0.027779,
+1066, 1063, -0.083334,
+1066, 1066, -0.083334,
+1066, 1090, -0.027779,
+1066, 1095, -0.083334,
+1066, 1098, -0.027779,
+1066, 1122, -0.083334,
+1066, 1123, -0.027779,
+1066, 1138, -0.027779,
+1066, 1140, -0.083334,
+1068, 1026, -0.083334,
+1068, 1028, -0.027779,
+1068, 1035, -0.083334,
+1068, 1046, -0.027779,
+1068, 1054, -0.027779,
+1068, 1057, -0.027779,
+1068, 1058, -0.083334,
+1068, 1059, -0.027779,
+1068, 1060, -0.027779,
+1068, 1061, -0.027779,
+1068, 1063, -0.083334,
+1068, 1066, -0.083334,
+1068, 1090, -0.027779,
+1068, 1095, -0.083334,
+1068, 1098, -0.027779,
+1068, 1122, -0.083334,
+1068, 1123, -0.027779,
+1068, 1138, -0.027779,
+1068, 1140, -0.083334,
+1069, 1040, -0.027779,
+1069, 1044, -0.027779,
+1069, 1046, -0.027779,
+1069, 1059, -0.027779,
+1069, 1061, -0.027779,
+1069, 1140, -0.027779,
+1070, 1040, -0.027779,
+1070, 1044, -0.027779,
+1070, 1046, -0.027779,
+1070, 1059, -0.027779,
+1070, 1061, -0.027779,
+1070, 1140, -0.027779,
+1072, 1091, -0.027779,
+1072, 1095, -0.027779,
+1073, 1076, -0.027779,
+1073, 1078, -0.027779,
+1073, 1093, -0.027779,
+1073, 1103, -0.027779,
+1075, 1076, -0.027779,
+1075, 1083, -0.027779,
+1075, 1103, -0.027779,
+1075, 1113, -0.027779,
+1078, 1072, -0.027779,
+1078, 1077, -0.027779,
+1078, 1086, -0.027779,
+1078, 1089, -0.027779,
+1078, 1105, -0.027779,
+1078, 1108, -0.027779,
+1078, 1139, -0.027779,
+1082, 1072, -0.027779,
+1082, 1077, -0.027779,
+1082, 1086, -0.027779,
+1082, 1089, -0.027779,
+1082, 1105, -0.027779,
+1082, 1108, -0.027779,
+1082, 1139, -0.027779,
+1086, 1076, -0.027779,
+1086, 1078, -0.027779,
+1086, 1093, -0.027779,
+1086, 1103, -0.027779,
+1088, 1076, -0.027779,
+1088, 1078, -0.027779,
+1088, 1093, -0.027779,
+1088, 1103, -0.027779,
+1089, 1076, -0.027779,
+1089, 1078, -0.027779,
+1089, 1093, -0.027779,
+1089, 1103, -0.027779,
+1090, 1076, -0.027779,
+1090, 1083, -0.027779,
+1090, 1103, -0.027779,
+1090, 1113, -0.027779,
+1091, 1072, -0.027779,
+1091, 1076, -0.055555,
+1091, 1077, -0.027779,
+1091, 1083, -0.055555,
+1091, 1086, -0.027779,
+1091, 1089, -0.027779,
+1091, 1103, -0.027779,
+1091, 1105, -0.027779,
+1091, 1108, -0.027779,
+1091, 1113, -0.055555,
+1091, 1139, -0.027779,
+1092, 1076, -0.027779,
+1092, 1078, -0.027779,
+1092, 1093, -0.027779,
+1092, 1103, -0.027779,
+1093, 1072, -0.027779,
+1093, 1077, -0.027779,
+1093, 1086, -0.027779,
+1093, 1089, -0.027779,
+1093, 1105, -0.027779,
+1093, 1108, -0.027779,
+1093, 1139, -0.027779,
+1098, 1086, -0.027779,
+1098, 1090, -0.027779,
+1098, 1091, -0.055555,
+1098, 1092, -0.027779,
+1098, 1095, -0.083334,
+1098, 1098, -0.027779,
+1098, 1108, -0.027779,
+1098, 1123, -0.027779,
+1098, 1139, -0.027779,
+1098, 1141, -0.055555,
+1100, 1086, -0.027779,
+1100, 1090, -0.027779,
+1100, 1091, -0.055555,
+1100, 1092, -0.027779,
+1100, 1095, -0.083334,
+1100, 1098, -0.027779,
+1100, 1108, -0.027779,
+1100, 1123, -0.027779,
+1100, 1139, -0.027779,
+1100, 1141, -0.055555,
+1101, 1076, -0.027779,
+1101, 1078, -0.027779,
+1101, 1093, -0.027779,
+1101, 1103, -0.027779,
+1102, 1076, -0.027779,
+1102, 1078, -0.027779,
+1102, 1093, -0.027779,
+1102, 1103, -0.027779,
+1113, 1086, -0.027779,
+1113, 1090, -0.027779,
+1113, 1091, -0.055555,
+1113, 1092, -0.027779,
+1113, 1095, -0.083334,
+1113, 1098, -0.027779,
+1113, 1108, -0.027779,
+1113, 1123, -0.027779,
+1113, 1139, -0.027779,
+1113, 1141, -0.055555,
+1114, 1086, -0.027779,
+1114, 1090, -0.027779,
+1114, 1091, -0.055555,
+1114, 1092, -0.027779,
+1114, 1095, -0.083334,
+1114, 1098, -0.027779,
+1114, 1108, -0.027779,
+1114, 1123, -0.027779,
+1114, 1139, -0.027779,
+1114, 1141, -0.055555,
+1122, 1026, -0.083334,
+1122, 1028, -0.027779,
+1122, 1035, -0.083334,
+1122, 1046, -0.027779,
+1122, 1054, -0.027779,
+1122, 1057, -0.027779,
+1122, 1058, -0.083334,
+1122, 1059, -0.027779,
+1122, 1060, -0.027779,
+1122, 1061, -0.027779,
+1122, 1063, -0.083334,
+1122, 1066, -0.083334,
+1122, 1090, -0.027779,
+1122, 1095, -0.083334,
+1122, 1098, -0.027779,
+1122, 1122, -0.083334,
+1122, 1123, -0.027779,
+1122, 1138, -0.027779,
+1122, 1140, -0.083334,
+1123, 1086, -0.027779,
+1123, 1090, -0.027779,
+1123, 1091, -0.055555,
+1123, 1092, -0.027779,
+1123, 1095, -0.083334,
+1123, 1098, -0.027779,
+1123, 1108, -0.027779,
+1123, 1123, -0.027779,
+1123, 1139, -0.027779,
+1123, 1141, -0.055555,
+1138, 1040, -0.027779,
+1138, 1044, -0.027779,
+1138, 1046, -0.027779,
+1138, 1059, -0.027779,
+1138, 1061, -0.027779,
+1138, 1140, -0.027779,
+1139, 1076, -0.027779,
+1139, 1078, -0.027779,
+1139, 1093, -0.027779,
+1139, 1103, -0.027779,
+1140, 1028, -0.027779,
+1140, 1033, -0.055555,
+1140, 1040, -0.083334,
+1140, 1044, -0.055555,
+1140, 1051, -0.055555,
+1140, 1054, -0.027779,
+1140, 1057, -0.027779,
+1140, 1060, -0.027779,
+1140, 1072, -0.027779,
+1140, 1076, -0.083334,
+1140, 1077, -0.027779,
+1140, 1083, -0.083334,
+1140, 1086, -0.027779,
+1140, 1103, -0.083334,
+1140, 1105, -0.027779,
+1140, 1113, -0.083334,
+1140, 1138, -0.027779,
+1140, 1139, -0.027779,
+1141, 1072, -0.027779,
+1141, 1076, -0.055555,
+1141, 1077, -0.027779,
+1141, 1083, -0.055555,
+1141, 1086, -0.027779,
+1141, 1089, -0.027779,
+1141, 1103, -0.027779,
+1141, 1105, -0.027779,
+1141, 1108, -0.027779,
+1141, 1113, -0.055555,
+1141, 1139, -0.027779
+KERNS_END
+
+END
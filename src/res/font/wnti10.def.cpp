@@ -0,0 +1,663 @@
+// Generated by prebuilt/alphabet_def.py from res/cyrillic/wnti10.xml, do not edit
+
+#include "res/font_def.res.h"
+
+DEF_FONT(wnti10, cyrillic/wnti10.ttf, 95)
+
+xHeight(0.430555) quad(1.022217) space(0.357776)
+
+roman(wnr10) bold(wnbxti10) ss(wnssi10) tt(wntt10)
+
+METRICS_START
+171, 0.56222, 0.483335, 0, 0.022985,
+187, 0.56222, 0.483335, 0, 0,
+305, 0.306665, 0.430555, 0, 0.076714,
+774, 0.511108, 0.638838, 0, 0.094154,
+776, 0.511108, 0.659131, 0, 0.102562,
+1025, 0.678329, 0.891615, 0, 0.120277,
+1026, 0.843328, 0.683332, 0, 0.133055,
+1028, 0.715551, 0.683332, 0, 0.145277,
+1029, 0.56222, 0.683332, 0, 0.119722,
+1030, 0.385553, 0.683332, 0, 0.158055,
+1032, 0.524997, 0.683332, 0, 0.140279,
+1033, 1.048883, 0.683332, 0, 0.036629,
+1034, 1.048883, 0.683332, 0, 0.036629,
+1035, 0.753885, 0.683332, 0, 0.094722,
+1039, 0.768885, 0.683332, 0.194445, 0.16389,
+1040, 0.743329, 0.683332, 0, 0,
+1041, 0.703885, 0.683332, 0, 0.069166,
+1042, 0.703885, 0.683332, 0, 0.077014,
+1043, 0.627218, 0.683332, 0, 0.133055,
+1044, 0.768885, 0.683332, 0.194445, 0.16389,
+1045, 0.678329, 0.683332, 0, 0.120277,
+1046, 1.152216, 0.683332, 0, 0.145277,
+1047, 0.61333, 0.683332, 0, 0.10257,
+1048, 0.768885, 0.683332, 0, 0.16389,
+1049, 0.768885, 0.891615, 0, 0.16389,
+1050, 0.768885, 0.683332, 0, 0.145277,
+1051, 0.768885, 0.683332, 0, 0.16389,
+1052, 0.896662, 0.683332, 0, 0.16389,
+1053, 0.768885, 0.683332, 0, 0.16389,
+1054, 0.766663, 0.683332, 0, 0.0940275,
+1055, 0.768885, 0.683332, 0, 0.16389,
+1056, 0.678329, 0.683332, 0, 0.10257,
+1057, 0.715551, 0.683332, 0, 0.145277,
+1058, 0.715551, 0.683332, 0, 0.133055,
+1059, 0.743329, 0.683332, 0, 0.183611,
+1060, 0.817774, 0.683332, 0, 0.0940275,
+1061, 0.743329, 0.683332, 0, 0.158055,
+1062, 0.768885, 0.683332, 0.194445, 0.16389,
+1063, 0.768885, 0.683332, 0, 0.16389,
+1064, 1.088327, 0.683332, 0, 0.16389,
+1065, 1.088327, 0.683332, 0.194445, 0.16389,
+1066, 0.868884, 0.683332, 0, 0.036629,
+1067, 0.947772, 0.683332, 0, 0.16389,
+1068, 0.703885, 0.683332, 0, 0.036629,
+1069, 0.715551, 0.683332, 0, 0.0940275,
+1070, 1.087216, 0.683332, 0, 0.0940275,
+1071, 0.768885, 0.683332, 0, 0.16389,
+1072, 0.493219, 0.430555, 0, 0.076714,
+1073, 0.475329, 0.694445, 0, 0.154445,
+1074, 0.493219, 0.430555, 0, 0.075139,
+1075, 0.421664, 0.430555, 0, 0.075139,
+1076, 0.475329, 0.694445, 0, 0.113861,
+1077, 0.442108, 0.430555, 0, 0.075139,
+1078, 1.047772, 0.430555, 0, 0.056528,
+1079, 0.459997, 0.430555, 0, 0.056528,
+1080, 0.56222, 0.430555, 0, 0.076714,
+1081, 0.56222, 0.638838, 0, 0.076714,
+1082, 0.511108, 0.430555, 0, 0.107638,
+1083, 0.536664, 0.430555, 0, 0.076714,
+1084, 0.741107, 0.430555, 0, 0.076714,
+1085, 0.56222, 0.430555, 0, 0.076714,
+1086, 0.475329, 0.430555, 0, 0.063124,
+1087, 0.56222, 0.430555, 0, 0.076714,
+1088, 0.505997, 0.430555, 0.194445, 0.063124,
+1089, 0.442108, 0.430555, 0, 0.056528,
+1090, 0.817774, 0.430555, 0, 0.076714,
+1091, 0.511108, 0.430555, 0.194445, 0.088472,
+1092, 0.679773, 0.694445, 0.194445, 0.063124,
+1093, 0.540553, 0.430555, 0, 0.120417,
+1094, 0.567331, 0.430555, 0.194445, 0.076714,
+1095, 0.536664, 0.430555, 0, 0.076714,
+1096, 0.817774, 0.430555, 0, 0.076714,
+1097, 0.8228855, 0.430555, 0.194445, 0.076714,
+1098, 0.485553, 0.430555, 0, 0.063124,
+1099, 0.664441, 0.430555, 0, 0.076714,
+1100, 0.511108, 0.430555, 0, 0.063124,
+1101, 0.442108, 0.430555, 0, 0.063124,
+1102, 0.723218, 0.430555, 0, 0.063124,
+1103, 0.536664, 0.430555, 0, 0.076714,
+1105, 0.442108, 0.659131, 0, 0.075139,
+1106, 0.459997, 0.694445, 0.194445, 0.075346,
+1108, 0.442108, 0.430555, 0, 0.082083,
+1109, 0.408887, 0.430555, 0, 0.082083,
+1110, 0.306665, 0.655359, 0, 0.101896,
+1112, 0.306665, 0.655359, 0.194445, 0.144673,
+1113, 0.689997, 0.430555, 0, 0.063124,
+1114, 0.715551, 0.430555, 0, 0.063124,
+1115, 0.511108, 0.694445, 0, 0.076714,
+1119, 0.536664, 0.430555, 0.194445, 0.076714,
+1122, 0.806107, 0.75, 0, 0.10257,
+1123, 0.715551, 0.430555, 0, 0.063124,
+1138, 0.766663, 0.683332, 0, 0.0940275,
+1139, 0.459997, 0.430555, 0, 0.063124,
+1140, 0.806107, 0.683332, 0, 0.183611,
+1141, 0.615275, 0.430555, 0, 0.120417
+METRICS_END
+
+LIGTURES_START
+1044, 1032, 1026,
+1044, 1112, 1026,
+1047, 1061, 1046,
+1047, 1093, 1046,
+1050, 1061, 1061,
+1050, 1093, 1061,
+1051, 1032, 1033,
+1051, 1112, 1033,
+1053, 1032, 1034,
+1053, 1112, 1034,
+1057, 1061, 1064,
+1057, 1093, 1064,
+1058, 1057, 1062,
+1058, 1089, 1062,
+1062, 1061, 1063,
+1062, 1093, 1063,
+1064, 1062, 0,
+1064, 1063, 1065,
+1064, 1094, 0,
+1064, 1095, 1065,
+1067, 1040, 1071,
+1067, 1059, 1070,
+1067, 1072, 1071,
+1067, 1091, 1070,
+1076, 1112, 1106,
+1079, 1093, 1078,
+1082, 1093, 1093,
+1083, 1112, 1113,
+1085, 1112, 1114,
+1089, 1093, 1096,
+1090, 1089, 1094,
+1094, 1093, 1095,
+1096, 1094, 0,
+1096, 1095, 1097,
+1099, 1072, 1103,
+1099, 1091, 1102
+LIGTURES_END
+
+KERNS_START
+1026, 1026, -0.076666,
+1026, 1028, -0.025556,
+1026, 1035, -0.076666,
+1026, 1046, -0.025556,
+1026, 1054, -0.025556,
+1026, 1057, -0.025556,
+1026, 1058, -0.076666,
+1026, 1059, -0.076666,
+1026, 1060, -0.025556,
+1026, 1061, -0.025556,
+1026, 1063, -0.076666,
+1026, 1066, -0.076666,
+1026, 1080, -0.025556,
+1026, 1081, -0.025556,
+1026, 1082, -0.025556,
+1026, 1085, -0.025556,
+1026, 1087, -0.025556,
+1026, 1090, -0.025556,
+1026, 1091, -0.025556,
+1026, 1094, -0.025556,
+1026, 1096, -0.025556,
+1026, 1097, -0.025556,
+1026, 1098, -0.025556,
+1026, 1099, -0.025556,
+1026, 1100, -0.025556,
+1026, 1102, -0.025556,
+1026, 1110, -0.025556,
+1026, 1114, -0.025556,
+1026, 1122, -0.076666,
+1026, 1123, -0.025556,
+1026, 1138, -0.025556,
+1026, 1140, -0.1022215,
+1026, 1141, -0.025556,
+1030, 1030, 0.025556,
+1033, 1026, -0.076666,
+1033, 1028, -0.025556,
+1033, 1035, -0.076666,
+1033, 1046, -0.025556,
+1033, 1054, -0.025556,
+1033, 1057, -0.025556,
+1033, 1058, -0.076666,
+1033, 1059, -0.076666,
+1033, 1060, -0.025556,
+1033, 1061, -0.025556,
+1033, 1063, -0.076666,
+1033, 1066, -0.076666,
+1033, 1080, -0.025556,
+1033, 1081, -0.025556,
+1033, 1082, -0.025556,
+1033, 1085, -0.025556,
+1033, 1087, -0.025556,
+1033, 1090, -0.025556,
+1033, 1091, -0.025556,
+1033, 1094, -0.025556,
+1033, 1096, -0.025556,
+1033, 1097, -0.025556,
+1033, 1098, -0.025556,
+1033, 1099, -0.025556,
+1033, 1100, -0.025556,
+1033, 1102, -0.025556,
+1033, 1110, -0.025556,
+1033, 1114, -0.025556,
+1033, 1122, -0.076666,
+1033, 1123, -0.025556,
+1033, 1138, -0.025556,
+1033, 1140, -0.1022215,
+1033, 1141, -0.025556,
+1034, 1026, -0.076666,
+1034, 1028, -0.025556,
+1034, 1035, -0.076666,
+1034, 1046, -0.025556,
+1034, 1054, -0.025556,
+1034, 1057, -0.025556,
+1034, 1058, -0.076666,
+1034, 1059, -0.076666,
+1034, 1060, -0.025556,
+1034, 1061, -0.025556,
+1034, 1063, -0.076666,
+1034, 1066, -0.076666,
+1034, 1080, -0.025556,
+1034, 1081, -0.025556,
+1034, 1082, -0.025556,
+1034, 1085, -0.025556,
+1034, 1087, -0.025556,
+1034, 1090, -0.025556,
+1034, 1091, -0.025556,
+1034, 1094, -0.025556,
+1034, 1096, -0.025556,
+1034, 1097, -0.025556,
+1034, 1098, -0.025556,
+1034, 1099, -0.025556,
+1034, 1100, -0.025556,
+1034, 1102, -0.025556,
+1034, 1110, -0.025556,
+1034, 1114, -0.025556,
+1034, 1122, -0.076666,
+1034, 1123, -0.025556,
+1034, 1138, -0.025556,
+1034, 1140, -0.1022215,
+1034, 1141, -0.025556,
+1040, 1026, -0.076666,
+1040, 1028, -0.025556,
+1040, 1035, -0.076666,
+1040, 1054, -0.025556,
+1040, 1057, -0.025556,
+1040, 1058, -0.076666,
+1040, 1059, -0.076666,
+1040, 1060, -0.025556,
+1040, 1063, -0.076666,
+1040, 1066, -0.076666,
+1040, 1080, -0.025556,
+1040, 1081, -0.025556,
+1040, 1082, -0.025556,
+1040, 1085, -0.025556,
+1040, 1087, -0.025556,
+1040, 1090, -0.025556,
+1040, 1091, -0.025556,
+1040, 1094, -0.025556,
+1040, 1096, -0.025556,
+1040, 1097, -0.025556,
+1040, 1098, -0.025556,
+1040, 1099, -0.025556,
+1040, 1100, -0.025556,
+1040, 1102, -0.025556,
+1040, 1110, -0.025556,
+1040, 1114, -0.025556,
+1040, 1122, -0.076666,
+1040, 1123, -0.025556,
+1040, 1138, -0.025556,
+1040, 1140, -0.1022215,
+1040, 1141, -0.025556,
+1043, 1033, -0.025556,
+1043, 1040, -0.076666,
+1043, 1044, -0.076666,
+1043, 1051, -0.025556,
+1043, 1071, -0.076666,
+1043, 1072, -0.076666,
+1043, 1077, -0.076666,
+1043, 1080, -0.076666,
+1043, 1081, -0.076666,
+1043, 1083, -0.076666,
+1043, 1084, -0.076666,
+1043, 1086, -0.076666,
+1043, 1089, -0.076666,
+1043, 1091, -0.076666,
+1043, 1092, -0.076666,
+1043, 1094, -0.076666,
+1043, 1096, -0.076666,
+1043, 1097, -0.076666,
+1043, 1098, -0.076666,
+1043, 1099, -0.076666,
+1043, 1100, -0.076666,
+1043, 1105, -0.076666,
+1043, 1108, -0.076666,
+1043, 1113, -0.076666,
+1043, 1139, -0.076666,
+1043, 1141, -0.076666,
+1046, 1028, -0.025556,
+1046, 1054, -0.025556,
+1046, 1057, -0.025556,
+1046, 1060, -0.025556,
+1046, 1095, -0.025556,
+1046, 1138, -0.025556,
+1050, 1028, -0.025556,
+1050, 1054, -0.025556,
+1050, 1057, -0.025556,
+1050, 1060, -0.025556,
+1050, 1095, -0.025556,
+1050, 1138, -0.025556,
+1054, 1040, -0.025556,
+1054, 1044, -0.025556,
+1054, 1046, -0.025556,
+1054, 1059, -0.025556,
+1054, 1061, -0.025556,
+1054, 1071, -0.025556,
+1054, 1140, -0.025556,
+1056, 1033, -0.076666,
+1056, 1040, -0.076666,
+1056, 1044, -0.076666,
+1056, 1051, -0.076666,
+1056, 1071, -0.076666,
+1056, 1072, -0.025556,
+1056, 1076, -0.076666,
+1056, 1077, -0.025556,
+1056, 1083, -0.076666,
+1056, 1086, -0.025556,
+1056, 1105, -0.025556,
+1056, 1113, -0.076666,
+1056, 1139, -0.025556,
+1058, 1033, -0.025556,
+1058, 1040, -0.076666,
+1058, 1044, -0.076666,
+1058, 1051, -0.025556,
+1058, 1071, -0.076666,
+1058, 1072, -0.076666,
+1058, 1077, -0.076666,
+1058, 1080, -0.076666,
+1058, 1081, -0.076666,
+1058, 1083, -0.076666,
+1058, 1084, -0.076666,
+1058, 1086, -0.076666,
+1058, 1089, -0.076666,
+1058, 1091, -0.076666,
+1058, 1092, -0.076666,
+1058, 1094, -0.076666,
+1058, 1096, -0.076666,
+1058, 1097, -0.076666,
+1058, 1098, -0.076666,
+1058, 1099, -0.076666,
+1058, 1100, -0.076666,
+1058, 1105, -0.076666,
+1058, 1108, -0.076666,
+1058, 1113, -0.076666,
+1058, 1139, -0.076666,
+1058, 1141, -0.076666,
+1059, 1028, -0.025556,
+1059, 1033, -0.051111,
+1059, 1040, -0.076666,
+1059, 1044, -0.051111,
+1059, 1051, -0.051111,
+1059, 1054, -0.025556,
+1059, 1057, -0.025556,
+1059, 1060, -0.025556,
+1059, 1071, -0.076666,
+1059, 1072, -0.076666,
+1059, 1077, -0.076666,
+1059, 1080, -0.1022215,
+1059, 1081, -0.1022215,
+1059, 1083, -0.1022215,
+1059, 1084, -0.1022215,
+1059, 1086, -0.076666,
+1059, 1089, -0.076666,
+1059, 1091, -0.1022215,
+1059, 1094, -0.1022215,
+1059, 1096, -0.1022215,
+1059, 1097, -0.1022215,
+1059, 1098, -0.1022215,
+1059, 1099, -0.1022215,
+1059, 1100, -0.1022215,
+1059, 1105, -0.076666,
+1059, 1108, -0.076666,
+1059, 1113, -0.1022215,
+1059, 1138, -0.025556,
+1059, 1139, -0.076666,
+1059, 1141, -0.1022215,
+1060, 1040, -0.025556,
+1060, 1044, -0.025556,
+1060, 1046, -0.025556,
+1060, 1059, -0.025556,
+1060, 1061, -0.025556,
+1060, 1071, -0.025556,
+1060, 1140, -0.025556,
+1061, 1028, -0.025556,
+1061, 1054, -0.025556,
+1061, 1057, -0.025556,
+1061, 1060, -0.025556,
+1061, 1095, -0.025556,
+1061, 1138, -0.025556,
+1066, 1026, -0.076666,
+1066, 1028, -0.025556,
+1066, 1035, -0.076666,
+1066, 1046, -0.025556,
+1066, 1054, -0.025556,
+1066, 1057, -0.025556,
+1066, 1058, -0.076666,
+1066, 1059, -0.076666,
+1066, 1060, -0.025556,
+1066, 1061, -0.025556,
+1066, 1063, -0.076666,
+1066, 1066, -0.076666,
+1066, 1080, -0.025556,
+1066, 1081, -0.025556,
+1066, 1082, -0.025556,
+1066, 1085, -0.025556,
+1066, 1087, -0.025556,
+1066, 1090, -0.025556,
+1066, 1091, -0.025556,
+1066, 1094, -0.025556,
+1066, 1096, -0.025556,
+1066, 1097, -0.025556,
+1066, 1098, -0.025556,
+1066, 1099, -0.025556,
+1066, 1100, -0.025556,
+1066, 1102, -0.025556,
+1066, 1110, -0.025556,
+1066, 1114, -0.025556,
+1066, 1122, -0.076666,
+1066, 1123, -0.025556,
+1066, 1138, -0.025556,
+1066, 1140, -0.1022215,
+1066, 1141, -0.025556,
+1068, 1026, -0.076666,
+1068, 1028, -0.025556,
+1068, 1035, -0.076666,
+1068, 1046, -0.025556,
+1068, 1054, -0.025556,
+1068, 1057, -0.025556,
+1068, 1058, -0.076666,
+1068, 1059, -0.076666,
+1068, 1060, -0.025556,
+1068, 1061, -0.025556,
+1068, 1063, -0.076666,
+1068, 1066, -0.076666,
+1068, 1080, -0.025556,
+1068, 1081, -0.025556,
+1068, 1082, -0.025556,
+1068, 1085, -0.025556,
+1068, 1087, -0.025556,
+1068, 1090, -0.025556,
+1068, 1091, -0.025556,
+1068, 1094, -0.025556,
+1068, 1096, -0.025556,
+1068, 1097, -0.025556,
+1068, 1098, -0.025556,
+1068, 1099, -0.025556,
+1068, 1100, -0.025556,
+1068, 1102, -0.025556,
+1068, 1110, -0.025556,
+1068, 1114, -0.025556,
+1068, 1122, -0.076666,
+1068, 1123, -0.025556,
+1068, 1138, -0.025556,
+1068, 1140, -0.1022215,
+1068, 1141, -0.025556,
+1069, 1040, -0.025556,
+1069, 1044, -0.025556,
+1069, 1046, -0.025556,
+1069, 1059, -0.025556,
+1069, 1061, -0.025556,
+1069, 1071, -0.025556,
+1069, 1140, -0.025556,
+1070, 1040, -0.025556,
+1070, 1044, -0.025556,
+1070, 1046, -0.025556,
+1070, 1059, -0.025556,
+1070, 1061, -0.025556,
+1070, 1071, -0.025556,
+1070, 1140, -0.025556,
+1073, 1072, -0.051111,
+1073, 1083, -0.025556,
+1073, 1084, -0.025556,
+1073, 1092, -0.051111,
+1073, 1113, -0.025556,
+1077, 1072, -0.051111,
+1077, 1083, -0.025556,
+1077, 1084, -0.025556,
+1077, 1092, -0.051111,
+1077, 1113, -0.025556,
+1083, 1083, -0.025556,
+1083, 1084, -0.025556,
+1083, 1095, -0.076666,
+1083, 1098, -0.025556,
+1083, 1113, -0.025556,
+1083, 1141, -0.025556,
+1086, 1072, -0.051111,
+1086, 1083, -0.025556,
+1086, 1084, -0.025556,
+1086, 1092, -0.051111,
+1086, 1113, -0.025556,
+1088, 1072, -0.051111,
+1088, 1083, -0.025556,
+1088, 1084, -0.025556,
+1088, 1092, -0.051111,
+1088, 1113, -0.025556,
+1089, 1072, -0.051111,
+1089, 1083, -0.025556,
+1089, 1084, -0.025556,
+1089, 1092, -0.051111,
+1089, 1113, -0.025556,
+1092, 1072, -0.051111,
+1092, 1083, -0.025556,
+1092, 1084, -0.025556,
+1092, 1092, -0.051111,
+1092, 1113, -0.025556,
+1098, 1083, -0.025556,
+1098, 1084, -0.025556,
+1098, 1086, -0.025556,
+1098, 1092, -0.025556,
+1098, 1095, -0.076666,
+1098, 1098, -0.025556,
+1098, 1108, -0.025556,
+1098, 1113, -0.025556,
+1098, 1139, -0.025556,
+1098, 1141, -0.025556,
+1100, 1083, -0.025556,
+1100, 1084, -0.025556,
+1100, 1086, -0.025556,
+1100, 1092, -0.025556,
+1100, 1095, -0.076666,
+1100, 1098, -0.025556,
+1100, 1108, -0.025556,
+1100, 1113, -0.025556,
+1100, 1139, -0.025556,
+1100, 1141, -0.025556,
+1101, 1072, -0.051111,
+1101, 1083, -0.025556,
+1101, 1084, -0.025556,
+1101, 1092, -0.051111,
+1101, 1113, -0.025556,
+1102, 1072, -0.051111,
+1102, 1083, -0.025556,
+1102, 1084, -0.025556,
+1102, 1092, -0.051111,
+1102, 1113, -0.025556,
+1105, 1072, -0.051111,
+1105, 1083, -0.025556,
+1105, 1084, -0.025556,
+1105, 1092, -0.051111,
+1105, 1113, -0.025556,
+1113, 1083, -0.025556,
+1113, 1084, -0.025556,
+1113, 1086, -0.025556,
+1113, 1092, -0.025556,
+1113, 1095, -0.076666,
+1113, 1098, -0.025556,
+1113, 1108, -0.025556,
+1113, 1113, -0.025556,
+1113, 1139, -0.025556,
+1113, 1141, -0.025556,
+1114, 1083, -0.025556,
+1114, 1084, -0.025556,
+1114, 1086, -0.025556,
+1114, 1092, -0.025556,
+1114, 1095, -0.076666,
+1114, 1098, -0.025556,
+1114, 1108, -0.025556,
+1114, 1113, -0.025556,
+1114, 1139, -0.025556,
+1114, 1141, -0.025556,
+1122, 1026, -0.076666,
+1122, 1028, -0.025556,
+1122, 1035, -0.076666,
+1122, 1046, -0.025556,
+1122, 1054, -0.025556,
+1122, 1057, -0.025556,
+1122, 1058, -0.076666,
+1122, 1059, -0.076666,
+1122, 1060, -0.025556,
+1122, 1061, -0.025556,
+1122, 1063, -0.076666,
+1122, 1066, -0.076666,
+1122, 1080, -0.025556,
+1122, 1081, -0.025556,
+1122, 1082, -0.025556,
+1122, 1085, -0.025556,
+1122, 1087, -0.025556,
+1122, 1090, -0.025556,
+1122, 1091, -0.025556,
+1122, 1094, -0.025556,
+1122, 1096, -0.025556,
+1122, 1097, -0.025556,
+1122, 1098, -0.025556,
+1122, 1099, -0.025556,
+1122, 1100, -0.025556,
+1122, 1102, -0.025556,
+1122, 1110, -0.025556,
+1122, 1114, -0.025556,
+1122, 1122, -0.076666,
+1122, 1123, -0.025556,
+1122, 1138, -0.025556,
+1122, 1140, -0.1022215,
+1122, 1141, -0.025556,
+1123, 1083, -0.025556,
+1123, 1084, -0.025556,
+1123, 1086, -0.025556,
+1123, 1092, -0.025556,
+1123, 1095, -0.076666,
+1123, 1098, -0.025556,
+1123, 1108, -0.025556,
+1123, 1113, -0.025556,
+1123, 1139, -0.025556,
+1123, 1141, -0.025556,
+1138, 1040, -0.025556,
+1138, 1044, -0.025556,
+1138, 1046, -0.025556,
+1138, 1059, -0.025556,
+1138, 1061, -0.025556,
+1138, 1071, -0.025556,
+1138, 1140, -0.025556,
+1139, 1072, -0.051111,
+1139, 1083, -0.025556,
+1139, 1084, -0.025556,
+1139, 1092, -0.051111,
+1139, 1113, -0.025556,
+1140, 1028, -0.025556,
+1140, 1040, -0.1022215,
+1140, 1054, -0.025556,
+1140, 1057, -0.025556,
+1140, 1060, -0.025556,
+1140, 1071, -0.1022215,
+1140, 1072, -0.076666,
+1140, 1077, -0.076666,
+1140, 1080, -0.1022215,
+1140, 1081, -0.1022215,
+1140, 1083, -0.1022215,
+1140, 1084, -0.1022215,
+1140, 1086, -0.076666,
+1140, 1091, -0.1022215,
+1140, 1094, -0.1022215,
+1140, 1096, -0.1022215,
+1140, 1097, -0.1022215,
+1140, 1098, -0.1022215,
+1140, 1099, -0.1022215,
+1140, 1100, -0.1022215,
+1140, 1105, -0.076666,
+1140, 1113, -0.1022215,
+1140, 1138, -0.025556,
+1140, 1139, -0.076666,
+1140, 1141, -0.1022215,
+1141, 1083, -0.076666,
+1141, 1084, -0.076666,
+1141, 1113, -0.076666
+KERNS_END
+
+END
@@ -0,0 +1,148 @@
+// Generated by prebuilt/alphabet_def.py from res/cyrillic/wntt10.xml, do not edit
+
+#include "res/font_def.res.h"
+
+DEF_FONT(wntt10, cyrillic/wntt10.ttf, 95)
+
+xHeight(0.430555) quad(1.049991) space(0.524996)
+
+roman(wnr10) ss(wnss10)
+
+METRICS_START
+171, 0.524996, 0.438889, 0, 0,
+187, 0.524996, 0.438889, 0, 0,
+305, 0.524996, 0.430555, 0, 0,
+774, 0.524996, 0.638838, 0, 0,
+776, 0.524996, 0.611112, 0, 0,
+1025, 0.524996, 0.819394, 0, 0,
+1026, 0.524996, 0.611112, 0, 0,
+1028, 0.524996, 0.611112, 0, 0,
+1029, 0.524996, 0.611112, 0, 0,
+1030, 0.524996, 0.611112, 0, 0,
+1032, 0.524996, 0.611112, 0, 0,
+1033, 0.524996, 0.611112, 0, 0,
+1034, 0.524996, 0.611112, 0, 0,
+1035, 0.524996, 0.611112, 0, 0,
+1039, 0.524996, 0.611112, 0.166667, 0,
+1040, 0.524996, 0.611112, 0, 0,
+1041, 0.524996, 0.611112, 0, 0,
+1042, 0.524996, 0.611112, 0, 0,
+1043, 0.524996, 0.611112, 0, 0,
+1044, 0.524996, 0.611112, 0.166667, 0,
+1045, 0.524996, 0.611112, 0, 0,
+1046, 0.524996, 0.611112, 0, 0,
+1047, 0.524996, 0.611112, 0, 0,
+1048, 0.524996, 0.611112, 0, 0,
+1049, 0.524996, 0.819394, 0, 0,
+1050, 0.524996, 0.611112, 0, 0,
+1051, 0.524996, 0.611112, 0, 0,
+1052, 0.524996, 0.611112, 0, 0,
+1053, 0.524996, 0.611112, 0, 0,
+1054, 0.524996, 0.611112, 0, 0,
+1055, 0.524996, 0.611112, 0, 0,
+1056, 0.524996, 0.611112, 0, 0,
+1057, 0.524996, 0.611112, 0, 0,
+1058, 0.524996, 0.611112, 0, 0,
+1059, 0.524996, 0.611112, 0, 0,
+1060, 0.524996, 0.611112, 0, 0,
+1061, 0.524996, 0.611112, 0, 0,
+1062, 0.524996, 0.611112, 0.166667, 0,
+1063, 0.524996, 0.611112, 0, 0,
+1064, 0.524996, 0.611112, 0, 0,
+1065, 0.524996, 0.611112, 0.166667, 0,
+1066, 0.524996, 0.611112, 0, 0,
+1067, 0.524996, 0.611112, 0, 0,
+1068, 0.524996, 0.611112, 0, 0,
+1069, 0.524996, 0.611112, 0, 0,
+1070, 0.524996, 0.611112, 0, 0,
+1071, 0.524996, 0.611112, 0, 0,
+1072, 0.524996, 0.430555, 0, 0,
+1073, 0.524996, 0.611112, 0, 0,
+1074, 0.524996, 0.430555, 0, 0,
+1075, 0.524996, 0.430555, 0, 0,
+1076, 0.524996, 0.430555, 0.13889, 0,
+1077, 0.524996, 0.430555, 0, 0,
+1078, 0.524996, 0.430555, 0, 0,
+1079, 0.524996, 0.430555, 0, 0,
+1080, 0.524996, 0.430555, 0, 0,
+1081, 0.524996, 0.638838, 0, 0,
+1082, 0.524996, 0.430555, 0, 0,
+1083, 0.524996, 0.430555, 0, 0,
+1084, 0.524996, 0.430555, 0, 0,
+1085, 0.524996, 0.430555, 0, 0,
+1086, 0.524996, 0.430555, 0, 0,
+1087, 0.524996, 0.430555, 0, 0,
+1088, 0.524996, 0.430555, 0.222223, 0,
+1089, 0.524996, 0.430555, 0, 0,
+1090, 0.524996, 0.430555, 0, 0,
+1091, 0.524996, 0.430555, 0.222223, 0,
+1092, 0.524996, 0.611112, 0.222223, 0,
+1093, 0.524996, 0.430555, 0, 0,
+1094, 0.524996, 0.430555, 0.13889, 0,
+1095, 0.524996, 0.430555, 0, 0,
+1096, 0.524996, 0.430555, 0, 0,
+1097, 0.524996, 0.430555, 0.13889, 0,
+1098, 0.524996, 0.430555, 0, 0,
+1099, 0.524996, 0.430555, 0, 0,
+1100, 0.524996, 0.430555, 0, 0,
+1101, 0.524996, 0.430555, 0, 0,
+1102, 0.524996, 0.430555, 0, 0,
+1103, 0.524996, 0.430555, 0, 0,
+1105, 0.524996, 0.611112, 0, 0,
+1106, 0.524996, 0.611112, 0.222223, 0,
+1108, 0.524996, 0.430555, 0, 0,
+1109, 0.524996, 0.430555, 0, 0,
+1110, 0.524996, 0.611112, 0, 0,
+1112, 0.524996, 0.611112, 0.222223, 0,
+1113, 0.524996, 0.430555, 0, 0,
+1114, 0.524996, 0.430555, 0, 0,
+1115, 0.524996, 0.611112, 0, 0,
+1119, 0.524996, 0.430555, 0.13889, 0,
+1122, 0.524996, 0.694445, 0, 0,
+1123, 0.524996, 0.638838, 0, 0,
+1138, 0.524996, 0.611112, 0, 0,
+1139, 0.524996, 0.430555, 0, 0,
+1140, 0.524996, 0.611112, 0, 0,
+1141, 0.524996, 0.430555, 0, 0
+METRICS_END
+
+LIGTURES_START
+1044, 1032, 1026,
+1044, 1112, 1026,
+1047, 1061, 1046,
+1047, 1093, 1046,
+1050, 1061, 1061,
+1050, 1093, 1061,
+1051, 1032, 1033,
+1051, 1112, 1033,
+1053, 1032, 1034,
+1053, 1112, 1034,
+1057, 1061, 1064,
+1057, 1093, 1064,
+1058, 1057, 1062,
+1058, 1089, 1062,
+1062, 1061, 1063,
+1062, 1093, 1063,
+1064, 1062, 0,
+1064, 1063, 1065,
+1064, 1094, 0,
+1064, 1095, 1065,
+1067, 1040, 1071,
+1067, 1059, 1070,
+1067, 1072, 1071,
+1067, 1091, 1070,
+1076, 1112, 1106,
+1079, 1093, 1078,
+1082, 1093, 1093,
+1083, 1112, 1113,
+1085, 1112, 1114,
+1089, 1093, 1096,
+1090, 1089, 1094,
+1094, 1093, 1095,
+1096, 1094, 0,
+1096, 1095, 1097,
+1099, 1072, 1103,
+1099, 1091, 1102
+LIGTURES_END
+
+END
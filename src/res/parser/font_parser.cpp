@@ -317,10 +317,11 @@ void DefaultTeXFontParser::sortBasicInfo(__BasicInfo& bi) {
   sort(begin(bi.largers), end(bi.largers), [](const __Larger& x, const __Larger& y) {
     return x.code < y.code;
   });
-  sort(begin(bi.kerns), end(bi.kerns), [](const __Kern& x, const __Kern& y) {
+  // the first kern or ligature of a pair in the file is the one found, see IndexedArray
+  stable_sort(begin(bi.kerns), end(bi.kerns), [](const __Kern& x, const __Kern& y) {
     return make_tuple(x.left, x.right) < make_tuple(y.left, y.right);
   });
-  sort(begin(bi.ligs), end(bi.ligs), [](const __Lig& x, const __Lig& y) {
+  stable_sort(begin(bi.ligs), end(bi.ligs), [](const __Lig& x, const __Lig& y) {
     return make_tuple(x.left, x.right) < make_tuple(y.left, y.right);
   });
 }
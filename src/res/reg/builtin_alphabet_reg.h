@@ -0,0 +1,13 @@
+#ifndef BUILTIN_ALPHABET_REG_H_INCLUDED
+#define BUILTIN_ALPHABET_REG_H_INCLUDED
+
+#include "fonts/alphabet.h"
+
+/**
+ * BUILTIN ALPHABETS
+ * Generated from the XML-files in res/ by prebuilt/alphabet_def.py
+ */
+DECL_ALPHABET_REG(cyrillic);
+DECL_ALPHABET_REG(greek);
+
+#endif
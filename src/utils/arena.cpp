@@ -0,0 +1,25 @@
+#include "utils/arena.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace tex;
+
+thread_local shared_ptr<Arena> Arena::_current;
+
+void* Arena::allocateBlock(size_t size, size_t align) {
+  const size_t need = size + align;
+  if (need > _nextBlock / 4) {
+    // a large object gets its own block, the current one is kept for the small ones
+    _blocks.emplace_back(new char[need]);
+    _bytes += need;
+    char* p = _blocks.back().get();
+    return p + ((align - ((size_t) p & (align - 1))) & (align - 1));
+  }
+  _blocks.emplace_back(new char[_nextBlock]);
+  _bytes += _nextBlock;
+  _cur = _blocks.back().get();
+  _left = _nextBlock;
+  _nextBlock = min(_nextBlock * 2, MAX_BLOCK);
+  return allocate(size, align);
+}
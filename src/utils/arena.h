@@ -0,0 +1,119 @@
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace tex {
+
+/**
+ * A monotonic buffer the atoms and the boxes of a render are allocated from (see sptrOf). The
+ * memory is never reused, it is released in one shot when the arena is destroyed. The objects
+ * do not keep their arena alive, it is owned by the render the boxes belong to (see
+ * TeXRender#getArena) and by ArenaScope while it is filled, so an object must not outlive
+ * them: the boxes live as long as their render.
+ *
+ * An arena is filled by the thread that installed it with ArenaScope, its objects may be
+ * used and released by any thread afterwards.
+ */
+class Arena {
+private:
+  static constexpr size_t FIRST_BLOCK = 16 << 10;
+  static constexpr size_t MAX_BLOCK = 1 << 20;
+
+  static thread_local std::shared_ptr<Arena> _current;
+
+  std::vector<std::unique_ptr<char[]>> _blocks;
+  char* _cur = nullptr;
+  size_t _left = 0;
+  size_t _nextBlock = FIRST_BLOCK;
+  size_t _bytes = 0;
+
+  void* allocateBlock(size_t size, size_t align);
+
+  friend class ArenaScope;
+
+public:
+  Arena() = default;
+
+  Arena(const Arena&) = delete;
+
+  Arena& operator=(const Arena&) = delete;
+
+  inline void* allocate(size_t size, size_t align) {
+    const size_t pad = (align - ((size_t) _cur & (align - 1))) & (align - 1);
+    if (pad + size > _left) return allocateBlock(size, align);
+    char* p = _cur + pad;
+    _cur = p + size;
+    _left -= pad + size;
+    return p;
+  }
+
+  /** Get the size in bytes of the blocks held by this arena */
+  inline size_t bytes() const {
+    return _bytes;
+  }
+
+  /** Get the arena installed on the current thread, nullptr if none */
+  static inline const std::shared_ptr<Arena>& current() {
+    return _current;
+  }
+};
+
+/** Install an arena on the current thread until this scope ends */
+class ArenaScope {
+private:
+  std::shared_ptr<Arena> _previous;
+
+public:
+  explicit ArenaScope(const std::shared_ptr<Arena>& arena) : _previous(Arena::_current) {
+    Arena::_current = arena;
+  }
+
+  ArenaScope(const ArenaScope&) = delete;
+
+  ArenaScope& operator=(const ArenaScope&) = delete;
+
+  ~ArenaScope() {
+    Arena::_current = std::move(_previous);
+  }
+};
+
+/** Allocator that takes the memory from an arena and never gives it back */
+template <typename T>
+class ArenaAllocator {
+private:
+  Arena* _arena;
+
+  template <typename U>
+  friend class ArenaAllocator;
+
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena* arena) : _arena(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& a) : _arena(a._arena) {}
+
+  inline T* allocate(size_t n) {
+    return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  inline void deallocate(T*, size_t) {}
+
+  template <typename U>
+  inline bool operator==(const ArenaAllocator<U>& a) const {
+    return _arena == a._arena;
+  }
+
+  template <typename U>
+  inline bool operator!=(const ArenaAllocator<U>& a) const {
+    return _arena != a._arena;
+  }
+};
+
+}  // namespace tex
+
+#endif
@@ -23,6 +23,17 @@ enum class Alignment : i8 {
   none = -1
 };
 
+/** How a formula wider than the text width is broken into lines. */
+enum class LineBreaking : i8 {
+  /** Fill each line as much as possible, from the first one to the last one. */
+  greedy,
+  /**
+   * Choose the breaks over the whole formula, so that the lines are evenly filled,
+   * in the manner of the Knuth-Plass algorithm.
+   */
+  optimal
+};
+
 /** Space amount between formulas. */
 enum class SpaceType : i8 {
   thinMuSkip = 1,
@@ -1,18 +1,38 @@
 #ifndef INDEXED_ARR_H_INCLUDED
 #define INDEXED_ARR_H_INCLUDED
 
+#include <cstdint>
+#include <vector>
+
 namespace tex {
 
 /**
  * Template to represents 2 dimensions array with N element(s) for each item and
  * sorted by the first M element(s).
+ *
+ * If the first keys are integral and packed closely enough (e.g. the character
+ * codes of a TeX font), a direct index from the first key to its first row is
+ * built when the array is assigned, so a lookup is a single table load plus a
+ * scan over the (usually 1 item long) run of rows sharing that key. Sparse
+ * arrays fall back to the binary search.
+ *
+ * If several rows have the same keys, the first one is found, like TeX takes the
+ * first kern or ligature of a lig/kern program that matches.
  */
 template <typename T, size_t N, size_t M>
 class IndexedArray {
 private:
+  /** Max ratio of index slots to rows before the array is treated as sparse */
+  static constexpr long DENSE_RATIO = 8;
+  /** Spans up to this size are always indexed directly */
+  static constexpr long DENSE_MIN_SPAN = 256;
+
   const T* _raw;
   size_t   _rows;
   bool     _auto_delete;
+  // direct index: first key - _base -> first row with that key, or -1
+  long                 _base;
+  std::vector<int32_t> _index;
 
   int compare(const T a[M], const T b[M]) const {
     for (size_t i = 0; i < M; i++) {
@@ -22,45 +42,94 @@ private:
     return 0;
   }
 
+  void buildIndex() {
+    _index.clear();
+    if (_raw == nullptr || _rows == 0) return;
+    const long lo = (long) _raw[0];
+    const long hi = (long) _raw[(_rows - 1) * N];
+    const long span = hi - lo + 1;
+    if (span <= 0 || span > DENSE_MIN_SPAN + DENSE_RATIO * (long) _rows) return;
+    for (size_t i = 0; i < _rows; i++) {
+      // only integral first keys can be indexed
+      if ((T) (long) _raw[i * N] != _raw[i * N]) return;
+    }
+    _base = lo;
+    _index.assign(span, -1);
+    for (size_t i = _rows; i-- > 0;) {
+      _index[(long) _raw[i * N] - lo] = (int32_t) i;
+    }
+  }
+
+  /** Get the first row in [l, m] with the given keys, row m has them */
+  const T* lowerBound(const T k[M], int l, int m) const {
+    while (l < m) {
+      const int i = l + ((m - l) >> 1);
+      compare(k, _raw + (i * N)) == 0 ? m = i : l = i + 1;
+    }
+    return _raw + (m * N);
+  }
+
+  const T* find(const T k[M]) const {
+    if (!_index.empty()) {
+      const long k0 = (long) k[0];
+      const unsigned long slot = (unsigned long) (k0 - _base);
+      if ((T) k0 != k[0] || slot >= _index.size()) return nullptr;
+      const int32_t row = _index[slot];
+      if (row < 0) return nullptr;
+      for (const T* r = _raw + row * N, *end = _raw + _rows * N; r < end && r[0] == k[0]; r += N) {
+        if (compare(k, r) == 0) return r;
+      }
+      return nullptr;
+    }
+    int l = 0, h = (int) _rows - 1;
+    while (l <= h) {
+      const int m   = l + ((h - l) >> 1);
+      const T*  r   = _raw + (m * N);
+      const int cmp = compare(k, r);
+      // keep searching below for a first row with the same keys
+      if (cmp == 0) return lowerBound(k, l, m);
+      cmp < 0 ? h = m - 1 : l = m + 1;
+    }
+    return nullptr;
+  }
+
 public:
   IndexedArray(const IndexedArray& arr) = delete;
 
   IndexedArray(IndexedArray&& arr) = delete;
 
-  IndexedArray() : _raw(nullptr), _rows(0), _auto_delete(false) {}
+  IndexedArray() : _raw(nullptr), _rows(0), _auto_delete(false), _base(0) {}
 
   IndexedArray(const T* arr, int len, bool auto_delete = false)
-      : _raw(arr), _rows(len / N), _auto_delete(auto_delete) {}
+      : _raw(arr), _rows(len / N), _auto_delete(auto_delete), _base(0) {
+    buildIndex();
+  }
 
   void operator=(IndexedArray&& o) {
+    if (_auto_delete && _raw != nullptr && _raw != o._raw) delete[] _raw;
     _raw         = o._raw;
     _rows        = o._rows;
     _auto_delete = o._auto_delete;
+    _base        = o._base;
+    _index       = std::move(o._index);
     // reset o
     o._raw         = nullptr;
     o._rows        = 0;
     o._auto_delete = false;
+    o._index.clear();
   }
 
   /** Find the item by the given keys, return nullptr if not found */
   template <typename... Ks>
   const T* operator()(const Ks&... keys) const {
     if (_raw == nullptr) return nullptr;
-    const T k[] = {keys...};
-    int     l = 0, h = _rows;
-    while (l <= h) {
-      const int  m   = l + ((h - l) >> 1);
-      const T*   r   = _raw + (m * N);
-      const int cmp = compare(k, r);
-      if (cmp == 0) return r;
-      cmp < 0 ? h = m - 1 : l = m + 1;
-    }
-    return nullptr;
+    const T k[] = {(T) keys...};
+    return find(k);
   }
 
   /** Get the item by the given index, return nullptr if index out of range */
   const T* operator[](const size_t i) const {
-    if (_raw == nullptr || i < 0 || i >= _rows) return nullptr;
+    if (_raw == nullptr || i >= _rows) return nullptr;
     return _raw + (i * N);
   }
 
@@ -76,6 +145,11 @@ public:
     return _rows == 0 || _raw == nullptr;
   }
 
+  /** Test if the lookups go through the direct index */
+  inline bool isDense() const {
+    return !_index.empty();
+  }
+
   ~IndexedArray() {
     if (_auto_delete && _raw != nullptr) delete[] _raw;
     _raw = nullptr;
@@ -4,8 +4,11 @@
 #include <cinttypes>
 #include <functional>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
+#include "utils/arena.h"
+
 #define no_copy_assign(T) \
   T(const T&) = delete;   \
   void operator=(const T&) = delete
@@ -24,8 +27,22 @@ using c32 = char32_t;
 template<typename T>
 using sptr = std::shared_ptr<T>;
 
+class Atom;
+
+class Box;
+
+/**
+ * Make a shared object, the atoms and the boxes are allocated from the arena installed on
+ * the current thread if any, see ArenaScope.
+ */
 template<typename T, typename... Args>
 inline sptr<T> sptrOf(Args&& ... args) {
+  if constexpr (std::is_base_of<Atom, T>::value || std::is_base_of<Box, T>::value) {
+    const auto& arena = Arena::current();
+    if (arena != nullptr) {
+      return std::allocate_shared<T>(ArenaAllocator<T>(arena.get()), std::forward<Args>(args)...);
+    }
+  }
   return std::make_shared<T>(std::forward<Args>(args)...);
 }
 